@@ -484,8 +484,8 @@ void CConsoleWindow::NotifyOnConnect()
     SetStatusMessage("Connected");
     SetTargetInfoMessage("");
 
-    // -- send the text command to identify this connection as for a debugger
-    SocketManager::SendCommand("DebuggerSetConnected(true);");
+    // -- identify this connection as the debugger - the target ends the session when this connection drops
+    SocketManager::SendDebuggerAttach();
 
     // -- resend our list of breakpoints
     GetDebugBreakpointsWin()->NotifyOnConnect();
@@ -1380,6 +1380,7 @@ void CConsoleInput::keyPressEvent(QKeyEvent * event)
 CConsoleOutput::CConsoleOutput(QWidget* parent) : QListWidget(parent)
 {
     mCurrentTime = 0;
+    mCallstackSize = 0;
 
     mTimer = new QTimer(this);
     connect(mTimer, SIGNAL(timeout()), this, SLOT(Update()));
@@ -1516,61 +1517,98 @@ void CConsoleOutput::ProcessDataPackets()
 
         // -- see what type of data packet we received
         int32* dataPtr = (int32*)packet->mData;
-    
-        // -- get the ID of the packet, as defined in the USER CONSTANTS at the top of socket.h
-        int32 dataType = *dataPtr;
-
-        // -- see if we have a handler for this packet
-        switch (dataType)
-        {
-            case k_DebuggerCurrentWorkingDirPacketID:
-                HandlePacketCurrentWorkingDir(dataPtr);
-                break;
 
-            case k_DebuggerCodeblockLoadedPacketID:
-                HandlePacketCodeblockLoaded(dataPtr);
-                break;
+        // -- dispatch the packet to its handler
+        DispatchPacket(dataPtr, packet->mHeader.mSize);
 
-            case k_DebuggerBreakpointHitPacketID:
-                HandlePacketBreakpointHit(dataPtr);
-                break;
-
-            case k_DebuggerBreakpointConfirmPacketID:
-                HandlePacketBreakpointConfirm(dataPtr);
-                break;
-
-            case k_DebuggerVarWatchConfirmPacketID:
-                HandlePacketVarWatchConfirm(dataPtr);
-                break;
+        // -- the callback is required to manage the packet memory itself
+        delete packet;
+    }
+}
+// ====================================================================================================================
+// DispatchPacket():  Call the handler registered for the packet ID, the first int32 of the data.
+// ====================================================================================================================
+void CConsoleOutput::DispatchPacket(int32* dataPtr, int32 size)
+{
+    // -- the table of handlers, indexed by the packet ID defined in the debugger constants at the top of TinScript.h
+    static HandlePacketMethod handlers[k_DebuggerMaxPacketID + 1] = { NULL };
+    if (!handlers[k_DebuggerCurrentWorkingDirPacketID])
+    {
+        handlers[k_DebuggerCurrentWorkingDirPacketID] = &CConsoleOutput::HandlePacketCurrentWorkingDir;
+        handlers[k_DebuggerCodeblockLoadedPacketID] = &CConsoleOutput::HandlePacketCodeblockLoaded;
+        handlers[k_DebuggerBreakpointHitPacketID] = &CConsoleOutput::HandlePacketBreakpointHit;
+        handlers[k_DebuggerBreakpointConfirmPacketID] = &CConsoleOutput::HandlePacketBreakpointConfirm;
+        handlers[k_DebuggerVarWatchConfirmPacketID] = &CConsoleOutput::HandlePacketVarWatchConfirm;
+        handlers[k_DebuggerCallstackPacketID] = &CConsoleOutput::HandlePacketCallstack;
+        handlers[k_DebuggerCallstackDeltaPacketID] = &CConsoleOutput::HandlePacketCallstackDelta;
+        handlers[k_DebuggerWatchVarEntryPacketID] = &CConsoleOutput::HandlePacketWatchVarEntry;
+        handlers[k_DebuggerAssertMsgPacketID] = &CConsoleOutput::HandlePacketAssertMsg;
+        handlers[k_DebuggerPrintMsgPacketID] = &CConsoleOutput::HandlePacketPrintMsg;
+        handlers[k_DebuggerFunctionAssistPacketID] = &CConsoleOutput::HandlePacketFunctionAssist;
+        handlers[k_DebuggerObjectCreatedPacketID] = &CConsoleOutput::HandlePacketObjectCreated;
+        handlers[k_DebuggerObjectDestroyedPacketID] = &CConsoleOutput::HandlePacketObjectDestroyed;
+        handlers[k_DebuggerSetAddObjectPacketID] = &CConsoleOutput::HandlePacketSetAddObject;
+        handlers[k_DebuggerSetRemoveObjectPacketID] = &CConsoleOutput::HandlePacketSetRemoveObject;
+        handlers[k_DebuggerClearObjectBrowserPacketID] = &CConsoleOutput::HandlePacketClearObjectBrowser;
+        handlers[k_DebuggerTimeScalePacketID] = &CConsoleOutput::HandlePacketTimeScale;
+        handlers[k_DebuggerAddSchedulePacketID] = &CConsoleOutput::HandlePacketAddSchedule;
+        handlers[k_DebuggerRescheduleSchedulePacketID] = &CConsoleOutput::HandlePacketRescheduleSchedule;
+        handlers[k_DebuggerRemoveSchedulePacketID] = &CConsoleOutput::HandlePacketRemoveSchedule;
+        handlers[k_DebuggerLogMsgPacketID] = &CConsoleOutput::HandlePacketLogMsg;
+    }
 
-            case k_DebuggerCallstackPacketID:
-                HandlePacketCallstack(dataPtr);
-                break;
+    // -- see if we have a handler for this packet
+    if (size < (int32)sizeof(int32))
+        return;
+    int32 dataType = *dataPtr;
 
-            case k_DebuggerWatchVarEntryPacketID:
-                HandlePacketWatchVarEntry(dataPtr);
-                break;
+    // -- a batch is the only packet whose handler needs the packet size, to validate the messages within it
+    if (dataType == k_DebuggerBatchPacketID)
+    {
+        HandlePacketBatch(dataPtr, size);
+        return;
+    }
 
-            case k_DebuggerAssertMsgPacketID:
-                HandlePacketAssertMsg(dataPtr);
-                break;
+    if (dataType > 0 && dataType <= k_DebuggerMaxPacketID && handlers[dataType])
+        (this->*handlers[dataType])(dataPtr);
+}
 
-            case k_DebuggerPrintMsgPacketID:
-                HandlePacketPrintMsg(dataPtr);
-                break;
+// ====================================================================================================================
+// HandlePacketBatch():  A handler for a batch of messages, coalesced by the target into a single packet
+// ====================================================================================================================
+void CConsoleOutput::HandlePacketBatch(int32* dataPtr, int32 size)
+{
+    // -- the packet ID and the message count
+    if (size < 2 * (int32)sizeof(int32))
+        return;
 
-            case k_DebuggerFunctionAssistPacketID:
-                HandlePacketFunctionAssist(dataPtr);
-                break;
+    // -- skip past the packet ID
+    ++dataPtr;
 
-            default:
-                break;
+    // -- each message is its (4-byte aligned) size, followed by the message, beginning with its own packet ID
+    int32 count = *dataPtr++;
+    int32 remaining = size - 2 * (int32)sizeof(int32);
+    for (int32 i = 0; i < count; ++i)
+    {
+        // -- never trust a message size that would read past the end of the packet
+        if (remaining < (int32)sizeof(int32))
+            break;
+        int32 msg_size = *dataPtr++;
+        remaining -= (int32)sizeof(int32);
+        if (msg_size < (int32)sizeof(int32) || (msg_size % 4) != 0 || msg_size > remaining)
+        {
+            ConsolePrint("Error - HandlePacketBatch():  message %d of %d has invalid size %d\n", i, count, msg_size);
+            break;
         }
 
-        // -- the callback is required to manage the packet memory itself
-        delete packet;
+        // -- a batch within a batch is never sent
+        if (*dataPtr != k_DebuggerBatchPacketID)
+            DispatchPacket(dataPtr, msg_size);
+        dataPtr += (msg_size / 4);
+        remaining -= msg_size;
     }
 }
+
 // ====================================================================================================================
 // HandlePacketCurrentWorkingDir():  A callback handler for a packet of type "current working directory"
 // ====================================================================================================================
@@ -1701,6 +1739,57 @@ void CConsoleOutput::HandlePacketCallstack(int32* dataPtr)
     DebuggerNotifyCallstack(codeblock_array, objid_array, namespace_array, func_array, linenumber_array, array_size);
 }
 
+// ====================================================================================================================
+// HandlePacketCallstackDelta():  A handler for a callstack, sent as only the frames changed since the last one.
+// ====================================================================================================================
+void CConsoleOutput::HandlePacketCallstackDelta(int32* dataPtr)
+{
+    // -- skip past the packet ID
+    ++dataPtr;
+
+    // -- get the array size, and the number of outermost frames unchanged
+    int32 array_size = *dataPtr++;
+    int32 unchanged_count = *dataPtr++;
+    int32 changed_count = array_size - unchanged_count;
+    if (array_size > kDebuggerCallstackSize || unchanged_count > mCallstackSize || changed_count < 0)
+    {
+        ConsolePrint("Error - HandlePacketCallstackDelta():  invalid callstack delta\n");
+        return;
+    }
+
+    // -- the unchanged frames are the outermost, at the end of the arrays - move them to the end of the new size
+    int32 prev_start = mCallstackSize - unchanged_count;
+    if (prev_start != changed_count)
+    {
+        memmove(&mCallstackCodeblocks[changed_count], &mCallstackCodeblocks[prev_start],
+                sizeof(uint32) * unchanged_count);
+        memmove(&mCallstackObjIDs[changed_count], &mCallstackObjIDs[prev_start], sizeof(uint32) * unchanged_count);
+        memmove(&mCallstackNamespaces[changed_count], &mCallstackNamespaces[prev_start],
+                sizeof(uint32) * unchanged_count);
+        memmove(&mCallstackFunctions[changed_count], &mCallstackFunctions[prev_start],
+                sizeof(uint32) * unchanged_count);
+        memmove(&mCallstackLineNumbers[changed_count], &mCallstackLineNumbers[prev_start],
+                sizeof(uint32) * unchanged_count);
+    }
+
+    // -- copy in the changed frames
+    memcpy(mCallstackCodeblocks, dataPtr, sizeof(uint32) * changed_count);
+    dataPtr += changed_count;
+    memcpy(mCallstackObjIDs, dataPtr, sizeof(uint32) * changed_count);
+    dataPtr += changed_count;
+    memcpy(mCallstackNamespaces, dataPtr, sizeof(uint32) * changed_count);
+    dataPtr += changed_count;
+    memcpy(mCallstackFunctions, dataPtr, sizeof(uint32) * changed_count);
+    dataPtr += changed_count;
+    memcpy(mCallstackLineNumbers, dataPtr, sizeof(uint32) * changed_count);
+    dataPtr += changed_count;
+    mCallstackSize = array_size;
+
+    // -- notify the debugger
+    DebuggerNotifyCallstack(mCallstackCodeblocks, mCallstackObjIDs, mCallstackNamespaces, mCallstackFunctions,
+                            mCallstackLineNumbers, mCallstackSize);
+}
+
 // ====================================================================================================================
 // HandlePacketWatchVarEntry():  A handler for packet type "watch var entry"
 // ====================================================================================================================
@@ -1810,6 +1899,161 @@ void CConsoleOutput::HandlePacketPrintMsg(int32* dataPtr)
     ConsolePrint("%s%s", kConsoleRecvPrefix, msg);
 }
 
+// ====================================================================================================================
+// HandlePacketLogMsg():  A handler for packet type "log", a message with its severity and channel
+// ====================================================================================================================
+void CConsoleOutput::HandlePacketLogMsg(int32* dataPtr)
+{
+    // -- skip past the packet ID
+    ++dataPtr;
+
+    // -- get the severity (the console doesn't filter by channel)
+    int32 severity = *dataPtr++;
+    ++dataPtr;
+
+    // -- get the length of the message string
+    int32 msg_length = *dataPtr++;
+
+    // -- set the const char*
+    const char* msg = (char*)dataPtr;
+    dataPtr += (msg_length / 4);
+
+    // -- add the message, preceeded with some indication that it's a remote message (and a warning or error)
+    const char* severity_prefix = severity == TinScript::LOG_SEVERITY_Error ? "[Error] " :
+                                  severity == TinScript::LOG_SEVERITY_Warning ? "[Warning] " : "";
+    ConsolePrint("%s%s%s", kConsoleRecvPrefix, severity_prefix, msg);
+}
+
+// ====================================================================================================================
+// HandlePacketObjectCreated():  A handler for packet type "object created"
+// ====================================================================================================================
+void CConsoleOutput::HandlePacketObjectCreated(int32* dataPtr)
+{
+    // -- skip past the packet ID
+    ++dataPtr;
+
+    int32 object_id = *dataPtr++;
+
+    // -- get the object name
+    int32 name_length = *dataPtr++;
+    const char* object_name = (char*)dataPtr;
+    dataPtr += (name_length / 4);
+
+    // -- get the derivation
+    int32 derivation_length = *dataPtr++;
+    const char* derivation = (char*)dataPtr;
+    dataPtr += (derivation_length / 4);
+
+    CConsoleWindow::GetInstance()->GetDebugObjectBrowserWin()->NotifyCreateObject(object_id, object_name, derivation);
+}
+
+// ====================================================================================================================
+// HandlePacketObjectDestroyed():  A handler for packet type "object destroyed"
+// ====================================================================================================================
+void CConsoleOutput::HandlePacketObjectDestroyed(int32* dataPtr)
+{
+    // -- skip past the packet ID
+    ++dataPtr;
+
+    int32 object_id = *dataPtr++;
+    CConsoleWindow::GetInstance()->GetDebugObjectBrowserWin()->NotifyDestroyObject(object_id);
+    CConsoleWindow::GetInstance()->NotifyDestroyObject(object_id);
+}
+
+// ====================================================================================================================
+// HandlePacketSetAddObject():  A handler for packet type "set add object"
+// ====================================================================================================================
+void CConsoleOutput::HandlePacketSetAddObject(int32* dataPtr)
+{
+    // -- skip past the packet ID
+    ++dataPtr;
+
+    int32 set_id = *dataPtr++;
+    int32 object_id = *dataPtr++;
+    bool8 owned = *dataPtr++ != 0;
+    CConsoleWindow::GetInstance()->GetDebugObjectBrowserWin()->NotifySetAddObject(set_id, object_id, owned);
+}
+
+// ====================================================================================================================
+// HandlePacketSetRemoveObject():  A handler for packet type "set remove object"
+// ====================================================================================================================
+void CConsoleOutput::HandlePacketSetRemoveObject(int32* dataPtr)
+{
+    // -- skip past the packet ID
+    ++dataPtr;
+
+    int32 set_id = *dataPtr++;
+    int32 object_id = *dataPtr++;
+    CConsoleWindow::GetInstance()->GetDebugObjectBrowserWin()->NotifySetRemoveObject(set_id, object_id);
+}
+
+// ====================================================================================================================
+// HandlePacketClearObjectBrowser():  A handler for packet type "clear object browser"
+// ====================================================================================================================
+void CConsoleOutput::HandlePacketClearObjectBrowser(int32* dataPtr)
+{
+    CConsoleWindow::GetInstance()->GetDebugObjectBrowserWin()->RemoveAll();
+}
+
+// ====================================================================================================================
+// HandlePacketTimeScale():  A handler for packet type "time scale"
+// ====================================================================================================================
+void CConsoleOutput::HandlePacketTimeScale(int32* dataPtr)
+{
+    // -- skip past the packet ID
+    ++dataPtr;
+
+    float32 time_scale = *(float32*)dataPtr++;
+    CConsoleWindow::GetInstance()->GetDebugSchedulesWin()->NotifyTargetTimeScale(time_scale);
+}
+
+// ====================================================================================================================
+// HandlePacketAddSchedule():  A handler for packet type "add schedule"
+// ====================================================================================================================
+void CConsoleOutput::HandlePacketAddSchedule(int32* dataPtr)
+{
+    // -- skip past the packet ID
+    ++dataPtr;
+
+    int32 schedule_id = *dataPtr++;
+    bool8 repeat = *dataPtr++ != 0;
+    int32 time_remaining_ms = *dataPtr++;
+    int32 object_id = *dataPtr++;
+
+    // -- get the command string
+    int32 cmd_length = *dataPtr++;
+    const char* command = (char*)dataPtr;
+    dataPtr += (cmd_length / 4);
+
+    CConsoleWindow::GetInstance()->GetDebugSchedulesWin()->AddSchedule(schedule_id, repeat, time_remaining_ms,
+                                                                       object_id, command);
+}
+
+// ====================================================================================================================
+// HandlePacketRescheduleSchedule():  A handler for packet type "reschedule schedule"
+// ====================================================================================================================
+void CConsoleOutput::HandlePacketRescheduleSchedule(int32* dataPtr)
+{
+    // -- skip past the packet ID
+    ++dataPtr;
+
+    int32 schedule_id = *dataPtr++;
+    int32 time_remaining_ms = *dataPtr++;
+    CConsoleWindow::GetInstance()->GetDebugSchedulesWin()->RescheduleSchedule(schedule_id, time_remaining_ms);
+}
+
+// ====================================================================================================================
+// HandlePacketRemoveSchedule():  A handler for packet type "remove schedule"
+// ====================================================================================================================
+void CConsoleOutput::HandlePacketRemoveSchedule(int32* dataPtr)
+{
+    // -- skip past the packet ID
+    ++dataPtr;
+
+    int32 schedule_id = *dataPtr++;
+    CConsoleWindow::GetInstance()->GetDebugSchedulesWin()->RemoveSchedule(schedule_id);
+}
+
 // ====================================================================================================================
 // HandlePacketFunctionAssist():  A handler for packet type "function assist entry"
 // ====================================================================================================================
@@ -2123,6 +2367,7 @@ int _tmain(int argc, _TCHAR* argv[])
     // -- required to ensure registered functions from unittest.cpp are linked.
     REGISTER_FILE(unittest_cpp);
     REGISTER_FILE(mathutil_cpp);
+    REGISTER_FILE(spatialgrid_cpp);
 
     // -- initialize (true for MainThread context)
     TinScript::CreateContext(ConsolePrint, AssertHandler, true);
@@ -293,6 +293,9 @@ class CConsoleOutput : public QListWidget
 
         void NotifyConnectionStatus(bool is_connected)
         {
+            // -- callstack deltas from a new connection are relative to an empty callstack
+            mCallstackSize = 0;
+
             QDockWidget* parent_widget = static_cast<QDockWidget*>(parent());
 	        QPalette myPalette = parent_widget->palette();
 	        myPalette.setColor(QPalette::WindowText, is_connected ? Qt::darkGreen : Qt::red);	
@@ -330,17 +333,31 @@ class CConsoleOutput : public QListWidget
         void ReceiveDataPacket(SocketManager::tDataPacket* packet);
         void ProcessDataPackets();
 
-        // -- handlers for the data packet
+        // -- handlers for the data packet, dispatched through a table indexed by the packet ID
+        typedef void (CConsoleOutput::*HandlePacketMethod)(int32* dataPtr);
+        void DispatchPacket(int32* dataPtr, int32 size);
+        void HandlePacketBatch(int32* dataPtr, int32 size);
         void HandlePacketCurrentWorkingDir(int32* dataPtr);
         void HandlePacketCodeblockLoaded(int32* dataPtr);
         void HandlePacketBreakpointConfirm(int32* dataPtr);
         void HandlePacketVarWatchConfirm(int32* dataPtr);
         void HandlePacketBreakpointHit(int32* dataPtr);
         void HandlePacketCallstack(int32* dataPtr);
+        void HandlePacketCallstackDelta(int32* dataPtr);
         void HandlePacketWatchVarEntry(int32* dataPtr);
         void HandlePacketAssertMsg(int32* dataPtr);
         void HandlePacketPrintMsg(int32* dataPtr);
+        void HandlePacketLogMsg(int32* dataPtr);
         void HandlePacketFunctionAssist(int32* dataPtr);
+        void HandlePacketObjectCreated(int32* dataPtr);
+        void HandlePacketObjectDestroyed(int32* dataPtr);
+        void HandlePacketSetAddObject(int32* dataPtr);
+        void HandlePacketSetRemoveObject(int32* dataPtr);
+        void HandlePacketClearObjectBrowser(int32* dataPtr);
+        void HandlePacketTimeScale(int32* dataPtr);
+        void HandlePacketAddSchedule(int32* dataPtr);
+        void HandlePacketRescheduleSchedule(int32* dataPtr);
+        void HandlePacketRemoveSchedule(int32* dataPtr);
 
         // -- called while handling a breakpoint, to ensure we still get to update our own context
         void DebuggerUpdate();
@@ -357,6 +374,14 @@ class CConsoleOutput : public QListWidget
         // -- the console output also needs to receive and process data packets
         TinScript::CThreadMutex mThreadLock;
         std::vector<SocketManager::tDataPacket*> mReceivedPackets;
+
+        // -- the target only sends the callstack frames that changed, so the last callstack is kept
+        uint32 mCallstackCodeblocks[kDebuggerCallstackSize];
+        uint32 mCallstackObjIDs[kDebuggerCallstackSize];
+        uint32 mCallstackNamespaces[kDebuggerCallstackSize];
+        uint32 mCallstackFunctions[kDebuggerCallstackSize];
+        uint32 mCallstackLineNumbers[kDebuggerCallstackSize];
+        int32 mCallstackSize;
 };
 
 // ====================================================================================================================
@@ -180,6 +180,11 @@ CDebugObjectInspectWin::CDebugObjectInspectWin(uint32 object_id, const char* obj
 // ====================================================================================================================
 CDebugObjectInspectWin::~CDebugObjectInspectWin()
 {
+    // -- the target sends changes to the object's members while it's inspected
+    if (SocketManager::IsConnected())
+    {
+        SocketManager::SendCommandf("DebuggerStopInspectObject(%d);", mObjectID);
+    }
 }
 
 // ====================================================================================================================
@@ -243,12 +243,27 @@ void CDebugSchedulesWin::AddSchedule(uint32 sched_id, bool repeat, int32 time_re
     SortSchedules();
 }
 
+// ====================================================================================================================
+// RescheduleSchedule():  Notify a repeating (or resumed) schedule has executed, and is pending again.
+// ====================================================================================================================
+void CDebugSchedulesWin::RescheduleSchedule(uint32 sched_id, int32 time_remaining_ms)
+{
+    // -- a schedule not yet received (e.g. while the list is still being sent) will be sent with the listing
+    CScheduleEntry* entry = mEntryMap.value(sched_id, NULL);
+    if (entry)
+    {
+        entry->SetTimeRemaining(time_remaining_ms);
+        SortSchedules();
+    }
+}
+
 // ====================================================================================================================
 // RemoveSchedule():  Notify a schedule has either been canceled or executed.
 // ====================================================================================================================
 void CDebugSchedulesWin::RemoveSchedule(uint32 sched_id)
 {
-    CScheduleEntry* entry = mEntryMap[sched_id];
+    // -- (value() rather than [], which would insert an empty entry for an unknown ID)
+    CScheduleEntry* entry = mEntryMap.value(sched_id, NULL);
     if (entry)
     {
         mEntryMap.remove(entry->GetScheduleID());
@@ -114,6 +114,7 @@ class CDebugSchedulesWin : public QWidget
         QScrollArea* GetScrollArea() { return (mScrollArea); }
 
         void AddSchedule(uint32 sched_id, bool repeat, int32 time_remaining_ms, uint32 object_id, const char* command);
+        void RescheduleSchedule(uint32 sched_id, int32 time_remaining_ms);
         void RemoveSchedule(uint32 sched_id);
         void RemoveAll();
         void SortSchedules();
@@ -115,6 +115,10 @@ void CDemoWidget::OnUpdate()
     // -- update the context
     TinScript::UpdateContext(gCurrentTimeMS);
 
+    // -- notify the scripts subscribed to the frame update
+    if (!gPaused)
+        TinScript::EmitSignal("FrameUpdate");
+
     // -- repaint the window
     repaint();
 }
@@ -382,6 +386,7 @@ int _tmain(int argc, char** argv)
     // -- required to ensure registered functions from unittest.cpp are linked.
     REGISTER_FILE(unittest_cpp);
     REGISTER_FILE(mathutil_cpp);
+    REGISTER_FILE(spatialgrid_cpp);
     REGISTER_FILE(socket_cpp);
 
     // -- Create the TinScript context, using the default printf, and no assert handler
@@ -9,13 +9,24 @@ void ThreadTestCount(int num) {
         schedule(0, 1000, Hash("ThreadTestCount"), num - 1);
 }
 
+// -- same count, as a single scheduled call:  schedule(0, 1, Hash("WaitTestCount"), 5);
+// -- wait suspends the function (keeping its locals) until the scheduler resumes it
+void WaitTestCount(int num) {
+    while (num > 0) {
+        Print(num);
+        num -= 1;
+        wait 1000;
+    }
+    Print(num);
+}
+
 // ====================================================================================================================
 // DefaultGame implementation
 // ====================================================================================================================
 void DefaultGame::OnCreate() : CScriptObject
 {
-    // -- this schedule is repeated, so which will reschedule itself automatically
-    int self.sched_update = repeat(self, 1, hash("OnUpdate"));
+    // -- the demo emits "FrameUpdate" every (unpaused) frame - the subscription is removed when we're destroyed
+    SignalSubscribe("FrameUpdate", self, "OnUpdate");
 
     // -- declare the member, but we'll hook up the actual group in the OnInit()
     // -- this allows hooking up the member from a saved game (which also creates the group)
@@ -54,12 +65,8 @@ void DefaultGame::OnUpdate()
     deltaTime /= 1000.0f;
     self.SimTime = curTime;
 
-    object cur_object = self.game_objects.First();
-    while (IsObject(cur_object))
-    {
-        cur_object.OnUpdate(deltaTime);
-        cur_object = self.game_objects.Next();
-    }
+    // -- update every game object in a single native call
+    self.game_objects.BroadcastFloat("OnUpdate", deltaTime);
 }
 
 void CreateGame()
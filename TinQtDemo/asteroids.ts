@@ -13,6 +13,10 @@ float gBulletSpeed = 150.0f;
 int gMaxBullets = 4;
 float gFireCDTime = 0.1f;
 
+// -- spatial grid layers
+int gLAYER_ASTEROID = 1;
+int gLAYER_BULLET = 2;
+
 // -- FLTK Colors -----------------------------------------------------------------------------------------------------
 int gCOLOR_BLACK = 0xff000000;
 int gCOLOR_RED = 0xffff0000;
@@ -31,16 +35,30 @@ void Asteroid::OnCreate() : SceneObject
     // -- asteroids have movement
     vector3f self.velocity = '0 0 0';
     
-    // -- add ourself to the game's asteroid set
+    // -- add ourself to the game's asteroid set, and its spatial grid
+    object self.spatial_grid;
     object current_game = FindObject("CurrentGame");
     if (IsObject(current_game))
+    {
         current_game.asteroid_set.AddObject(self);
+        self.spatial_grid = current_game.spatial_grid;
+        self.spatial_grid.Insert(self, gLAYER_ASTEROID, self.position, self.radius);
+    }
+}
+
+void Asteroid::OnDestroy()
+{
+    // -- SceneObject::OnDestroy() is called automatically, as OnDestroy() is called for the whole hierarchy
+    if (IsObject(self.spatial_grid))
+        self.spatial_grid.Remove(self);
 }
 
 void Asteroid::OnUpdate(float deltaTime)
 {
     // -- update the screen position - applies the velocity, and wraps
     UpdateScreenPosition(self, deltaTime);
+    if (IsObject(self.spatial_grid))
+        self.spatial_grid.Update(self, self.position, self.radius);
         
     // -- draw the asteroid
     CancelDrawRequests(self);
@@ -320,12 +338,24 @@ void Bullet::OnCreate() : SceneObject
     
     // -- self terminating
     float self.expireTime = 2.0f;
+
+    // -- hooked up by SpawnBullet()
+    object self.spatial_grid;
+}
+
+void Bullet::OnDestroy()
+{
+    // -- SceneObject::OnDestroy() is called automatically, as OnDestroy() is called for the whole hierarchy
+    if (IsObject(self.spatial_grid))
+        self.spatial_grid.Remove(self);
 }
 
 void Bullet::OnUpdate(float deltaTime)
 {
     // -- update the screen position - applies the velocity, and wraps
     UpdateScreenPosition(self, deltaTime);
+    if (IsObject(self.spatial_grid))
+        self.spatial_grid.Update(self, self.position, 0.0f);
     
     // -- we're using our object ID also as a draw request ID
     CancelDrawRequests(self);
@@ -344,10 +374,15 @@ object SpawnBullet(vector3f position, vector3f direction)
     // -- apply the muzzle velocity
     ApplyImpulse(bullet, direction * gBulletSpeed);
     
-    // -- add the bullet to the game's bullet set
+    // -- add the bullet to the game's bullet set, and its spatial grid
+    // -- bullets collide as points, so they're in the grid with a zero radius
     object current_game = FindObject("CurrentGame");
     if (IsObject(current_game))
+    {
         current_game.bullet_set.AddObject(bullet);
+        bullet.spatial_grid = current_game.spatial_grid;
+        bullet.spatial_grid.Insert(bullet, gLAYER_BULLET, bullet.position, 0.0f);
+    }
 }
 
 // ====================================================================================================================
@@ -364,6 +399,11 @@ void AsteroidsGame::OnCreate() : DefaultGame
     // -- generic set, used for deleting bullets/asteroids/etc... things that have collided during OnUpdate
     object self.delete_set = create CObjectSet("DeleteSet");
     
+    // -- the spatial grid finds collisions natively, returning them in the hit sets
+    object self.spatial_grid = create CSpatialGrid("SpatialGrid");
+    object self.hit_bullets = create CObjectSet("HitBullets");
+    object self.hit_asteroids = create CObjectSet("HitAsteroids");
+    
     // -- cache the 'ship' object
     object self.ship;
 }
@@ -385,6 +425,18 @@ void AsteroidsGame::OnInit()
     if (!IsObject(self.delete_set))
         self.delete_set = create CObjectSet("DeleteSet");
         
+    self.spatial_grid = FindObject("SpatialGrid");
+    if (!IsObject(self.spatial_grid))
+        self.spatial_grid = create CSpatialGrid("SpatialGrid");
+        
+    self.hit_bullets = FindObject("HitBullets");
+    if (!IsObject(self.hit_bullets))
+        self.hit_bullets = create CObjectSet("HitBullets");
+        
+    self.hit_asteroids = FindObject("HitAsteroids");
+    if (!IsObject(self.hit_asteroids))
+        self.hit_asteroids = create CObjectSet("HitAsteroids");
+        
     // -- hook up the ship, however, this is only created from StartAsteroids(), not the OnCreate()
     self.ship = FindObject("Ship");
 }
@@ -394,71 +446,50 @@ void AsteroidsGame::OnUpdate()
     // -- update all the scene objects
     DefaultGame::OnUpdate();
     
-    object bullet = self.bullet_set.First();
-    while (IsObject(bullet))
+    // -- a single native query pairs each bullet with the asteroid it hit
+    // -- hit_bullets[i] hit hit_asteroids[i], and each asteroid is hit at most once
+    int hit_count = self.spatial_grid.QueryPairs(gLAYER_BULLET, gLAYER_ASTEROID, self.hit_bullets,
+                                                 self.hit_asteroids);
+
+    // -- destroying an asteroid removes it from the hit set, so walk the pairs from the end
+    while (hit_count > 0)
+    {
+        hit_count -= 1;
+        self.delete_set.AddObject(self.hit_bullets.GetObjectByIndex(hit_count));
+        object asteroid = self.hit_asteroids.GetObjectByIndex(hit_count);
+        asteroid.OnCollision();
+    }
+    
+    // -- look for asteroid collisions with the ship - the grid query finds the asteroids within the sum of
+    // -- the radii, and we only need the exact test against those
+    if (IsObject(self.ship))
     {
-        // -- loop through all the asteroids
-        object asteroid = self.asteroid_set.First();
-        while (IsObject(asteroid))
+        int candidate_count = self.spatial_grid.QueryRadius(self.ship.position, self.ship.radius, gLAYER_ASTEROID,
+                                                            self.hit_asteroids);
+        int i;
+        for (i = 0; i < candidate_count; i += 1)
         {
-            // -- if the bullet is within radius of the asteroid, it's a collision
-            float distance = V3fLength(bullet.position - asteroid.position);
-            if (distance < asteroid.radius)
+            // -- if the distance to from the ship to the asteroid < sum of their radii
+            object candidate = self.hit_asteroids.GetObjectByIndex(i);
+            float distance = V3fLength(candidate.position - self.ship.position);
+            float max_dist = (candidate.radius + self.ship.radius) * 0.75f;
+            if (distance < max_dist)
             {
-                // -- set the flag, call the function
-                asteroid.OnCollision();
+                // -- notify the ship of the collision
+                self.ship.OnCollision();
                 
-                // -- add the bullet to the delete set and break
-                self.delete_set.AddObject(bullet);
+                // -- also split the asteroid
+                candidate.OnCollision();
                 
-                // -- no need to keep colliding with this asteroid
+                // -- note - the asteroid could have been deleted, so the loop should exit without
+                // -- continuing to iterate
                 break;
             }
-            
-            // -- otherwise, get the next asteroid
-            else
-            {
-                asteroid = self.asteroid_set.Next();
-            }
-        }
-        
-        // -- check the next bullet
-        bullet = self.bullet_set.Next();
-    }
-    
-    // -- look for asteroid collisions with the ship
-    object asteroid = self.asteroid_set.First();
-    while (IsObject(asteroid))
-    {
-        // -- if the distance to from the ship to the asteroid < sum of their radii
-        float distance = V3fLength(asteroid.position - self.ship.position);
-        float max_dist = (asteroid.radius + self.ship.radius) * 0.75f;
-        if (distance < max_dist)
-        {
-            // -- notify the ship of the collision
-            self.ship.OnCollision();
-            
-            // -- also split the asteroid
-            asteroid.OnCollision();
-            
-            // -- note - the asteroid could have been deleted, so the loop should exit without
-            // -- continuing to iterate
-            break;
-        }
-        
-        // -- else check the next asteroid
-        else
-        {
-            asteroid = self.asteroid_set.Next();
         }
     }
     
-    // -- now clean up the delete set
-    while (self.delete_set.Used() > 0)
-    {
-        object delete_me = self.delete_set.GetObjectByIndex(0);
-        destroy delete_me;
-    }
+    // -- now clean up the delete set, as a single batch
+    self.delete_set.DestroyObjects();
 }
 
 void AsteroidsGame::OnDestroy()
@@ -467,6 +498,9 @@ void AsteroidsGame::OnDestroy()
     destroy self.asteroid_set;
     destroy self.bullet_set;
     destroy self.delete_set;
+    destroy self.spatial_grid;
+    destroy self.hit_bullets;
+    destroy self.hit_asteroids;
 }
 
 void AsteroidsGame::OnKeyPress(int keypress)
@@ -21,6 +21,7 @@
 
 // -- system includes
 #include <cstdlib>
+#include <cstring>
 
 // -- includes
 #include "mathutil.h"
@@ -53,7 +54,7 @@ void CVector3f::Set(float32 _x, float32 _y, float32 _z)
 // ====================================================================================================================
 float32 CVector3f::Length()
 {
-    float32 length = sqrt(x*x + y*y + z*z);
+    float32 length = sqrt(x * x + y * y + z * z);
     return (length);
 }
 
@@ -62,12 +63,13 @@ float32 CVector3f::Length()
 // ====================================================================================================================
 float32 CVector3f::Normalize()
 {
-    float32 length = sqrt(x*x + y*y + z*z);
+    float32 length = sqrt(x * x + y * y + z * z);
     if (length > 0.0f)
     {
-        x /= length;
-        y /= length;
-        z /= length;
+        float32 inv_length = 1.0f / length;
+        x *= inv_length;
+        y *= inv_length;
+        z *= inv_length;
     }
 
     // -- return the length
@@ -111,6 +113,15 @@ float32 CVector3f::Length(CVector3f v0)
     return (v0.Length());
 }
 
+// ====================================================================================================================
+// Lerp():  Returns the linear interpolation between two vectors
+// ====================================================================================================================
+CVector3f CVector3f::Lerp(CVector3f v0, CVector3f v1, float32 t)
+{
+    CVector3f result = v0 + (v1 - v0) * t;
+    return (result);
+}
+
 // --------------------------------------------------------------------------------------------------------------------
 // -- registered functions
 bool8 TS_Cross(CVector3f* result, CVector3f* v0, CVector3f* v1)
@@ -184,6 +195,307 @@ REGISTER_FUNCTION_P1(V3fLength, CVector3f::Length, float32, CVector3f);
 REGISTER_FUNCTION_P2(V3fCross, CVector3f::Cross, CVector3f, CVector3f, CVector3f);
 REGISTER_FUNCTION_P2(V3fDot, CVector3f::Dot, float32, CVector3f, CVector3f);
 REGISTER_FUNCTION_P1(V3fNormalized, CVector3f::Normalized, CVector3f, CVector3f);
+REGISTER_FUNCTION_P3(V3fLerp, CVector3f::Lerp, CVector3f, CVector3f, CVector3f, float32);
+
+// == CVector4f =======================================================================================================
+
+const CVector4f CVector4f::zero(0.0f, 0.0f, 0.0f, 0.0f);
+
+// ====================================================================================================================
+// Dot():  Returns the dot product of two vectors
+// ====================================================================================================================
+float32 CVector4f::Dot(CVector4f v0, CVector4f v1)
+{
+    return (Simd4fDot(Simd4fLoad(&v0.x), Simd4fLoad(&v1.x)));
+}
+
+// ====================================================================================================================
+// Length():  Returns the length of the input vector
+// ====================================================================================================================
+float32 CVector4f::Length(CVector4f v0)
+{
+    tSimd4f v = Simd4fLoad(&v0.x);
+    return (sqrt(Simd4fDot(v, v)));
+}
+
+// ====================================================================================================================
+// Normalized():  Returns the value of the input vector normalized (a zero vector is returned unchanged)
+// ====================================================================================================================
+CVector4f CVector4f::Normalized(CVector4f v0)
+{
+    tSimd4f v = Simd4fLoad(&v0.x);
+    float32 length = sqrt(Simd4fDot(v, v));
+    if (length <= 0.0f)
+        return (v0);
+
+    CVector4f result;
+    Simd4fStore(&result.x, Simd4fMul(v, Simd4fSplat(1.0f / length)));
+    return (result);
+}
+
+// ====================================================================================================================
+// Lerp():  Returns the linear interpolation between two vectors
+// ====================================================================================================================
+CVector4f CVector4f::Lerp(CVector4f v0, CVector4f v1, float32 t)
+{
+    tSimd4f a = Simd4fLoad(&v0.x);
+    tSimd4f delta = Simd4fSub(Simd4fLoad(&v1.x), a);
+    CVector4f result;
+    Simd4fStore(&result.x, Simd4fAdd(a, Simd4fMul(delta, Simd4fSplat(t))));
+    return (result);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// -- registration - CVector4f is only a registered type, there's no object form
+REGISTER_FUNCTION_P2(V4fDot, CVector4f::Dot, float32, CVector4f, CVector4f);
+REGISTER_FUNCTION_P1(V4fLength, CVector4f::Length, float32, CVector4f);
+REGISTER_FUNCTION_P1(V4fNormalized, CVector4f::Normalized, CVector4f, CVector4f);
+REGISTER_FUNCTION_P3(V4fLerp, CVector4f::Lerp, CVector4f, CVector4f, CVector4f, float32);
+
+// == CQuaternion =====================================================================================================
+
+const CQuaternion CQuaternion::identity(0.0f, 0.0f, 0.0f, 1.0f);
+
+// ====================================================================================================================
+// AxisAngle():  Returns the rotation of the given number of degrees, about the given axis
+// ====================================================================================================================
+CQuaternion CQuaternion::AxisAngle(CVector3f axis, float32 degrees)
+{
+    // -- a zero axis is no rotation at all
+    if (axis.Normalize() <= 0.0f)
+        return (identity);
+
+    float32 half_radians = degrees * (3.1415926535f / 360.0f);
+    float32 s = sinf(half_radians);
+    CQuaternion result(axis.x * s, axis.y * s, axis.z * s, cosf(half_radians));
+    return (result);
+}
+
+// ====================================================================================================================
+// Dot():  Returns the 4D dot product of two quaternions
+// ====================================================================================================================
+float32 CQuaternion::Dot(CQuaternion q0, CQuaternion q1)
+{
+    return (Simd4fDot(Simd4fLoad(&q0.x), Simd4fLoad(&q1.x)));
+}
+
+// ====================================================================================================================
+// Normalized():  Returns the unit length version of the quaternion
+// ====================================================================================================================
+CQuaternion CQuaternion::Normalized(CQuaternion q0)
+{
+    tSimd4f q = Simd4fLoad(&q0.x);
+    float32 length = sqrt(Simd4fDot(q, q));
+    if (length <= 0.0f)
+        return (identity);
+
+    CQuaternion result;
+    Simd4fStore(&result.x, Simd4fMul(q, Simd4fSplat(1.0f / length)));
+    return (result);
+}
+
+// ====================================================================================================================
+// Inverse():  Returns the inverse rotation (the conjugate, scaled by the squared length)
+// ====================================================================================================================
+CQuaternion CQuaternion::Inverse(CQuaternion q0)
+{
+    float32 length_sq = Dot(q0, q0);
+    if (length_sq <= 0.0f)
+        return (identity);
+
+    float32 inv = 1.0f / length_sq;
+    CQuaternion result(-q0.x * inv, -q0.y * inv, -q0.z * inv, q0.w * inv);
+    return (result);
+}
+
+// ====================================================================================================================
+// Slerp():  Returns the spherical interpolation between two rotations, along the shortest arc
+// ====================================================================================================================
+CQuaternion CQuaternion::Slerp(CQuaternion q0, CQuaternion q1, float32 t)
+{
+    tSimd4f a = Simd4fLoad(&q0.x);
+    tSimd4f b = Simd4fLoad(&q1.x);
+    float32 cos_theta = Simd4fDot(a, b);
+
+    // -- q and -q are the same rotation, so take the shorter path
+    if (cos_theta < 0.0f)
+    {
+        b = Simd4fSub(Simd4fSplat(0.0f), b);
+        cos_theta = -cos_theta;
+    }
+
+    // -- nearly parallel, a normalized lerp is accurate (and avoids dividing by sin(theta) ~= 0)
+    float32 scale0 = 1.0f - t;
+    float32 scale1 = t;
+    if (cos_theta < 0.9995f)
+    {
+        float32 theta = acosf(cos_theta);
+        float32 inv_sin_theta = 1.0f / sinf(theta);
+        scale0 = sinf(scale0 * theta) * inv_sin_theta;
+        scale1 = sinf(scale1 * theta) * inv_sin_theta;
+    }
+
+    CQuaternion result;
+    Simd4fStore(&result.x, Simd4fAdd(Simd4fMul(a, Simd4fSplat(scale0)), Simd4fMul(b, Simd4fSplat(scale1))));
+    return (Normalized(result));
+}
+
+// ====================================================================================================================
+// Rotate():  Returns the vector rotated by the (unit) quaternion
+// ====================================================================================================================
+CVector3f CQuaternion::Rotate(CQuaternion q0, CVector3f v0)
+{
+    // -- v' = v + 2w(q x v) + 2(q x (q x v))
+    CVector3f q_xyz(q0.x, q0.y, q0.z);
+    CVector3f t = CVector3f::Cross(q_xyz, v0) * 2.0f;
+    CVector3f result = v0 + t * q0.w + CVector3f::Cross(q_xyz, t);
+    return (result);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// -- quaternion is a registered type, so these are registered functions, and not methods
+REGISTER_FUNCTION_P2(QuatAxisAngle, CQuaternion::AxisAngle, CQuaternion, CVector3f, float32);
+REGISTER_FUNCTION_P2(QuatDot, CQuaternion::Dot, float32, CQuaternion, CQuaternion);
+REGISTER_FUNCTION_P1(QuatNormalized, CQuaternion::Normalized, CQuaternion, CQuaternion);
+REGISTER_FUNCTION_P1(QuatInverse, CQuaternion::Inverse, CQuaternion, CQuaternion);
+REGISTER_FUNCTION_P3(QuatSlerp, CQuaternion::Slerp, CQuaternion, CQuaternion, CQuaternion, float32);
+REGISTER_FUNCTION_P2(QuatRotate, CQuaternion::Rotate, CVector3f, CQuaternion, CVector3f);
+
+// == CMatrix44 =======================================================================================================
+
+// ====================================================================================================================
+// SetIdentity():  Resets the matrix to the identity transform
+// ====================================================================================================================
+void CMatrix44::SetIdentity()
+{
+    for (int32 col = 0; col < 4; ++col)
+    {
+        for (int32 row = 0; row < 4; ++row)
+            m[col][row] = (col == row) ? 1.0f : 0.0f;
+    }
+}
+
+// ====================================================================================================================
+// SetRotation():  Sets the upper 3x3 from a (unit) quaternion, leaving the translation unchanged
+// ====================================================================================================================
+void CMatrix44::SetRotation(CQuaternion q0)
+{
+    float32 xx = q0.x * q0.x, yy = q0.y * q0.y, zz = q0.z * q0.z;
+    float32 xy = q0.x * q0.y, xz = q0.x * q0.z, yz = q0.y * q0.z;
+    float32 wx = q0.w * q0.x, wy = q0.w * q0.y, wz = q0.w * q0.z;
+
+    m[0][0] = 1.0f - 2.0f * (yy + zz);
+    m[0][1] = 2.0f * (xy + wz);
+    m[0][2] = 2.0f * (xz - wy);
+    m[0][3] = 0.0f;
+
+    m[1][0] = 2.0f * (xy - wz);
+    m[1][1] = 1.0f - 2.0f * (xx + zz);
+    m[1][2] = 2.0f * (yz + wx);
+    m[1][3] = 0.0f;
+
+    m[2][0] = 2.0f * (xz + wy);
+    m[2][1] = 2.0f * (yz - wx);
+    m[2][2] = 1.0f - 2.0f * (xx + yy);
+    m[2][3] = 0.0f;
+}
+
+// ====================================================================================================================
+// SetTranslation():  Sets the translation column
+// ====================================================================================================================
+void CMatrix44::SetTranslation(CVector3f t)
+{
+    m[3][0] = t.x;
+    m[3][1] = t.y;
+    m[3][2] = t.z;
+    m[3][3] = 1.0f;
+}
+
+// ====================================================================================================================
+// SetTransform():  Sets both the rotation and translation
+// ====================================================================================================================
+void CMatrix44::SetTransform(CQuaternion q0, CVector3f t)
+{
+    SetRotation(q0);
+    SetTranslation(t);
+}
+
+// ====================================================================================================================
+// GetTranslation():  Returns the translation column
+// ====================================================================================================================
+CVector3f CMatrix44::GetTranslation()
+{
+    return (CVector3f(m[3][0], m[3][1], m[3][2]));
+}
+
+// ====================================================================================================================
+// TransformPoint():  Returns the point transformed, including the translation
+// ====================================================================================================================
+CVector3f CMatrix44::TransformPoint(CVector3f p)
+{
+    tSimd4f result = Simd4fAdd(Simd4fAdd(Simd4fMul(Simd4fLoad(m[0]), Simd4fSplat(p.x)),
+                                         Simd4fMul(Simd4fLoad(m[1]), Simd4fSplat(p.y))),
+                               Simd4fAdd(Simd4fMul(Simd4fLoad(m[2]), Simd4fSplat(p.z)), Simd4fLoad(m[3])));
+    float32 out[4];
+    Simd4fStore(out, result);
+    return (CVector3f(out[0], out[1], out[2]));
+}
+
+// ====================================================================================================================
+// TransformVector():  Returns the direction transformed, ignoring the translation
+// ====================================================================================================================
+CVector3f CMatrix44::TransformVector(CVector3f v)
+{
+    tSimd4f result = Simd4fAdd(Simd4fAdd(Simd4fMul(Simd4fLoad(m[0]), Simd4fSplat(v.x)),
+                                         Simd4fMul(Simd4fLoad(m[1]), Simd4fSplat(v.y))),
+                               Simd4fMul(Simd4fLoad(m[2]), Simd4fSplat(v.z)));
+    float32 out[4];
+    Simd4fStore(out, result);
+    return (CVector3f(out[0], out[1], out[2]));
+}
+
+// ====================================================================================================================
+// Multiply():  Sets this matrix to (m0 * m1), applying m1 first - this may be either argument
+// ====================================================================================================================
+void CMatrix44::Multiply(CMatrix44* m0, CMatrix44* m1)
+{
+    if (!m0 || !m1)
+    {
+        ScriptAssert_(::TinScript::GetContext(), m0 && m1, "<internal>", -1,
+                      "Error - Multiply():  Unable to find the m0/m1 objects\n");
+        return;
+    }
+
+    // -- each result column is m0 * (column of m1)
+    float32 result[4][4];
+    tSimd4f c0 = Simd4fLoad(m0->m[0]);
+    tSimd4f c1 = Simd4fLoad(m0->m[1]);
+    tSimd4f c2 = Simd4fLoad(m0->m[2]);
+    tSimd4f c3 = Simd4fLoad(m0->m[3]);
+    for (int32 col = 0; col < 4; ++col)
+    {
+        const float32* src = m1->m[col];
+        tSimd4f r = Simd4fAdd(Simd4fAdd(Simd4fMul(c0, Simd4fSplat(src[0])), Simd4fMul(c1, Simd4fSplat(src[1]))),
+                              Simd4fAdd(Simd4fMul(c2, Simd4fSplat(src[2])), Simd4fMul(c3, Simd4fSplat(src[3]))));
+        Simd4fStore(result[col], r);
+    }
+
+    memcpy(m, result, sizeof(m));
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// -- registration - CMatrix44 as a object, using create, destroy, etc..
+IMPLEMENT_SCRIPT_CLASS_BEGIN(CMatrix44, VOID)
+IMPLEMENT_SCRIPT_CLASS_END()
+
+REGISTER_METHOD_P0(CMatrix44, SetIdentity, SetIdentity, void);
+REGISTER_METHOD_P1(CMatrix44, SetRotation, SetRotation, void, CQuaternion);
+REGISTER_METHOD_P1(CMatrix44, SetTranslation, SetTranslation, void, CVector3f);
+REGISTER_METHOD_P2(CMatrix44, SetTransform, SetTransform, void, CQuaternion, CVector3f);
+REGISTER_METHOD_P0(CMatrix44, GetTranslation, GetTranslation, CVector3f);
+REGISTER_METHOD_P1(CMatrix44, TransformPoint, TransformPoint, CVector3f, CVector3f);
+REGISTER_METHOD_P1(CMatrix44, TransformVector, TransformVector, CVector3f, CVector3f);
+REGISTER_METHOD_P2(CMatrix44, Multiply, Multiply, void, CMatrix44*, CMatrix44*);
 
 // ====================================================================================================================
 // Random Numbers
@@ -25,10 +25,97 @@
 // -- lib includes
 #include "math.h"
 
+// -- SIMD support:  SSE on x86/x64, NEON on ARM, otherwise a scalar fallback with the same interface
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE__)
+    #define MATHUTIL_SSE 1
+    #include "xmmintrin.h"
+#elif defined(_M_ARM) || defined(__ARM_NEON)
+    #define MATHUTIL_NEON 1
+    #include "arm_neon.h"
+#endif
+
 // -- includes required by any system wanting access to TinScript
 #include "TinScript.h"
 #include "TinRegistration.h"
 
+// ====================================================================================================================
+// -- tSimd4f:  four packed floats, and the handful of operations the math types are built from
+// -- only used by the 16 byte types (vector4f, quaternion, matrix columns) - a 12 byte vector3f would need a gather
+// -- on load and a scatter on store, which costs more than the three scalar ops it replaces
+#if MATHUTIL_SSE
+
+typedef __m128 tSimd4f;
+
+inline tSimd4f Simd4fLoad(const float32* p) { return (_mm_loadu_ps(p)); }
+inline tSimd4f Simd4fSplat(float32 s) { return (_mm_set1_ps(s)); }
+inline void Simd4fStore(float32* p, tSimd4f v) { _mm_storeu_ps(p, v); }
+inline tSimd4f Simd4fAdd(tSimd4f a, tSimd4f b) { return (_mm_add_ps(a, b)); }
+inline tSimd4f Simd4fSub(tSimd4f a, tSimd4f b) { return (_mm_sub_ps(a, b)); }
+inline tSimd4f Simd4fMul(tSimd4f a, tSimd4f b) { return (_mm_mul_ps(a, b)); }
+
+inline float32 Simd4fDot(tSimd4f a, tSimd4f b)
+{
+    __m128 m = _mm_mul_ps(a, b);
+    __m128 s = _mm_add_ps(m, _mm_movehl_ps(m, m));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+    return (_mm_cvtss_f32(s));
+}
+
+#elif MATHUTIL_NEON
+
+typedef float32x4_t tSimd4f;
+
+inline tSimd4f Simd4fLoad(const float32* p) { return (vld1q_f32(p)); }
+inline tSimd4f Simd4fSplat(float32 s) { return (vdupq_n_f32(s)); }
+inline void Simd4fStore(float32* p, tSimd4f v) { vst1q_f32(p, v); }
+inline tSimd4f Simd4fAdd(tSimd4f a, tSimd4f b) { return (vaddq_f32(a, b)); }
+inline tSimd4f Simd4fSub(tSimd4f a, tSimd4f b) { return (vsubq_f32(a, b)); }
+inline tSimd4f Simd4fMul(tSimd4f a, tSimd4f b) { return (vmulq_f32(a, b)); }
+
+inline float32 Simd4fDot(tSimd4f a, tSimd4f b)
+{
+    float32x4_t m = vmulq_f32(a, b);
+    float32x2_t s = vadd_f32(vget_low_f32(m), vget_high_f32(m));
+    s = vpadd_f32(s, s);
+    return (vget_lane_f32(s, 0));
+}
+
+#else
+
+struct tSimd4f
+{
+    float32 v[4];
+};
+
+inline tSimd4f Simd4fLoad(const float32* p) { tSimd4f r = { { p[0], p[1], p[2], p[3] } }; return (r); }
+inline tSimd4f Simd4fSplat(float32 s) { tSimd4f r = { { s, s, s, s } }; return (r); }
+inline void Simd4fStore(float32* p, tSimd4f a) { p[0] = a.v[0]; p[1] = a.v[1]; p[2] = a.v[2]; p[3] = a.v[3]; }
+
+inline tSimd4f Simd4fAdd(tSimd4f a, tSimd4f b)
+{
+    tSimd4f r = { { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] } };
+    return (r);
+}
+
+inline tSimd4f Simd4fSub(tSimd4f a, tSimd4f b)
+{
+    tSimd4f r = { { a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3] } };
+    return (r);
+}
+
+inline tSimd4f Simd4fMul(tSimd4f a, tSimd4f b)
+{
+    tSimd4f r = { { a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] } };
+    return (r);
+}
+
+inline float32 Simd4fDot(tSimd4f a, tSimd4f b)
+{
+    return (a.v[0] * b.v[0] + a.v[1] * b.v[1] + a.v[2] * b.v[2] + a.v[3] * b.v[3]);
+}
+
+#endif
+
 // ====================================================================================================================
 // class CVector3f
 // Simple implementation of a 3D float class
@@ -50,36 +137,37 @@ public:
         return *this;
     }
 
-    CVector3f& operator+(const CVector3f& rhs)
+    CVector3f operator+(const CVector3f& rhs) const
     {
-        x += rhs.x; y += rhs.y; z += rhs.z;
-        return *this;
+        CVector3f result(x + rhs.x, y + rhs.y, z + rhs.z);
+        return (result);
     }
 
-    CVector3f& operator-(const CVector3f& rhs)
+    CVector3f operator-(const CVector3f& rhs) const
     {
-        x -= rhs.x; y -= rhs.y; z -= rhs.z;
-        return *this;
+        CVector3f result(x - rhs.x, y - rhs.y, z - rhs.z);
+        return (result);
     }
 
-    CVector3f& operator*(const float32 s)
+    CVector3f operator*(const float32 s) const
     {
-        x *= s; y *= s; z *= s;
-        return *this;
+        CVector3f result(x * s, y * s, z * s);
+        return (result);
     }
 
-    CVector3f& operator/(const float32 s)
+    CVector3f operator/(const float32 s) const
     {
-        x /= s; y /= s; z /= s;
-        return *this;
+        float32 inv_s = 1.0f / s;
+        CVector3f result(x * inv_s, y * inv_s, z * inv_s);
+        return (result);
     }
 
-    bool8 operator==(const CVector3f& rhs)
+    bool8 operator==(const CVector3f& rhs) const
     {
         return (x == rhs.x && y == rhs.y && z == rhs.z);
     }
 
-    bool8 operator!=(const CVector3f& rhs)
+    bool8 operator!=(const CVector3f& rhs) const
     {
         return (x != rhs.x || y != rhs.y || z != rhs.z);
     }
@@ -93,6 +181,7 @@ public:
     static float32 Dot(CVector3f v0, CVector3f v1);
     static float32 Length(CVector3f v0);
     static CVector3f Normalized(CVector3f v0);
+    static CVector3f Lerp(CVector3f v0, CVector3f v1, float32 t);
 
     static const CVector3f zero;
     static const CVector3f realmax;
@@ -102,6 +191,149 @@ public:
     float32 z;
 };
 
+// ====================================================================================================================
+// class CVector4f
+// 4D float vector, registered as a first class script type.  At 16 bytes, it fills a whole SIMD register, so unlike
+// vector3f, its ops load and store directly.  Script values are only guaranteed 4 byte alignment, so the loads are
+// unaligned - on current hardware, an unaligned load of aligned data costs the same as an aligned one.
+// ====================================================================================================================
+class CVector4f
+{
+public:
+    CVector4f(float32 _x = 0.0f, float32 _y = 0.0f, float32 _z = 0.0f, float32 _w = 0.0f)
+    {
+        x = _x; y = _y; z = _z; w = _w;
+    }
+
+    CVector4f operator+(const CVector4f& rhs) const
+    {
+        CVector4f result;
+        Simd4fStore(&result.x, Simd4fAdd(Simd4fLoad(&x), Simd4fLoad(&rhs.x)));
+        return (result);
+    }
+
+    CVector4f operator-(const CVector4f& rhs) const
+    {
+        CVector4f result;
+        Simd4fStore(&result.x, Simd4fSub(Simd4fLoad(&x), Simd4fLoad(&rhs.x)));
+        return (result);
+    }
+
+    CVector4f operator*(const float32 s) const
+    {
+        CVector4f result;
+        Simd4fStore(&result.x, Simd4fMul(Simd4fLoad(&x), Simd4fSplat(s)));
+        return (result);
+    }
+
+    CVector4f operator/(const float32 s) const
+    {
+        CVector4f result;
+        Simd4fStore(&result.x, Simd4fMul(Simd4fLoad(&x), Simd4fSplat(1.0f / s)));
+        return (result);
+    }
+
+    bool8 operator==(const CVector4f& rhs) const
+    {
+        return (x == rhs.x && y == rhs.y && z == rhs.z && w == rhs.w);
+    }
+
+    bool8 operator!=(const CVector4f& rhs) const
+    {
+        return (x != rhs.x || y != rhs.y || z != rhs.z || w != rhs.w);
+    }
+
+    // -- registered functions
+    static float32 Dot(CVector4f v0, CVector4f v1);
+    static float32 Length(CVector4f v0);
+    static CVector4f Normalized(CVector4f v0);
+    static CVector4f Lerp(CVector4f v0, CVector4f v1, float32 t);
+
+    static const CVector4f zero;
+
+    float32 x;
+    float32 y;
+    float32 z;
+    float32 w;
+};
+
+// ====================================================================================================================
+// class CQuaternion
+// Rotation quaternion, registered as a first class script type (16 bytes, the largest size a script value may be)
+// ====================================================================================================================
+class CQuaternion
+{
+public:
+    CQuaternion(float32 _x = 0.0f, float32 _y = 0.0f, float32 _z = 0.0f, float32 _w = 1.0f)
+    {
+        x = _x; y = _y; z = _z; w = _w;
+    }
+
+    // -- the Hamilton product:  (q0 * q1) rotates by q1, then by q0
+    CQuaternion operator*(const CQuaternion& rhs) const
+    {
+        CQuaternion result(w * rhs.x + x * rhs.w + y * rhs.z - z * rhs.y,
+                           w * rhs.y - x * rhs.z + y * rhs.w + z * rhs.x,
+                           w * rhs.z + x * rhs.y - y * rhs.x + z * rhs.w,
+                           w * rhs.w - x * rhs.x - y * rhs.y - z * rhs.z);
+        return (result);
+    }
+
+    bool8 operator==(const CQuaternion& rhs) const
+    {
+        return (x == rhs.x && y == rhs.y && z == rhs.z && w == rhs.w);
+    }
+
+    bool8 operator!=(const CQuaternion& rhs) const
+    {
+        return (x != rhs.x || y != rhs.y || z != rhs.z || w != rhs.w);
+    }
+
+    // -- registered functions
+    static CQuaternion AxisAngle(CVector3f axis, float32 degrees);
+    static float32 Dot(CQuaternion q0, CQuaternion q1);
+    static CQuaternion Normalized(CQuaternion q0);
+    static CQuaternion Inverse(CQuaternion q0);
+    static CQuaternion Slerp(CQuaternion q0, CQuaternion q1, float32 t);
+    static CVector3f Rotate(CQuaternion q0, CVector3f v0);
+
+    static const CQuaternion identity;
+
+    float32 x;
+    float32 y;
+    float32 z;
+    float32 w;
+};
+
+// ====================================================================================================================
+// class CMatrix44
+// 4x4 transform, column major, for column vectors (p' = M * p).
+// At 64 bytes it's too large to be a script value, so it's registered as a script class, and used by object ID.
+// ====================================================================================================================
+class CMatrix44
+{
+public:
+
+    DECLARE_SCRIPT_CLASS(CMatrix44, VOID);
+
+    CMatrix44()
+    {
+        SetIdentity();
+    }
+
+    // -- registered methods
+    void SetIdentity();
+    void SetRotation(CQuaternion q0);
+    void SetTranslation(CVector3f t);
+    void SetTransform(CQuaternion q0, CVector3f t);
+    CVector3f GetTranslation();
+    CVector3f TransformPoint(CVector3f p);
+    CVector3f TransformVector(CVector3f v);
+    void Multiply(CMatrix44* m0, CMatrix44* m1);
+
+    float32 m[4][4];
+};
+
 // ====================================================================================================================
 // Random Numbers
 // ====================================================================================================================
@@ -22,12 +22,20 @@
 #include "stdafx.h"
 
 // -- system includes
-// -- sockets are only implemented in WIN32
 #ifdef WIN32
     #include <winsock2.h>
     #include <ws2tcpip.h>
+#else
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <netdb.h>
+    #include <poll.h>
+    #include <unistd.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
 #endif
 
+#include <chrono>
 #include <vector>
 
 // -- includes
@@ -44,6 +52,28 @@ DECLARE_FILE(socket_cpp);
 // -- statics
 const uint32 SCK_VERSION2 = 0x0202;
 
+// --------------------------------------------------------------------------------------------------------------------
+// -- the socket implementation is shared - these map the few differences between winsock and BSD sockets
+#ifdef WIN32
+    #define poll WSAPoll
+    #define GetSocketError() WSAGetLastError()
+    #define IsSocketWouldBlock(error) ((error) == WSAEWOULDBLOCK)
+    const int kSocketSendFlags = 0;
+#else
+    #define INVALID_SOCKET (-1)
+    #define SOCKET_ERROR (-1)
+    #define closesocket close
+    #define GetSocketError() errno
+    #define IsSocketWouldBlock(error) ((error) == EWOULDBLOCK || (error) == EAGAIN)
+
+    // -- a closed connection should return an error, not raise SIGPIPE
+    #ifdef MSG_NOSIGNAL
+        const int kSocketSendFlags = MSG_NOSIGNAL;
+    #else
+        const int kSocketSendFlags = 0;
+    #endif
+#endif // WIN32
+
 // == namespace SocketManager =========================================================================================
 
 namespace SocketManager
@@ -52,25 +82,53 @@ namespace SocketManager
 // --------------------------------------------------------------------------------------------------------------------
 // -- statics
 #ifdef WIN32
-    static bool mInitialized = false;
     static DWORD mThreadID = 0;
     static HANDLE mThreadHandle = NULL;
-    static CSocket* mThreadSocket = NULL;
-    static int mThreadSocketID = 1;
 
     // -- WSA variables
     bool mWSAInitialized = false;
     static WSADATA mWSAdata;
+#else
+    static pthread_t mThreadHandle;
+    static bool mThreadCreated = false;
 #endif // WIN32
 
+static CSocket* mThreadSocket = NULL;
+static volatile bool mThreadTerminate = false;
+
 // -- a custom data handler
 static ProcessRecvDataCallback mRecvDataCallback = NULL;
 
+// ====================================================================================================================
+// SetNonBlocking():  Ensure calls on the socket return immediately, instead of waiting for data, or a connection
+// ====================================================================================================================
+static void SetNonBlocking(SOCKET socket_id)
+{
+    #ifdef WIN32
+        u_long iMode = 1;
+        ioctlsocket(socket_id, FIONBIO, &iMode);
+    #else
+        fcntl(socket_id, F_SETFL, fcntl(socket_id, F_GETFL, 0) | O_NONBLOCK);
+    #endif
+}
+
+// ====================================================================================================================
+// GetTimeMS():  Returns a monotonic time, used to update the heartbeat timers
+// The time wraps (every ~49 days), so only the unsigned difference between two times is meaningful.
+// ====================================================================================================================
+static uint32 GetTimeMS()
+{
+    std::chrono::steady_clock::duration time = std::chrono::steady_clock::now().time_since_epoch();
+    return ((uint32)std::chrono::duration_cast<std::chrono::milliseconds>(time).count());
+}
+
 // ====================================================================================================================
 // Initialize():  Initialize the SocketManager
 // ====================================================================================================================
 void Initialize()
 {
+    mThreadTerminate = false;
+
     #ifdef WIN32
         // -- create the thread
         mThreadHandle = CreateThread(NULL,                      // default security attributes
@@ -79,6 +137,8 @@ void Initialize()
                                      TinScript::GetContext(),   // argument to thread function 
                                      0,                         // use default creation flags 
                                      &mThreadID);               // returns the thread identifier 
+    #else
+        mThreadCreated = pthread_create(&mThreadHandle, NULL, ThreadUpdate, TinScript::GetContext()) == 0;
     #endif // WIN32
 }
 
@@ -87,33 +147,42 @@ void Initialize()
 // ====================================================================================================================
 #ifdef WIN32
 DWORD WINAPI ThreadUpdate(void* script_context)
+#else
+void* ThreadUpdate(void* script_context)
+#endif
 {
     // -- see if we need to create the socket
     if (mThreadSocket == NULL)
     {
-        mThreadSocket = new CSocket((TinScript::CScriptContext*)(script_context));
+        #ifdef WIN32
+            // -- initialize the WSAData
+            int error = WSAStartup(SCK_VERSION2, &mWSAdata);
+            if (error)
+            {
+                // -- fail to start Winsock
+                return (0);
+            }
 
-        // -- initialize the WSAData
-        int error = WSAStartup(SCK_VERSION2, &mWSAdata);
-        if (error)
-        {
-            // -- fail to start Winsock
-            return (false);
-        }
+            // -- wrong Winsock version?
+            if (mWSAdata.wVersion != SCK_VERSION2)
+            {
+                WSACleanup();
+                return (0);
+            }
 
-        // -- wrong Winsock version?
-        if (mWSAdata.wVersion != SCK_VERSION2)
+            // -- we were successfully able to initialize WSA
+            mWSAInitialized = true;
+        #endif // WIN32
+
+        mThreadSocket = new CSocket((TinScript::CScriptContext*)(script_context));
+        if (!mThreadSocket->CreateWakeup())
         {
-            WSACleanup();
-            return (false);
+            return (0);
         }
-
-        // -- we were successfully able to initialize WSA
-        mWSAInitialized = true;
     }
 
     // -- update the socket until the thread is terminated
-    while (true)
+    while (!mThreadTerminate)
     {
         // -- listen for connections (internally, will actually listen, or simply ignore)
         if (!mThreadSocket->Listen())
@@ -127,33 +196,50 @@ DWORD WINAPI ThreadUpdate(void* script_context)
             return (0);
         }
 
-        Sleep(k_ThreadUpdateTimeMS);
+        // -- block until there's something to do
+        mThreadSocket->WaitForEvents();
     }
 
     // -- no errors
     return (0);
 }
-#endif // WIN32
 
 // ====================================================================================================================
 // Termintate():  Perform all shutdown and cleanup of the SocketManager
 // ====================================================================================================================
 void Terminate()
 {
-    #ifdef WIN32
-        // -- first disconnect the socket
-        Disconnect();
+    // -- first disconnect the socket
+    Disconnect();
 
-        // -- kill the thread
-        TerminateThread(mThreadHandle, 0);
+    // -- wake the thread, and wait for it to exit
+    mThreadTerminate = true;
+    if (mThreadSocket)
+        mThreadSocket->Wakeup();
 
-        // -- kill the socket
-        if (mThreadSocket)
+    #ifdef WIN32
+        if (mThreadHandle != NULL)
+        {
+            WaitForSingleObject(mThreadHandle, INFINITE);
+            CloseHandle(mThreadHandle);
+            mThreadHandle = NULL;
+        }
+    #else
+        if (mThreadCreated)
         {
-            delete mThreadSocket;
-            mThreadSocket = NULL;
+            pthread_join(mThreadHandle, NULL);
+            mThreadCreated = false;
         }
+    #endif // WIN32
+
+    // -- kill the socket
+    if (mThreadSocket)
+    {
+        delete mThreadSocket;
+        mThreadSocket = NULL;
+    }
 
+    #ifdef WIN32
         // -- see if we need to shutdown WSA
         if (mWSAInitialized)
         {
@@ -168,86 +254,106 @@ void Terminate()
 // ====================================================================================================================
 bool Listen()
 {
-    #ifdef WIN32
-        // -- see if we can enable listening
-        if (mThreadSocket && !mThreadSocket->IsConnected())
-        {
-            mThreadSocket->SetListen(true);
-            return (true);
-        }
-    #endif // WIN32
+    // -- see if we can enable listening - a listening socket continues to accept clients while connected,
+    // -- but a socket that connected to a remote listener can't also listen
+    if (mThreadSocket && (mThreadSocket->GetListen() || !mThreadSocket->IsConnected()))
+    {
+        mThreadSocket->SetListen(true);
+        mThreadSocket->Wakeup();
+        return (true);
+    }
 
     // -- unable to listen for new connections
     return (false);
 }
 
 // ====================================================================================================================
-// Connect():  send a winsock connection request
+// Connect():  send a socket connection request
 // ====================================================================================================================
 bool Connect(const char* ipAddress)
 {
-    bool result = false;
+    if (!mThreadSocket)
+    {
+        TinPrintError(TinScript::GetContext(), "Error - Connect(): SocketManager has not been initialized.\n");
+        return (false);
+    }
+    else if (mThreadSocket->GetListen())
+    {
+        TinPrintError(TinScript::GetContext(), "Error - Connect(): SocketManager is set to listen.\n");
+        return (false);
+    }
+    else if (mThreadSocket->IsConnected())
+    {
+        TinPrintError(TinScript::GetContext(), "Error - Connect(): SocketManager is already connected.\n");
+        return (false);
+    }
 
-    #ifdef WIN32
-        if (!mThreadSocket)
-        {
-            TinPrint(TinScript::GetContext(), "Error - Connect(): SocketManager has not been initialized.\n");
-        }
-        else if (mThreadSocket->GetListen())
-        {
-            TinPrint(TinScript::GetContext(), "Error - Connect(): SocketManager is set to listen.\n");
-            return (false);
-        }
+    // -- default address is loopback
+    if (!ipAddress || !ipAddress[0])
+        ipAddress = "127.0.0.1";
 
-        // -- default address is loopback
-        if (!ipAddress || !ipAddress[0])
-            ipAddress = "127.0.0.1";
+    bool result = mThreadSocket->Connect(ipAddress);
+    if (!result)
+    {
+        TinPrintError(TinScript::GetContext(),
+                      "Error - Connect(): unable to connect - execute SocketListen() on target IP.\n");
+    }
 
-        result = mThreadSocket->Connect(ipAddress);
-        if (!result)
-        {
-            TinPrint(TinScript::GetContext(),
-                     "Error - Connect(): unable to connect - execute SocketListen() on target IP.\n");
-        }
-    #endif // WIN32
+    // -- wake the thread, to begin waiting on the new connection
+    else
+    {
+        mThreadSocket->Wakeup();
+    }
 
     return (result);
 }
 
 // ====================================================================================================================
-// IsConnected():  returns if we have a valid winsock connected
+// IsConnected():  returns if we have a valid socket connected
 // ====================================================================================================================
 bool IsConnected()
 {
-    bool result = false;
+    // -- sanity check
+    if (!mThreadSocket)
+        return (false);
 
-    #ifdef WIN32
-        // -- sanity check
-        if (!mThreadSocket)
-            return (false);
+    return (mThreadSocket->IsConnected());
+}
 
-        result = mThreadSocket->IsConnected();
-    #endif // WIN32
+// ====================================================================================================================
+// Disconnect():  disconnect a socket connection
+// ====================================================================================================================
+void Disconnect()
+{
+    // -- sanity check
+    if (!mThreadSocket)
+        return;
 
-    // -- return the result
-    return (result);
+    // -- call disconnect
+    mThreadSocket->RequestDisconnect();
+    mThreadSocket->SetListen(false);
 }
 
 // ====================================================================================================================
-// Disconnect():  disconnect a winsock connection
+// Subscribe():  Request that the listening end only send messages from the given channels to this connection
 // ====================================================================================================================
-void Disconnect()
+bool Subscribe(uint32 channel_mask)
 {
-    #ifdef WIN32
-        // -- sanity check
-        if (!mThreadSocket)
-            return;
+    // -- ensure we've initialized and connected the socket
+    if (!mThreadSocket || !mThreadSocket->IsConnected())
+    {
+        return (false);
+    }
 
-        // -- call disconnect
-       mThreadSocket->RequestDisconnect();
-       mThreadSocket->SetListen(false);
+    return (mThreadSocket->Subscribe(channel_mask));
+}
 
-    #endif // WIN32
+// ====================================================================================================================
+// IsSubscribed():  Returns true if any connection is subscribed to at least one of the given channels
+// ====================================================================================================================
+bool IsSubscribed(uint32 channel_mask)
+{
+    return (mThreadSocket && mThreadSocket->IsSubscribed(channel_mask));
 }
 
 // ====================================================================================================================
@@ -255,18 +361,12 @@ void Disconnect()
 // ====================================================================================================================
 bool SendCommand(const char* command)
 {
-    bool result = false;
-
-    #ifdef WIN32
-        if (!mThreadSocket)
-        {
-            return (false);
-        }
-
-        result = mThreadSocket->SendScriptCommand(command);
-    #endif
+    if (!mThreadSocket)
+    {
+        return (false);
+    }
 
-    return (result);
+    return (mThreadSocket->SendScriptCommand(command));
 }
 
 // ====================================================================================================================
@@ -274,24 +374,18 @@ bool SendCommand(const char* command)
 // ====================================================================================================================
 bool SendCommandf(const char* fmt, ...)
 {
-    bool result = false;
-
-    #ifdef WIN32
-        // -- ensure we're innitialized, and have a command to send
-        if (!mThreadSocket || !fmt || !fmt[0])
-            return (false);
-
-        // -- create the script command
-        va_list args;
-        va_start(args, fmt);
-        char cmdBuf[2048];
-        vsprintf_s(cmdBuf, 2048, fmt, args);
-        va_end(args);
+    // -- ensure we're innitialized, and have a command to send
+    if (!mThreadSocket || !fmt || !fmt[0])
+        return (false);
 
-        result = mThreadSocket->SendScriptCommand(cmdBuf);
-    #endif // WIN32
+    // -- create the script command
+    va_list args;
+    va_start(args, fmt);
+    char cmdBuf[2048];
+    vsprintf_s(cmdBuf, 2048, fmt, args);
+    va_end(args);
 
-    return (result);
+    return (mThreadSocket->SendScriptCommand(cmdBuf));
 }
 
 // ====================================================================================================================
@@ -299,12 +393,22 @@ bool SendCommandf(const char* fmt, ...)
 // ====================================================================================================================
 void SendDebuggerBreak()
 {
-    #ifdef WIN32
-        // -- construct and send a debugger break packet
-        tPacketHeader header(k_PacketVersion, tPacketHeader::DEBUGGER_BREAK, 0);
-        tDataPacket* newPacket = new tDataPacket(&header, NULL);
-        SendDataPacket(newPacket);
-    #endif // WIN32
+    // -- construct and send a debugger break packet
+    tPacketHeader header(k_PacketVersion, tPacketHeader::DEBUGGER_BREAK, 0);
+    tDataPacket* newPacket = new tDataPacket(&header, NULL);
+    if (!SendDataPacket(newPacket))
+        delete newPacket;
+}
+
+// ====================================================================================================================
+// SendDebuggerAttach():  Identify this connection as the debugger, starting a new debugger session on the target.
+// ====================================================================================================================
+void SendDebuggerAttach()
+{
+    tPacketHeader header(k_PacketVersion, tPacketHeader::DEBUGGER_ATTACH, 0);
+    tDataPacket* newPacket = new tDataPacket(&header, NULL);
+    if (!SendDataPacket(newPacket))
+        delete newPacket;
 }
 
 // ====================================================================================================================
@@ -320,165 +424,583 @@ void RegisterProcessRecvDataCallback(ProcessRecvDataCallback recvCallback)
 // ====================================================================================================================
 tDataPacket* CreateDataPacket(tPacketHeader* header, void* data)
 {
-    tDataPacket* newPacket = NULL;
-    #ifdef WIN32
-        // -- ensure we've initialized and connected the socket
-        if (!mThreadSocket || !mThreadSocket->IsConnected())
+    // -- ensure we've initialized and connected the socket
+    if (!mThreadSocket || !mThreadSocket->IsConnected())
+    {
+        return (NULL);
+    }
+
+    // -- packets have a fixed capacity
+    if (!header || header->mSize < 0 || header->mSize > k_MaxPacketSize)
+    {
+        return (NULL);
+    }
+
+    // -- create the packet, given a header, and possibly data
+    return (new tDataPacket(header, data));
+}
+
+// ====================================================================================================================
+// SendDataPacket():  Send a pre-constructed data packet through the socket
+// ====================================================================================================================
+bool SendDataPacket(tDataPacket* dataPacket)
+{
+    // -- ensure we've initialized and connected the socket
+    if (!mThreadSocket || !mThreadSocket->IsConnected())
+    {
+        return (false);
+    }
+
+    return (mThreadSocket->SendDataPacket(dataPacket));
+}
+
+// ====================================================================================================================
+// SendDataPacket():  Send a header and data through the socket, without creating a packet
+// ====================================================================================================================
+bool SendDataPacket(tPacketHeader* header, const void* data, uint32 channel_mask)
+{
+    // -- ensure we've initialized and connected the socket
+    if (!mThreadSocket || !mThreadSocket->IsConnected())
+    {
+        return (false);
+    }
+
+    return (mThreadSocket->SendDataPacket(header, data, channel_mask));
+}
+
+// == struct tDataPacket ==============================================================================================
+
+// --------------------------------------------------------------------------------------------------------------------
+// -- the packet pool is a free list, threaded through the unused packets
+// -- packets are created and deleted from both the socket thread and the main thread, so access is locked
+struct tFreePacket
+{
+    tFreePacket* mNext;
+};
+
+static tFreePacket* gFreePackets = NULL;
+static int32 gFreePacketCount = 0;
+
+static TinScript::CThreadMutex& GetPacketPoolLock()
+{
+    static TinScript::CThreadMutex packet_pool_lock;
+    return (packet_pool_lock);
+}
+
+// ====================================================================================================================
+// operator new():  Allocate a packet from the pool
+// ====================================================================================================================
+void* tDataPacket::operator new(size_t size)
+{
+    GetPacketPoolLock().Lock();
+    tFreePacket* packet = gFreePackets;
+    if (packet)
+    {
+        gFreePackets = packet->mNext;
+        --gFreePacketCount;
+    }
+    GetPacketPoolLock().Unlock();
+
+    // -- the pool only grows to its high water mark, after which packets are never allocated
+    if (!packet)
+        return (::operator new(size));
+
+    return (packet);
+}
+
+// ====================================================================================================================
+// operator delete():  Return a packet to the pool
+// ====================================================================================================================
+void tDataPacket::operator delete(void* ptr)
+{
+    if (!ptr)
+        return;
+
+    // -- keep up to k_PacketPoolSize free packets
+    GetPacketPoolLock().Lock();
+    if (gFreePacketCount < k_PacketPoolSize)
+    {
+        tFreePacket* packet = (tFreePacket*)ptr;
+        packet->mNext = gFreePackets;
+        gFreePackets = packet;
+        ++gFreePacketCount;
+        ptr = NULL;
+    }
+    GetPacketPoolLock().Unlock();
+
+    if (ptr)
+        ::operator delete(ptr);
+}
+
+// == class DataQueue =================================================================================================
+
+// ====================================================================================================================
+// Constructor
+// ====================================================================================================================
+DataQueue::DataQueue(int32 size, int32 max_size)
+    : mSize(size)
+    , mMaxSize(max_size > size ? max_size : size)
+    , mReadIndex(0)
+    , mUsed(0)
+{
+    mBuffer = new char[mSize];
+}
+
+// ====================================================================================================================
+// Destructor
+// ====================================================================================================================
+DataQueue::~DataQueue()
+{
+    delete [] mBuffer;
+}
+
+// ====================================================================================================================
+// Enqueue():  Add a packet header, followed by its data, to the queue
+// ====================================================================================================================
+bool DataQueue::Enqueue(const tPacketHeader& header, const void* data)
+{
+    // -- sanity check - validate the packet
+    if (header.mSize < 0 || header.mSize > k_MaxPacketSize || (header.mSize > 0 && !data))
+    {
+        return (false);
+    }
+    if (header.mType <= tPacketHeader::NONE || header.mType >= tPacketHeader::COUNT)
+    {
+        return (false);
+    }
+    if (header.mVersion != k_PacketVersion)
+    {
+        return (false);
+    }
+
+    // -- ensure we have room for the packet, without growing past the max size
+    if (!HasRoom(header.mSize))
+    {
+        return (false);
+    }
+
+    int32 required = (int32)sizeof(tPacketHeader) + header.mSize;
+    if (GetFree() < required)
+        Grow(required);
+
+    // -- copy the header and data to the back of the queue, wrapping as needed
+    const char* src_ptrs[2] = { (const char*)&header, (const char*)data };
+    int32 src_sizes[2] = { (int32)sizeof(tPacketHeader), header.mSize };
+    for (int32 i = 0; i < 2; ++i)
+    {
+        const char* src = src_ptrs[i];
+        int32 remaining = src_sizes[i];
+        while (remaining > 0)
         {
-            return (NULL);
+            int32 contiguous = 0;
+            char* dest = GetWritePtr(contiguous);
+            int32 bytes_to_copy = remaining < contiguous ? remaining : contiguous;
+            memcpy(dest, src, bytes_to_copy);
+            Commit(bytes_to_copy);
+            src += bytes_to_copy;
+            remaining -= bytes_to_copy;
         }
+    }
 
-        // -- create the packet, given a header, and possibly data
-        newPacket = new tDataPacket(header, data);
+    // -- success
+    return (true);
+}
 
-    #endif // WIN32
+// ====================================================================================================================
+// Peek():  Copy bytes from the queue, without removing them
+// ====================================================================================================================
+void DataQueue::Peek(int32 offset, void* dest, int32 size) const
+{
+    if (offset < 0 || size <= 0 || offset + size > mUsed)
+        return;
+
+    // -- copy up to the end of the buffer, and the remainder from the start
+    int32 index = (mReadIndex + offset) % mSize;
+    int32 first_size = mSize - index;
+    if (first_size > size)
+        first_size = size;
+    memcpy(dest, &mBuffer[index], first_size);
+    if (first_size < size)
+        memcpy((char*)dest + first_size, mBuffer, size - first_size);
+}
 
-    // -- return the result
-    return (newPacket);
+// ====================================================================================================================
+// GetReadPtr():  Returns the front of the queue, and the number of contiguous bytes that can be read
+// ====================================================================================================================
+const char* DataQueue::GetReadPtr(int32& contiguous) const
+{
+    contiguous = mSize - mReadIndex;
+    if (contiguous > mUsed)
+        contiguous = mUsed;
+    return (&mBuffer[mReadIndex]);
 }
 
 // ====================================================================================================================
-// SendDataPacket():  Send a pre-constructed data packet through the socket
+// Consume():  Remove bytes from the front of the queue
 // ====================================================================================================================
-bool SendDataPacket(tDataPacket* dataPacket)
+void DataQueue::Consume(int32 size)
+{
+    if (size > mUsed)
+        size = mUsed;
+    mReadIndex = (mReadIndex + size) % mSize;
+    mUsed -= size;
+
+    // -- if the queue is empty, start again at the front, to keep the free space contiguous
+    if (mUsed == 0)
+        mReadIndex = 0;
+}
+
+// ====================================================================================================================
+// GetWritePtr():  Returns the back of the queue, and the number of contiguous bytes that can be written
+// ====================================================================================================================
+char* DataQueue::GetWritePtr(int32& contiguous)
+{
+    int32 write_index = (mReadIndex + mUsed) % mSize;
+    contiguous = (write_index >= mReadIndex && mUsed < mSize) ? mSize - write_index : mReadIndex - write_index;
+    return (&mBuffer[write_index]);
+}
+
+// ====================================================================================================================
+// Commit():  Add bytes written through GetWritePtr() to the back of the queue
+// ====================================================================================================================
+void DataQueue::Commit(int32 size)
+{
+    mUsed += size;
+    if (mUsed > mSize)
+        mUsed = mSize;
+}
+
+// ====================================================================================================================
+// Grow():  Increase the size of the queue, to fit at least the required number of additional bytes
+// ====================================================================================================================
+void DataQueue::Grow(int32 required)
 {
-    // -- initialize the result
-    bool result = false;
+    int32 new_size = mSize * 2;
+    while (new_size - mUsed < required)
+        new_size *= 2;
+    if (new_size > mMaxSize)
+        new_size = mMaxSize;
+
+    // -- copy the contents to the front of the new buffer
+    char* new_buffer = new char[new_size];
+    Peek(0, new_buffer, mUsed);
+    delete [] mBuffer;
+
+    mBuffer = new_buffer;
+    mSize = new_size;
+    mReadIndex = 0;
+}
 
+// ====================================================================================================================
+// Clear();
+// ====================================================================================================================
+void DataQueue::Clear()
+{
+    mReadIndex = 0;
+    mUsed = 0;
+}
+
+// == CSocket =========================================================================================================
+
+// ====================================================================================================================
+// Constructor
+// ====================================================================================================================
+CSocket::CSocket(TinScript::CScriptContext* script_context)
+    : mListen(false)
+    , mListenSocket(INVALID_SOCKET)
+    , mConnectionCount(0)
+    , mLastUpdateTimeMS(0)
+    , mSubscribedChannels(0)
+    , mScriptContext(script_context)
+    , mWakeupRecv(INVALID_SOCKET)
+    , mWakeupSend(INVALID_SOCKET)
+{
+}
+
+// ====================================================================================================================
+// Destructor
+// ====================================================================================================================
+CSocket::~CSocket()
+{
+    // -- close the socket if it exists
+    if (mListenSocket != INVALID_SOCKET)
+        closesocket(mListenSocket);
+
+    // -- close any open connections
+    for (int32 i = 0; i < k_MaxConnections; ++i)
+    {
+        if (mConnections[i].mConnected)
+            closesocket(mConnections[i].mSocket);
+    }
+
+    DestroyWakeup();
+}
+
+// ====================================================================================================================
+// CreateWakeup():  Create the descriptor pair used to interrupt WaitForEvents() from another thread
+// ====================================================================================================================
+bool CSocket::CreateWakeup()
+{
     #ifdef WIN32
-        // -- ensure we've initialized and connected the socket
-        if (!mThreadSocket || !mThreadSocket->IsConnected())
+        // -- winsock can only poll sockets, so the wakeup is a loopback UDP socket, connected to itself
+        SOCKET wakeup = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (wakeup == INVALID_SOCKET)
+            return (false);
+
+        sockaddr_in addr;
+        int addr_length = sizeof(addr);
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        if (bind(wakeup, (sockaddr*)&addr, sizeof(addr)) == SOCKET_ERROR ||
+            getsockname(wakeup, (sockaddr*)&addr, &addr_length) == SOCKET_ERROR ||
+            connect(wakeup, (sockaddr*)&addr, sizeof(addr)) == SOCKET_ERROR)
         {
-            return (NULL);
+            closesocket(wakeup);
+            return (false);
         }
 
-        result = mThreadSocket->SendDataPacket(dataPacket);
+        mWakeupRecv = wakeup;
+        mWakeupSend = wakeup;
+    #else
+        int pipe_fds[2];
+        if (pipe(pipe_fds) != 0)
+            return (false);
+
+        mWakeupRecv = pipe_fds[0];
+        mWakeupSend = pipe_fds[1];
     #endif // WIN32
 
-    // -- return the result
-    return (result);
+    // -- neither end should ever block the thread - a full buffer already guarantees a wakeup
+    SetNonBlocking(mWakeupRecv);
+    SetNonBlocking(mWakeupSend);
+    return (true);
+}
+
+// ====================================================================================================================
+// DestroyWakeup():  Close the wakeup descriptors
+// ====================================================================================================================
+void CSocket::DestroyWakeup()
+{
+    if (mWakeupSend != INVALID_SOCKET && mWakeupSend != mWakeupRecv)
+        closesocket(mWakeupSend);
+    if (mWakeupRecv != INVALID_SOCKET)
+        closesocket(mWakeupRecv);
+
+    mWakeupRecv = INVALID_SOCKET;
+    mWakeupSend = INVALID_SOCKET;
+}
+
+// ====================================================================================================================
+// Wakeup():  Interrupt the socket thread, waiting in WaitForEvents()
+// ====================================================================================================================
+void CSocket::Wakeup()
+{
+    if (mWakeupSend == INVALID_SOCKET)
+        return;
+
+    char wakeup = 0;
+    #ifdef WIN32
+        send(mWakeupSend, &wakeup, 1, 0);
+    #else
+        ssize_t result = write(mWakeupSend, &wakeup, 1);
+        (void)result;
+    #endif // WIN32
 }
 
-// == class DataQueue =================================================================================================
-
 // ====================================================================================================================
-// Constructure
+// DrainWakeup():  Consume all pending wakeups, so the next WaitForEvents() will block again
 // ====================================================================================================================
-DataQueue::DataQueue()
+void CSocket::DrainWakeup()
 {
+    char drain_buf[64];
+    #ifdef WIN32
+        while (recv(mWakeupRecv, drain_buf, sizeof(drain_buf), 0) > 0);
+    #else
+        while (read(mWakeupRecv, drain_buf, sizeof(drain_buf)) > 0);
+    #endif // WIN32
 }
 
 // ====================================================================================================================
-// Enqueue():  Add data to the queue
+// WaitForEvents():  Block until the socket has data or room to send, a heartbeat is due, or we're woken up
 // ====================================================================================================================
-bool DataQueue::Enqueue(tDataPacket* packet, bool at_front)
+void CSocket::WaitForEvents()
 {
-    // -- sanity check - validate the packet
-    if (!packet || (packet->mHeader.mSize > 0 && !packet->mData))
-    {
-        return (false);
-    }
-    if (packet->mHeader.mType <= tPacketHeader::NONE || packet->mHeader.mType >= tPacketHeader::COUNT)
+    pollfd poll_fds[2 + k_MaxConnections];
+    int poll_count = 0;
+    int timeout_ms = -1;
+
+    // -- we can always be woken up, e.g. a packet was queued to send, or we were asked to listen or connect
+    poll_fds[poll_count].fd = mWakeupRecv;
+    poll_fds[poll_count].events = POLLIN;
+    poll_fds[poll_count].revents = 0;
+    ++poll_count;
+
+    mThreadLock.Lock();
+
+    // -- if we're listening and have room for another client, wait for a connection request
+    if (mListen && mListenSocket != INVALID_SOCKET && mConnectionCount < k_MaxConnections)
     {
-        return (false);
+        poll_fds[poll_count].fd = mListenSocket;
+        poll_fds[poll_count].events = POLLIN;
+        poll_fds[poll_count].revents = 0;
+        ++poll_count;
     }
-    if (packet->mHeader.mVersion != k_PacketVersion)
+
+    for (int32 i = 0; i < k_MaxConnections; ++i)
     {
-        return (false);
+        tConnection& connection = mConnections[i];
+        if (!connection.mConnected)
+            continue;
+
+        // -- wait for incoming data (if we have room to receive it),
+        // -- and if we weren't able to send everything, for room to send the rest
+        poll_fds[poll_count].fd = connection.mSocket;
+        poll_fds[poll_count].events = (connection.mRecvQueue.GetFree() > 0 ? POLLIN : 0) |
+                                      (connection.mSendQueue.IsEmpty() ? 0 : POLLOUT);
+        poll_fds[poll_count].revents = 0;
+        ++poll_count;
+
+        // -- wake in time to send the earliest heartbeat, or to time out a partner
+        int32 heartbeat_ms = connection.mSendHeartbeatTimer < connection.mRecvHeartbeatTimer
+                             ? connection.mSendHeartbeatTimer
+                             : connection.mRecvHeartbeatTimer;
+
+        // -- if the script context couldn't accept all the received packets, retry shortly
+        if (connection.mRecvQueueBlocked && heartbeat_ms > k_ThreadUpdateTimeMS)
+            heartbeat_ms = k_ThreadUpdateTimeMS;
+
+        if (heartbeat_ms < 0)
+            heartbeat_ms = 0;
+
+        if (timeout_ms < 0 || heartbeat_ms < timeout_ms)
+            timeout_ms = heartbeat_ms;
     }
 
-    // -- add the packet to the queue
-    if (at_front)
-        mQueue.insert(mQueue.begin(), packet);
-    else
-        mQueue.push_back(packet);
+    mThreadLock.Unlock();
 
-    // -- success
-    return (true);
+    // -- block - when idle, there's no timeout at all
+    poll(poll_fds, poll_count, timeout_ms);
+
+    if (poll_fds[0].revents & POLLIN)
+        DrainWakeup();
 }
 
 // ====================================================================================================================
-// Dequeue():  return the next data block and size
+// AddConnection():  Add a newly connected socket to the first free connection slot
 // ====================================================================================================================
-bool DataQueue::Dequeue(tDataPacket*& packet, bool peekOnly)
+void CSocket::AddConnection(SOCKET socket_id)
 {
-    if (mQueue.size() == 0)
-        return (false);
-
-    // -- if we didn't request a specific packet ID, return the first element
-    packet = mQueue[0];
+    // -- find a free slot - the caller has already ensured there is one
+    tConnection* connection = NULL;
+    for (int32 i = 0; i < k_MaxConnections; ++i)
+    {
+        if (!mConnections[i].mConnected)
+        {
+            connection = &mConnections[i];
+            break;
+        }
+    }
 
-    // -- if we're only peeking, then don't remove
-    if (!peekOnly)
-        mQueue.erase(mQueue.begin());
+    if (!connection)
+    {
+        closesocket(socket_id);
+        return;
+    }
 
-    return (true);
+    // -- ensure the connect socket is non-blocking
+    SetNonBlocking(socket_id);
+
+    // -- a new client receives every channel, until it subscribes otherwise
+    connection->mSocket = socket_id;
+    connection->mConnected = true;
+    connection->mChannels = k_DebuggerChannelMaskAll;
+    connection->mRecvQueueBlocked = false;
+    connection->mSendQueueOverflow = false;
+    connection->mDebugger = false;
+    connection->mSendQueue.Clear();
+    connection->mRecvQueue.Clear();
+
+    // -- initialize the heartbeat - the update time is shared by all connections
+    connection->mSendHeartbeatTimer = k_HeartbeatTimeMS;
+    connection->mRecvHeartbeatTimer = k_HeartbeatTimeoutMS;
+    if (mConnectionCount == 0)
+        mLastUpdateTimeMS = GetTimeMS();
+
+    ++mConnectionCount;
+    UpdateSubscribedChannels();
 }
 
 // ====================================================================================================================
-// Clear();
+// DisconnectConnection():  Close a single connection, leaving any others open
 // ====================================================================================================================
-void DataQueue::Clear()
+void CSocket::DisconnectConnection(tConnection& connection)
 {
-    // -- delete all queued packets
-    while (mQueue.size() > 0)
+    mThreadLock.Lock();
+
+    if (!connection.mConnected)
     {
-        tDataPacket* packet = mQueue[0];
-        mQueue.erase(mQueue.begin());
-        delete packet;
+        mThreadLock.Unlock();
+        return;
     }
-}
 
-// == CSocket =========================================================================================================
+    // -- close the socket
+    closesocket(connection.mSocket);
+    connection.mSocket = INVALID_SOCKET;
+    connection.mConnected = false;
+    connection.mRecvQueueBlocked = false;
+    connection.mSendQueueOverflow = false;
+    --mConnectionCount;
 
-// -- only implmeented in WIN32
-#ifdef WIN32
+    // -- clear the queues
+    connection.mSendQueue.Clear();
+    connection.mRecvQueue.Clear();
 
-// ====================================================================================================================
-// Constructor
-// ====================================================================================================================
-CSocket::CSocket(TinScript::CScriptContext* script_context)
-    : mListen(false)
-    , mConnected(false)
-    , mListenSocket(INVALID_SOCKET)
-    , mConnectSocket(INVALID_SOCKET)
-    , mScriptContext(script_context)
-{
-    // -- initialize the incoming packet members
-    mRecvHeader[0] = '\0';
-    mRecvPtr = mRecvHeader;
-    mRecvPacket = NULL;
+    UpdateSubscribedChannels();
+
+    // -- notify TinScript - if this connection owned the debugger session, the session ends (clearing its
+    // -- breakpoints and releasing a break loop), even if other clients remain connected
+    // -- note:  a client that never attached as the debugger only ends the session if it was the last subscriber
+    ScriptCommand("Print('CSocket: Disconnected.');");
+    if (connection.mDebugger || !IsSubscribed(1 << DEBUGGER_CHANNEL_Debugger))
+        ScriptCommand("DebuggerSetConnected(false);");
+    connection.mDebugger = false;
+
+    mThreadLock.Unlock();
 }
 
 // ====================================================================================================================
-// Destructor
+// UpdateSubscribedChannels():  Recompute the union of the channels subscribed to by all connections
 // ====================================================================================================================
-CSocket::~CSocket()
+void CSocket::UpdateSubscribedChannels()
 {
-    // -- clear the queues
-    mSendQueue.Clear();
-    mRecvQueue.Clear();
-    if (mRecvPacket != NULL)
+    uint32 channels = 0;
+    for (int32 i = 0; i < k_MaxConnections; ++i)
     {
-        delete mRecvPacket;
+        if (mConnections[i].mConnected)
+            channels |= mConnections[i].GetChannels();
     }
 
-    // -- close the socket if it exists
-    if (mListenSocket != INVALID_SOCKET)
-        closesocket(mConnectSocket);
+    mSubscribedChannels = channels;
+}
 
-    // -- if we have an open connection socket, we also need to cleanup WSA
-    if (mConnectSocket != INVALID_SOCKET)
-        closesocket(mConnectSocket);
+// ====================================================================================================================
+// Subscribe():  Request that our partner only send us messages from the given channels
+// ====================================================================================================================
+bool CSocket::Subscribe(uint32 channel_mask)
+{
+    tPacketHeader header(k_PacketVersion, tPacketHeader::SUBSCRIBE, sizeof(uint32));
+    return (SendDataPacket(&header, &channel_mask));
 }
 
 // ====================================================================================================================
-// ListenForConnection():  See if anyone is trying to connect
+// Listen():  Accept incoming connection requests, while we have room for more clients
 // ====================================================================================================================
 bool CSocket::Listen()
 {
-    // -- if we're already connected, we're done
-    if (mConnected || !mListen)
+    // -- if we're not listening, or we already have all the clients we can handle, we're done
+    if (!mListen || mConnectionCount >= k_MaxConnections)
     {
         return (true);
     }
@@ -490,7 +1012,8 @@ bool CSocket::Listen()
         ScriptCommand("Print('CSocket::Listen(): listening for connection.\n');");
 
         // The address structure for a TCP socket
-        SOCKADDR_IN addr;
+        sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
 
         // -- address family
         addr.sin_family = AF_INET;      
@@ -511,8 +1034,14 @@ bool CSocket::Listen()
             return (false); 
         }
 
+        #ifndef WIN32
+            // -- allow listening again immediately, after a previous connection on this port is closed
+            int reuse_addr = 1;
+            setsockopt(mListenSocket, SOL_SOCKET, SO_REUSEADDR, (const char*)&reuse_addr, sizeof(reuse_addr));
+        #endif // WIN32
+
         // -- bind the socket to this address
-        if (bind(mListenSocket, (LPSOCKADDR)&addr, sizeof(addr)) == SOCKET_ERROR)
+        if (bind(mListenSocket, (sockaddr*)&addr, sizeof(addr)) == SOCKET_ERROR)
         {
             // -- failed to bind
             closesocket(mListenSocket);
@@ -520,41 +1049,44 @@ bool CSocket::Listen()
             return (false);
         }
 
-        // -- only one connection - use SOMAXCONN if you want multiple
-        if (listen(mListenSocket, 1) != 0)
+        // -- allow as many pending requests as we have connection slots
+        if (listen(mListenSocket, k_MaxConnections) != 0)
         {
             // -- failed to listen
-            ScriptCommand("Print('Error - CSocket: listen() failed with error %d\n');", WSAGetLastError());
+            TinPrintError(mScriptContext, "Error - CSocket: listen() failed with error %d\n", GetSocketError());
             closesocket(mListenSocket);
             mListenSocket = INVALID_SOCKET;
             return (false);
         }
 
-        // -- accept a socket request
-        mConnectSocket = accept(mListenSocket, NULL, NULL);
-        if (mConnectSocket == INVALID_SOCKET)
+        // -- rather than blocking in accept(), the thread waits on the listen socket in WaitForEvents()
+        SetNonBlocking(mListenSocket);
+    }
+
+    // -- accept all pending socket requests, while we have room
+    while (mConnectionCount < k_MaxConnections)
+    {
+        SOCKET connectSocket = accept(mListenSocket, NULL, NULL);
+        if (connectSocket == INVALID_SOCKET)
         {
+            // -- no connection has been requested yet
+            int error = GetSocketError();
+            if (IsSocketWouldBlock(error))
+                return (true);
+
             // -- failed to listen - note, if we chose to disconnect, this will also fail
             // -- so we still return true, to allow the thread to continue
-            ScriptCommand("Print('Error - CSocket: accept() failed with error %d\n');", WSAGetLastError());
+            TinPrintError(mScriptContext, "Error - CSocket: accept() failed with error %d\n", error);
             closesocket(mListenSocket);
             mListenSocket = INVALID_SOCKET;
             return (true);
         }
 
-        // -- ensure the connect socket is non-blocking
-        u_long iMode=1;
-        ioctlsocket(mConnectSocket, FIONBIO, &iMode);
-
-        // -- we're connected
+        // -- we're connected - the listen socket remains open, to accept further clients
+        mThreadLock.Lock();
+        AddConnection(connectSocket);
+        mThreadLock.Unlock();
         ScriptCommand("Print('CSocket: Connected.');");
-        closesocket(mListenSocket);
-        mListenSocket = INVALID_SOCKET;
-        mConnected = true;
-
-        // -- initialize the heartbeat
-        mSendHeartbeatTimer = k_HeartbeatTimeMS;
-        mRecvHeartbeatTimer = k_HeartbeatTimeoutMS;
     }
 
     // -- done
@@ -562,81 +1094,69 @@ bool CSocket::Listen()
 }
 
 // ====================================================================================================================
-// RequestConnection():  See if we can establish a connection
+// Connect():  Connect to a listening socket
 // ====================================================================================================================
 bool CSocket::Connect(const char* ipAddress)
 {
-    // -- this only works if we're not already connected, and we have a listening socket, and a valid address
-    if (mConnected || !ipAddress || !ipAddress[0])
+    // -- this only works if we're not already connected or listening, and we have a valid address
+    if (mConnectionCount > 0 || mListen || !ipAddress || !ipAddress[0])
     {
         return (false);
     }
 
     struct addrinfo* addressResult = NULL;
     struct addrinfo addressHints;
-    struct addrinfo *addresses = NULL;
 
     // -- get the connection info
     char defaultPortStr[8];
     sprintf_s(defaultPortStr, "%d", k_DefaultPort);
     
     memset(&addressHints, 0, sizeof(addrinfo));
+    addressHints.ai_family = AF_INET;
+    addressHints.ai_socktype = SOCK_STREAM;
     int addrResult = getaddrinfo(ipAddress, defaultPortStr, &addressHints, &addressResult);
     if (addrResult != 0)
     {
-        ScriptCommand("Print('Error - CSocket: getaddrinfo failed with error: %d\n');", addrResult);
+        TinPrintError(mScriptContext, "Error - CSocket: getaddrinfo failed with error: %d\n", addrResult);
         return (false);
     }
 
     // -- create the connect socket
-    mConnectSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
-    if (mConnectSocket == INVALID_SOCKET)
+    SOCKET connectSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (connectSocket == INVALID_SOCKET)
     {
         // -- failed to create a socket
+        freeaddrinfo(addressResult);
         return (false); 
     }
 
     // -- see if we can request a conenction
-    int connectResult = connect(mConnectSocket, addressResult->ai_addr, addressResult->ai_addrlen);
+    int connectResult = connect(connectSocket, addressResult->ai_addr, (int)addressResult->ai_addrlen);
     if (connectResult == SOCKET_ERROR)
     {
-        ScriptCommand("Print('Error CSocket: connect() failed.\n');");
-        closesocket(mConnectSocket);
-        mConnectSocket = INVALID_SOCKET;
+        TinPrintError(mScriptContext, "Error - CSocket: connect() failed.\n");
+        closesocket(connectSocket);
+        freeaddrinfo(addressResult);
         return (false);
     }
 
     // -- cleanup the addr info
     freeaddrinfo(addressResult);
 
-    // -- see if we actually created a socket
-    if (mConnectSocket == INVALID_SOCKET)
-    {
-        ScriptCommand("Print('Error CSocket: connect() failed.\n');");
-        return (false);
-    }
-
-    // -- ensure the socket is non-blocking
-    u_long iMode=1;
-    ioctlsocket(mConnectSocket, FIONBIO, &iMode);
-
     // -- success
     ScriptCommand("Print('CSocket: Connected.\n');");
 
     // -- connection was successful - close down the listening connection
+    mThreadLock.Lock();
     if (mListenSocket != INVALID_SOCKET)
     {
         closesocket(mListenSocket);
         mListenSocket = INVALID_SOCKET;
     }
 
-    // -- set the bool, return the result
-    mConnected = true;
-    mListen = false;
-
-    // -- initialize the heartbeat
-    mSendHeartbeatTimer = k_HeartbeatTimeMS;
-    mRecvHeartbeatTimer = k_HeartbeatTimeoutMS;
+    // -- our partner is the only connection
+    AddConnection(connectSocket);
+    mThreadLock.Unlock();
 
     return (true);
 }
@@ -649,10 +1169,13 @@ void CSocket::RequestDisconnect()
     // -- this must be threadsafe, so as not to stomp the current Update thread
     mThreadLock.Lock();
 
-    // -- enqueue a disconnect packet to send to our partner
+    // -- enqueue a disconnect packet to send to each of our partners
     tPacketHeader header(k_PacketVersion, tPacketHeader::DISCONNECT, 0);
-    tDataPacket* newPacket = new tDataPacket(&header, NULL);
-    mSendQueue.Enqueue(newPacket);
+    for (int32 i = 0; i < k_MaxConnections; ++i)
+    {
+        if (mConnections[i].mConnected)
+            mConnections[i].mSendQueue.Enqueue(header, NULL);
+    }
 
     // -- unlock the thread
     mThreadLock.Unlock();
@@ -665,11 +1188,11 @@ void CSocket::RequestDisconnect()
 }
 
 // ====================================================================================================================
-// Disconnect():  Disconnect the socket, either from our connected partner, or from an error
+// Disconnect():  Disconnect all connections, and stop listening for more
 // ====================================================================================================================
 void CSocket::Disconnect()
 {
-    // -- kill the connection (thread safe)
+    // -- kill the connections (thread safe)
     mThreadLock.Lock();
 
     // -- close the listening socket as well
@@ -681,21 +1204,15 @@ void CSocket::Disconnect()
         mListenSocket = INVALID_SOCKET;
     }
 
-    // -- close the socket
-    closesocket(mConnectSocket);
-    mConnectSocket = INVALID_SOCKET;
-    mConnected = false;
-
-    // -- notify TinScript, in case this connection was from a debugger
-    ScriptCommand("Print('CSocket: Disconnected.');");
-    ScriptCommand("DebuggerSetConnected(false);");
-
-    // -- clear the queues
-    mSendQueue.Clear();
-    mRecvQueue.Clear();
+    // -- close each connection
+    for (int32 i = 0; i < k_MaxConnections; ++i)
+        DisconnectConnection(mConnections[i]);
 
     // -- unlock
     mThreadLock.Unlock();
+
+    // -- if the socket thread is waiting on the closed sockets, it needs to stop
+    Wakeup();
 }
 
 // ====================================================================================================================
@@ -706,103 +1223,66 @@ bool CSocket::ProcessSendPackets()
     // -- this must be threadsafe
     mThreadLock.Lock();
 
-    // -- if we're not connected, return (successfully)
-    if (!mConnected)
-    {
-        mThreadLock.Unlock();
-        return (true);
-    }
-
-    // -- check the heartbeat timer
-    if (mSendHeartbeatTimer <= 0)
-    {
-        tPacketHeader header(k_PacketVersion, tPacketHeader::HEARTBEAT, 0);
-        tDataPacket* newPacket = new tDataPacket(&header, NULL);
-        mSendQueue.Enqueue(newPacket);
-    }
-
-    // -- send the messages we've queued, and check for an error
-    bool errorDisconnect = false;
-    int error = 0;
-    tDataPacket* packetToSend = NULL;
-    while (mSendQueue.Dequeue(packetToSend, true))
+    for (int32 i = 0; i < k_MaxConnections; ++i)
     {
-        // -- as long as we're attempting to send, reset the heartbeat timer
-        mSendHeartbeatTimer = k_HeartbeatTimeMS;
-
-        // -- see if we have to send the header
-        bool sendingHeader = !packetToSend->mHeader.mHeaderSent;
-        int bytesToSend = 0;
-        if (sendingHeader)
-        {
-            // -- ensure we've initialized the send ptr
-            if (packetToSend->mHeader.mSendPtr == NULL)
-            {
-                packetToSend->mHeader.mSendPtr = (const char*)&packetToSend->mHeader;
-            }
+        // -- skip empty connection slots
+        tConnection& connection = mConnections[i];
+        if (!connection.mConnected)
+            continue;
 
-            bytesToSend = sizeof(tPacketHeader) -
-                          ((int)packetToSend->mHeader.mSendPtr - (int)((const char*)&packetToSend->mHeader));
-        }
-        else
+        // -- a client that isn't reading what we send is disconnected, before its queue grows any further
+        if (connection.mSendQueueOverflow)
         {
-            bytesToSend = packetToSend->mHeader.mSize -
-                          ((int)packetToSend->mHeader.mSendPtr - (int)packetToSend->mData);
+            TinPrintError(mScriptContext, "Error - CSocket::Send(): send queue full (%d bytes), disconnecting\n",
+                          connection.mSendQueue.GetUsed());
+            DisconnectConnection(connection);
+            continue;
         }
 
-        // -- send (skip this, if we the packet has no data
-        int bytesSent = 0;
-        if (bytesToSend > 0)
+        // -- check the heartbeat timer
+        if (connection.mSendHeartbeatTimer <= 0)
         {
-            bytesSent = send(mConnectSocket, packetToSend->mHeader.mSendPtr, bytesToSend, 0);
+            tPacketHeader header(k_PacketVersion, tPacketHeader::HEARTBEAT, 0);
+            connection.mSendQueue.Enqueue(header, NULL);
         }
 
-        // -- if we received an error, we'll have to disconnect
-        if (bytesSent == SOCKET_ERROR)
+        // -- send the bytes we've queued (packets are already framed in the queue), and check for an error
+        bool errorDisconnect = false;
+        int error = 0;
+        while (!connection.mSendQueue.IsEmpty())
         {
-            error = WSAGetLastError();
-            if (error != WSAEWOULDBLOCK)
-                errorDisconnect = true;
-            break;
-        }
+            // -- as long as we're attempting to send, reset the heartbeat timer
+            connection.mSendHeartbeatTimer = k_HeartbeatTimeMS;
 
-        // -- otherwise, see if we're finished with this packet
-        else
-        {
-            // -- update our pointers, etc... based on what we were able to send
-            bytesToSend -= bytesSent;
-            packetToSend->mHeader.mSendPtr += bytesSent;
+            // -- send() can still send a partial byte stream - whatever isn't sent remains in the queue
+            int32 bytesToSend = 0;
+            const char* sendPtr = connection.mSendQueue.GetReadPtr(bytesToSend);
+            int bytesSent = send(connection.mSocket, sendPtr, bytesToSend, kSocketSendFlags);
 
-            // -- see if we're done
-            if (bytesToSend <= 0)
+            // -- if we received an error, we'll have to disconnect
+            if (bytesSent == SOCKET_ERROR)
             {
-                if (sendingHeader)
-                {
-                    packetToSend->mHeader.mHeaderSent = true;
-                    packetToSend->mHeader.mSendPtr = (const char*)packetToSend->mData;
-                }
-                else
-                {
-                    mSendQueue.Dequeue(packetToSend);
-                    delete packetToSend;
-
-                }
+                error = GetSocketError();
+                if (!IsSocketWouldBlock(error))
+                    errorDisconnect = true;
+                break;
             }
 
-            // -- not done, but not able to send any more this frame
-            else
+            // -- remove what we were able to send
+            connection.mSendQueue.Consume(bytesSent);
+
+            // -- if we weren't able to send everything, wait until there's room to send more
+            if (bytesSent < bytesToSend)
                 break;
         }
-    }
 
-    // -- if we encountered a socket error sending, disconnect
-    if (errorDisconnect)
-    {
-        // -- notify the script context
-        ScriptCommand("Print('Error - CSocket::Send(): failed with error: %d\n');", error);
-        mThreadLock.Unlock();
-        Disconnect();
-        return (true);
+        // -- if we encountered a socket error sending, disconnect only this connection
+        if (errorDisconnect)
+        {
+            // -- notify the script context
+            TinPrintError(mScriptContext, "Error - CSocket::Send(): failed with error: %d\n", error);
+            DisconnectConnection(connection);
+        }
     }
 
     // -- this must be threadsafe
@@ -820,64 +1300,72 @@ bool CSocket::ReceivePackets()
     mThreadLock.Lock();
 
     // -- if we're not connected, we're done
-    if (!mConnected)
+    if (mConnectionCount == 0)
     {
         mThreadLock.Unlock();
         return (true);
     }
 
-    // -- decrement the heartbeat timers
-    mSendHeartbeatTimer -= k_ThreadUpdateTimeMS;
-    mRecvHeartbeatTimer -= k_ThreadUpdateTimeMS;
-
-    // -- see if we have something to recv
-    char recvbuf[k_MaxBufferSize];
-    int recvbuflen = k_MaxBufferSize;
+    // -- the time since the last update is the same for all connections
+    // -- note:  the unsigned difference is correct even if the time wrapped since the last update
+    uint32 current_time_ms = GetTimeMS();
+    int32 elapsed_ms = (int32)(current_time_ms - mLastUpdateTimeMS);
+    mLastUpdateTimeMS = current_time_ms;
 
-    // -- recv data from the socket
-    while (true)
+    for (int32 i = 0; i < k_MaxConnections; ++i)
     {
-        int bytesRecv = recv(mConnectSocket, recvbuf, recvbuflen, 0);
+        // -- skip empty connection slots
+        tConnection& connection = mConnections[i];
+        if (!connection.mConnected)
+            continue;
 
-        // -- check for a disconnecct
-        int error = WSAGetLastError();
-        if (error != WSAEWOULDBLOCK && error != 0)
-        {
-            // -- notify the script context
-            ScriptCommand("Print('CSocket: Recv error %d\n');", error);
-            mThreadLock.Unlock();
-            Disconnect();
-            return (true);
-        }
+        // -- decrement the heartbeat timers
+        connection.mSendHeartbeatTimer -= elapsed_ms;
+        connection.mRecvHeartbeatTimer -= elapsed_ms;
 
-        else if (bytesRecv > 0)
+        // -- recv data from the socket, directly into the recv queue
+        while (true)
         {
-            // -- we received data - reset the heartbeat timer
-            mRecvHeartbeatTimer = k_HeartbeatTimeoutMS;
+            // -- if the queue is full, leave the data in the socket until we've processed what we have
+            int32 recvbuflen = 0;
+            char* recvbuf = connection.mRecvQueue.GetWritePtr(recvbuflen);
+            if (recvbuflen <= 0)
+                break;
+
+            int bytesRecv = recv(connection.mSocket, recvbuf, recvbuflen, 0);
+            int error = bytesRecv == SOCKET_ERROR ? GetSocketError() : 0;
 
-            // -- if we fail to process the data, something very bad has happened
-            if (!ProcessRecvData(recvbuf, bytesRecv))
+            // -- check for a disconnect - a closed connection is always readable, so we can't wait for a timeout
+            if (bytesRecv == 0 || (bytesRecv == SOCKET_ERROR && !IsSocketWouldBlock(error)))
             {
                 // -- notify the script context
-                ScriptCommand("Print('CSocket: Unable to ProcessRecvData()\n');");
-                mThreadLock.Unlock();
-                Disconnect();
-                return (true);
+                if (bytesRecv == 0)
+                    ScriptCommand("Print('CSocket: Connection closed\n');");
+                else
+                    ScriptCommand("Print('CSocket: Recv error %d\n');", error);
+                DisconnectConnection(connection);
+                break;
             }
-        }
 
-        // -- else we're done receiving
-        else
-        {
-            // -- check the heartbeat
-            if (mRecvHeartbeatTimer <= 0)
+            else if (bytesRecv > 0)
             {
-                ScriptCommand("Print('CSocket: Heartbeat timeout\n');");
-                mThreadLock.Unlock();
-                Disconnect();
+                // -- we received data - reset the heartbeat timer
+                connection.mRecvHeartbeatTimer = k_HeartbeatTimeoutMS;
+                connection.mRecvQueue.Commit(bytesRecv);
             }
 
-            break;
+            // -- else we're done receiving
+            else
+            {
+                // -- check the heartbeat
+                if (connection.mRecvHeartbeatTimer <= 0)
+                {
+                    ScriptCommand("Print('CSocket: Heartbeat timeout\n');");
+                    DisconnectConnection(connection);
+                }
+
+                break;
+            }
         }
     }
 
@@ -888,86 +1376,129 @@ bool CSocket::ReceivePackets()
 }
 
 // ====================================================================================================================
-// ProcessSendPackets():  Send all queued packets
+// ProcessRecvPackets():  Process all completely received packets, in place in the recv queues
 // ====================================================================================================================
 bool CSocket::ProcessRecvPackets()
 {
     // -- this must be threadsafe
     mThreadLock.Lock();
 
-    // -- if we're not connected, return (successfully)
-    if (!mConnected)
+    for (int32 i = 0; i < k_MaxConnections; ++i)
     {
-        mThreadLock.Unlock();
-        return (true);
-    }
+        // -- skip empty connection slots
+        tConnection& connection = mConnections[i];
+        if (!connection.mConnected)
+            continue;
+
+        // -- process the connection's recv queue
+        bool receivedDisconnect = false;
+        bool invalidPacket = false;
+        connection.mRecvQueueBlocked = false;
+        while (connection.mRecvQueue.GetUsed() >= (int32)sizeof(tPacketHeader))
+        {
+            // -- verify the packet is valid
+            tPacketHeader header;
+            connection.mRecvQueue.Peek(0, &header, sizeof(tPacketHeader));
+            if (header.mVersion != k_PacketVersion ||
+                header.mType <= tPacketHeader::NONE || header.mType >= tPacketHeader::COUNT ||
+                header.mSize < 0 || header.mSize > k_MaxPacketSize)
+            {
+                invalidPacket = true;
+                break;
+            }
 
-    // -- process our recv queue
-    bool receivedDisconnect = false;
-    bool deletePacket = false;
-    tDataPacket* recvPacket = NULL;
-    while (mRecvQueue.Dequeue(recvPacket))
-    {
-        // -- set the bool to delete the packet
-        deletePacket = true;
+            // -- wait until we have received the complete packet
+            int32 packetSize = (int32)sizeof(tPacketHeader) + header.mSize;
+            if (connection.mRecvQueue.GetUsed() < packetSize)
+                break;
 
-        // -- if the packet contains a TinScript command
-        if (recvPacket->mHeader.mType == tPacketHeader::SCRIPT)
-        {
-            // -- execute whatever command we received
-            bool success = ScriptCommand((const char*)recvPacket->mData);
+            // -- if the packet contains a TinScript command
+            if (header.mType == tPacketHeader::SCRIPT)
+            {
+                // -- commands must be contiguous and null terminated, to be executed
+                char command[k_MaxPacketSize + 1];
+                connection.mRecvQueue.Peek(sizeof(tPacketHeader), command, header.mSize);
+                command[header.mSize] = '\0';
+
+                // -- if the thread buffer was full, leave the packet in the queue, and try again later
+                if (!ScriptCommand("%s", command))
+                {
+                    connection.mRecvQueueBlocked = true;
+                    break;
+                }
+            }
 
-            // -- if the thread buffer was full, re-enqueue, and try again later
-            if (!success)
+            // -- if the packet is raw data, send it through the registered callback
+            // -- note:  the registered callback better be threadsafe
+            // -- note:  the callback is responsible for deallocating the packet
+            else if (header.mType == tPacketHeader::DATA)
             {
-                mRecvQueue.Enqueue(recvPacket, true);
-                break;
+                if (mRecvDataCallback != NULL)
+                {
+                    tDataPacket* recvPacket = new tDataPacket(&header, NULL);
+                    connection.mRecvQueue.Peek(sizeof(tPacketHeader), recvPacket->mData, header.mSize);
+                    mRecvDataCallback(recvPacket);
+                }
             }
-        }
 
-        // -- if the packet is raw data, send it through the registered callback
-        // -- note:  the registered callback better be threadsafe
-        // -- note:  the callback is responsible for deallocating the packet
-        else if (recvPacket->mHeader.mType == tPacketHeader::DATA)
-        {
-            if (mRecvDataCallback != NULL)
+            // -- if we received a debugger break, notify the script context immediately
+            // -- this is technically not thread safe, but it's the only way to break an infinite loop
+            else if (header.mType == tPacketHeader::DEBUGGER_BREAK)
             {
-                // -- set the bool to prevent the packet from being deleted here
-                deletePacket = false;
+                mScriptContext->SetForceBreak(0);
+            }
 
-                // -- send the packet to the client
-                mRecvDataCallback(recvPacket);
+            // -- the client is telling us which channels it wants to receive
+            else if (header.mType == tPacketHeader::SUBSCRIBE)
+            {
+                uint32 channel_mask = 0;
+                if (header.mSize == (int32)sizeof(uint32))
+                    connection.mRecvQueue.Peek(sizeof(tPacketHeader), &channel_mask, sizeof(uint32));
+                connection.mChannels = channel_mask;
+                UpdateSubscribedChannels();
             }
-        }
 
-        // -- if we received a debugger break, notify the script context immediately
-        // -- this is technically not thread safe, but it's the only way to break an infinite loop
-        else if (recvPacket->mHeader.mType == tPacketHeader::DEBUGGER_BREAK)
-        {
-            mScriptContext->SetForceBreak(0);
-        }
+            // -- a debugger is attaching - it takes ownership of the session from any previous debugger
+            else if (header.mType == tPacketHeader::DEBUGGER_ATTACH)
+            {
+                if (!ScriptCommand("DebuggerSetConnected(true);"))
+                {
+                    connection.mRecvQueueBlocked = true;
+                    break;
+                }
 
-        // -- else if the packet contains a disconnect command
-        else if (recvPacket->mHeader.mType == tPacketHeader::DISCONNECT)
-        {
-            receivedDisconnect = true;
-            break;
+                for (int32 j = 0; j < k_MaxConnections; ++j)
+                    mConnections[j].mDebugger = false;
+                connection.mDebugger = true;
+                UpdateSubscribedChannels();
+            }
+
+            // -- else if the packet contains a disconnect command
+            else if (header.mType == tPacketHeader::DISCONNECT)
+            {
+                receivedDisconnect = true;
+                break;
+            }
+
+            // -- the packet has been processed
+            connection.mRecvQueue.Consume(packetSize);
         }
 
-        // -- if we're supposed to delete the packet...
-        if (deletePacket)
+        // -- if we received an invalid packet, something very bad has happened
+        if (invalidPacket)
         {
-            delete recvPacket;
+            ScriptCommand("Print('CSocket: Invalid packet received\n');");
+            DisconnectConnection(connection);
         }
+
+        // -- if we received a disconnect...
+        else if (receivedDisconnect)
+            DisconnectConnection(connection);
     }
 
     // -- Unlock and return success
     mThreadLock.Unlock();
 
-    // -- if we received a disconnect...
-    if (receivedDisconnect)
-        Disconnect();
-
     return (true);
 }
 
@@ -977,14 +1508,11 @@ bool CSocket::ProcessRecvPackets()
 bool CSocket::SendScriptCommand(const char* command)
 {
     // -- ensure we're connected, and have something to send
-    if (!mConnected || !command || !command[0])
+    if (mConnectionCount == 0 || !command || !command[0])
     {
         return (false);
     }
 
-    // -- lock the thread before modifying the queues
-    mThreadLock.Lock();
-
     // -- fill in the packet header
     int length = strlen(command) + 1;
 
@@ -995,16 +1523,7 @@ bool CSocket::SendScriptCommand(const char* command)
     }
 
     tPacketHeader header(k_PacketVersion, tPacketHeader::SCRIPT, length);
-    tDataPacket* newPacket = new tDataPacket(&header, (void*)command);
-
-    // -- enqueue the packet
-    bool result = mSendQueue.Enqueue(newPacket);
-
-    // -- unlock the thread
-    mThreadLock.Unlock();
-
-    // -- return the result
-    return (result);
+    return (SendDataPacket(&header, command));
 }
 
 // ====================================================================================================================
@@ -1018,29 +1537,37 @@ bool CSocket::SendData(void* data, int dataSize)
         return (false);
     }
 
-    // -- lock the thread before modifying the queues
-    mThreadLock.Lock();
-
     tPacketHeader header(k_PacketVersion, tPacketHeader::DATA, dataSize);
-    tDataPacket* newPacket = new tDataPacket(&header, data);
+    return (SendDataPacket(&header, data));
+}
 
-    // -- enqueue the packet
-    bool result = mSendQueue.Enqueue(newPacket);
+// ====================================================================================================================
+// SendDataPacket():  Send a pre=constructed packet through the socket
+// ====================================================================================================================
+bool CSocket::SendDataPacket(tDataPacket* dataPacket)
+{
+    // -- ensure we're connected, and have something to send
+    if (!dataPacket)
+    {
+        return (false);
+    }
 
-    // -- unlock the thread
-    mThreadLock.Unlock();
+    // -- the packet is copied into the send queues
+    // -- note:  if this returns false, the requestor must either try again, or delete the packet
+    bool result = SendDataPacket(&dataPacket->mHeader, dataPacket->mData);
+    if (result)
+        delete dataPacket;
 
     // -- return the result
     return (result);
 }
 
 // ====================================================================================================================
-// SendDataPacket():  Send a pre=constructed packet through the socket
+// SendDataPacket():  Frame a header and its data directly in the send queue of each subscribed connection
 // ====================================================================================================================
-bool CSocket::SendDataPacket(tDataPacket* dataPacket)
+bool CSocket::SendDataPacket(tPacketHeader* header, const void* data, uint32 channel_mask)
 {
-    // -- ensure we're connected, and have something to send
-    if (!dataPacket)
+    if (!header)
     {
         return (false);
     }
@@ -1048,15 +1575,36 @@ bool CSocket::SendDataPacket(tDataPacket* dataPacket)
     // -- lock the thread before modifying the queues
     mThreadLock.Lock();
 
-    // -- enqueue the packet
-    bool result = mSendQueue.Enqueue(dataPacket);
+    // -- the packet is serialized once by the caller, and copied only to the clients that want it
+    // -- note:  the send fails if any subscribed connection's queue can't hold the packet
+    bool result = true;
+    for (int32 i = 0; i < k_MaxConnections; ++i)
+    {
+        tConnection& connection = mConnections[i];
+        if (connection.mConnected && (connection.GetChannels() & channel_mask) != 0)
+        {
+            // -- a client that has stalled long enough to fill its queue is dropped, rather than failing
+            // -- (and retrying) the send for every other client
+            if (connection.mSendQueueOverflow)
+                continue;
+            if (!connection.mSendQueue.HasRoom(header->mSize))
+            {
+                connection.mSendQueueOverflow = true;
+                continue;
+            }
+
+            if (!connection.mSendQueue.Enqueue(*header, data))
+                result = false;
+        }
+    }
 
     // -- unlock the thread
     mThreadLock.Unlock();
 
+    // -- wake the socket thread to send it
+    Wakeup();
+
     // -- return the result
-    // -- note:  if this returns false, the packet will not have been enqueued,
-    // -- so the requestor must either try again, or delete the memory
     return (result);
 }
 
@@ -1111,99 +1659,6 @@ bool8 CSocket::ScriptCommand(const char* fmt, ...)
     return (mScriptContext->AddThreadCommand(cmdBuf));
 }
 
-// ====================================================================================================================
-// ProcessRecvData():  Reconstitute a data stream back into packets
-// ====================================================================================================================
-bool CSocket::ProcessRecvData(void* data, int dataSize)
-{
-    // -- keep track of the data left to process
-    char* dataPtr = (char*)data;
-    int bytesToProcess = dataSize;
-
-    // -- keep processing, as long as we have data
-    while (bytesToProcess)
-    {
-        // -- set up the pointers to fill in either the header, of the data of a packet
-        bool processHeader = (mRecvPacket == NULL);
-        char* basePtr = (processHeader) ? mRecvHeader : mRecvPacket->mData;
-        int bufferSize = (processHeader) ? sizeof(tPacketHeader) : mRecvPacket->mHeader.mSize;
-        int bytesRequired = bufferSize - ((int)mRecvPtr - (int)basePtr);
-
-        // -- find out how many bytes we've received, and copy as many as we're able
-        int bytesToCopy = (bytesToProcess >= bytesRequired) ? bytesRequired : bytesToProcess;
-        if (bytesToCopy > 0)
-        {
-            // -- copy the data, and modify the counts and pointers
-            memcpy(mRecvPtr, dataPtr, bytesToCopy);
-            dataPtr += bytesToCopy;
-            mRecvPtr += bytesToCopy;
-            bytesRequired -= bytesToCopy;
-            bytesToProcess -= bytesToCopy;
-        }
-
-        // -- see if we have filled our required bytes
-        if (bytesRequired == 0)
-        {
-            // -- if we don't have a recv packet, then we've completed a header, and can construct one
-            if (processHeader)
-            {
-                // -- verify the new packet is valid
-                tPacketHeader* newPacketHeader = (tPacketHeader*)mRecvHeader;
-                if (newPacketHeader->mVersion != k_PacketVersion)
-                {
-                    // -- invalid version
-                    return (false);
-                }
-                if (newPacketHeader->mType <= tPacketHeader::NONE || newPacketHeader->mType >= tPacketHeader::COUNT)
-                {
-                    // -- invalid type
-                    return (false);
-                }
-
-                if (newPacketHeader->mSize < 0 || newPacketHeader->mSize > 1024)
-                {
-                    // -- invalid size
-                    return (false);
-                }
-
-                // -- create the new packet
-                mRecvPacket = new tDataPacket((tPacketHeader*)mRecvHeader, NULL);
-
-                // -- reset the recv pointer to the data of the new packet
-                mRecvPtr = mRecvPacket->mData;
-
-                // -- if we have data, we need to keep reading
-                // -- otherwise, fall through, and process a complete packet
-                if (mRecvPacket->mHeader.mSize == 0)
-                {
-                    processHeader = false;
-                }
-            }
-
-            // -- if we're not processing the header, we've got complete packet
-            // -- might have fallen through for a header with no data
-            if (!processHeader)
-            {
-                // -- enqueue, and prepare for the next
-                if (!mRecvQueue.Enqueue(mRecvPacket))
-                {
-                    // -- unable to enqueue - no more space
-                    return (false);
-                }
-
-                // -- reset the recv members
-                mRecvPacket = NULL;
-                mRecvPtr = mRecvHeader;
-            }
-        }
-    }
-
-    // -- success
-    return (true);
-}
-
-#endif // WIN32
-
 } // namespace SocketManager
 
 // ====================================================================================================================
@@ -1211,6 +1666,7 @@ bool CSocket::ProcessRecvData(void* data, int dataSize)
 REGISTER_FUNCTION_P0(SocketListen, SocketManager::Listen, bool);
 REGISTER_FUNCTION_P1(SocketConnect, SocketManager::Connect, bool, const char*);
 REGISTER_FUNCTION_P0(SocketDisconnect, SocketManager::Disconnect, void);
+REGISTER_FUNCTION_P1(SocketSubscribe, SocketManager::Subscribe, bool, uint32);
 REGISTER_FUNCTION_P1(SocketSend, SocketManager::SendCommand, bool, const char*);
 
 // ====================================================================================================================
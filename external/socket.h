@@ -22,12 +22,13 @@
 #ifndef __SOCKET_H
 #define __SOCKET_H
 
-// -- sockets are only implemented in win32
+// -- sockets are implemented using winsock in win32, and BSD sockets otherwise
 #ifdef WIN32
     #include <Windows.h>
     #include <winsock.h>
 #else
-    #define SOCKET uint32*
+    #include <pthread.h>
+    typedef int SOCKET;
 #endif // WIN32
 
 #include <vector>
@@ -38,13 +39,26 @@
 
 // ====================================================================================================================
 // -- constants
-// some random int32, just to ensure socket clients are compatible
-const int32 k_PacketVersion = 0xdeadbeef;  
+// some random int32, just to ensure socket clients are compatible (changed whenever the packet format changes)
+const int32 k_PacketVersion = 0xdeadbe01;
 const int32 k_MaxPacketSize = 1024;
 
 const int32 k_DefaultPort = 27069;
+
+// -- a listening socket accepts connections from multiple clients (e.g. a debugger, a profiler, a test harness)
+const int32 k_MaxConnections = 4;
+
+// -- initial size of the send and recv queues - the send queue grows if required, the recv queue is fixed
 const int32 k_MaxBufferSize = 8 * 1024;
 
+// -- a client that stops reading is disconnected when its send queue reaches this size, instead of growing forever
+const int32 k_MaxSendQueueSize = 4 * 1024 * 1024;
+
+// -- the number of free packets kept by the packet pool
+const int32 k_PacketPoolSize = 32;
+
+// -- the socket thread blocks until there's traffic - this is only the interval to retry delivering
+// -- received commands, if the script context's thread buffer was full
 const int32 k_ThreadUpdateTimeMS = 5;
 const int32 k_HeartbeatTimeMS = 10000;
 const int32 k_HeartbeatTimeoutMS = 300000;
@@ -66,6 +80,8 @@ void Initialize();
 // -- update loop for the SocketManager, run inside the thread
 #ifdef WIN32
     DWORD WINAPI ThreadUpdate(LPVOID lpParam);
+#else
+    void* ThreadUpdate(void* lpParam);
 #endif
 
 // -- perform all shutdown and cleanup of the SocketManager
@@ -79,10 +95,19 @@ bool IsConnected();
 bool SendCommand(const char* command);
 bool SendCommandf(const char* fmt, ...);
 
+// -- each client only receives packets sent on the channels it subscribes to (all channels, by default)
+// -- subscribe sends the request from a client, is subscribed tests whether any connected client subscribes
+bool Subscribe(uint32 channel_mask);
+bool IsSubscribed(uint32 channel_mask);
+
 // -- This is not technically thread safe, but the chances of a collision are remote,
 // -- and if you're using this, you're probably stuck in an infinte loop anyways
 void SendDebuggerBreak();
 
+// -- sent by a debugger client - its connection owns the debugger session (breakpoints, break state, etc.)
+// -- until it disconnects, or another debugger attaches
+void SendDebuggerAttach();
+
 // ====================================================================================================================
 // -- only use this interface if you're sure you know what you're doing - e.g. the TinScript debugger methods
 // -- send too much data for everything to use registered script functions
@@ -91,11 +116,13 @@ void SendDebuggerBreak();
 // -- third, write to the mData buffer the exact size of data as specified in the header mSize
 // -- finally, send the data packet.
 // -- note:  if sending the data packet fails, the client is required to resend or deallocate the memory
+// -- if the data is already in a buffer, sending the header and data directly avoids creating a packet at all
 
 typedef void (*ProcessRecvDataCallback)(tDataPacket* packet); 
 void RegisterProcessRecvDataCallback(ProcessRecvDataCallback recvCallback);
 tDataPacket* CreateDataPacket(tPacketHeader* header, void* data); 
 bool SendDataPacket(tDataPacket* dataPacket);
+bool SendDataPacket(tPacketHeader* header, const void* data, uint32 channel_mask = k_DebuggerChannelMaskAll);
 
 // ====================================================================================================================
 // struct tPacketHeader:  struct to organize the data being queued for send/recv
@@ -115,6 +142,13 @@ struct tPacketHeader
         DEBUGGER_BREAK,
 
         DISCONNECT,
+
+        // -- sent by a client, the data is the mask of channels it wants to receive
+        SUBSCRIBE,
+
+        // -- sent by a debugger client, to take ownership of the debugger session
+        DEBUGGER_ATTACH,
+
         COUNT,
     };
 
@@ -123,56 +157,40 @@ struct tPacketHeader
         mVersion = version;
         mType = type;
         mSize = size;
-
-        // -- initialize the send ptr to the start of the header
-        mHeaderSent = false;
-        mSendPtr = NULL;
     }
 
+    // -- the header is written to the socket as is, followed by mSize bytes of data
     int32 mVersion;
     int32 mType;
     int32 mSize;
-
-    // -- send() can still send a partial byte stream - need to track how much still needs to be sent
-    bool mHeaderSent;
-    const char* mSendPtr;
 };
 
 // ====================================================================================================================
 // struct tDataPacket:  struct to contain a complete packet (including a header) to send/recv
+// Packets hold up to k_MaxPacketSize bytes of data, and are allocated from a pool, so new/delete are cheap.
 // ====================================================================================================================
 struct tDataPacket
 {
     // -- constructor
-    explicit tDataPacket(tPacketHeader* header, void* data)
+    explicit tDataPacket(tPacketHeader* header, const void* data)
     {
         // -- copy the header
         memcpy(&mHeader, header, sizeof(tPacketHeader));
 
-        // -- allocate the buffer
-        mData = NULL;
-        if (mHeader.mSize > 0)
+        // -- if we already have data, fill that in as well
+        if (data != NULL && mHeader.mSize > 0 && mHeader.mSize <= k_MaxPacketSize)
         {
-            mData = new char[mHeader.mSize];
-
-            // -- if we already have data, fill that in as well
-            if (data != NULL)
-            {
-                memcpy(mData, data, mHeader.mSize);
-            }
+            memcpy(mData, data, mHeader.mSize);
         }
     }
 
-    // -- destructor
-    ~tDataPacket()
-    {
-        if (mData)
-            delete [] mData;
-    }
+    // -- packets are recycled through a pool
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr);
 
     // -- members, a header and the packet data
     tPacketHeader mHeader;
-    char* mData;
+    char mData[k_MaxPacketSize];
 
     private:
         // -- no empty packets
@@ -180,26 +198,63 @@ struct tDataPacket
 };
 
 // ====================================================================================================================
-// class DataQueue:  helper class to manage a circular queue to send and recv data
+// class DataQueue:  helper class to manage a circular byte queue to send and recv data
+// Packets are framed in place, as a header followed by the data, exactly as they're sent through the socket.
 // ====================================================================================================================
 class DataQueue
 {
     public:
-        DataQueue();
-        bool Enqueue(tDataPacket* packet, bool at_front = false);
-        bool Dequeue(tDataPacket*& packet, bool peekOnly = false);
+        DataQueue(int32 size = k_MaxBufferSize, int32 max_size = k_MaxSendQueueSize);
+        ~DataQueue();
+
+        // -- frame a packet in the queue - the queue grows if there isn't room, up to its max size
+        bool Enqueue(const tPacketHeader& header, const void* data);
+        bool HasRoom(int32 data_size) const
+        {
+            return (mUsed + (int32)sizeof(tPacketHeader) + data_size <= mMaxSize);
+        }
+
+        // -- copy bytes from the queue, starting offset bytes from the front, without removing them
+        void Peek(int32 offset, void* dest, int32 size) const;
+
+        // -- direct access to the contiguous bytes at the front, and space at the back of the queue
+        // -- allows send() and recv() to use the queue without copying through another buffer
+        const char* GetReadPtr(int32& contiguous) const;
+        void Consume(int32 size);
+        char* GetWritePtr(int32& contiguous);
+        void Commit(int32 size);
 
         // -- clear the entire queue
         void Clear();
 
+        int32 GetUsed() const
+        {
+            return (mUsed);
+        }
+
+        int32 GetFree() const
+        {
+            return (mSize - mUsed);
+        }
+
+        bool IsEmpty() const
+        {
+            return (mUsed == 0);
+        }
+
     protected:
-        std::vector<tDataPacket*> mQueue;
+        void Grow(int32 required);
+
+        char* mBuffer;
+        int32 mSize;
+        int32 mMaxSize;
+        int32 mReadIndex;
+        int32 mUsed;
 };
 
 // ====================================================================================================================
-// class CSocket:  an instance of a winsock connection
+// class CSocket:  a socket either listening for (and connected to) multiple clients, or connected to a single host
 // ====================================================================================================================
-#ifdef WIN32
 class CSocket
 {
     public:
@@ -207,10 +262,6 @@ class CSocket
         explicit CSocket(TinScript::CScriptContext* script_context);
         ~CSocket();
 
-        // -- public interface to create, update, and destroy sockets by name
-        static CSocket* Create();
-        static void UpdateSockets();
-
         void SetListen(bool torf)
         {
             mListen = torf;
@@ -223,7 +274,7 @@ class CSocket
 
         bool IsConnected() const
         {
-            return (mConnected);
+            return (mConnectionCount > 0);
         }
 
         // -- see if we have anyone requesting a connection
@@ -247,12 +298,27 @@ class CSocket
         // -- send raw data
         bool SendData(void* data, int dataSize);
 
-        // -- send a pre-constructed data packet
+        // -- send a pre-constructed data packet, or a header and data directly
+        // -- the packet is only copied to the send queues of the connections subscribed to the channels
         bool SendDataPacket(tDataPacket* packet);
+        bool SendDataPacket(tPacketHeader* header, const void* data, uint32 channel_mask = k_DebuggerChannelMaskAll);
+
+        // -- channel subscriptions
+        bool Subscribe(uint32 channel_mask);
+        bool IsSubscribed(uint32 channel_mask) const
+        {
+            return ((mSubscribedChannels & channel_mask) != 0);
+        }
 
         // -- update, to send/recv data
         bool Update();
 
+        // -- the socket thread blocks in WaitForEvents(), until there is traffic, a heartbeat is due,
+        // -- or another thread calls Wakeup() (e.g. after queuing a packet to send)
+        bool CreateWakeup();
+        void WaitForEvents();
+        void Wakeup();
+
         // -- Because sockets run in their own thread, they have to enqueue commands and statements through a mutex
         bool ScriptCommand(const char* fmt, ...);
 
@@ -260,32 +326,74 @@ class CSocket
         void DebuggerBreak();
 
     protected:
+        // -- each connection has its own queues, heartbeat, and channel subscriptions
+        struct tConnection
+        {
+            tConnection()
+                : mSocket(0)
+                , mConnected(false)
+                , mChannels(k_DebuggerChannelMaskAll)
+                , mRecvQueueBlocked(false)
+                , mSendQueueOverflow(false)
+                , mDebugger(false)
+                , mSendHeartbeatTimer(k_HeartbeatTimeMS)
+                , mRecvHeartbeatTimer(k_HeartbeatTimeoutMS)
+            {
+            }
+
+            SOCKET mSocket;
+            bool mConnected;
+            uint32 mChannels;
+
+            // -- we need both send and a recv packet queues
+            // -- received packets are processed in place, once they've been completely received
+            DataQueue mSendQueue;
+            DataQueue mRecvQueue;
+            bool mRecvQueueBlocked;
+
+            // -- set when the send queue reaches k_MaxSendQueueSize - the socket thread drops the connection
+            bool mSendQueueOverflow;
+
+            // -- only one connection owns the debugger session - when it drops, the session ends
+            bool mDebugger;
+
+            // -- the debugger channel carries session state (e.g. callstack deltas), so it's only sent to the
+            // -- connection that owns the session, regardless of what other clients subscribe to
+            uint32 GetChannels() const
+            {
+                return (mDebugger ? mChannels : (mChannels & ~(1 << DEBUGGER_CHANNEL_Debugger)));
+            }
+
+            // -- timers to track last packet sent/received
+            int32 mSendHeartbeatTimer;
+            int32 mRecvHeartbeatTimer;
+        };
+
+        void AddConnection(SOCKET socket_id);
+        void DisconnectConnection(tConnection& connection);
+        void UpdateSubscribedChannels();
+
         bool mListen;
-        bool mConnected;
         SOCKET mListenSocket;
-        SOCKET mConnectSocket;
+        tConnection mConnections[k_MaxConnections];
+        int32 mConnectionCount;
+        uint32 mLastUpdateTimeMS;
+
+        // -- the union of the channels subscribed to by all connections
+        volatile uint32 mSubscribedChannels;
 
         // -- we need access to the script context for which this socket was created
         TinScript::CScriptContext* mScriptContext;
 
-        // -- we need to reconstitute packets as they arrive
-        bool ProcessRecvData(void* data, int dataSize);
-        char mRecvHeader[sizeof(tPacketHeader)];
-        char* mRecvPtr;
-        tDataPacket* mRecvPacket;
-
-        // -- we need both send and a recv packet queues
-        DataQueue mSendQueue;
-        DataQueue mRecvQueue;
-
-        // -- timers to track last packet sent/received
-        int32 mSendHeartbeatTimer;
-        int32 mRecvHeartbeatTimer;
+        // -- a pipe (or a loopback socket, in win32), to interrupt the thread waiting on the socket
+        void DrainWakeup();
+        void DestroyWakeup();
+        SOCKET mWakeupRecv;
+        SOCKET mWakeupSend;
 
         // -- we need to ensure the queues are thread safe
         TinScript::CThreadMutex mThreadLock;
 };
-#endif // WIN32
 
 } // SocketManager
 
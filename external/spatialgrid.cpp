@@ -0,0 +1,511 @@
+// ------------------------------------------------------------------------------------------------
+//  The MIT License
+//  
+//  Copyright (c) 2013 Tim Andersen
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+//  and associated documentation files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all copies or
+//  substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// ------------------------------------------------------------------------------------------------
+
+// -- system includes
+#include <cmath>
+#include <cstring>
+
+// -- includes
+#include "spatialgrid.h"
+
+// -- includes required by any system wanting access to TinScript
+#include "integration.h"
+#include "TinScript.h"
+#include "TinRegistration.h"
+#include "TinObjectGroup.h"
+
+// -- use the DECLARE_FILE/REGISTER_FILE macros to prevent deadstripping
+DECLARE_FILE(spatialgrid_cpp);
+
+// ====================================================================================================================
+// GrowBuffer():  Ensures a scratch buffer can hold the required count, preserving its contents.
+// ====================================================================================================================
+template <typename T>
+static void GrowBuffer(T*& buffer, int32& size, int32 count, int32 required)
+{
+    if (required <= size)
+        return;
+
+    int32 new_size = size > 0 ? size * 2 : 64;
+    while (new_size < required)
+        new_size *= 2;
+
+    T* new_buffer = TinAllocArray(ALLOC_ObjectGroup, T, new_size);
+    if (buffer)
+    {
+        if (count > 0)
+            memcpy(new_buffer, buffer, sizeof(T) * count);
+        TinFreeArray(buffer);
+    }
+
+    buffer = new_buffer;
+    size = new_size;
+}
+
+// == CSpatialGrid ====================================================================================================
+
+IMPLEMENT_SCRIPT_CLASS_BEGIN(CSpatialGrid, VOID)
+IMPLEMENT_SCRIPT_CLASS_END()
+
+REGISTER_METHOD_P1(CSpatialGrid, SetCellSize, SetCellSize, void, float32);
+REGISTER_METHOD_P4(CSpatialGrid, Insert, Insert, bool8, uint32, int32, CVector3f, float32);
+REGISTER_METHOD_P3(CSpatialGrid, Update, Update, bool8, uint32, CVector3f, float32);
+REGISTER_METHOD_P1(CSpatialGrid, Remove, Remove, void, uint32);
+REGISTER_METHOD_P0(CSpatialGrid, RemoveAll, RemoveAll, void);
+REGISTER_METHOD_P1(CSpatialGrid, Contains, Contains, bool8, uint32);
+REGISTER_METHOD_P0(CSpatialGrid, Used, Used, int32);
+REGISTER_METHOD_P4(CSpatialGrid, QueryRadius, QueryRadius, int32, CVector3f, float32, int32, TinScript::CObjectSet*);
+REGISTER_METHOD_P4(CSpatialGrid, QueryPairs, QueryPairs, int32, int32, int32, TinScript::CObjectSet*,
+                   TinScript::CObjectSet*);
+
+// ====================================================================================================================
+// Constructor
+// ====================================================================================================================
+CSpatialGrid::CSpatialGrid()
+{
+    mContextOwner = TinScript::GetContext();
+    mEntryList = TinAlloc(ALLOC_ObjectGroup, TinScript::CHashTable<tGridEntry>, kSpatialGridTableSize);
+    memset(mBuckets, 0, sizeof(mBuckets));
+
+    mCellSize = kSpatialGridDefaultCellSize;
+    mMaxRadius = 0.0f;
+    mQueryStamp = 0;
+    mInQuery = false;
+
+    mCandidates = NULL;
+    mCandidateCount = 0;
+    mCandidateSize = 0;
+    mResultIDs = NULL;
+    mResultCount = 0;
+    mResultSize = 0;
+    mStaleIDs = NULL;
+    mStaleCount = 0;
+    mStaleSize = 0;
+}
+
+// ====================================================================================================================
+// Destructor
+// ====================================================================================================================
+CSpatialGrid::~CSpatialGrid()
+{
+    RemoveAll();
+    TinFree(mEntryList);
+
+    if (mCandidates)
+        TinFreeArray(mCandidates);
+    if (mResultIDs)
+        TinFreeArray(mResultIDs);
+    if (mStaleIDs)
+        TinFreeArray(mStaleIDs);
+}
+
+// ====================================================================================================================
+// SetCellSize():  Sets the size of a grid cell - ideally close to the diameter of the typical object.
+// ====================================================================================================================
+void CSpatialGrid::SetCellSize(float32 cell_size)
+{
+    if (cell_size <= 0.0f)
+    {
+        ScriptAssert_(mContextOwner, 0, "<internal>", -1,
+                      "Error - CSpatialGrid::SetCellSize(): invalid cell size %.2f\n", cell_size);
+        return;
+    }
+
+    if (mInQuery)
+    {
+        ScriptAssert_(mContextOwner, 0, "<internal>", -1,
+                      "Error - CSpatialGrid::SetCellSize(): not allowed during a query\n");
+        return;
+    }
+
+    // -- every entry must be rehashed into its new bucket
+    mCellSize = cell_size;
+    memset(mBuckets, 0, sizeof(mBuckets));
+    int32 count = mEntryList->Used();
+    for (int32 i = 0; i < count; ++i)
+        LinkEntry(mEntryList->FindItemByIndex(i));
+}
+
+// ====================================================================================================================
+// Insert():  Adds an object to the grid - if it's already in the grid, its layer and position are updated.
+// ====================================================================================================================
+bool8 CSpatialGrid::Insert(uint32 object_id, int32 layer, CVector3f position, float32 radius)
+{
+    if (!mContextOwner->FindObjectEntry(object_id))
+    {
+        ScriptAssert_(mContextOwner, 0, "<internal>", -1,
+                      "Error - CSpatialGrid::Insert(): unable to find object %d\n", object_id);
+        return (false);
+    }
+
+    tGridEntry* entry = mEntryList->FindItem(object_id);
+    if (!entry)
+    {
+        entry = TinAlloc(ALLOC_ObjectGroup, tGridEntry);
+        entry->mObjectID = object_id;
+        entry->mBucket = -1;
+        entry->mPrev = NULL;
+        entry->mNext = NULL;
+        entry->mVisitStamp = 0;
+        entry->mPairStamp = 0;
+        mEntryList->AddItem(*entry, object_id);
+    }
+
+    entry->mLayer = layer;
+    return (Update(object_id, position, radius));
+}
+
+// ====================================================================================================================
+// Update():  Updates the position and radius of an object already in the grid.
+// ====================================================================================================================
+bool8 CSpatialGrid::Update(uint32 object_id, CVector3f position, float32 radius)
+{
+    tGridEntry* entry = mEntryList->FindItem(object_id);
+    if (!entry)
+    {
+        ScriptAssert_(mContextOwner, 0, "<internal>", -1,
+                      "Error - CSpatialGrid::Update(): object %d is not in the grid\n", object_id);
+        return (false);
+    }
+
+    entry->mPosition = position;
+    entry->mRadius = radius > 0.0f ? radius : 0.0f;
+
+    // -- the max radius only ever grows, keeping the query expansion conservative
+    if (entry->mRadius > mMaxRadius)
+        mMaxRadius = entry->mRadius;
+
+    // -- only relink if the object moved to a different bucket
+    int32 bucket = CalcBucket(CalcCell(position.x), CalcCell(position.y));
+    if (bucket != entry->mBucket)
+    {
+        if (entry->mBucket >= 0)
+            UnlinkEntry(entry);
+        LinkEntry(entry);
+    }
+
+    return (true);
+}
+
+// ====================================================================================================================
+// Remove():  Removes an object from the grid.
+// ====================================================================================================================
+void CSpatialGrid::Remove(uint32 object_id)
+{
+    tGridEntry* entry = mEntryList->FindItem(object_id);
+    if (entry)
+        RemoveEntry(entry);
+}
+
+// ====================================================================================================================
+// RemoveAll():  Removes every object from the grid.
+// ====================================================================================================================
+void CSpatialGrid::RemoveAll()
+{
+    mEntryList->DestroyAll();
+    memset(mBuckets, 0, sizeof(mBuckets));
+    mMaxRadius = 0.0f;
+}
+
+// ====================================================================================================================
+// Contains():  Returns true if the object is in the grid.
+// ====================================================================================================================
+bool8 CSpatialGrid::Contains(uint32 object_id)
+{
+    return (mEntryList->FindItem(object_id) != NULL);
+}
+
+// ====================================================================================================================
+// Used():  Returns the number of objects in the grid.
+// ====================================================================================================================
+int32 CSpatialGrid::Used()
+{
+    return (mEntryList->Used());
+}
+
+// ====================================================================================================================
+// QueryRadius():  Finds every object in the layer overlapping the given circle, and returns them in the results set.
+// The results set is cleared first, and the return value is the number of objects found.
+// ====================================================================================================================
+int32 CSpatialGrid::QueryRadius(CVector3f position, float32 radius, int32 layer, TinScript::CObjectSet* results)
+{
+    if (!results || mInQuery)
+    {
+        ScriptAssert_(mContextOwner, 0, "<internal>", -1,
+                      "Error - CSpatialGrid::QueryRadius(): %s\n",
+                      !results ? "invalid results set" : "queries cannot be nested");
+        return (0);
+    }
+
+    mInQuery = true;
+    mResultCount = 0;
+    mStaleCount = 0;
+
+    GatherCandidates(position, radius, layer, NULL);
+    GrowBuffer(mResultIDs, mResultSize, 0, mCandidateCount);
+    for (int32 i = 0; i < mCandidateCount; ++i)
+        mResultIDs[mResultCount++] = mCandidates[i]->mObjectID;
+
+    RemoveStaleEntries();
+    AddResults(results, NULL);
+
+    mInQuery = false;
+    return (mResultCount);
+}
+
+// ====================================================================================================================
+// QueryPairs():  Pairs each object in layer_a with the nearest overlapping object in layer_b.
+// Each object is in at most one pair, so results_a[i] and results_b[i] are a pair.  Both sets are cleared first,
+// and the return value is the number of pairs found.
+// ====================================================================================================================
+int32 CSpatialGrid::QueryPairs(int32 layer_a, int32 layer_b, TinScript::CObjectSet* results_a,
+                               TinScript::CObjectSet* results_b)
+{
+    if (!results_a || !results_b || results_a == results_b || mInQuery)
+    {
+        ScriptAssert_(mContextOwner, 0, "<internal>", -1,
+                      "Error - CSpatialGrid::QueryPairs(): %s\n",
+                      mInQuery ? "queries cannot be nested" : "two different results sets are required");
+        return (0);
+    }
+
+    mInQuery = true;
+    mResultCount = 0;
+    mStaleCount = 0;
+
+    // -- visit layer_a in insertion order, so the pairing is deterministic
+    uint32 pair_stamp = ++mQueryStamp;
+    int32 count = mEntryList->Used();
+    for (int32 i = 0; i < count; ++i)
+    {
+        tGridEntry* entry_a = mEntryList->FindItemByIndex(i);
+        if (!entry_a || entry_a->mLayer != layer_a || entry_a->mPairStamp == pair_stamp)
+            continue;
+
+        if (!mContextOwner->FindObjectEntry(entry_a->mObjectID))
+        {
+            GrowBuffer(mStaleIDs, mStaleSize, mStaleCount, mStaleCount + 1);
+            mStaleIDs[mStaleCount++] = entry_a->mObjectID;
+            continue;
+        }
+
+        // -- find the nearest unpaired candidate
+        GatherCandidates(entry_a->mPosition, entry_a->mRadius, layer_b, entry_a);
+        tGridEntry* nearest = NULL;
+        float32 nearest_dist_sq = 0.0f;
+        for (int32 c = 0; c < mCandidateCount; ++c)
+        {
+            tGridEntry* entry_b = mCandidates[c];
+            if (entry_b->mPairStamp == pair_stamp)
+                continue;
+
+            CVector3f delta = entry_b->mPosition - entry_a->mPosition;
+            float32 dist_sq = CVector3f::Dot(delta, delta);
+            if (!nearest || dist_sq < nearest_dist_sq)
+            {
+                nearest = entry_b;
+                nearest_dist_sq = dist_sq;
+            }
+        }
+
+        if (nearest)
+        {
+            entry_a->mPairStamp = pair_stamp;
+            nearest->mPairStamp = pair_stamp;
+            GrowBuffer(mResultIDs, mResultSize, mResultCount, mResultCount + 2);
+            mResultIDs[mResultCount++] = entry_a->mObjectID;
+            mResultIDs[mResultCount++] = nearest->mObjectID;
+        }
+    }
+
+    RemoveStaleEntries();
+    AddResults(results_a, results_b);
+
+    mInQuery = false;
+    return (mResultCount / 2);
+}
+
+// ====================================================================================================================
+// CalcCell():  Returns the cell coordinate containing the value.
+// ====================================================================================================================
+int32 CSpatialGrid::CalcCell(float32 value) const
+{
+    // -- clamp, so a wild position can't overflow the conversion
+    float32 cell = floorf(value / mCellSize);
+    if (cell < -1e9f)
+        cell = -1e9f;
+    else if (cell > 1e9f)
+        cell = 1e9f;
+    return ((int32)cell);
+}
+
+// ====================================================================================================================
+// CalcBucket():  Hashes a cell coordinate to a bucket - distant cells may share a bucket.
+// ====================================================================================================================
+int32 CSpatialGrid::CalcBucket(int32 cell_x, int32 cell_y) const
+{
+    uint32 hash = ((uint32)cell_x * 73856093u) ^ ((uint32)cell_y * 19349663u);
+    return ((int32)(hash & (kSpatialGridBucketCount - 1)));
+}
+
+// ====================================================================================================================
+// LinkEntry():  Links the entry into the bucket for its current position.
+// ====================================================================================================================
+void CSpatialGrid::LinkEntry(tGridEntry* entry)
+{
+    entry->mBucket = CalcBucket(CalcCell(entry->mPosition.x), CalcCell(entry->mPosition.y));
+    entry->mPrev = NULL;
+    entry->mNext = mBuckets[entry->mBucket];
+    if (entry->mNext)
+        entry->mNext->mPrev = entry;
+    mBuckets[entry->mBucket] = entry;
+}
+
+// ====================================================================================================================
+// UnlinkEntry():  Unlinks the entry from its bucket.
+// ====================================================================================================================
+void CSpatialGrid::UnlinkEntry(tGridEntry* entry)
+{
+    if (entry->mPrev)
+        entry->mPrev->mNext = entry->mNext;
+    else
+        mBuckets[entry->mBucket] = entry->mNext;
+
+    if (entry->mNext)
+        entry->mNext->mPrev = entry->mPrev;
+
+    entry->mBucket = -1;
+    entry->mPrev = NULL;
+    entry->mNext = NULL;
+}
+
+// ====================================================================================================================
+// RemoveEntry():  Unlinks and deletes the entry.
+// ====================================================================================================================
+void CSpatialGrid::RemoveEntry(tGridEntry* entry)
+{
+    UnlinkEntry(entry);
+    mEntryList->RemoveItem(entry->mObjectID);
+    TinFree(entry);
+}
+
+// ====================================================================================================================
+// GatherCandidates():  Fills the candidate buffer with the entries in the layer overlapping the given circle.
+// Entries for objects that no longer exist are added to the stale list instead.
+// ====================================================================================================================
+void CSpatialGrid::GatherCandidates(const CVector3f& position, float32 radius, int32 layer, tGridEntry* exclude)
+{
+    mCandidateCount = 0;
+    uint32 visit_stamp = ++mQueryStamp;
+
+    // -- entries are stored by their center, so the search is expanded by the largest radius
+    float32 reach = radius + mMaxRadius;
+    int32 min_x = CalcCell(position.x - reach);
+    int32 max_x = CalcCell(position.x + reach);
+    int32 min_y = CalcCell(position.y - reach);
+    int32 max_y = CalcCell(position.y + reach);
+
+    // -- if the search covers more cells than there are buckets, simply visit every bucket once
+    int32 bucket_list[kSpatialGridBucketCount];
+    int32 bucket_count = 0;
+    int32 width = max_x - min_x + 1;
+    int32 height = max_y - min_y + 1;
+    if (width >= kSpatialGridBucketCount || height >= kSpatialGridBucketCount ||
+        width * height >= kSpatialGridBucketCount)
+    {
+        for (int32 b = 0; b < kSpatialGridBucketCount; ++b)
+            bucket_list[bucket_count++] = b;
+    }
+    else
+    {
+        for (int32 y = min_y; y <= max_y; ++y)
+        {
+            for (int32 x = min_x; x <= max_x; ++x)
+                bucket_list[bucket_count++] = CalcBucket(x, y);
+        }
+    }
+
+    for (int32 b = 0; b < bucket_count; ++b)
+    {
+        tGridEntry* entry = mBuckets[bucket_list[b]];
+        while (entry)
+        {
+            // -- distant cells can share a bucket - if its first entry was visited, the whole bucket was
+            if (entry->mVisitStamp == visit_stamp)
+                break;
+            entry->mVisitStamp = visit_stamp;
+
+            if (entry != exclude && (layer < 0 || entry->mLayer == layer))
+            {
+                CVector3f delta = entry->mPosition - position;
+                float32 max_dist = radius + entry->mRadius;
+                if (CVector3f::Dot(delta, delta) < max_dist * max_dist)
+                {
+                    if (mContextOwner->FindObjectEntry(entry->mObjectID))
+                    {
+                        GrowBuffer(mCandidates, mCandidateSize, mCandidateCount, mCandidateCount + 1);
+                        mCandidates[mCandidateCount++] = entry;
+                    }
+                    else
+                    {
+                        GrowBuffer(mStaleIDs, mStaleSize, mStaleCount, mStaleCount + 1);
+                        mStaleIDs[mStaleCount++] = entry->mObjectID;
+                    }
+                }
+            }
+
+            entry = entry->mNext;
+        }
+    }
+}
+
+// ====================================================================================================================
+// RemoveStaleEntries():  Removes the entries of destroyed objects found during the last query.
+// ====================================================================================================================
+void CSpatialGrid::RemoveStaleEntries()
+{
+    for (int32 i = 0; i < mStaleCount; ++i)
+        Remove(mStaleIDs[i]);
+    mStaleCount = 0;
+}
+
+// ====================================================================================================================
+// AddResults():  Copies the result IDs into the results sets - interleaved as pairs, if there are two sets.
+// Adding to a set may execute script (OnAdd), so the results are only added after the query is complete.
+// ====================================================================================================================
+void CSpatialGrid::AddResults(TinScript::CObjectSet* results_a, TinScript::CObjectSet* results_b)
+{
+    results_a->RemoveAll();
+    if (results_b)
+        results_b->RemoveAll();
+
+    int32 stride = results_b ? 2 : 1;
+    for (int32 i = 0; i + stride <= mResultCount; i += stride)
+    {
+        results_a->AddObject(mResultIDs[i]);
+        if (results_b)
+            results_b->AddObject(mResultIDs[i + 1]);
+    }
+}
+
+// ====================================================================================================================
+// EOF
+// ====================================================================================================================
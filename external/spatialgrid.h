@@ -0,0 +1,131 @@
+// ------------------------------------------------------------------------------------------------
+//  The MIT License
+//  
+//  Copyright (c) 2013 Tim Andersen
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+//  and associated documentation files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all copies or
+//  substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// ------------------------------------------------------------------------------------------------
+
+#ifndef __SPATIALGRID_H
+#define __SPATIALGRID_H
+
+// -- includes
+#include "mathutil.h"
+
+// -- includes required by any system wanting access to TinScript
+#include "TinScript.h"
+#include "TinRegistration.h"
+#include "TinHash.h"
+
+// -- forward declarations
+namespace TinScript
+{
+    class CObjectSet;
+}
+
+// ====================================================================================================================
+// -- constants
+const int32 kSpatialGridTableSize = 211;
+const int32 kSpatialGridBucketCount = 256;      // must be a power of 2
+const float32 kSpatialGridDefaultCellSize = 64.0f;
+
+// ====================================================================================================================
+// class CSpatialGrid
+// A spatial hash of object circles, for broad phase queries from script.  The grid is on the x/y plane, but the
+// overlap tests use the full 3D distance.  Objects are inserted and updated by ID, and the query results are
+// returned in a CObjectSet.  Each object is stored in the cell containing its center, so queries are expanded by
+// the largest radius in the grid.
+// ====================================================================================================================
+class CSpatialGrid
+{
+public:
+
+    DECLARE_SCRIPT_CLASS(CSpatialGrid, VOID);
+
+    CSpatialGrid();
+    virtual ~CSpatialGrid();
+
+    // -- registered methods
+    void SetCellSize(float32 cell_size);
+    bool8 Insert(uint32 object_id, int32 layer, CVector3f position, float32 radius);
+    bool8 Update(uint32 object_id, CVector3f position, float32 radius);
+    void Remove(uint32 object_id);
+    void RemoveAll();
+    bool8 Contains(uint32 object_id);
+    int32 Used();
+
+    // -- a layer of -1 matches every layer
+    int32 QueryRadius(CVector3f position, float32 radius, int32 layer, TinScript::CObjectSet* results);
+
+    // -- pairs each object in layer_a with the nearest unpaired overlapping object in layer_b
+    // -- each object is in at most one pair, so results_a[i] and results_b[i] are a pair
+    int32 QueryPairs(int32 layer_a, int32 layer_b, TinScript::CObjectSet* results_a,
+                     TinScript::CObjectSet* results_b);
+
+private:
+    struct tGridEntry
+    {
+        uint32 mObjectID;
+        int32 mLayer;
+        CVector3f mPosition;
+        float32 mRadius;
+
+        // -- the bucket list this entry is linked into
+        int32 mBucket;
+        tGridEntry* mPrev;
+        tGridEntry* mNext;
+
+        // -- stamps prevent visiting or pairing an entry twice in the same query
+        uint32 mVisitStamp;
+        uint32 mPairStamp;
+    };
+
+    int32 CalcCell(float32 value) const;
+    int32 CalcBucket(int32 cell_x, int32 cell_y) const;
+    void LinkEntry(tGridEntry* entry);
+    void UnlinkEntry(tGridEntry* entry);
+    void RemoveEntry(tGridEntry* entry);
+
+    void GatherCandidates(const CVector3f& position, float32 radius, int32 layer, tGridEntry* exclude);
+    void RemoveStaleEntries();
+    void AddResults(TinScript::CObjectSet* results_a, TinScript::CObjectSet* results_b);
+
+    TinScript::CScriptContext* mContextOwner;
+    TinScript::CHashTable<tGridEntry>* mEntryList;
+    tGridEntry* mBuckets[kSpatialGridBucketCount];
+
+    float32 mCellSize;
+    float32 mMaxRadius;
+    uint32 mQueryStamp;
+    bool8 mInQuery;
+
+    // -- scratch buffers, reused across queries
+    tGridEntry** mCandidates;
+    int32 mCandidateCount;
+    int32 mCandidateSize;
+    uint32* mResultIDs;
+    int32 mResultCount;
+    int32 mResultSize;
+    uint32* mStaleIDs;
+    int32 mStaleCount;
+    int32 mStaleSize;
+};
+
+#endif // __SPATIALGRID_H
+
+// ====================================================================================================================
+// EOF
+// ====================================================================================================================
@@ -0,0 +1,501 @@
+// ------------------------------------------------------------------------------------------------
+//  The MIT License
+//
+//  Copyright (c) 2013 Tim Andersen
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+//  and associated documentation files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or
+//  substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// ------------------------------------------------------------------------------------------------
+
+// ====================================================================================================================
+// TinClone.cpp
+// ====================================================================================================================
+
+// -- includes
+#include "stdafx.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "assert.h"
+
+#include "TinScript.h"
+#include "TinRegistration.h"
+#include "TinNamespace.h"
+#include "TinCompile.h"
+#include "TinParse.h"
+#include "TinStringTable.h"
+#include "TinSnapshot.h"
+#include "TinClone.h"
+
+// == namespace TinScript =============================================================================================
+
+namespace TinScript
+{
+
+// == Image sections ==================================================================================================
+
+// ====================================================================================================================
+// WriteImageStrings():  Write every string in the table - byte code refers to strings (including literals) by hash.
+// ====================================================================================================================
+static void WriteImageStrings(CScriptContext* script_context, CSnapshotWriter& writer)
+{
+    writer.BeginSection(SNAPSHOT_Strings);
+    int32 count_offset = writer.ReserveInt32();
+    int32 count = 0;
+
+    const CHashTable<CStringTable::tStringEntry>* string_table =
+        script_context->GetStringTable()->GetStringDictionary();
+    CStringTable::tStringEntry* ste = string_table->First();
+    while (ste)
+    {
+        writer.WriteString(ste->mString);
+        ++count;
+        ste = string_table->Next();
+    }
+
+    writer.PatchInt32(count_offset, count);
+}
+
+// ====================================================================================================================
+// ReadImageStrings():  Add the strings, with a reference held, as when the string table is loaded from file.
+// ====================================================================================================================
+static bool8 ReadImageStrings(CScriptContext* script_context, CSnapshotReader& reader)
+{
+    if (!reader.ReadSection(SNAPSHOT_Strings))
+        return (false);
+
+    int32 count = reader.ReadCount();
+    for (int32 i = 0; i < count && !reader.HasError(); ++i)
+        reader.ReadString(true);
+
+    return (!reader.HasError());
+}
+
+// ====================================================================================================================
+// WriteImageNamespaces():  Write each namespace that is derived from another, with the name of its parent.
+// ====================================================================================================================
+static void WriteImageNamespaces(CScriptContext* script_context, CSnapshotWriter& writer)
+{
+    writer.BeginSection(SNAPSHOT_Namespaces);
+    int32 count_offset = writer.ReserveInt32();
+    int32 count = 0;
+
+    CNamespace* ns = script_context->GetNamespaceDictionary()->First();
+    while (ns)
+    {
+        if (ns->GetNext())
+        {
+            writer.WriteString(ns->GetName());
+            writer.WriteString(ns->GetNext()->GetName());
+            ++count;
+        }
+        ns = script_context->GetNamespaceDictionary()->Next();
+    }
+
+    writer.PatchInt32(count_offset, count);
+}
+
+// ====================================================================================================================
+// ReadImageNamespaces():  Create the script namespaces, and link each to its parent.
+// Note:  registered classes are already linked when the context is created, in which case linking does nothing.
+// ====================================================================================================================
+static bool8 ReadImageNamespaces(CScriptContext* script_context, CSnapshotReader& reader)
+{
+    if (!reader.ReadSection(SNAPSHOT_Namespaces))
+        return (false);
+
+    int32 count = reader.ReadCount();
+    for (int32 i = 0; i < count && !reader.HasError(); ++i)
+    {
+        CNamespace* child_ns = script_context->FindOrCreateNamespace(reader.ReadString(), true);
+        CNamespace* parent_ns = script_context->FindOrCreateNamespace(reader.ReadString(), true);
+        if (reader.HasError() || !script_context->LinkNamespaces(child_ns, parent_ns))
+            return (false);
+    }
+
+    return (!reader.HasError());
+}
+
+// ====================================================================================================================
+// IsImageCodeBlock():  Only codeblocks still implementing functions are captured - the rest are pending deletion.
+// ====================================================================================================================
+static bool8 IsImageCodeBlock(CCodeBlock* codeblock)
+{
+    return (codeblock && codeblock->IsInUse() && !codeblock->IsReloading() && codeblock->GetFilenameHash() != 0 &&
+            codeblock->GetInstructionCount() > 0);
+}
+
+// ====================================================================================================================
+// FindImageCodeBlockIndex():  Returns the index of a codeblock within the image, in the order they're written.
+// Codeblocks are identified by index, as a file executed more than once may have more than one codeblock.
+// ====================================================================================================================
+static int32 FindImageCodeBlockIndex(CScriptContext* script_context, CCodeBlock* find_codeblock)
+{
+    int32 index = 0;
+    CCodeBlock* codeblock = script_context->GetCodeBlockList()->First();
+    while (codeblock)
+    {
+        if (IsImageCodeBlock(codeblock))
+        {
+            if (codeblock == find_codeblock)
+                return (index);
+            ++index;
+        }
+        codeblock = script_context->GetCodeBlockList()->Next();
+    }
+
+    return (-1);
+}
+
+// ====================================================================================================================
+// WriteImageCodeBlocks():  Write the filename, byte code and line numbers of each codeblock.
+// ====================================================================================================================
+static void WriteImageCodeBlocks(CScriptContext* script_context, CSnapshotWriter& writer)
+{
+    writer.BeginSection(SNAPSHOT_CodeBlocks);
+    int32 count_offset = writer.ReserveInt32();
+    int32 count = 0;
+
+    CCodeBlock* codeblock = script_context->GetCodeBlockList()->First();
+    while (codeblock)
+    {
+        if (IsImageCodeBlock(codeblock))
+        {
+            int32 instr_count = (int32)codeblock->GetInstructionCount();
+            int32 line_count = codeblock->GetLineNumberPtr() ? (int32)codeblock->GetLineNumberCount() : 0;
+            writer.WriteString(codeblock->GetFileName());
+            writer.WriteInt32(instr_count);
+            writer.WriteInt32(line_count);
+
+            // -- the byte code is aligned, so the codeblocks instantiated from the image can execute it in place
+            writer.WriteAlign();
+            writer.WriteBytes(codeblock->GetInstructionPtr(), instr_count * (int32)sizeof(uint32));
+            writer.WriteBytes(codeblock->GetLineNumberPtr(), line_count * (int32)sizeof(uint32));
+            ++count;
+        }
+        codeblock = script_context->GetCodeBlockList()->Next();
+    }
+
+    writer.PatchInt32(count_offset, count);
+}
+
+// ====================================================================================================================
+// ReadImageCodeBlocks():  Create each codeblock, executing from the byte code within the image.  The codeblocks are
+// returned in image order, to be bound to the functions by index.
+// ====================================================================================================================
+static bool8 ReadImageCodeBlocks(CScriptContext* script_context, CSnapshotReader& reader, int32& codeblock_count,
+                                 CCodeBlock**& codeblocks)
+{
+    if (!reader.ReadSection(SNAPSHOT_CodeBlocks))
+        return (false);
+
+    codeblock_count = reader.ReadCount();
+    if (reader.HasError())
+        return (false);
+
+    if (codeblock_count > 0)
+    {
+        codeblocks = TinAllocArray(ALLOC_CodeBlock, CCodeBlock*, codeblock_count);
+        for (int32 i = 0; i < codeblock_count; ++i)
+            codeblocks[i] = NULL;
+    }
+
+    for (int32 i = 0; i < codeblock_count && !reader.HasError(); ++i)
+    {
+        const char* filename = reader.ReadString();
+        int32 instr_count = reader.ReadCount();
+        int32 line_count = reader.ReadCount();
+
+        reader.ReadAlign();
+        const uint32* instr_block = (const uint32*)reader.ReadInPlace(instr_count * (int32)sizeof(uint32));
+        const uint32* line_numbers = (const uint32*)reader.ReadInPlace(line_count * (int32)sizeof(uint32));
+        if (reader.HasError() || !filename[0] || instr_count <= 0)
+            return (false);
+
+        // -- the codeblock remains flagged as parsing, until the function entries referring to it are declared
+        CCodeBlock* codeblock = TinAlloc(ALLOC_CodeBlock, CCodeBlock, script_context, filename);
+        codeblock->SetSharedInstructionBlock(instr_block, instr_count, line_numbers, line_count);
+        codeblocks[i] = codeblock;
+    }
+
+    return (!reader.HasError());
+}
+
+// ====================================================================================================================
+// FindParameterIndex():  Returns the index of a variable in a function's parameter list, or -1 for a local.
+// ====================================================================================================================
+static int32 FindParameterIndex(CFunctionContext* function_context, CVariableEntry* ve)
+{
+    if (!ve->IsParameter())
+        return (-1);
+
+    int32 param_count = function_context->GetParameterCount();
+    for (int32 i = 0; i < param_count; ++i)
+    {
+        if (function_context->GetParameter(i) == ve)
+            return (i);
+    }
+
+    return (-1);
+}
+
+// ====================================================================================================================
+// WriteImageFunctions():  Write the declaration of each script function - its namespace, name, codeblock index and
+// offset, and its parameters and local variables, with the stack offsets the byte code was compiled against.
+// ====================================================================================================================
+static void WriteImageFunctions(CScriptContext* script_context, CSnapshotWriter& writer)
+{
+    writer.BeginSection(SNAPSHOT_Functions);
+    int32 count_offset = writer.ReserveInt32();
+    int32 count = 0;
+
+    CNamespace* ns = script_context->GetNamespaceDictionary()->First();
+    while (ns)
+    {
+        CFunctionEntry* fe = ns->GetFuncTable()->First();
+        while (fe)
+        {
+            CCodeBlock* codeblock = fe->GetType() == eFuncTypeScript ? fe->GetCodeBlock() : NULL;
+            if (IsImageCodeBlock(codeblock))
+            {
+                CCodeBlock* offset_codeblock = NULL;
+                writer.WriteString(ns->GetName());
+                writer.WriteString(fe->GetName());
+                writer.WriteInt32(FindImageCodeBlockIndex(script_context, codeblock));
+                writer.WriteUInt32(fe->GetCodeBlockOffset(offset_codeblock));
+
+                // -- the variables are written in table order, as the byte code also refers to a local by its index
+                CFunctionContext* function_context = fe->GetContext();
+                tVarTable* var_table = function_context->GetLocalVarTable();
+                writer.WriteInt32(var_table->Used());
+                CVariableEntry* ve = var_table->First();
+                while (ve)
+                {
+                    writer.WriteHashString(ve->GetHash());
+                    writer.WriteUInt32((uint32)ve->GetType());
+                    writer.WriteInt32(ve->GetArraySize());
+                    writer.WriteInt32(FindParameterIndex(function_context, ve));
+                    writer.WriteInt32(ve->GetStackOffset());
+                    ve = var_table->Next();
+                }
+
+                ++count;
+            }
+            fe = ns->GetFuncTable()->Next();
+        }
+        ns = script_context->GetNamespaceDictionary()->Next();
+    }
+
+    writer.PatchInt32(count_offset, count);
+}
+
+// ====================================================================================================================
+// ReadImageFunctions():  Declare each script function, without executing the codeblock that defines it.
+// ====================================================================================================================
+static bool8 ReadImageFunctions(CScriptContext* script_context, CSnapshotReader& reader, int32& function_count,
+                                CCodeBlock** codeblocks, int32 codeblock_count)
+{
+    if (!reader.ReadSection(SNAPSHOT_Functions))
+        return (false);
+
+    function_count = reader.ReadCount();
+    for (int32 i = 0; i < function_count && !reader.HasError(); ++i)
+    {
+        CNamespace* ns = script_context->FindOrCreateNamespace(reader.ReadString(), true);
+        const char* function_name = reader.ReadString();
+        int32 codeblock_index = reader.ReadInt32();
+        CCodeBlock* codeblock = codeblock_index >= 0 && codeblock_index < codeblock_count ? codeblocks[codeblock_index]
+                                                                                          : NULL;
+        uint32 offset = reader.ReadUInt32();
+        if (reader.HasError() || !ns || !function_name[0] || !codeblock || offset >= codeblock->GetInstructionCount())
+            return (false);
+
+        CFunctionEntry* fe = FuncDeclaration(script_context, ns, function_name, Hash(function_name),
+                                             eFuncTypeScript);
+        if (!fe)
+            return (false);
+        fe->SetCodeBlockOffset(codeblock, offset);
+
+        CFunctionContext* function_context = fe->GetContext();
+        int32 var_count = reader.ReadCount();
+        for (int32 var_index = 0; var_index < var_count; ++var_index)
+        {
+            const char* var_name = reader.ReadString();
+            uint32 type_id = reader.ReadUInt32();
+            int32 array_size = reader.ReadInt32();
+            int32 param_index = reader.ReadInt32();
+            int32 stack_offset = reader.ReadInt32();
+            if (reader.HasError() || !var_name[0] || type_id >= (uint32)TYPE_COUNT ||
+                param_index >= CFunctionContext::eMaxParameterCount)
+            {
+                reader.SetError();
+                return (false);
+            }
+
+            CVariableEntry* ve = NULL;
+            uint32 var_hash = Hash(var_name);
+            if (param_index < 0)
+                ve = function_context->AddLocalVar(var_name, var_hash, (eVarType)type_id, array_size, false);
+            else if (function_context->AddParameter(var_name, var_hash, (eVarType)type_id, array_size,
+                                                    param_index, 0))
+                ve = function_context->GetParameter(param_index);
+
+            if (!ve)
+            {
+                reader.SetError();
+                return (false);
+            }
+
+            ve->SetStackOffset(stack_offset);
+            ve->SetFunctionEntry(fe);
+        }
+    }
+
+    return (!reader.HasError());
+}
+
+// == class CContextImage =============================================================================================
+
+// ====================================================================================================================
+// Constructor
+// ====================================================================================================================
+CContextImage::CContextImage()
+{
+    mBuffer = NULL;
+    mSize = 0;
+}
+
+// ====================================================================================================================
+// Destructor
+// ====================================================================================================================
+CContextImage::~CContextImage()
+{
+    Clear();
+}
+
+// ====================================================================================================================
+// Clear():  Release the image - no context instantiated from it may still exist.
+// ====================================================================================================================
+void CContextImage::Clear()
+{
+    if (mBuffer)
+        TinFreeArray(mBuffer);
+    mBuffer = NULL;
+    mSize = 0;
+}
+
+// ====================================================================================================================
+// Capture():  Capture the code and state of a context - must be called on the context's own thread.
+// ====================================================================================================================
+bool8 CContextImage::Capture(CScriptContext* script_context)
+{
+    Clear();
+    if (!script_context || script_context != TinScript::GetContext())
+    {
+        ScriptAssert_(script_context, 0, "<internal>", -1,
+                      "Error - CContextImage::Capture() must be called on the context's thread\n");
+        return (false);
+    }
+
+    CSnapshotWriter writer(script_context);
+    writer.WriteUInt32(kContextImageMagic);
+    writer.WriteInt32(kSnapshotVersion);
+
+    WriteImageStrings(script_context, writer);
+    WriteImageNamespaces(script_context, writer);
+    WriteImageCodeBlocks(script_context, writer);
+    WriteImageFunctions(script_context, writer);
+
+    // -- registered globals are owned by the application (shared by every thread), so they're not part of the image
+    int32 object_count = 0;
+    WriteSnapshotState(script_context, writer, true, object_count);
+
+    mBuffer = writer.DetachBuffer(mSize);
+    return (true);
+}
+
+// == class CScriptContext ============================================================================================
+
+// ====================================================================================================================
+// InstantiateImage():  Restore a captured image into this (newly created) context, without parsing or executing any
+// script - the codeblocks execute the byte code within the image, and the function entries are declared directly.
+// ====================================================================================================================
+bool8 CScriptContext::InstantiateImage(const CContextImage* image)
+{
+    if (!image || !image->IsValid())
+    {
+        ScriptAssert_(this, 0, "<internal>", -1, "Error - InstantiateImage() with no image\n");
+        return (false);
+    }
+
+    // -- codeblocks are identified by filename, so an image can't be merged with scripts already executed
+    if (GetCodeBlockList()->Used() > 0)
+    {
+        ScriptAssert_(this, 0, "<internal>", -1,
+                      "Error - InstantiateImage() requires a context that hasn't executed any scripts\n");
+        return (false);
+    }
+
+    CSnapshotReader reader(this);
+    reader.SetBuffer(image->GetBuffer(), image->GetSize());
+    if (reader.ReadUInt32() != kContextImageMagic || reader.ReadInt32() != kSnapshotVersion)
+    {
+        ScriptAssert_(this, 0, "<internal>", -1, "Error - InstantiateImage() invalid image\n");
+        return (false);
+    }
+
+    int32 codeblock_count = 0;
+    CCodeBlock** codeblocks = NULL;
+    int32 function_count = 0;
+    int32 object_count = 0;
+    eSnapshotSection failed_section = SNAPSHOT_COUNT;
+    if (!ReadImageStrings(this, reader))
+        failed_section = SNAPSHOT_Strings;
+    else if (!ReadImageNamespaces(this, reader))
+        failed_section = SNAPSHOT_Namespaces;
+    else if (!ReadImageCodeBlocks(this, reader, codeblock_count, codeblocks))
+        failed_section = SNAPSHOT_CodeBlocks;
+    else if (!ReadImageFunctions(this, reader, function_count, codeblocks, codeblock_count))
+        failed_section = SNAPSHOT_Functions;
+    else
+        failed_section = ReadSnapshotState(this, reader, object_count);
+
+    // -- with the function entries declared, the codeblocks are complete (any left unused are deleted as usual)
+    CCodeBlock* codeblock = GetCodeBlockList()->First();
+    while (codeblock)
+    {
+        codeblock->SetFinishedParsing();
+        codeblock = GetCodeBlockList()->Next();
+    }
+
+    if (codeblocks)
+        TinFreeArray(codeblocks);
+
+    if (failed_section != SNAPSHOT_COUNT)
+    {
+        ScriptAssert_(this, 0, "<internal>", -1, "Error - InstantiateImage() failed reading %s\n",
+                      GetSnapshotSectionName(failed_section));
+        return (false);
+    }
+
+    TinPrint(this, "Image instantiated: %d codeblocks, %d functions, %d objects\n", codeblock_count, function_count,
+             object_count);
+    return (true);
+}
+
+} // TinScript
+
+// ====================================================================================================================
+// EOF
+// ====================================================================================================================
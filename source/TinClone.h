@@ -0,0 +1,70 @@
+// ------------------------------------------------------------------------------------------------
+//  The MIT License
+//
+//  Copyright (c) 2013 Tim Andersen
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+//  and associated documentation files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or
+//  substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// ------------------------------------------------------------------------------------------------
+
+// ====================================================================================================================
+// TinClone.h
+// ====================================================================================================================
+
+#ifndef __TINCLONE_H
+#define __TINCLONE_H
+
+// == namespace TinScript =============================================================================================
+
+namespace TinScript
+{
+
+// --------------------------------------------------------------------------------------------------------------------
+// -- the image begins with its own magic number, and the snapshot version, as it's written by the snapshot writer
+const uint32 kContextImageMagic = 0x474d4954;
+
+// ====================================================================================================================
+// class CContextImage:  An immutable capture of a context - its string table, namespace hierarchy, compiled
+// codeblocks and script function declarations, followed by the snapshot state (objects, globals, schedules, signals).
+// A context is bound to the thread that created it, so an image is captured on the source context's thread, and then
+// instantiated into a newly created context on any other thread - concurrently, as instantiating only reads the image.
+// The codeblocks of every instantiated context execute directly from the byte code stored in the image, so the image
+// must not be destroyed until all contexts instantiated from it have been destroyed.
+// ====================================================================================================================
+class CContextImage
+{
+    public:
+        CContextImage();
+        virtual ~CContextImage();
+
+        bool8 Capture(CScriptContext* script_context);
+        void Clear();
+
+        bool8 IsValid() const { return (mBuffer != NULL); }
+        const char* GetBuffer() const { return (mBuffer); }
+        int32 GetSize() const { return (mSize); }
+
+    private:
+        char* mBuffer;
+        int32 mSize;
+};
+
+} // TinScript
+
+#endif // __TINCLONE_H
+
+// ====================================================================================================================
+// EOF
+// ====================================================================================================================
@@ -36,6 +36,7 @@
 #include "TinCompile.h"
 #include "TinExecute.h"
 #include "TinNamespace.h"
+#include "TinScheduler.h"
 
 // == namespace TinScript =============================================================================================
 
@@ -306,6 +307,87 @@ int32 CompileFunctionContext(CFunctionEntry* fe, uint32*& instrptr, bool8 counto
     return size;
 }
 
+// == class CParseArena ===============================================================================================
+
+// ====================================================================================================================
+// Constructor
+// ====================================================================================================================
+CParseArena::CParseArena()
+{
+    mChunkList = NULL;
+    mAllocatedSize = 0;
+}
+
+// ====================================================================================================================
+// Destructor
+// ====================================================================================================================
+CParseArena::~CParseArena()
+{
+    Reset();
+}
+
+// ====================================================================================================================
+// Alloc():  Bump allocate from the current chunk, adding a new chunk when the current one is exhausted.
+// ====================================================================================================================
+void* CParseArena::Alloc(int32 size)
+{
+    // -- keep every allocation pointer aligned
+    size = (size + (int32)sizeof(void*) - 1) & ~((int32)sizeof(void*) - 1);
+
+    // -- if the current chunk can't hold the request, push a new chunk to the front of the list
+    if (!mChunkList || mChunkList->mUsed + size > mChunkList->mSize)
+    {
+        int32 chunk_size = size > kParseArenaChunkSize ? size : kParseArenaChunkSize;
+        char* chunk_buf = TinAllocArray(ALLOC_TreeNode, char, sizeof(tArenaChunk) + chunk_size);
+        tArenaChunk* chunk = reinterpret_cast<tArenaChunk*>(chunk_buf);
+        chunk->mNext = mChunkList;
+        chunk->mSize = chunk_size;
+        chunk->mUsed = 0;
+        mChunkList = chunk;
+    }
+
+    // -- the chunk memory immediately follows the chunk header
+    char* result = reinterpret_cast<char*>(mChunkList) + sizeof(tArenaChunk) + mChunkList->mUsed;
+    mChunkList->mUsed += size;
+    mAllocatedSize += size;
+
+    return (result);
+}
+
+// ====================================================================================================================
+// AllocString():  Copies a token (not necessarily null terminated) into the arena, sized to fit exactly.
+// ====================================================================================================================
+const char* CParseArena::AllocString(const char* str, int32 length)
+{
+    if (!str || length <= 0)
+        return ("");
+
+    // -- a token is a view into the source buffer - stop at the length, or a terminator, whichever is first
+    char* result = reinterpret_cast<char*>(Alloc(length + 1));
+    int32 i = 0;
+    for (i = 0; i < length && str[i] != '\0'; ++i)
+        result[i] = str[i];
+    result[i] = '\0';
+
+    return (result);
+}
+
+// ====================================================================================================================
+// Reset():  Releases every chunk - any tree nodes allocated from this arena are no longer valid.
+// ====================================================================================================================
+void CParseArena::Reset()
+{
+    while (mChunkList)
+    {
+        tArenaChunk* next = mChunkList->mNext;
+        char* chunk_buf = reinterpret_cast<char*>(mChunkList);
+        TinFreeArray(chunk_buf);
+        mChunkList = next;
+    }
+
+    mAllocatedSize = 0;
+}
+
 // == class CCompileTreeNode ==========================================================================================
 
 // ====================================================================================================================
@@ -313,7 +395,7 @@ int32 CompileFunctionContext(CFunctionEntry* fe, uint32*& instrptr, bool8 counto
 // ====================================================================================================================
 CCompileTreeNode* CCompileTreeNode::CreateTreeRoot(CCodeBlock* codeblock)
 {
-    CCompileTreeNode* root = TinAlloc(ALLOC_TreeNode, CCompileTreeNode, codeblock);
+    CCompileTreeNode* root = TinAllocTreeNode(codeblock, CCompileTreeNode, codeblock);
 	root->next = NULL;
 	root->leftchild = NULL;
 	root->rightchild = NULL;
@@ -398,7 +480,7 @@ CValueNode::CValueNode(CCodeBlock* _codeblock, CCompileTreeNode*& _link, int32 _
                        eVarType _valtype)
     : CCompileTreeNode(_codeblock, _link, eValue, _linenumber)
 {
-	SafeStrcpy(value, _value, _valuelength + 1);
+	value = _codeblock->GetParseArena()->AllocString(_value, _valuelength);
 	isvariable = _isvar;
     isparam = false;
     valtype = _valtype;
@@ -411,7 +493,7 @@ CValueNode::CValueNode(CCodeBlock* _codeblock, CCompileTreeNode*& _link, int32 _
                        eVarType _valtype)
     : CCompileTreeNode(_codeblock, _link, eValue, _linenumber)
 {
-    value[0] = '\0';
+    value = "";
 	isvariable = false;
     isparam = true;
     paramindex = _paramindex;
@@ -436,16 +518,9 @@ int32 CValueNode::Eval(uint32*& instrptr, eVarType pushresult, bool8 countonly)
         }
 		else if (isvariable)
         {
-            int32 stacktopdummy = 0;
-            CObjectEntry* dummy = NULL;
-            CFunctionEntry* curfunction = codeblock->smFuncDefinitionStack->GetTop(dummy, stacktopdummy);
-
 			// -- ensure we can find the variable
 			uint32 varhash = Hash(value);
-            uint32 funchash = curfunction ? curfunction->GetHash() : 0;
-            uint32 nshash = curfunction ? curfunction->GetNamespaceHash() : CScriptContext::kGlobalNamespaceHash;
-            CVariableEntry* var = GetVariable(codeblock->GetScriptContext(), codeblock->smCurrentGlobalVarTable,
-                                              nshash, funchash, varhash, 0);
+            CVariableEntry* var = GetCompileVariable(codeblock, varhash);
 			if (!var)
             {
                 ScriptAssert_(codeblock->GetScriptContext(), 0, codeblock->GetFileName(), linenumber,
@@ -586,7 +661,7 @@ CObjMemberNode::CObjMemberNode(CCodeBlock* _codeblock, CCompileTreeNode*& _link,
                                const char* _membername, int32 _memberlength)
     : CCompileTreeNode(_codeblock, _link, eObjMember, _linenumber)
 {
-	SafeStrcpy(membername, _membername, _memberlength + 1);
+	membername = _codeblock->GetParseArena()->AllocString(_membername, _memberlength);
 }
 
 // ====================================================================================================================
@@ -662,7 +737,7 @@ CPODMemberNode::CPODMemberNode(CCodeBlock* _codeblock, CCompileTreeNode*& _link,
                                const char* _membername, int32 _memberlength)
     : CCompileTreeNode(_codeblock, _link, ePODMember, _linenumber)
 {
-	SafeStrcpy(podmembername, _membername, _memberlength + 1);
+	podmembername = _codeblock->GetParseArena()->AllocString(_membername, _memberlength);
 }
 
 // ====================================================================================================================
@@ -1224,8 +1299,8 @@ CFuncDeclNode::CFuncDeclNode(CCodeBlock* _codeblock, CCompileTreeNode*& _link, i
                              int32 _funcnslength, uint32 derived_ns)
     : CCompileTreeNode(_codeblock, _link, eFuncDecl, _linenumber)
 {
-    SafeStrcpy(funcname, _funcname, _length + 1);
-    SafeStrcpy(funcnamespace, _funcns, _funcnslength + 1);
+    funcname = _codeblock->GetParseArena()->AllocString(_funcname, _length);
+    funcnamespace = _codeblock->GetParseArena()->AllocString(_funcns, _funcnslength);
 
     int32 stacktopdummy = 0;
     CObjectEntry* dummy = NULL;
@@ -1262,7 +1337,8 @@ int32 CFuncDeclNode::Eval(uint32*& instrptr, eVarType pushresult, bool8 countonl
     else
 	    functable = codeblock->GetScriptContext()->GetGlobalNamespace()->GetFuncTable();
 
-	CFunctionEntry* fe = functable->FindItem(funchash);
+    // -- when reloading, the function entry was created detached from the function table
+	CFunctionEntry* fe = codeblock->IsReloading() ? functionentry : functable->FindItem(funchash);
 	if (!fe)
     {
 		ScriptAssert_(codeblock->GetScriptContext(), 0, codeblock->GetFileName(), linenumber,
@@ -1310,8 +1386,23 @@ int32 CFuncDeclNode::Eval(uint32*& instrptr, eVarType pushresult, bool8 countonl
         // -- fill in the missing offset
         uint32 offset = codeblock->CalcOffset(instrptr);
 
+        // -- a reload never modifies the existing function - the entry is swapped in once the file has compiled
+        if (codeblock->IsReloading())
+        {
+            CFunctionEntry* exists = functable->FindItem(funchash);
+            if (exists && exists->GetType() != eFuncTypeScript)
+            {
+                ScriptAssert_(codeblock->GetScriptContext(), false, codeblock->GetFileName(), linenumber,
+                              "Error - there is already a code registered function %s()\n", fe->GetName());
+                return (-1);
+            }
+
+            if (!codeblock->SetReloadFunctionOffset(fe, offset, mDerivedNamespace))
+                return (-1);
+        }
+
         // -- note, there's a possibility we're stomping a registered code function here
-        if (fe->GetType() != eFuncTypeScript)
+        else if (fe->GetType() != eFuncTypeScript)
         {
             ScriptAssert_(codeblock->GetScriptContext(), false, codeblock->GetFileName(), linenumber,
                           "Error - there is already a code dregistered function %s()\n"
@@ -1321,11 +1412,14 @@ int32 CFuncDeclNode::Eval(uint32*& instrptr, eVarType pushresult, bool8 countonl
             // -- it with the (presumably) updated signature
             functable->RemoveItem(funchash);
             TinFree(fe);
+            codeblock->GetScriptContext()->NotifyMethodTableChanged();
 
             return (-1);
         }
 
-        fe->SetCodeBlockOffset(codeblock, offset);
+        else
+            fe->SetCodeBlockOffset(codeblock, offset);
+
         *funcoffset = offset;
     }
 
@@ -1374,8 +1468,8 @@ CFuncCallNode::CFuncCallNode(CCodeBlock* _codeblock, CCompileTreeNode*& _link, i
                              int32 _nslength, bool8 _ismethod)
     : CCompileTreeNode(_codeblock, _link, eFuncCall, _linenumber)
 {
-    SafeStrcpy(funcname, _funcname, _length + 1);
-    SafeStrcpy(nsname, _nsname, _nslength + 1);
+    funcname = _codeblock->GetParseArena()->AllocString(_funcname, _length);
+    nsname = _codeblock->GetParseArena()->AllocString(_nsname, _nslength);
     ismethod = _ismethod;
 }
 
@@ -1518,7 +1612,7 @@ CObjMethodNode::CObjMethodNode(CCodeBlock* _codeblock, CCompileTreeNode*& _link,
                                const char* _methodname, int32 _methodlength)
     : CCompileTreeNode(_codeblock, _link, eObjMethod, _linenumber)
 {
-	SafeStrcpy(methodname, _methodname, _methodlength + 1);
+	methodname = _codeblock->GetParseArena()->AllocString(_methodname, _methodlength);
 }
 
 // ====================================================================================================================
@@ -1800,7 +1894,7 @@ CSelfVarDeclNode::CSelfVarDeclNode(CCodeBlock* _codeblock, CCompileTreeNode*& _l
                                    eVarType _type, int32 _array_size)
     : CCompileTreeNode(_codeblock, _link, eSelfVarDecl, _linenumber)
 {
-	SafeStrcpy(varname, _varname, _varnamelength + 1);
+	varname = _codeblock->GetParseArena()->AllocString(_varname, _varnamelength);
     type = _type;
     mArraySize = _array_size;
 }
@@ -1846,7 +1940,7 @@ CObjMemberDeclNode::CObjMemberDeclNode(CCodeBlock* _codeblock, CCompileTreeNode*
                                        eVarType _type, int32 _array_size)
     : CCompileTreeNode(_codeblock, _link, eObjMemberDecl, _linenumber)
 {
-	SafeStrcpy(varname, _varname, _varnamelength + 1);
+	varname = _codeblock->GetParseArena()->AllocString(_varname, _varnamelength);
     type = _type;
     mArraySize = _array_size;
 }
@@ -2071,7 +2165,7 @@ CCreateObjectNode::CCreateObjectNode(CCodeBlock* _codeblock, CCompileTreeNode*&
                                      const char* _classname, uint32 _classlength)
     : CCompileTreeNode(_codeblock, _link, eCreateObject, _linenumber)
 {
-	SafeStrcpy(classname, _classname, _classlength + 1);
+	classname = _codeblock->GetParseArena()->AllocString(_classname, _classlength);
 }
 
 // ====================================================================================================================
@@ -2130,6 +2224,99 @@ int32 CDestroyObjectNode::Eval(uint32*& instrptr, eVarType pushresult, bool8 cou
 	return size;
 }
 
+// == class CWaitNode =================================================================================================
+
+// ====================================================================================================================
+// Constructor
+// ====================================================================================================================
+CWaitNode::CWaitNode(CCodeBlock* _codeblock, CCompileTreeNode*& _link, int32 _linenumber)
+    : CCompileTreeNode(_codeblock, _link, eWait, _linenumber)
+{
+}
+
+// ====================================================================================================================
+// Eval():  Generates the byte code instruction compiled from this node.
+// ====================================================================================================================
+int32 CWaitNode::Eval(uint32*& instrptr, eVarType pushresult, bool8 countonly) const
+{
+	DebugEvaluateNode(*this, countonly, instrptr);
+	int32 size = 0;
+
+  	// -- evaluate the left child, pushing the delay as a TYPE_int
+    int32 tree_size = leftchild->Eval(instrptr, TYPE_int, countonly);
+    if (tree_size < 0)
+        return (-1);
+    size += tree_size;
+
+    // -- suspend the function
+	size += PushInstruction(countonly, instrptr, OP_Wait, DBG_instr);
+
+	return size;
+}
+
+// == class CArrayOpNode ==============================================================================================
+
+// ====================================================================================================================
+// Constructor
+// ====================================================================================================================
+CArrayOpNode::CArrayOpNode(CCodeBlock* _codeblock, CCompileTreeNode*& _link, int32 _linenumber,
+                           eOpCode _arrayopcode)
+    : CCompileTreeNode(_codeblock, _link, eArrayOp, _linenumber)
+{
+    arrayopcode = _arrayopcode;
+}
+
+// ====================================================================================================================
+// Eval():  Generates the byte code instruction compiled from this node.
+// ====================================================================================================================
+int32 CArrayOpNode::Eval(uint32*& instrptr, eVarType pushresult, bool8 countonly) const
+{
+	DebugEvaluateNode(*this, countonly, instrptr);
+	int32 size = 0;
+
+	// -- ensure we have a left child
+	if (!leftchild || (arrayopcode != OP_ArrayCount && !rightchild))
+    {
+        ScriptAssert_(codeblock->GetScriptContext(), 0, codeblock->GetFileName(), linenumber,
+                      "Error - CArrayOpNode missing an argument\n");
+		return (-1);
+	}
+
+  	// -- the left child must resolve to the array variable itself, not an element
+    int32 tree_size = leftchild->Eval(instrptr, TYPE__var, countonly);
+    if (tree_size < 0)
+        return (-1);
+    size += tree_size;
+
+    // -- a resize is followed by the new size, and a copy by the source array variable
+    if (arrayopcode != OP_ArrayCount)
+    {
+        tree_size = rightchild->Eval(instrptr, arrayopcode == OP_ArrayResize ? TYPE_int : TYPE__var, countonly);
+        if (tree_size < 0)
+            return (-1);
+        size += tree_size;
+    }
+
+	size += PushInstruction(countonly, instrptr, arrayopcode, DBG_instr);
+
+    // -- every array op leaves an int result on the stack - pop it, if it's unused
+    if (pushresult <= TYPE_void)
+        size += PushInstruction(countonly, instrptr, OP_Pop, DBG_instr);
+
+	return size;
+}
+
+// ====================================================================================================================
+// Dump():  Outputs the text version of the instructions compiled from this node.
+// ====================================================================================================================
+void CArrayOpNode::Dump(char*& output, int32& length) const
+{
+	sprintf_s(output, length, "type: %s, op: %s", gCompileNodeTypes[type], GetOperationString(arrayopcode));
+	int32 debuglength = (int32)strlen(output);
+	output += debuglength;
+	length -= debuglength;
+}
+
 // == class CCodeBlock ================================================================================================
 
 // ====================================================================================================================
@@ -2141,14 +2328,23 @@ CCodeBlock::CCodeBlock(CScriptContext* script_context, const char* _filename)
 
     mIsParsing = true;
 
+    mFunctionRefCount = 0;
+    mIsDead = false;
+    mDeadPrev = NULL;
+    mDeadNext = NULL;
+
     mInstrBlock = NULL;
     mInstrCount = 0;
+    mIsSharedInstrBlock = false;
 
     smFuncDefinitionStack = TinAlloc(ALLOC_FuncCallStack, CFunctionCallStack, kFunctionCallStackSize);
     smCurrentGlobalVarTable = TinAlloc(ALLOC_VarTable, tVarTable, kLocalVarTableSize);
-    mFunctionList = TinAlloc(ALLOC_FuncTable, tFuncTable, kLocalFuncTableSize);
     mBreakpoints = TinAlloc(ALLOC_Debugger, CHashTable<CDebuggerWatchExpression>, kBreakpointTableSize);
 
+    // -- functions compiled by a reload are held here until the commit
+    mIsReloading = false;
+    mReloadFunctionList = TinAlloc(ALLOC_FuncTable, CHashTable<tReloadFunction>, kLocalFuncTableSize);
+
     // -- add to the resident list of codeblocks, if a name was given
     mFileName[0] = '\0';
     mFileNameHash = 0;
@@ -2163,6 +2359,7 @@ CCodeBlock::CCodeBlock(CScriptContext* script_context, const char* _filename)
     mLineNumberIndex = 0;
     mLineNumberCount = 0;
     mLineNumbers = NULL;
+    mBreakpointBits = NULL;
 }
 
 // ====================================================================================================================
@@ -2170,20 +2367,69 @@ CCodeBlock::CCodeBlock(CScriptContext* script_context, const char* _filename)
 // ====================================================================================================================
 CCodeBlock::~CCodeBlock()
 {
-	if (mInstrBlock)
+	if (mInstrBlock && !mIsSharedInstrBlock)
 		TinFreeArray(mInstrBlock);
 
+    // -- if we're in the dead list, unlink
+    if (mIsDead)
+        UnlinkDead();
+
     smCurrentGlobalVarTable->DestroyAll();
     TinFree(smCurrentGlobalVarTable);
-    mFunctionList->DestroyAll();
-    TinFree(mFunctionList);
 
-    if (mLineNumbers)
+    if (mLineNumbers && !mIsSharedInstrBlock)
         TinFreeArray(mLineNumbers);
 
     // -- clear out the breakpoints list
     mBreakpoints->DestroyAll();
     TinFree(mBreakpoints);
+    if (mBreakpointBits)
+        TinFreeArray(mBreakpointBits);
+
+    // -- any reload functions never committed are discarded
+    DiscardReloadFunctions();
+    TinFree(mReloadFunctionList);
+}
+
+// ====================================================================================================================
+// UpdateDeadList():  Link the codeblock into the context's dead list when it's no longer in use, or unlink if reused.
+// ====================================================================================================================
+void CCodeBlock::UpdateDeadList()
+{
+    bool8 is_dead = !IsInUse();
+    if (is_dead == mIsDead)
+        return;
+
+    if (is_dead)
+    {
+        CCodeBlock*& dead_list = GetScriptContext()->GetDeadCodeBlockList();
+        mIsDead = true;
+        mDeadPrev = NULL;
+        mDeadNext = dead_list;
+        if (dead_list)
+            dead_list->mDeadPrev = this;
+        dead_list = this;
+    }
+    else
+        UnlinkDead();
+}
+
+// ====================================================================================================================
+// UnlinkDead():  Remove the codeblock from the context's dead list.
+// ====================================================================================================================
+void CCodeBlock::UnlinkDead()
+{
+    CCodeBlock*& dead_list = GetScriptContext()->GetDeadCodeBlockList();
+    if (mDeadPrev)
+        mDeadPrev->mDeadNext = mDeadNext;
+    else
+        dead_list = mDeadNext;
+    if (mDeadNext)
+        mDeadNext->mDeadPrev = mDeadPrev;
+
+    mIsDead = false;
+    mDeadPrev = NULL;
+    mDeadNext = NULL;
 }
 
 // ====================================================================================================================
@@ -2247,9 +2493,291 @@ bool8 CCodeBlock::CompileTree(const CCompileTreeNode& root)
         return (false);
     }
 
+    // -- encode the line numbers recorded during compilation
+    BuildLineNumberTable();
+
 	return true;
 }
 
+// == Line Number Table ===============================================================================================
+
+// --------------------------------------------------------------------------------------------------------------------
+// -- variable length encoding of the deltas within a block - 7 bits per byte, the high bit set if more follow
+// -- line deltas may be negative, so they're zigzag encoded (the sign in the low bit)
+static uint8* WriteLineNumberVarInt(uint8* writeptr, uint32 value)
+{
+    while (value >= 0x80)
+    {
+        *writeptr++ = (uint8)(value | 0x80);
+        value >>= 7;
+    }
+    *writeptr++ = (uint8)value;
+    return (writeptr);
+}
+
+static const uint8* ReadLineNumberVarInt(const uint8* readptr, uint32& value)
+{
+    value = 0;
+    int32 shift = 0;
+    while (*readptr & 0x80)
+    {
+        value |= (uint32)(*readptr++ & 0x7f) << shift;
+        shift += 7;
+    }
+    value |= (uint32)(*readptr++) << shift;
+    return (readptr);
+}
+
+// ====================================================================================================================
+// struct tLineNumberReader:  Iterates the entries of an encoded line number table, in offset order.
+// ====================================================================================================================
+struct tLineNumberReader
+{
+    tLineNumberReader(const uint32* table, uint32 word_count)
+    {
+        bool8 valid = table && word_count >= 2;
+        mEntryCount = valid ? table[0] : 0;
+        mBlockIndex = valid ? &table[2] : NULL;
+        mBytes = valid ? (const uint8*)&table[2 + 3 * table[1]] : NULL;
+        mReadPtr = NULL;
+        mEntry = 0;
+        mOffset = 0;
+        mLine = 0;
+    }
+
+    // -- position the reader before the first entry of the given block
+    void SeekBlock(uint32 block)
+    {
+        mEntry = block * kLineNumberTableBlockSize;
+        mReadPtr = NULL;
+    }
+
+    bool8 Next()
+    {
+        if (mEntry >= mEntryCount)
+            return (false);
+
+        // -- the first entry of each block is stored in the block index
+        if ((mEntry % kLineNumberTableBlockSize) == 0)
+        {
+            const uint32* block = &mBlockIndex[3 * (mEntry / kLineNumberTableBlockSize)];
+            mOffset = block[0];
+            mLine = (int32)block[1];
+            mReadPtr = &mBytes[block[2]];
+        }
+
+        // -- the rest are deltas from the previous entry
+        else
+        {
+            uint32 offset_delta = 0;
+            uint32 line_delta = 0;
+            mReadPtr = ReadLineNumberVarInt(mReadPtr, offset_delta);
+            mReadPtr = ReadLineNumberVarInt(mReadPtr, line_delta);
+            mOffset += offset_delta;
+            mLine += (int32)(line_delta >> 1) ^ -(int32)(line_delta & 1);
+        }
+
+        ++mEntry;
+        return (true);
+    }
+
+    // -- peek at the offset of the next entry, without advancing (returns false if there isn't one)
+    bool8 PeekOffset(uint32& offset) const
+    {
+        if (mEntry >= mEntryCount)
+            return (false);
+
+        if ((mEntry % kLineNumberTableBlockSize) == 0)
+        {
+            offset = mBlockIndex[3 * (mEntry / kLineNumberTableBlockSize)];
+            return (true);
+        }
+
+        uint32 offset_delta = 0;
+        ReadLineNumberVarInt(mReadPtr, offset_delta);
+        offset = mOffset + offset_delta;
+        return (true);
+    }
+
+    uint32 mEntryCount;
+    const uint32* mBlockIndex;
+    const uint8* mBytes;
+    const uint8* mReadPtr;
+    uint32 mEntry;
+    uint32 mOffset;
+    int32 mLine;
+};
+
+// ====================================================================================================================
+// BuildLineNumberTable():  Encode the (offset, line) pairs recorded during compilation, into the line number table.
+// ====================================================================================================================
+void CCodeBlock::BuildLineNumberTable()
+{
+    if (!mLineNumbers || mIsSharedInstrBlock)
+        return;
+
+    // -- the raw pairs are in offset order, as they're recorded as the instructions are written
+    // -- a lookup returns the line of the first entry at the instruction, or else the line of the last entry
+    // -- before it, so only the entries where the line changes are needed...  unless the entry begins a group
+    // -- of entries sharing an offset (nested nodes), where it's the line reported at that exact instruction
+    uint32 pair_count = mLineNumberIndex / 2;
+    uint32 entry_count = 0;
+    int32 prev_line = -1;
+    for (uint32 i = 0; i < pair_count; ++i)
+    {
+        uint32 offset = mLineNumbers[2 * i];
+        int32 line = (int32)mLineNumbers[2 * i + 1];
+        if (line < 0)
+            continue;
+
+        if (entry_count > 0 && line == prev_line)
+        {
+            uint32 next = i + 1;
+            while (next < pair_count && (int32)mLineNumbers[2 * next + 1] < 0)
+                ++next;
+            if (next >= pair_count || mLineNumbers[2 * next] != offset)
+                continue;
+        }
+
+        // -- compact the kept pairs in place
+        mLineNumbers[2 * entry_count] = offset;
+        mLineNumbers[2 * entry_count + 1] = (uint32)line;
+        ++entry_count;
+        prev_line = line;
+    }
+
+    // -- the worst case is 10 bytes per delta entry (two 5 byte variable length values)
+    uint32 block_count = (entry_count + kLineNumberTableBlockSize - 1) / kLineNumberTableBlockSize;
+    uint32 max_words = 2 + 3 * block_count + ((entry_count * 10) + 3) / 4;
+    uint32* table = TinAllocInstrBlock(max_words);
+    table[0] = entry_count;
+    table[1] = block_count;
+
+    uint32* block_index = &table[2];
+    uint8* bytes = (uint8*)&table[2 + 3 * block_count];
+    uint8* writeptr = bytes;
+    for (uint32 i = 0; i < entry_count; ++i)
+    {
+        uint32 offset = mLineNumbers[2 * i];
+        int32 line = (int32)mLineNumbers[2 * i + 1];
+        if ((i % kLineNumberTableBlockSize) == 0)
+        {
+            uint32* block = &block_index[3 * (i / kLineNumberTableBlockSize)];
+            block[0] = offset;
+            block[1] = (uint32)line;
+            block[2] = (uint32)(writeptr - bytes);
+        }
+        else
+        {
+            int32 line_delta = line - (int32)mLineNumbers[2 * i - 1];
+            writeptr = WriteLineNumberVarInt(writeptr, offset - mLineNumbers[2 * i - 2]);
+            writeptr = WriteLineNumberVarInt(writeptr, (uint32)((line_delta << 1) ^ (line_delta >> 31)));
+        }
+    }
+
+    // -- copy the table into an exact allocation, and release the raw pairs
+    uint32 word_count = 2 + 3 * block_count + (uint32)((writeptr - bytes) + 3) / 4;
+    uint32* exact_table = TinAllocInstrBlock(word_count);
+    memcpy(exact_table, table, word_count * sizeof(uint32));
+    TinFreeArray(table);
+    TinFreeArray(mLineNumbers);
+
+    mLineNumbers = exact_table;
+    mLineNumberCount = word_count;
+    mLineNumberIndex = 0;
+}
+
+// ====================================================================================================================
+// CalcLineNumber():  Return the line of the given instruction, and whether the instruction begins a new line.
+// ====================================================================================================================
+uint32 CCodeBlock::CalcLineNumber(const uint32* instrptr, bool* isNewLine) const
+{
+#if !TIN_DEBUGGER
+    return (0);
+#endif
+
+    // -- initialize the result
+    if (isNewLine)
+        *isNewLine = false;
+
+    if (!instrptr || !mLineNumbers || mLineNumberCount < 2 || mLineNumbers[0] == 0)
+        return (0);
+
+    // -- binary search for the last block beginning before the instruction
+    uint32 curoffset = CalcOffset(instrptr);
+    tLineNumberReader reader(mLineNumbers, mLineNumberCount);
+    int32 low = 0;
+    int32 high = (int32)mLineNumbers[1] - 1;
+    while (low < high)
+    {
+        int32 mid = (low + high + 1) / 2;
+        if (reader.mBlockIndex[3 * mid] < curoffset)
+            low = mid;
+        else
+            high = mid - 1;
+    }
+
+    // -- the instruction precedes every line
+    reader.SeekBlock(low);
+    reader.Next();
+    if (reader.mOffset > curoffset)
+    {
+        if (isNewLine)
+            *isNewLine = true;
+        return (0);
+    }
+
+    // -- step through the block, to the last entry before the instruction, or the first entry at it
+    // -- (the search guarantees an exact match is never a block's first entry, except for the table's first)
+    int32 prev_line = -1;
+    uint32 next_offset = 0;
+    while (reader.mOffset < curoffset && reader.PeekOffset(next_offset) && next_offset <= curoffset)
+    {
+        prev_line = reader.mLine;
+        reader.Next();
+    }
+
+    if (isNewLine)
+        *isNewLine = (reader.mOffset == curoffset && reader.mLine != prev_line);
+
+    return ((uint32)reader.mLine);
+}
+
+// ====================================================================================================================
+// UpdateBreakpointBits():  Mark every instruction on a line with a breakpoint, so the VM only has to test a bit.
+// ====================================================================================================================
+void CCodeBlock::UpdateBreakpointBits()
+{
+    // -- with no breakpoints, there's nothing to test
+    if (!HasBreakpoints() || mInstrCount == 0)
+    {
+        if (mBreakpointBits)
+            TinFreeArray(mBreakpointBits);
+        mBreakpointBits = NULL;
+        return;
+    }
+
+    int32 word_count = (mInstrCount + 31) / 32;
+    if (!mBreakpointBits)
+        mBreakpointBits = TinAllocArray(ALLOC_Debugger, uint32, word_count);
+    memset(mBreakpointBits, 0, word_count * sizeof(uint32));
+
+    // -- each entry's line covers its instruction, and every instruction up to the next entry
+    tLineNumberReader reader(mLineNumbers, mLineNumberCount);
+    while (reader.Next())
+    {
+        if (!mBreakpoints->FindItem(reader.mLine))
+            continue;
+
+        uint32 end_offset = mInstrCount;
+        reader.PeekOffset(end_offset);
+        if (end_offset <= reader.mOffset)
+            end_offset = reader.mOffset + 1;
+        for (uint32 offset = reader.mOffset; offset < end_offset && offset < mInstrCount; ++offset)
+            mBreakpointBits[offset >> 5] |= (1 << (offset & 31));
+    }
+}
+
 // ====================================================================================================================
 // HasBreakpoints():  Method used by the debugger, returns true if there are debug breakpoints set in this codeblock.
 // ====================================================================================================================
@@ -2264,21 +2792,19 @@ bool8 CCodeBlock::HasBreakpoints()
 int32 CCodeBlock::AdjustLineNumber(int32 line_number)
 {
     // -- sanity check
-    if (mLineNumberCount == 0)
+    tLineNumberReader reader(mLineNumbers, mLineNumberCount);
+    if (reader.mEntryCount == 0)
         return (0);
 
     // -- ensure the line number we're attempting to set, is one that will actually execute
-    for (uint32 i = 0; i < mLineNumberCount; ++i)
+    while (reader.Next())
     {
-        int32 instr_line_number = mLineNumbers[i] & 0xffff;
-        if (instr_line_number != 0xffff && instr_line_number >= line_number)
-        {
-            return (mLineNumbers[i] & 0xffff);
-        }
+        if (reader.mLine >= line_number)
+            return (reader.mLine);
     }
 
     // -- return the last line
-    return (mLineNumbers[mLineNumberCount - 1] & 0xffff);
+    return (reader.mLine);
 }
 
 // ====================================================================================================================
@@ -2300,6 +2826,8 @@ int32 CCodeBlock::AddBreakpoint(int32 line_number, bool8 break_enabled, const ch
     else
         watch->SetAttributes(break_enabled, conditional, trace, trace_on_condition);
 
+    UpdateBreakpointBits();
+
     return (adjusted_line_number);
 }
 
@@ -2314,6 +2842,7 @@ int32 CCodeBlock::RemoveBreakpoint(int32 line_number)
     {
         mBreakpoints->RemoveItem(adjusted_line_number);
         TinFree(watch);
+        UpdateBreakpointBits();
     }
 
     return (adjusted_line_number);
@@ -2325,6 +2854,219 @@ int32 CCodeBlock::RemoveBreakpoint(int32 line_number)
 void CCodeBlock::RemoveAllBreakpoints()
 {
     mBreakpoints->DestroyAll();
+    UpdateBreakpointBits();
+}
+
+// ====================================================================================================================
+// AddReloadFunction():  Add a function entry, detached from its function table, defined by reloading this file.
+// ====================================================================================================================
+void CCodeBlock::AddReloadFunction(CFunctionEntry* fe)
+{
+    tReloadFunction* reload = TinAlloc(ALLOC_FuncEntry, tReloadFunction);
+    reload->mFunctionEntry = fe;
+    reload->mOffset = 0;
+    reload->mDerivedNamespace = 0;
+    mReloadFunctionList->AddItem(*reload, fe->GetHash());
+}
+
+// ====================================================================================================================
+// SetReloadFunctionOffset():  Once a reload function is compiled, store where its body begins in this codeblock.
+// ====================================================================================================================
+bool8 CCodeBlock::SetReloadFunctionOffset(CFunctionEntry* fe, uint32 offset, uint32 derived_ns)
+{
+    // -- the same function name may be declared in more than one namespace - match the entry itself
+    tReloadFunction* reload = mReloadFunctionList->First();
+    while (reload)
+    {
+        if (reload->mFunctionEntry == fe)
+        {
+            reload->mOffset = offset;
+            reload->mDerivedNamespace = derived_ns;
+            return (true);
+        }
+        reload = mReloadFunctionList->Next();
+    }
+
+    ScriptAssert_(GetScriptContext(), 0, GetFileName(), -1,
+                  "Error - reload function %s() not found\n", fe->GetName());
+    return (false);
+}
+
+// ====================================================================================================================
+// IsFunctionChanged():  Returns true if the reloaded function differs from the current - signature or byte code.
+// ====================================================================================================================
+bool8 CCodeBlock::IsFunctionChanged(CFunctionEntry* cur_fe, CFunctionEntry* reload_fe, uint32 reload_offset) const
+{
+    CCodeBlock* cur_codeblock = NULL;
+    uint32 cur_offset = cur_fe->GetCodeBlockOffset(cur_codeblock);
+    if (!cur_codeblock || cur_offset == 0 || cur_fe->GetType() != eFuncTypeScript)
+        return (true);
+
+    // -- compare the signatures (the return type is parameter 0)
+    CFunctionContext* cur_context = cur_fe->GetContext();
+    CFunctionContext* reload_context = reload_fe->GetContext();
+    int32 param_count = cur_context->GetParameterCount();
+    if (param_count != reload_context->GetParameterCount())
+        return (true);
+
+    for (int32 i = 0; i < param_count; ++i)
+    {
+        CVariableEntry* cur_param = cur_context->GetParameter(i);
+        CVariableEntry* reload_param = reload_context->GetParameter(i);
+        if (cur_param->GetHash() != reload_param->GetHash() || cur_param->GetType() != reload_param->GetType() ||
+            cur_param->IsArray() != reload_param->IsArray())
+        {
+            return (true);
+        }
+    }
+
+    // -- the body of every function is preceeded by the branch word count that skips over it
+    const uint32* cur_body = &cur_codeblock->GetInstructionPtr()[cur_offset];
+    const uint32* reload_body = &mInstrBlock[reload_offset];
+    uint32 body_count = cur_body[-1];
+    if (body_count != reload_body[-1])
+        return (true);
+
+    // -- the body includes the local var table, and all branches within the body are relative
+    if (memcmp(cur_body, reload_body, body_count * sizeof(uint32)) != 0)
+        return (true);
+
+    // -- identical code that has moved within the file still needs the new line numbers for the debugger
+    if (cur_codeblock->CalcLineNumber(cur_body) != CalcLineNumber(reload_body))
+        return (true);
+
+    return (false);
+}
+
+// ====================================================================================================================
+// SetReloading():  A reloading codeblock isn't registered by its filename until its functions are committed, as the
+// file is still executing from the current codeblock - a file is only ever registered once.
+// ====================================================================================================================
+void CCodeBlock::SetReloading(bool8 torf)
+{
+    if (torf && !mIsReloading && mFileNameHash != 0)
+        GetScriptContext()->GetCodeBlockList()->RemoveItem(this, mFileNameHash);
+    mIsReloading = torf;
+}
+
+// ====================================================================================================================
+// CommitReloadFunctions():  Swap in every reloaded function that differs from the current, returns the number swapped.
+// The unchanged functions are moved to this codeblock, which replaces the current codeblock for the file - the
+// current is no longer registered, and is deleted once nothing refers to it.
+// ====================================================================================================================
+int32 CCodeBlock::CommitReloadFunctions(int32& function_count)
+{
+    CScriptContext* script_context = GetScriptContext();
+    function_count = 0;
+
+    // -- the swap is all or nothing - ensure every function was compiled first
+    tReloadFunction* reload = mReloadFunctionList->First();
+    while (reload)
+    {
+        CNamespace* nsentry = script_context->FindNamespace(reload->mFunctionEntry->GetNamespaceHash());
+        if (reload->mOffset == 0 || !nsentry)
+        {
+            ScriptAssert_(script_context, 0, GetFileName(), -1,
+                          "Error - unable to reload function %s() - no functions were updated\n",
+                          reload->mFunctionEntry->GetName());
+            DiscardReloadFunctions();
+            return (-1);
+        }
+        reload = mReloadFunctionList->Next();
+    }
+
+    int32 changed_count = 0;
+    reload = mReloadFunctionList->First();
+    while (reload)
+    {
+        ++function_count;
+        CFunctionEntry* fe = reload->mFunctionEntry;
+        CNamespace* nsentry = script_context->FindNamespace(fe->GetNamespaceHash());
+        tFuncTable* functable = nsentry->GetFuncTable();
+        CFunctionEntry* cur_fe = functable->FindItem(fe->GetHash());
+
+        // -- if nothing has changed, keep the current entry, moving it (and any suspended executions of it) to the
+        // -- identical code in this codeblock - frames already executing it continue in the current codeblock
+        if (cur_fe && !IsFunctionChanged(cur_fe, fe, reload->mOffset))
+        {
+            CCodeBlock* cur_codeblock = NULL;
+            uint32 cur_offset = cur_fe->GetCodeBlockOffset(cur_codeblock);
+            script_context->GetScheduler()->MoveCoroutines(cur_fe, cur_codeblock, this,
+                                                           (int32)reload->mOffset - (int32)cur_offset);
+            cur_fe->SetCodeBlockOffset(this, reload->mOffset);
+            TinFree(fe);
+        }
+        else
+        {
+            // -- the current entry may still be on the call stack - it's retired, and deleted at the next update
+            if (cur_fe)
+            {
+                functable->RemoveItem(cur_fe, cur_fe->GetHash());
+                script_context->RetireFunctionEntry(cur_fe);
+            }
+
+            functable->AddItem(*fe, fe->GetHash());
+            fe->SetCodeBlockOffset(this, reload->mOffset);
+
+            // -- a reloaded OnCreate() may have changed the derivation
+            if (reload->mDerivedNamespace != 0)
+            {
+                CNamespace* parent_ns = script_context->FindNamespace(reload->mDerivedNamespace);
+                if (!script_context->LinkNamespaces(nsentry, parent_ns))
+                {
+                    ScriptAssert_(script_context, 0, GetFileName(), -1, "Error - Derivation %s : %s failed.\n",
+                                  UnHash(nsentry->GetHash()), UnHash(reload->mDerivedNamespace));
+                }
+            }
+
+            ++changed_count;
+        }
+
+        reload = mReloadFunctionList->Next();
+    }
+
+    // -- the function entries are now owned by their tables, only the records are deleted
+    mReloadFunctionList->DestroyAll();
+
+    // -- replace the registered codeblock - functions no longer in the file continue to execute from it
+    // -- note:  if the file no longer defines any functions, this codeblock will be deleted, so it isn't registered
+    if (mFunctionRefCount > 0)
+    {
+        CHashTable<CCodeBlock>* codeblock_list = script_context->GetCodeBlockList();
+        CCodeBlock* registered = codeblock_list->FindItem(mFileNameHash);
+        while (registered)
+        {
+            codeblock_list->RemoveItem(registered, mFileNameHash);
+            registered = codeblock_list->FindItem(mFileNameHash);
+        }
+        codeblock_list->AddItem(*this, mFileNameHash);
+    }
+
+    // -- globals declared by the file must exist, but the top-level statements that initialize them aren't replayed
+    CVariableEntry* ve = smCurrentGlobalVarTable->First();
+    while (ve)
+    {
+        AddVariable(script_context, script_context->GetGlobalNamespace()->GetVarTable(), NULL, ve->GetName(),
+                    ve->GetHash(), ve->GetType(), ve->GetArraySize());
+        ve = smCurrentGlobalVarTable->Next();
+    }
+
+    return (changed_count);
+}
+
+// ====================================================================================================================
+// DiscardReloadFunctions():  Delete the detached function entries created by a reload that will not be committed.
+// ====================================================================================================================
+void CCodeBlock::DiscardReloadFunctions()
+{
+    tReloadFunction* reload = mReloadFunctionList->First();
+    while (reload)
+    {
+        TinFree(reload->mFunctionEntry);
+        reload = mReloadFunctionList->Next();
+    }
+
+    mReloadFunctionList->DestroyAll();
 }
 
 // ====================================================================================================================
@@ -78,8 +78,10 @@ class CWhileLoopNode;
 	CompileNodeTypeEntry(SelfVarDecl)			\
 	CompileNodeTypeEntry(ObjMemberDecl)			\
 	CompileNodeTypeEntry(Schedule)			    \
+	CompileNodeTypeEntry(Wait)			        \
 	CompileNodeTypeEntry(CreateObject)  	    \
 	CompileNodeTypeEntry(DestroyObject)  	    \
+	CompileNodeTypeEntry(ArrayOp)  	            \
 
 // enum
 enum ECompileNodeType
@@ -167,8 +169,12 @@ const char* GetNodeTypeString(ECompileNodeType nodetype);
 	OperationEntry(ScheduleBegin)       \
 	OperationEntry(ScheduleParam)       \
 	OperationEntry(ScheduleEnd)         \
+	OperationEntry(Wait)                \
 	OperationEntry(CreateObject)		\
 	OperationEntry(DestroyObject)		\
+	OperationEntry(ArrayCount)		    \
+	OperationEntry(ArrayResize)		    \
+	OperationEntry(ArrayCopy)		    \
 	OperationEntry(EOF)					\
 
 enum eOpCode {
@@ -179,6 +185,36 @@ enum eOpCode {
 };
 
 const char* GetOperationString(eOpCode op);
+int32 GetBinOpPrecedence(eBinaryOpType binoptype);
+
+// ====================================================================================================================
+// class CParseArena:  Bump allocator for the temporary parse tree, owned by the codeblock being compiled.
+// Nodes (and the identifier strings they reference) are never freed individually - the whole arena is released
+// once the tree has been compiled, which also reclaims nodes orphaned by a failed TryParse...() attempt.
+// ====================================================================================================================
+class CParseArena
+{
+    public:
+        CParseArena();
+        ~CParseArena();
+
+        void* Alloc(int32 size);
+        const char* AllocString(const char* str, int32 length);
+        void Reset();
+
+        int32 GetAllocatedSize() const { return (mAllocatedSize); }
+
+    private:
+        struct tArenaChunk
+        {
+            tArenaChunk* mNext;
+            int32 mSize;
+            int32 mUsed;
+        };
+
+        tArenaChunk* mChunkList;
+        int32 mAllocatedSize;
+};
 
 // ====================================================================================================================
 // class CCompileTreeNode:  Base class for the nodes used comprising the parse tree.
@@ -235,7 +271,7 @@ class CValueNode : public CCompileTreeNode
 		bool8 isvariable;
         bool8 isparam;
         int32 paramindex;
-		char value[kMaxTokenLength];
+		const char* value;
         eVarType valtype;
 
 	protected:
@@ -259,7 +295,6 @@ class CBinaryOpNode : public CCompileTreeNode
 
         eOpCode GetOpCode() const { return binaryopcode; }
         int GetBinaryOpPrecedence() const { return binaryopprecedence; }
-        void OverrideBinaryOpPrecedence(int32 new_precedence) { binaryopprecedence = new_precedence; }
 
 	protected:
         eOpCode binaryopcode;
@@ -314,7 +349,7 @@ class CObjMemberNode : public CCompileTreeNode
 		virtual void Dump(char*& output, int& length) const;
 
 	protected:
-		char membername[kMaxTokenLength];
+		const char* membername;
 
 	protected:
 		CObjMemberNode() { }
@@ -333,7 +368,7 @@ class CPODMemberNode : public CCompileTreeNode
 		virtual void Dump(char*& output, int& length) const;
 
 	protected:
-		char podmembername[kMaxTokenLength];
+		const char* podmembername;
 
 	protected:
 		CPODMemberNode() { }
@@ -451,8 +486,8 @@ class CFuncDeclNode : public CCompileTreeNode
 
 	protected:
 		CFuncDeclNode() { }
-        char funcname[kMaxNameLength];
-        char funcnamespace[kMaxNameLength];
+        const char* funcname;
+        const char* funcnamespace;
         CFunctionEntry* functionentry;
         uint32 mDerivedNamespace;
 };
@@ -471,8 +506,8 @@ class CFuncCallNode : public CCompileTreeNode
 		virtual void Dump(char*& output, int& length)const;
 
 	protected:
-		char funcname[kMaxNameLength];
-		char nsname[kMaxNameLength];
+		const char* funcname;
+		const char* nsname;
         bool8 ismethod;
 
 	protected:
@@ -507,7 +542,7 @@ class CObjMethodNode : public CCompileTreeNode
 		virtual void Dump(char*& output, int& length) const;
 
 	protected:
-		char methodname[kMaxTokenLength];
+		const char* methodname;
 
 	protected:
 		CObjMethodNode() { }
@@ -586,7 +621,7 @@ class CSelfVarDeclNode : public CCompileTreeNode
 		CSelfVarDeclNode() { }
         eVarType type;
         int32 mArraySize;
-        char varname[kMaxNameLength];
+        const char* varname;
 };
 
 // ====================================================================================================================
@@ -605,7 +640,7 @@ class CObjMemberDeclNode : public CCompileTreeNode
 		CObjMemberDeclNode() { }
         eVarType type;
         int32 mArraySize;
-        char varname[kMaxNameLength];
+        const char* varname;
 };
 
 // ====================================================================================================================
@@ -677,7 +712,7 @@ class CCreateObjectNode : public CCompileTreeNode
 
 	protected:
 		CCreateObjectNode() { }
-		char classname[kMaxTokenLength];
+		const char* classname;
 };
 
 // ====================================================================================================================
@@ -694,6 +729,46 @@ class CDestroyObjectNode : public CCompileTreeNode
 		CDestroyObjectNode() { }
 };
 
+// ====================================================================================================================
+// class CWaitNode:  Parse tree node, compiles to a suspension of the current (scheduled) function.
+// ====================================================================================================================
+class CWaitNode : public CCompileTreeNode
+{
+	public:
+		CWaitNode(CCodeBlock* _codeblock, CCompileTreeNode*& _link, int _linenumber);
+
+		virtual int Eval(uint32*& instrptr, eVarType pushresult, bool countonly) const;
+
+	protected:
+		CWaitNode() { }
+};
+
+// ====================================================================================================================
+// class CArrayOpNode:  Parse tree node, compiles to a count, resize, or copy of an entire array variable.
+// ====================================================================================================================
+class CArrayOpNode : public CCompileTreeNode
+{
+	public:
+		CArrayOpNode(CCodeBlock* _codeblock, CCompileTreeNode*& _link, int _linenumber, eOpCode _arrayopcode);
+
+		virtual int Eval(uint32*& instrptr, eVarType pushresult, bool countonly) const;
+        virtual void Dump(char*& output, int32& length) const;
+
+	protected:
+		CArrayOpNode() { }
+        eOpCode arrayopcode;
+};
+
+// ====================================================================================================================
+// struct tReloadFunction:  A function compiled during a reload, held until the entire file has compiled successfully.
+// ====================================================================================================================
+struct tReloadFunction
+{
+    CFunctionEntry* mFunctionEntry;
+    uint32 mOffset;
+    uint32 mDerivedNamespace;
+};
+
 // ====================================================================================================================
 // class CCodeBlock:  Stores the table of local variables, functions, and the byte code for a compiled script.
 // ====================================================================================================================
@@ -716,19 +791,35 @@ class CCodeBlock
                 mLineNumbers = TinAllocInstrBlock(_linecount);
         }
 
+        // -- the byte code and line numbers are never modified once compiled, so a codeblock can execute from
+        // -- memory owned by someone else (e.g. a context image), which must outlive the codeblock
+        void SetSharedInstructionBlock(const uint32* _instrblock, int _size, const uint32* _linenumbers,
+                                       int _linecount)
+        {
+            mInstrBlock = const_cast<uint32*>(_instrblock);
+            mInstrCount = _size;
+            mLineNumbers = _linecount > 0 ? const_cast<uint32*>(_linenumbers) : NULL;
+            mLineNumberCount = _linecount > 0 ? _linecount : 0;
+            mIsSharedInstrBlock = true;
+        }
+
+        bool8 IsSharedInstructionBlock() const { return (mIsSharedInstrBlock); }
+
         const char* GetFileName() const { return (mFileName); }
 
         uint32 GetFilenameHash() const { return (mFileNameHash); }
 
+        // -- while compiling, each line number is recorded as an (offset, line) pair - once compiled, the pairs
+        // -- are encoded into the line number table (see BuildLineNumberTable())
         void AddLineNumber(int linenumber, uint32* instrptr)
         {
             if (mLineNumbers)
             {
-                uint32 offset = CalcOffset(instrptr);
-                mLineNumbers[mLineNumberIndex++] = (offset << 16) + (linenumber & (0xffff));
+                mLineNumbers[mLineNumberIndex++] = CalcOffset(instrptr);
+                mLineNumbers[mLineNumberIndex++] = (uint32)linenumber;
             }
             else
-                ++mLineNumberCount;
+                mLineNumberCount += 2;
         }
 
 		const uint32 GetInstructionCount() const { return (mInstrCount); }
@@ -739,57 +830,8 @@ class CCodeBlock
         void SetLineNumberCount(uint32 line_count) { mLineNumberCount = line_count; }
 		uint32* GetLineNumberPtr() { return (mLineNumbers); }
 
-        uint32 CalcLineNumber(const uint32* instrptr, bool* isNewLine = NULL) const
-        {
-
-#if !TIN_DEBUGGER
-    return (0);
-#endif
-            // -- initialize the result
-            if (isNewLine)
-                *isNewLine = false;
-
-            if (!instrptr || mLineNumberCount == 0)
-                return (0);
-
-            // get the offset
-            uint32 curoffset = CalcOffset(instrptr);
-            uint32 lineindex = 0;
-            uint32 linenumber = 0;
-            for (lineindex = 0; lineindex < mLineNumberCount; ++lineindex)
-            {
-                uint32 offset = mLineNumbers[lineindex] >> 16;
-                uint32 line = mLineNumbers[lineindex] & 0xffff;
-                if (line != 0xffff)
-                {
-                    // -- see if the current offset falls within range of this line
-                    if (offset <= curoffset)
-                        linenumber = line;
-                    if (offset >= curoffset)
-                    {
-                        // -- set the result
-                        if (isNewLine)
-                        {
-                            // -- check the previous valid instruction - see if it's on the same line or not
-                            *isNewLine = true;
-                            int testlineindex = lineindex;
-                            while (--testlineindex >= 0)
-                            {
-                                uint32 testline = mLineNumbers[testlineindex] & 0xffff;
-                                if (testline != 0xffff)
-                                {
-                                    *isNewLine = (testline != linenumber);
-                                    break;
-                                }
-                            }
-                        }
-                        break;
-                    }
-                }
-            }
-
-            return (linenumber);
-        }
+        // -- returns the line for the instruction, and whether the instruction begins a new line
+        uint32 CalcLineNumber(const uint32* instrptr, bool* isNewLine = NULL) const;
 
         uint32 CalcOffset(const uint32* instrptr) const
         {
@@ -800,23 +842,41 @@ class CCodeBlock
         bool CompileTree(const CCompileTreeNode& root);
         bool Execute(uint32 offset, CExecStack& execstack, CFunctionCallStack& funccallstack);
 
+        // -- every function entry whose byte code lives in this codeblock holds a reference
         void AddFunction(CFunctionEntry* _func)
         {
-            if (!mFunctionList->FindItem(_func->GetHash()))
-                mFunctionList->AddItem(*_func, _func->GetHash());
+            ++mFunctionRefCount;
+            UpdateDeadList();
         }
 
         void RemoveFunction(CFunctionEntry* _func)
         {
-            mFunctionList->RemoveItem(_func->GetHash());
+            assert(mFunctionRefCount > 0);
+            --mFunctionRefCount;
+            UpdateDeadList();
         }
 
         int IsInUse()
         {
-            return (mIsParsing || !mFunctionList->IsEmpty());
+            return (mIsParsing || mFunctionRefCount > 0);
+        }
+
+        void SetFinishedParsing()
+        {
+            mIsParsing = false;
+            UpdateDeadList();
         }
 
-        void SetFinishedParsing() { mIsParsing = false; }
+        // -- the parse tree nodes are allocated from the arena, and only live until the tree is compiled
+        CParseArena* GetParseArena() { return (&mParseArena); }
+
+        // -- hot reload - functions are compiled detached, and only swapped in once the whole file compiles
+        void SetReloading(bool8 torf);
+        bool8 IsReloading() const { return (mIsReloading); }
+        void AddReloadFunction(CFunctionEntry* fe);
+        bool8 SetReloadFunctionOffset(CFunctionEntry* fe, uint32 offset, uint32 derived_ns);
+        int32 CommitReloadFunctions(int32& function_count);
+        void DiscardReloadFunctions();
 
         CFunctionCallStack* smFuncDefinitionStack;
         tVarTable* smCurrentGlobalVarTable;
@@ -829,6 +889,15 @@ class CCodeBlock
         int32 RemoveBreakpoint(int32 line_number);
         void RemoveAllBreakpoints();
 
+        // -- a bit per instruction, set for every instruction on a line with a breakpoint (NULL if there are none)
+        bool8 IsBreakpointInstr(const uint32* instrptr) const
+        {
+            if (!mBreakpointBits)
+                return (false);
+            uint32 offset = CalcOffset(instrptr);
+            return ((mBreakpointBits[offset >> 5] & (1 << (offset & 31))) != 0);
+        }
+
         static void DestroyCodeBlock(CCodeBlock* codeblock)
         {
             if (!codeblock)
@@ -844,40 +913,57 @@ class CCodeBlock
             TinFree(codeblock);
         }
 
-        static void DestroyUnusedCodeBlocks(CHashTable<CCodeBlock>* code_block_list)
-        {
-            CCodeBlock* codeblock = code_block_list->First();
-            while (codeblock)
-            {
-                if (!codeblock->IsInUse())
-                {
-                    code_block_list->RemoveItem(codeblock, codeblock->mFileNameHash);
-                    TinFree(codeblock);
-                }
-                codeblock = code_block_list->Next();
-            }
-        }
+        // -- codeblocks no longer in use are linked into the context's dead list, to be destroyed incrementally
+        CCodeBlock* GetNextDead() const { return (mDeadNext); }
 
 	private:
+        void UpdateDeadList();
+        void UnlinkDead();
+        void BuildLineNumberTable();
+        void UpdateBreakpointBits();
+
+        // -- the interpreter loop is compiled twice:  with the debugger hooks, and without (see Execute())
+        template <bool8 debugger_active>
+        bool8 ExecuteInstructions(uint32 offset, CExecStack& execstack, CFunctionCallStack& funccallstack);
+        bool8 IsFunctionChanged(CFunctionEntry* cur_fe, CFunctionEntry* reload_fe, uint32 reload_offset) const;
+
         CScriptContext* mContextOwner;
 
         bool8 mIsParsing;
+        bool8 mIsReloading;
 
         char mFileName[kMaxNameLength];
         uint32 mFileNameHash;
 		uint32* mInstrBlock;
 		uint32 mInstrCount;
+        bool8 mIsSharedInstrBlock;
 
         // -- keep track of the linenumber offsets
+        // -- the table is sorted by offset, in blocks of kLineNumberTableBlockSize entries:  the entry count, the
+        // -- block count, then for each block, the offset and line of its first entry, and the byte position of the
+        // -- rest, delta encoded (as variable length offset and line deltas) - lookups binary search the blocks
         uint32 mLineNumberIndex;
         uint32 mLineNumberCount;
         uint32* mLineNumbers;
 
-        // -- need to keep a list of all functions that are tied to this codeblock
-        tFuncTable* mFunctionList;
+        uint32* mBreakpointBits;
+
+        // -- the number of function entries tied to this codeblock
+        int32 mFunctionRefCount;
+
+        // -- once unused, the codeblock is linked into the dead list, until it's destroyed (or used again)
+        bool8 mIsDead;
+        CCodeBlock* mDeadPrev;
+        CCodeBlock* mDeadNext;
 
         // -- keep a list of all lines to be broken on, for this code block
         CHashTable<CDebuggerWatchExpression>* mBreakpoints;
+
+        // -- storage for the parse tree
+        CParseArena mParseArena;
+
+        // -- functions compiled by a reload, pending the commit
+        CHashTable<tReloadFunction>* mReloadFunctionList;
 };
 
 // ====================================================================================================================
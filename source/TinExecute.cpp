@@ -576,8 +576,12 @@ bool8 ExecuteCodeBlock(CCodeBlock& codeblock)
 // ====================================================================================================================
 // ExecuteScheduledFunction():  Execute a scheduled function.
 // ====================================================================================================================
+static bool8 ExecuteScheduledFunction(CScriptContext* script_context, CObjectEntry* oe, CFunctionEntry* fe,
+                                      CFunctionContext* parameters, CExecStack& execstack,
+                                      CFunctionCallStack& funccallstack);
+
 bool8 ExecuteScheduledFunction(CScriptContext* script_context, uint32 objectid, uint32 ns_hash, uint32 funchash,
-                               CFunctionContext* parameters)
+                               CFunctionContext* parameters, CCoroutine** suspended)
 {
     // -- sanity check
     if (funchash == 0 && parameters == NULL)
@@ -617,10 +621,43 @@ bool8 ExecuteScheduledFunction(CScriptContext* script_context, uint32 objectid,
         return false;
     }
 
+    // -- if the caller can resume the function, execute on the stacks of a coroutine, which are kept if it suspends
+    if (suspended != NULL)
+    {
+        *suspended = NULL;
+        CCoroutine* coroutine = TinAlloc(ALLOC_Coroutine, CCoroutine, script_context);
+        coroutine->GetFuncCallStack().SetSuspendAllowed(true);
+        bool8 result = ExecuteScheduledFunction(script_context, oe, fe, parameters, coroutine->GetExecStack(),
+                                                coroutine->GetFuncCallStack());
+        if (result && coroutine->IsSuspended())
+        {
+            coroutine->OnSuspended();
+            *suspended = coroutine;
+        }
+        else
+        {
+            TinFree(coroutine);
+        }
+
+        return (result);
+    }
+
 	// -- create the stack to use for the execution
 	CExecStack execstack(script_context, kExecStackSize);
     CFunctionCallStack funccallstack(kExecFuncCallDepth);
 
+    return (ExecuteScheduledFunction(script_context, oe, fe, parameters, execstack, funccallstack));
+}
+
+// ====================================================================================================================
+// ExecuteScheduledFunction():  Execute a scheduled function, on the given stacks.
+// ====================================================================================================================
+static bool8 ExecuteScheduledFunction(CScriptContext* script_context, CObjectEntry* oe, CFunctionEntry* fe,
+                                      CFunctionContext* parameters, CExecStack& execstack,
+                                      CFunctionCallStack& funccallstack)
+{
+    uint32 funchash = fe->GetHash();
+
     // -- nullvalue used to clear parameter values
     char nullvalue[MAX_TYPE_SIZE];
     memset(nullvalue, 0, MAX_TYPE_SIZE);
@@ -685,6 +722,10 @@ bool8 ExecuteScheduledFunction(CScriptContext* script_context, uint32 objectid,
         return false;
     }
 
+    // -- if the function suspended itself, there's no return value yet
+    if (funccallstack.IsSuspended())
+        return (true);
+
     // -- because every function is required to push a value onto the stack, pop the stack and
     // -- copy it to the _return parameter of this scheduled function
     eVarType contenttype;
@@ -726,6 +767,225 @@ bool8 ExecuteScheduledFunction(CScriptContext* script_context, uint32 objectid,
     return (true);
 }
 
+// ====================================================================================================================
+// CCoroutine():  Constructor.
+// ====================================================================================================================
+CCoroutine::CCoroutine(CScriptContext* script_context)
+    : mExecStack(script_context, kExecStackSize)
+    , mFuncCallStack(kExecFuncCallDepth)
+{
+    mContextOwner = script_context;
+    mCodeBlock = NULL;
+}
+
+// ====================================================================================================================
+// ~CCoroutine():  Destructor.
+// ====================================================================================================================
+CCoroutine::~CCoroutine()
+{
+    // -- release the codeblock - if this was the last reference, it's moved to the context's dead list
+    if (mCodeBlock)
+        mCodeBlock->RemoveFunction(NULL);
+}
+
+// ====================================================================================================================
+// GetFunctionEntry():  Returns the function that was called to start the coroutine.
+// ====================================================================================================================
+CFunctionEntry* CCoroutine::GetFunctionEntry()
+{
+    CObjectEntry* oe = NULL;
+    int32 var_offset = 0;
+    return (mFuncCallStack.GetTop(oe, var_offset));
+}
+
+// ====================================================================================================================
+// OnSuspended():  Called after the function suspends, the coroutine holds a reference to the suspended codeblock.
+// ====================================================================================================================
+void CCoroutine::OnSuspended()
+{
+    uint32 resume_offset = 0;
+    CCodeBlock* codeblock = mFuncCallStack.GetSuspendCodeBlock(resume_offset);
+    if (codeblock == mCodeBlock)
+        return;
+
+    if (mCodeBlock)
+        mCodeBlock->RemoveFunction(NULL);
+    mCodeBlock = codeblock;
+    mCodeBlock->AddFunction(NULL);
+}
+
+// ====================================================================================================================
+// MoveCodeBlock():  A reload moved the suspended function, unchanged, to a new codeblock - resume from the same
+// instruction within it.  Only the function called by the scheduler can suspend, so there are no other frames.
+// ====================================================================================================================
+void CCoroutine::MoveCodeBlock(CCodeBlock* codeblock, int32 offset_delta)
+{
+    uint32 resume_offset = 0;
+    if (!codeblock || !mFuncCallStack.GetSuspendCodeBlock(resume_offset))
+        return;
+
+    mFuncCallStack.Suspend(codeblock, (uint32)((int32)resume_offset + offset_delta), mFuncCallStack.GetSuspendDelay());
+    OnSuspended();
+}
+
+// ====================================================================================================================
+// Resume():  Continue executing a suspended function, returns false if it can't be resumed.
+// ====================================================================================================================
+bool8 CCoroutine::Resume()
+{
+    uint32 resume_offset = 0;
+    CCodeBlock* codeblock = mFuncCallStack.GetSuspendCodeBlock(resume_offset);
+    CFunctionEntry* fe = GetFunctionEntry();
+    if (!codeblock || !fe)
+        return (false);
+
+    // -- if the function was redefined, the locals on our stack no longer match the codeblock
+    CCodeBlock* fe_codeblock = NULL;
+    fe->GetCodeBlockOffset(fe_codeblock);
+    if (fe_codeblock != codeblock)
+    {
+        TinPrintWarning(mContextOwner, "Warning - function %s() was redefined, cancelling suspended execution\n",
+                        UnHash(fe->GetHash()));
+        return (false);
+    }
+
+    mFuncCallStack.ClearSuspended();
+    bool8 result = codeblock->Execute(resume_offset, mExecStack, mFuncCallStack);
+    if (!result)
+    {
+        if (mFuncCallStack.mDebuggerObjectDeleted == 0 && mFuncCallStack.mDebuggerFunctionReload == 0)
+        {
+            ScriptAssert_(mContextOwner, 0, "<internal>", -1,
+                          "Error - error resuming function: %s()\n", UnHash(fe->GetHash()));
+        }
+        return (false);
+    }
+
+    // -- if the function suspended again, it'll be resumed later
+    if (mFuncCallStack.IsSuspended())
+    {
+        OnSuspended();
+        return (true);
+    }
+
+    // -- otherwise it's complete - no one is waiting on the return value of a resumed function
+    eVarType contenttype;
+    mExecStack.Pop(contenttype);
+    return (true);
+}
+
+// ====================================================================================================================
+// CMethodBroadcast():  Constructor, the argument types and values must remain valid for the life of the broadcast.
+// ====================================================================================================================
+CMethodBroadcast::CMethodBroadcast(CScriptContext* script_context, uint32 method_hash, int32 arg_count,
+                                   const eVarType* arg_types, void** arg_values)
+    : mExecStack(script_context, kExecStackSize)
+    , mFuncCallStack(kExecFuncCallDepth)
+{
+    mContextOwner = script_context;
+    mMethodHash = method_hash;
+    mArgCount = arg_count;
+    mArgTypes = arg_types;
+    mArgValues = arg_values;
+
+    mCachedNamespace = NULL;
+    mCachedFunction = NULL;
+    mCachedLocalVarCount = 0;
+
+    mCallCount = 0;
+}
+
+// ====================================================================================================================
+// Call():  Call the method on the given object - objects that don't implement the method are skipped.
+// Returns false only if the execution fails, in which case the broadcast should not continue.
+// ====================================================================================================================
+bool8 CMethodBroadcast::Call(CObjectEntry* oe)
+{
+    if (!oe)
+        return (true);
+
+    // -- objects from the same namespace share the same method, so we only look it up when the namespace changes
+    if (oe->GetNamespace() != mCachedNamespace)
+    {
+        mCachedNamespace = oe->GetNamespace();
+        mCachedFunction = oe->GetFunctionEntry(0, mMethodHash);
+        mCachedLocalVarCount = 0;
+        if (mCachedFunction && mCachedFunction->GetType() != eFuncTypeGlobal)
+            mCachedLocalVarCount = mCachedFunction->GetContext()->CalculateLocalVarStackSize();
+    }
+
+    if (!mCachedFunction)
+        return (true);
+
+    return (CallMethod(oe, mCachedFunction, mCachedLocalVarCount));
+}
+
+// ====================================================================================================================
+// CallMethod():  Call a resolved method on the given object, with the broadcast arguments.
+// The local var count is the function context's CalculateLocalVarStackSize(), cached by the caller.
+// ====================================================================================================================
+bool8 CMethodBroadcast::CallMethod(CObjectEntry* oe, CFunctionEntry* fe, int32 local_var_count)
+{
+    if (!oe || !fe)
+        return (false);
+
+    // -- nullvalue used to clear parameter values
+    char nullvalue[MAX_TYPE_SIZE];
+    memset(nullvalue, 0, MAX_TYPE_SIZE);
+
+    // -- initialize the parameters - parameter 0 is the return value, so the arguments start at 1
+    CFunctionContext* fe_context = fe->GetContext();
+    int32 dstparamcount = fe_context->GetParameterCount();
+    for (int32 i = 0; i < dstparamcount; ++i)
+    {
+        CVariableEntry* dst = fe_context->GetParameter(i);
+        void* srcaddr = nullvalue;
+        if (i > 0 && i <= mArgCount && dst->GetType() >= FIRST_VALID_TYPE)
+        {
+            srcaddr = TypeConvert(mContextOwner, mArgTypes[i - 1], mArgValues[i - 1], dst->GetType());
+            if (!srcaddr)
+            {
+                ScriptAssert_(mContextOwner, 0, "<internal>", -1,
+                              "Error - unable to convert parameter %d, calling method %s()\n",
+                              i, UnHash(fe->GetHash()));
+                return (false);
+            }
+        }
+
+        dst->SetValue(NULL, srcaddr);
+    }
+
+    // -- push the function entry onto the call stack (same as if OP_FuncCallArgs had been used)
+    mFuncCallStack.Push(fe, oe, 0);
+    if (fe->GetType() != eFuncTypeGlobal)
+        mExecStack.Reserve(local_var_count * MAX_TYPE_SIZE);
+
+    // -- each broadcast call starts from an empty stack, so it's never nested
+    mFuncCallStack.BeginExecution();
+    bool8 result = CodeBlockCallFunction(fe, oe, mExecStack, mFuncCallStack, true);
+    if (!result)
+    {
+        if (mFuncCallStack.mDebuggerObjectDeleted == 0 && mFuncCallStack.mDebuggerFunctionReload == 0)
+        {
+            ScriptAssert_(mContextOwner, 0, "<internal>", -1,
+                          "Error - Unable to call method: %s()\n", UnHash(fe->GetHash()));
+        }
+        return (false);
+    }
+
+    // -- every function pushes a return value - discard it, leaving the stack empty for the next call
+    eVarType contenttype;
+    if (!mExecStack.Pop(contenttype))
+    {
+        ScriptAssert_(mContextOwner, 0, "<internal>", -1,
+                      "Error - no return value for method: %s()\n", UnHash(fe->GetHash()));
+        return (false);
+    }
+
+    ++mCallCount;
+    return (true);
+}
+
 // ====================================================================================================================
 // GetOpExecFunction():  Get the function pointer from the table tied to the enum of operations.
 // ====================================================================================================================
@@ -784,7 +1044,7 @@ bool8 DebuggerBreakLoop(CCodeBlock* cb, const uint32* instrptr, CExecStack& exec
         // -- print the assert message, if we have one, but simply return (true)
         if (assert_msg && assert_msg[0])
         {
-            TinPrint(script_context, assert_msg);
+            TinPrintError(script_context, assert_msg);
         }
         return (true);
     }
@@ -836,6 +1096,9 @@ bool8 DebuggerBreakLoop(CCodeBlock* cb, const uint32* instrptr, CExecStack& exec
         }
     }
 
+    // -- deliver everything logged before the break, ahead of the assert or breakpoint
+    script_context->DrainLog();
+
     // -- send a message to the debugger - either this is an assert, or a breakpoint
     bool is_assert = (assert_msg && assert_msg[0]);
     if (is_assert)
@@ -847,6 +1110,9 @@ bool8 DebuggerBreakLoop(CCodeBlock* cb, const uint32* instrptr, CExecStack& exec
         script_context->DebuggerBreakpointHit(script_context->mDebuggerVarWatchRequestID, codeblock_hash, cur_line);
     }
 
+    // -- we won't reach the end of the update until the break is resolved, so send the batch now
+    script_context->DebuggerFlushMessages();
+
     // -- wait for the debugger to either continue to step or run
     script_context->SetBreakActionStep(false);
     script_context->SetBreakActionRun(false);
@@ -864,6 +1130,10 @@ bool8 DebuggerBreakLoop(CCodeBlock* cb, const uint32* instrptr, CExecStack& exec
         // -- or sends a message to step or run
         script_context->ProcessThreadCommands();
 
+        // -- send any responses to the commands (e.g. variable watches), and anything they printed
+        script_context->DrainLog();
+        script_context->DebuggerFlushMessages();
+
         // -- if either mDebuggerBreakStep or mDebuggerBreakRun was set, exit the loop
         if (script_context->mDebuggerActionStep || script_context->mDebuggerActionRun)
         {
@@ -934,6 +1204,24 @@ bool8 DebuggerFindStackTopVar(CScriptContext* script_context, uint32 var_hash, C
 // Execute():  Execute a code block
 // ====================================================================================================================
 bool8 CCodeBlock::Execute(uint32 offset, CExecStack& execstack, CFunctionCallStack& funccallstack)
+{
+    // -- initialize the function return value
+    GetScriptContext()->SetFunctionReturnValue(NULL, TYPE_NULL);
+
+    // -- the debugger hooks cost a test per instruction, so they're only compiled into one variant of the VM,
+    // -- selected per call - a VM already running without them switches over on its next backward branch or
+    // -- return from a call, once the context needs the debugger's attention (see ExecuteInstructions())
+    if (GetScriptContext()->IsDebuggerActive())
+        return (ExecuteInstructions<true>(offset, execstack, funccallstack));
+    else
+        return (ExecuteInstructions<false>(offset, execstack, funccallstack));
+}
+
+// ====================================================================================================================
+// ExecuteInstructions():  The VM loop, executing from the offset until the function returns, or the block ends.
+// ====================================================================================================================
+template <bool8 debugger_active>
+bool8 CCodeBlock::ExecuteInstructions(uint32 offset, CExecStack& execstack, CFunctionCallStack& funccallstack)
 {
 
 #if DEBUG_CODEBLOCK
@@ -943,9 +1231,6 @@ bool8 CCodeBlock::Execute(uint32 offset, CExecStack& execstack, CFunctionCallSta
     }
 #endif
 
-    // -- initialize the function return value
-    GetScriptContext()->SetFunctionReturnValue(NULL, TYPE_NULL);
-
     const uint32* instrptr = GetInstructionPtr();
     instrptr += offset;
 
@@ -956,104 +1241,118 @@ bool8 CCodeBlock::Execute(uint32 offset, CExecStack& execstack, CFunctionCallSta
 #ifdef WIN32
 #if TIN_DEBUGGER
 
-        // -- see if there's a breakpoint set for this line
-        // -- or if it's being forced, or if we're stepping from the last break
-        // -- note:  it's possible to be *in* the infinite loop, and then try to connect the debugger
-        // -- followed by forcing a break.  The break comes in on the socket thread, so processing the
-        // -- debugger connection might not have happened yet...
-        CScriptContext* script_context = GetScriptContext();
-        if (script_context->mDebuggerActionForceBreak ||
-            script_context->mDebuggerConnected && (funccallstack.mDebuggerBreakStep || HasBreakpoints()))
+        if (debugger_active)
         {
-            // -- get the current line number - see if we should break
-            bool isNewLine = false;
-            int32 cur_line = CalcLineNumber(instrptr, &isNewLine);
-
-            // -- break if we're stepping, and on a new line
-            // -- if we're stepping out or over, then there's a stack depth we want to be at or below
-            int32 cur_stack_depth = funccallstack.GetStackDepth();
-            bool break_at_stack_depth = (funccallstack.mDebuggerBreakOnStackDepth < 0 ||
-                                         cur_stack_depth <= funccallstack.mDebuggerBreakOnStackDepth);
-
-            // -- if we're forcing a debugger break
-            // -- if we're stepping, and we're on a different line, or if
-            // -- we're not stepping, and on a different line, and this new line has a breakpoint
-            CDebuggerWatchExpression* break_condition = mBreakpoints->FindItem(cur_line);
-            bool force_break = script_context->mDebuggerActionForceBreak;
-            bool step_new_line = funccallstack.mDebuggerBreakStep && funccallstack.mDebuggerLastBreak != cur_line &&
-                                 break_at_stack_depth;
-            bool found_break = (!funccallstack.mDebuggerBreakStep &&
-                               (isNewLine || cur_line != funccallstack.mDebuggerLastBreak) && break_condition);
-
-            // -- if we aren't forcing a break, and not stepping to a new line, and we found a break,
-            // -- then evaluate the break conditional
-            if (!force_break && !step_new_line && found_break)
+            // -- see if there's a breakpoint set for this line
+            // -- or if it's being forced, or if we're stepping from the last break
+            // -- note:  it's possible to be *in* the infinite loop, and then try to connect the debugger
+            // -- followed by forcing a break.  The break comes in on the socket thread, so processing the
+            // -- debugger connection might not have happened yet...  and if the loop began before the debugger
+            // -- was active, it's running in the VM without these hooks, until the next call
+            // -- note:  instructions on a line with a breakpoint are marked in a bitmap, so the line is only looked
+            // -- up for those instructions (or when stepping)
+            CScriptContext* script_context = GetScriptContext();
+            if (script_context->mDebuggerActionForceBreak ||
+                script_context->mDebuggerConnected && (funccallstack.mDebuggerBreakStep || IsBreakpointInstr(instrptr)))
             {
-                // -- when looking to see if we have a breakpoint on this line,
-                // -- we may have a condition and/or a trace expression
-                bool condition_result = true;
-
-                // -- note:  if we do have an expression, that can't be evaluated, assume true
-                if (script_context->HasWatchExpression(*break_condition) &&
-                    script_context->InitWatchExpression(*break_condition, false, funccallstack) &&
-                    script_context->EvalWatchExpression(*break_condition, false, funccallstack, execstack))
+                // -- get the current line number - see if we should break
+                bool isNewLine = false;
+                int32 cur_line = CalcLineNumber(instrptr, &isNewLine);
+
+                // -- break if we're stepping, and on a new line
+                // -- if we're stepping out or over, then there's a stack depth we want to be at or below
+                int32 cur_stack_depth = funccallstack.GetStackDepth();
+                bool break_at_stack_depth = (funccallstack.mDebuggerBreakOnStackDepth < 0 ||
+                                             cur_stack_depth <= funccallstack.mDebuggerBreakOnStackDepth);
+
+                // -- if we're forcing a debugger break
+                // -- if we're stepping, and we're on a different line, or if
+                // -- we're not stepping, and on a different line, and this new line has a breakpoint
+                CDebuggerWatchExpression* break_condition = mBreakpoints->FindItem(cur_line);
+                bool force_break = script_context->mDebuggerActionForceBreak;
+                bool step_new_line = funccallstack.mDebuggerBreakStep && funccallstack.mDebuggerLastBreak != cur_line &&
+                                     break_at_stack_depth;
+                bool found_break = (!funccallstack.mDebuggerBreakStep &&
+                                   (isNewLine || cur_line != funccallstack.mDebuggerLastBreak) && break_condition);
+
+                // -- if we aren't forcing a break, and not stepping to a new line, and we found a break,
+                // -- then evaluate the break conditional
+                if (!force_break && !step_new_line && found_break)
                 {
-                    // -- if we're unable to retrieve the result, then found_break
-                    eVarType return_type = TYPE_void;
-                    void* return_value = NULL;
-                    if (script_context->GetFunctionReturnValue(return_value, return_type))
+                    // -- when looking to see if we have a breakpoint on this line,
+                    // -- we may have a condition and/or a trace expression
+                    bool condition_result = true;
+
+                    // -- note:  if we do have an expression, that can't be evaluated, assume true
+                    if (script_context->HasWatchExpression(*break_condition) &&
+                        script_context->InitWatchExpression(*break_condition, false, funccallstack) &&
+                        script_context->EvalWatchExpression(*break_condition, false, funccallstack, execstack))
                     {
-                        // -- if this is false, then we *do not* break
-                        void* bool_result = TypeConvert(script_context, return_type, return_value, TYPE_bool);
-                        if (!(*(bool8*)bool_result))
+                        // -- if we're unable to retrieve the result, then found_break
+                        eVarType return_type = TYPE_void;
+                        void* return_value = NULL;
+                        if (script_context->GetFunctionReturnValue(return_value, return_type))
                         {
-                            condition_result = false;
+                            // -- if this is false, then we *do not* break
+                            void* bool_result = TypeConvert(script_context, return_type, return_value, TYPE_bool);
+                            if (!(*(bool8*)bool_result))
+                            {
+                                condition_result = false;
+                            }
                         }
                     }
-                }
 
-                // -- regardless of whether we break, we execute the trace expression, but only at the start of the line
-                if (isNewLine && break_condition && script_context->HasTraceExpression(*break_condition))
-                {
-                    if (!break_condition->mTraceOnCondition || condition_result)
+                    // -- regardless of whether we break, we execute the trace expression,
+                    // -- but only at the start of the line
+                    if (isNewLine && break_condition && script_context->HasTraceExpression(*break_condition))
                     {
-                        if (script_context->InitWatchExpression(*break_condition, true, funccallstack))
+                        if (!break_condition->mTraceOnCondition || condition_result)
                         {
-                            // -- the trace expression has no result
-                            script_context->EvalWatchExpression(*break_condition, true, funccallstack, execstack);
+                            if (script_context->InitWatchExpression(*break_condition, true, funccallstack))
+                            {
+                                // -- the trace expression has no result
+                                script_context->EvalWatchExpression(*break_condition, true, funccallstack, execstack);
+                            }
                         }
                     }
+
+                    // -- we want to break only if the break is enabled, and the condition is true
+                    found_break = break_condition->mIsEnabled && condition_result;
                 }
 
-                // -- we want to break only if the break is enabled, and the condition is true
-                found_break = break_condition->mIsEnabled && condition_result;
+                // -- now see if we should break
+                if (force_break || step_new_line || found_break)
+                {
+                    DebuggerBreakLoop(this, instrptr, execstack, funccallstack);
+                }
             }
 
-            // -- now see if we should break
-            if (force_break || step_new_line || found_break)
+            // -- if at any point during execution, we deleted a currently executing object, or reloaded a function
+            // -- we need to break from this VM so we don't dereference an IP that no longer exists.
+            if (funccallstack.mDebuggerObjectDeleted != 0 || funccallstack.mDebuggerFunctionReload != 0)
             {
-                DebuggerBreakLoop(this, instrptr, execstack, funccallstack);
+                char msg_buf[kMaxTokenLength];
+                if (funccallstack.mDebuggerFunctionReload != 0)
+                    sprintf_s(msg_buf, "Break suspended - function %s() has been redefined.\n",
+                              UnHash(funccallstack.mDebuggerFunctionReload));
+                else
+                    sprintf_s(msg_buf, "Break suspended - Object [%d] no longer exists.\n",
+                              funccallstack.mDebuggerObjectDeleted);
+                script_context->DebuggerSendAssert(msg_buf, 0, 0);
+                return (false);
             }
-        }
 
-        // -- if at any point during execution, we deleted a currently executing object, or reloaded a function
-        // -- we need to break from this VM so we don't dereference an IP that no longer exists.
-        if (funccallstack.mDebuggerObjectDeleted != 0 || funccallstack.mDebuggerFunctionReload != 0)
-        {
-            char msg_buf[kMaxTokenLength];
-            if (funccallstack.mDebuggerFunctionReload != 0)
-                sprintf_s(msg_buf, "Break suspended - function %s() has been redefined.\n",
-                          UnHash(funccallstack.mDebuggerFunctionReload));
-            else
-                sprintf_s(msg_buf, "Break suspended - Object [%d] no longer exists.\n",
-                          funccallstack.mDebuggerObjectDeleted);
-            script_context->DebuggerSendAssert(msg_buf, 0, 0);
-            return (false);
         }
 
 #endif // TIN_DEBUGGER
 #endif // WIN32
 
+#ifdef WIN32
+#if TIN_DEBUGGER
+        const uint32* op_instrptr = instrptr;
+#endif
+#endif
+
 		// -- get the operation and process it
 		eOpCode curoperation = (eOpCode)(*instrptr++);
 
@@ -1075,6 +1374,27 @@ bool8 CCodeBlock::Execute(uint32 offset, CExecStack& execstack, CFunctionCallSta
         {
             return (true);
         }
+
+        // -- a wait/yield suspends execution - the coroutine owning the stacks will resume at the stored offset
+        if (curoperation == OP_Wait && funccallstack.IsSuspended())
+        {
+            return (true);
+        }
+
+#ifdef WIN32
+#if TIN_DEBUGGER
+
+        // -- without the hooks, a loop that began before a debugger connected (or a caller stepped out to)
+        // -- would never see a break request, so every backward branch and return from a call tests the flag,
+        // -- and continues executing this function in the debugger variant
+        if (!debugger_active && (instrptr < op_instrptr || curoperation == OP_FuncCall) &&
+            GetScriptContext()->NeedsDebuggerAttention())
+        {
+            return (ExecuteInstructions<true>(CalcOffset(instrptr), execstack, funccallstack));
+        }
+
+#endif // TIN_DEBUGGER
+#endif // WIN32
 	}
 
 	// -- ran out of instructions, without a legitimate OP_EOF
@@ -273,6 +273,12 @@ class CFunctionCallStack
             mDebuggerObjectDeleted = 0;
             mDebuggerFunctionReload = 0;
             mDebuggerBreakOnStackDepth = -1;
+
+            // -- suspension members
+            mSuspendAllowed = false;
+            mSuspendCodeBlock = NULL;
+            mSuspendOffset = 0;
+            mSuspendDelay = 0;
 		}
 
 		virtual ~CFunctionCallStack()
@@ -335,6 +341,26 @@ class CFunctionCallStack
         void BeginExecution(const uint32* instrptr);
         void BeginExecution();
 
+        // -- only the function called directly by the scheduler can suspend itself (wait/yield) - see CCoroutine
+        void SetSuspendAllowed(bool8 allowed) { mSuspendAllowed = allowed; }
+        bool8 CanSuspend() const { return (mSuspendAllowed && stacktop == 1); }
+        void Suspend(CCodeBlock* codeblock, uint32 resume_offset, int32 delay)
+        {
+            mSuspendCodeBlock = codeblock;
+            mSuspendOffset = resume_offset;
+            mSuspendDelay = delay;
+        }
+
+        void ClearSuspended() { mSuspendCodeBlock = NULL; }
+        bool8 IsSuspended() const { return (mSuspendCodeBlock != NULL); }
+        CCodeBlock* GetSuspendCodeBlock(uint32& resume_offset) const
+        {
+            resume_offset = mSuspendOffset;
+            return (mSuspendCodeBlock);
+        }
+
+        int32 GetSuspendDelay() const { return (mSuspendDelay); }
+
         CFunctionEntry* GetExecuting(CObjectEntry*& objentry, int32& varoffset) {
             int32 temp = stacktop - 1;
             while (temp >= 0)
@@ -400,11 +426,81 @@ class CFunctionCallStack
         tFunctionCallEntry* funcentrystack;
 		int32 size;
 		int32 stacktop;
+
+        bool8 mSuspendAllowed;
+        CCodeBlock* mSuspendCodeBlock;
+        uint32 mSuspendOffset;
+        int32 mSuspendDelay;
+};
+
+// ====================================================================================================================
+// class CCoroutine:  The execution stacks of a scheduled function, which are kept if the function suspends itself
+// with a 'wait' or 'yield' statement.  The scheduler resumes it, with its locals intact, on the same stacks.
+// ====================================================================================================================
+class CCoroutine
+{
+    public:
+        CCoroutine(CScriptContext* script_context);
+        virtual ~CCoroutine();
+
+        CScriptContext* GetScriptContext() { return (mContextOwner); }
+
+        CExecStack& GetExecStack() { return (mExecStack); }
+        CFunctionCallStack& GetFuncCallStack() { return (mFuncCallStack); }
+
+        bool8 IsSuspended() const { return (mFuncCallStack.IsSuspended()); }
+        int32 GetResumeDelay() const { return (mFuncCallStack.GetSuspendDelay()); }
+        CFunctionEntry* GetFunctionEntry();
+
+        void OnSuspended();
+        void MoveCodeBlock(CCodeBlock* codeblock, int32 offset_delta);
+        bool8 Resume();
+
+    private:
+        CScriptContext* mContextOwner;
+        CExecStack mExecStack;
+        CFunctionCallStack mFuncCallStack;
+
+        // -- a suspended coroutine holds a reference to its codeblock, so it can't be destroyed by a reload
+        CCodeBlock* mCodeBlock;
+};
+
+// ====================================================================================================================
+// class CMethodBroadcast:  Calls the same method on a sequence of objects, back to back.
+// The method is resolved once per namespace, and a single exec stack and call stack are reused for every call.
+// CallMethod() executes an already resolved method, e.g. from a namespace's cached lifecycle hooks.
+// ====================================================================================================================
+class CMethodBroadcast
+{
+    public:
+        CMethodBroadcast(CScriptContext* script_context, uint32 method_hash, int32 arg_count = 0,
+                         const eVarType* arg_types = NULL, void** arg_values = NULL);
+
+        bool8 Call(CObjectEntry* oe);
+        bool8 CallMethod(CObjectEntry* oe, CFunctionEntry* fe, int32 local_var_count);
+        int32 GetCallCount() const { return (mCallCount); }
+
+    private:
+        CScriptContext* mContextOwner;
+        CExecStack mExecStack;
+        CFunctionCallStack mFuncCallStack;
+
+        uint32 mMethodHash;
+        int32 mArgCount;
+        const eVarType* mArgTypes;
+        void** mArgValues;
+
+        // -- the method (and its stack size) found for the namespace of the last object called
+        CNamespace* mCachedNamespace;
+        CFunctionEntry* mCachedFunction;
+        int32 mCachedLocalVarCount;
+
+        int32 mCallCount;
 };
 
 bool8 ExecuteCodeBlock(CCodeBlock& codeblock);
 bool8 ExecuteScheduledFunction(CScriptContext* script_context, uint32 objectid, uint32 ns_hash, uint32 funchash,
-                               CFunctionContext* parameters);
+                               CFunctionContext* parameters, CCoroutine** suspended = NULL);
 bool8 CodeBlockCallFunction(CFunctionEntry* fe, CObjectEntry* oe, CExecStack& execstack,
                             CFunctionCallStack& funccallstack, bool copy_stack_parameters);
 
@@ -95,6 +95,9 @@ class CHashTable
         iter = NULL;
         used = 0;
         iter_was_removed = false;
+
+        free_list = NULL;
+        recycle_entries = false;
 	}
 
 	virtual ~CHashTable()
@@ -111,11 +114,29 @@ class CHashTable
 		}
         TinFreeArray(table);
         TinFreeArray(index_table);
+
+        SetRecycleEntries(false);
 	}
 
+    // -- tables with a lot of add/remove churn can keep removed entries for reuse, so that once the table has
+    // -- reached its working size, adding an item no longer allocates
+    void SetRecycleEntries(bool8 recycle)
+    {
+        recycle_entries = recycle;
+        if (!recycle)
+        {
+            while (free_list)
+            {
+                CHashTableEntry* next_free = free_list->nextbucket;
+                TinFree(free_list);
+                free_list = next_free;
+            }
+        }
+    }
+
 	void AddItem(T& _item, uint32 _hash)
 	{
-		CHashTableEntry* hte = TinAlloc(ALLOC_HashTable, CHashTableEntry, _item, _hash);
+		CHashTableEntry* hte = AllocEntry(_item, _hash);
 		int32 bucket = _hash % size;
 		hte->nextbucket = table[bucket];
 		table[bucket] = hte;
@@ -153,7 +174,7 @@ class CHashTable
             _index = 0;
 
         // -- create the entry, add it to the table as per the hash, and clear the iterators
-		CHashTableEntry* hte = TinAlloc(ALLOC_HashTable, CHashTableEntry, _item, _hash);
+		CHashTableEntry* hte = AllocEntry(_item, _hash);
 		int32 bucket = _hash % size;
 		hte->nextbucket = table[bucket];
 		table[bucket] = hte;
@@ -211,6 +232,22 @@ class CHashTable
 		return (NULL);
 	}
 
+    int32 FindItemIndex(uint32 _hash) const
+    {
+		int32 bucket = _hash % size;
+		CHashTableEntry* hte = table[bucket];
+		while (hte)
+        {
+			if (hte->hash == _hash)
+				return (hte->index);
+
+			hte = hte->nextbucket;
+		}
+
+		// -- not found
+		return (-1);
+    }
+
     T* FindItemByIndex(int32 _index) const
     {
         if (_index < 0 || _index >= used)
@@ -306,7 +343,7 @@ class CHashTable
                 RemoveRawEntryFromIndexTable(curentry);
 
                 // -- delete the entry, and decriment the count
-				TinFree(curentry);
+				FreeEntry(curentry);
                 --used;
 				return;
 			}
@@ -345,7 +382,7 @@ class CHashTable
                 // -- remove the entry from the index table
                 RemoveRawEntryFromIndexTable(curentry);
 
-				TinFree(curentry);
+				FreeEntry(curentry);
                 --used;
 				return;
 			}
@@ -476,6 +513,33 @@ class CHashTable
     }
 
 	private:
+        CHashTableEntry* AllocEntry(T& _item, uint32 _hash)
+        {
+            if (!free_list)
+                return (TinAlloc(ALLOC_HashTable, CHashTableEntry, _item, _hash));
+
+            CHashTableEntry* hte = free_list;
+            free_list = hte->nextbucket;
+            hte->item = &_item;
+            hte->hash = _hash;
+            hte->nextbucket = NULL;
+            hte->index = -1;
+            hte->index_next = NULL;
+            return (hte);
+        }
+
+        void FreeEntry(CHashTableEntry* hte)
+        {
+            if (!recycle_entries)
+            {
+                TinFree(hte);
+                return;
+            }
+
+            hte->nextbucket = free_list;
+            free_list = hte;
+        }
+
 		CHashTableEntry** table;
 		CHashTableEntry** index_table;
 		int32 size;
@@ -483,6 +547,9 @@ class CHashTable
 
 		mutable CHashTableEntry* iter;
         mutable bool8 iter_was_removed;
+
+        CHashTableEntry* free_list;
+        bool8 recycle_entries;
  };
 
 }  // TinScript
@@ -60,6 +60,11 @@ CScriptContext* GetContext();
 // ====================================================================================================================
 bool8 ExecCommand(const char* statement);
 
+// ====================================================================================================================
+// EmitSignal():  Calls every script method subscribed to the named signal
+// ====================================================================================================================
+int32 EmitSignal(const char* signal_name);
+
 // ====================================================================================================================
 // CompileScript():  Compile (without executing) a text file containing script code
 // ====================================================================================================================
@@ -70,6 +75,11 @@ bool8 CompileScript(const char* filename);
 // ====================================================================================================================
 bool8 ExecScript(const char* filename);
 
+// ====================================================================================================================
+// ReloadScript():  Recompiles a script file, replacing only the functions that have changed (without executing it)
+// ====================================================================================================================
+bool8 ReloadScript(const char* filename);
+
 // ====================================================================================================================
 // SetTimeScale():  Allows for accurate communication with the debugger, if the application adjusts timescale
 // ====================================================================================================================
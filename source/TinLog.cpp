@@ -0,0 +1,309 @@
+// ------------------------------------------------------------------------------------------------
+//  The MIT License
+//
+//  Copyright (c) 2013 Tim Andersen
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+//  and associated documentation files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or
+//  substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// ------------------------------------------------------------------------------------------------
+
+// ====================================================================================================================
+// TinLog.cpp
+// ====================================================================================================================
+
+// -- includes
+#include "stdafx.h"
+#include "assert.h"
+#include "stdio.h"
+#include "string.h"
+
+#include "../external/socket.h"
+
+#include "TinScript.h"
+#include "TinRegistration.h"
+#include "TinInterface.h"
+#include "TinLog.h"
+
+// == namespace TinScript =============================================================================================
+
+namespace TinScript
+{
+
+// -- a debugger batch packet begins with the batch packet ID and the message count
+static const int32 kLogBatchHeaderSize = 2 * sizeof(int32);
+
+// == class CScriptLog ================================================================================================
+
+// ====================================================================================================================
+// Constructor
+// ====================================================================================================================
+CScriptLog::CScriptLog(CScriptContext* script_context)
+{
+    assert(script_context != NULL);
+    mContextOwner = script_context;
+
+    // -- by default, everything but debug messages is logged
+    mMinSeverity = LOG_SEVERITY_Info;
+    mChannelMask = 0xffffffff;
+    mDrainOnUpdate = true;
+
+    // -- the ring size must be a power of two, as positions are masked to find the slot
+    assert((kLogRingSize & (kLogRingSize - 1)) == 0);
+    mRecords = TinAllocArray(ALLOC_Log, tLogRecord, kLogRingSize);
+    for (int32 i = 0; i < kLogRingSize; ++i)
+        mRecords[i].mSequence.store((uint32)i, std::memory_order_relaxed);
+
+    mWritePosition.store(0, std::memory_order_relaxed);
+    mReadPosition = 0;
+    mDroppedCount.store(0, std::memory_order_relaxed);
+    mIsDraining.store(false, std::memory_order_relaxed);
+
+    mDebuggerBatch = TinAllocArray(ALLOC_Log, char, k_MaxPacketSize);
+    mDebuggerBatchSize = kLogBatchHeaderSize;
+    mDebuggerBatchCount = 0;
+}
+
+// ====================================================================================================================
+// Destructor
+// ====================================================================================================================
+CScriptLog::~CScriptLog()
+{
+    TinFreeArray(mRecords);
+    TinFreeArray(mDebuggerBatch);
+}
+
+// ====================================================================================================================
+// EnableChannel():  Enable or disable logging on a single channel.
+// ====================================================================================================================
+void CScriptLog::EnableChannel(int32 channel, bool8 enable)
+{
+    if (channel < 0 || channel >= kLogMaxChannels)
+        return;
+
+    if (enable)
+        mChannelMask |= (1 << channel);
+    else
+        mChannelMask &= ~(1 << channel);
+}
+
+// ====================================================================================================================
+// Write():  Format a message into the next slot of the ring, to be delivered by Drain().
+// ====================================================================================================================
+void CScriptLog::Write(eLogSeverity severity, int32 channel, const char* fmt, va_list args)
+{
+    if (!fmt)
+        return;
+
+    // -- reserve a slot - the socket thread may also be writing, so the position is claimed atomically
+    tLogRecord* record = NULL;
+    uint32 position = mWritePosition.load(std::memory_order_relaxed);
+    while (true)
+    {
+        record = &mRecords[position & (kLogRingSize - 1)];
+        uint32 sequence = record->mSequence.load(std::memory_order_acquire);
+        int32 difference = (int32)(sequence - position);
+        if (difference == 0)
+        {
+            if (mWritePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                break;
+        }
+
+        // -- the ring is full - if this is the thread the log is drained by, drain it and try again
+        else if (difference < 0)
+        {
+            if (mDrainOnUpdate && GetContext() == mContextOwner && Drain() > 0)
+            {
+                position = mWritePosition.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            // -- otherwise, the message is dropped, rather than blocking
+            mDroppedCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        // -- another thread claimed the slot first
+        else
+            position = mWritePosition.load(std::memory_order_relaxed);
+    }
+
+    // -- the arguments may not outlive the call, so the message is formatted now, directly into the slot
+    int32 length = vsnprintf(record->mMessage, kLogMessageSize, fmt, args);
+    if (length < 0)
+        length = 0;
+    else if (length >= kLogMessageSize)
+        length = kLogMessageSize - 1;
+    record->mMessage[length] = '\0';
+
+    record->mSeverity = severity;
+    record->mChannel = channel;
+    record->mLength = length;
+
+    // -- publish the message
+    record->mSequence.store(position + 1, std::memory_order_release);
+}
+
+// ====================================================================================================================
+// Drain():  Deliver the queued messages, in order, to the print handler, and to the debugger.
+// ====================================================================================================================
+int32 CScriptLog::Drain()
+{
+    // -- only one thread drains at a time
+    if (mIsDraining.exchange(true, std::memory_order_acquire))
+        return (0);
+
+    TinPrintHandler print_handler = mContextOwner->GetPrintHandler();
+    bool8 forward = SocketManager::IsSubscribed(1 << DEBUGGER_CHANNEL_Print);
+
+    // -- stop at the first slot not yet published (including one still being written by another thread)
+    int32 count = 0;
+    while (true)
+    {
+        tLogRecord& record = mRecords[mReadPosition & (kLogRingSize - 1)];
+        if (record.mSequence.load(std::memory_order_acquire) != mReadPosition + 1)
+            break;
+
+        print_handler("%s", record.mMessage);
+        if (forward)
+            DebuggerForward(record);
+
+        // -- free the slot, for the next time around the ring
+        record.mSequence.store(mReadPosition + kLogRingSize, std::memory_order_release);
+        ++mReadPosition;
+        ++count;
+    }
+
+    // -- report any messages dropped since the last drain
+    uint32 dropped_count = mDroppedCount.exchange(0, std::memory_order_relaxed);
+    if (dropped_count > 0)
+        print_handler("Warning - the log was full, %u messages were dropped\n", dropped_count);
+
+    if (forward)
+        DebuggerFlush();
+
+    mIsDraining.store(false, std::memory_order_release);
+    return (count);
+}
+
+// ====================================================================================================================
+// DebuggerForward():  Add a drained message to the batch for the debugger, as a binary log message.
+// ====================================================================================================================
+void CScriptLog::DebuggerForward(tLogRecord& record)
+{
+    // -- the message is the ID, the severity, the channel, and the string length (including EOL, and 4-byte
+    // -- aligned), followed by the string
+    int32 msg_length = (record.mLength + 1 + 3) & ~3;
+    int32 size = 4 * sizeof(int32) + msg_length;
+    if (mDebuggerBatchSize + (int32)sizeof(int32) + size > k_MaxPacketSize)
+        DebuggerFlush();
+
+    // -- each message in the batch is preceeded by its size
+    int32* dataPtr = (int32*)&mDebuggerBatch[mDebuggerBatchSize];
+    *dataPtr++ = size;
+    *dataPtr++ = k_DebuggerLogMsgPacketID;
+    *dataPtr++ = record.mSeverity;
+    *dataPtr++ = record.mChannel;
+    *dataPtr++ = msg_length;
+
+    memset(dataPtr, 0, msg_length);
+    memcpy(dataPtr, record.mMessage, record.mLength);
+
+    mDebuggerBatchSize += (int32)sizeof(int32) + size;
+    ++mDebuggerBatchCount;
+}
+
+// ====================================================================================================================
+// DebuggerFlush():  Send the batch of log messages to the debugger clients subscribed to prints.
+// ====================================================================================================================
+void CScriptLog::DebuggerFlush()
+{
+    if (mDebuggerBatchCount == 0)
+        return;
+
+    // -- fill in the batch header
+    int32* dataPtr = (int32*)mDebuggerBatch;
+    *dataPtr++ = k_DebuggerBatchPacketID;
+    *dataPtr++ = mDebuggerBatchCount;
+
+    // -- sending copies the packet to the socket's send queues, so this is safe from any thread
+    SocketManager::tPacketHeader header(k_PacketVersion, SocketManager::tPacketHeader::DATA, mDebuggerBatchSize);
+    SocketManager::SendDataPacket(&header, mDebuggerBatch, 1 << DEBUGGER_CHANNEL_Print);
+
+    mDebuggerBatchSize = kLogBatchHeaderSize;
+    mDebuggerBatchCount = 0;
+}
+
+// == CScriptContext ==================================================================================================
+
+// ====================================================================================================================
+// Log():  Queue a message to the log - callers test IsLogEnabled() first, so disabled messages aren't formatted.
+// ====================================================================================================================
+void CScriptContext::Log(eLogSeverity severity, int32 channel, const char* fmt, ...)
+{
+    if (!mLog)
+        return;
+
+    va_list args;
+    va_start(args, fmt);
+    mLog->Write(severity, channel, fmt, args);
+    va_end(args);
+}
+
+// -- script interface ------------------------------------------------------------------------------------------------
+
+// ====================================================================================================================
+// LogMessage():  Log a message from script, with the given severity and channel.
+// ====================================================================================================================
+void LogMessage(int32 severity, int32 channel, const char* msg)
+{
+    CScriptContext* script_context = ::TinScript::GetContext();
+    if (!msg || severity < 0 || severity >= LOG_SEVERITY_COUNT || channel < 0 || channel >= kLogMaxChannels)
+        return;
+
+    TinLog(script_context, (eLogSeverity)severity, channel, "%s\n", msg);
+}
+
+// ====================================================================================================================
+// LogSetSeverity():  Set the minimum severity of the messages logged.
+// ====================================================================================================================
+void LogSetSeverity(int32 severity)
+{
+    CScriptContext* script_context = ::TinScript::GetContext();
+    if (severity < 0 || severity >= LOG_SEVERITY_COUNT)
+        return;
+
+    script_context->GetLog()->SetMinSeverity((eLogSeverity)severity);
+}
+
+// ====================================================================================================================
+// LogEnableChannel():  Enable or disable the messages logged on a channel.
+// ====================================================================================================================
+void LogEnableChannel(int32 channel, bool8 enable)
+{
+    CScriptContext* script_context = ::TinScript::GetContext();
+    script_context->GetLog()->EnableChannel(channel, enable);
+}
+
+} // TinScript
+
+// --------------------------------------------------------------------------------------------------------------------
+// -- script registered interface
+REGISTER_FUNCTION_P3(LogMessage, TinScript::LogMessage, void, int32, int32, const char*);
+REGISTER_FUNCTION_P1(LogSetSeverity, TinScript::LogSetSeverity, void, int32);
+REGISTER_FUNCTION_P2(LogEnableChannel, TinScript::LogEnableChannel, void, int32, bool8);
+
+// ====================================================================================================================
+// EOF
+// ====================================================================================================================
@@ -0,0 +1,149 @@
+// ------------------------------------------------------------------------------------------------
+//  The MIT License
+//
+//  Copyright (c) 2013 Tim Andersen
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+//  and associated documentation files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or
+//  substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// ------------------------------------------------------------------------------------------------
+
+// ====================================================================================================================
+// TinLog.h
+// ====================================================================================================================
+
+#ifndef __TINLOG_H
+#define __TINLOG_H
+
+// -- includes
+#include <atomic>
+
+#include "integration.h"
+
+// == namespace TinScript =============================================================================================
+
+namespace TinScript
+{
+
+// --------------------------------------------------------------------------------------------------------------------
+// -- log messages are filtered by severity (at or above the minimum) and by channel (a bit per channel)
+#define LogSeverityTuple                \
+    LogSeverityEntry(Debug)             \
+    LogSeverityEntry(Info)              \
+    LogSeverityEntry(Warning)           \
+    LogSeverityEntry(Error)             \
+
+enum eLogSeverity
+{
+    #define LogSeverityEntry(a) LOG_SEVERITY_##a,
+    LogSeverityTuple
+    #undef LogSeverityEntry
+
+    LOG_SEVERITY_COUNT
+};
+
+// -- channels after LOG_CHANNEL_COUNT (up to kLogMaxChannels) are free to be used by the application
+#define LogChannelTuple                                                         \
+    LogChannelEntry(System)     /* TinPrint(), messages from TinScript itself */    \
+    LogChannelEntry(Script)     /* Print(), and LogMessage() from scripts */        \
+
+enum eLogChannel
+{
+    #define LogChannelEntry(a) LOG_CHANNEL_##a,
+    LogChannelTuple
+    #undef LogChannelEntry
+
+    LOG_CHANNEL_COUNT
+};
+
+const int32 kLogMaxChannels = 32;
+const int32 kLogRingSize = 256;
+const int32 kLogMessageSize = 512;
+
+class CScriptContext;
+
+// ====================================================================================================================
+// class CScriptLog:  Queues log messages, to be delivered to the print handler and the debugger off the script thread.
+// The filter is tested before a message is formatted, so a disabled message only costs a compare.  Enabled messages
+// are formatted once, directly into a lock-free ring, and Drain() delivers them - from the context's Update(), or
+// from whichever thread the application chooses, if it disables draining on update.
+// ====================================================================================================================
+class CScriptLog
+{
+    public:
+        CScriptLog(CScriptContext* script_context = NULL);
+        virtual ~CScriptLog();
+
+        CScriptContext* GetScriptContext() { return (mContextOwner); }
+
+        bool8 IsEnabled(eLogSeverity severity, int32 channel) const
+        {
+            return (severity >= mMinSeverity && (mChannelMask & (1 << channel)) != 0);
+        }
+
+        eLogSeverity GetMinSeverity() const { return (mMinSeverity); }
+        void SetMinSeverity(eLogSeverity severity) { mMinSeverity = severity; }
+        uint32 GetChannelMask() const { return (mChannelMask); }
+        void SetChannelMask(uint32 channel_mask) { mChannelMask = channel_mask; }
+        void EnableChannel(int32 channel, bool8 enable);
+
+        // -- never blocks:  if the ring is full, the message is dropped (and counted), unless the caller is
+        // -- the context's own thread, and the log is drained on update, in which case the ring is drained first
+        void Write(eLogSeverity severity, int32 channel, const char* fmt, va_list args);
+
+        // -- only one thread drains at a time (a concurrent call returns 0), returns the number of messages
+        int32 Drain();
+
+        bool8 IsDrainOnUpdate() const { return (mDrainOnUpdate); }
+        void SetDrainOnUpdate(bool8 drain_on_update) { mDrainOnUpdate = drain_on_update; }
+
+    private:
+        // -- each slot's sequence is its ring position while free, and the position + 1 once written
+        struct tLogRecord
+        {
+            std::atomic<uint32> mSequence;
+            int32 mSeverity;
+            int32 mChannel;
+            int32 mLength;
+            char mMessage[kLogMessageSize];
+        };
+
+        void DebuggerForward(tLogRecord& record);
+        void DebuggerFlush();
+
+        CScriptContext* mContextOwner;
+
+        eLogSeverity mMinSeverity;
+        uint32 mChannelMask;
+        bool8 mDrainOnUpdate;
+
+        tLogRecord* mRecords;
+        std::atomic<uint32> mWritePosition;
+        uint32 mReadPosition;
+        std::atomic<uint32> mDroppedCount;
+        std::atomic<bool> mIsDraining;
+
+        // -- drained messages are forwarded to the debugger (binary, not reformatted), batched into packets
+        char* mDebuggerBatch;
+        int32 mDebuggerBatchSize;
+        int32 mDebuggerBatchCount;
+};
+
+} // TinScript
+
+#endif // __TINLOG_H
+
+// ====================================================================================================================
+// EOF
+// ====================================================================================================================
@@ -26,14 +26,17 @@
 // -- lib includes
 #include "stdafx.h"
 #include "stdio.h"
+#include "stdlib.h"
 
 // -- includes
 #include "TinNamespace.h"
 #include "TinParse.h"
 #include "TinScheduler.h"
+#include "TinSignal.h"
 #include "TinObjectGroup.h"
 #include "TinStringTable.h"
 #include "TinRegistration.h"
+#include "TinExecute.h"
 
 #include "registrationexecs.h"
 
@@ -46,6 +49,35 @@ namespace TinScript
 // -- statics
 CNamespaceReg* CNamespaceReg::head = NULL;
 
+// ====================================================================================================================
+// GetLifecycleHookHash():  Returns the method hash for a lifecycle hook.
+// ====================================================================================================================
+uint32 GetLifecycleHookHash(eLifecycleHook hook)
+{
+    static uint32 hook_hash[LIFECYCLE_COUNT] =
+    {
+        #define LifecycleHookEntry(a) Hash(#a),
+        LifecycleHookTuple
+        #undef LifecycleHookEntry
+    };
+
+    return (hook_hash[hook]);
+}
+
+// ====================================================================================================================
+// FindLifecycleHook():  Returns the lifecycle hook for a method hash, or LIFECYCLE_COUNT if it isn't one.
+// ====================================================================================================================
+eLifecycleHook FindLifecycleHook(uint32 method_hash)
+{
+    for (int32 hook = 0; hook < LIFECYCLE_COUNT; ++hook)
+    {
+        if (GetLifecycleHookHash((eLifecycleHook)hook) == method_hash)
+            return ((eLifecycleHook)hook);
+    }
+
+    return (LIFECYCLE_COUNT);
+}
+
 // == class CObjectEntry ==============================================================================================
 
 // ====================================================================================================================
@@ -63,6 +95,15 @@ CObjectEntry::CObjectEntry(CScriptContext* script_context, uint32 _objid, uint32
     mGroupOwner = NULL;
     mManualRegister = register_manual;
     mIsDestroyed = false;
+
+    mMembershipList = mMembershipInline;
+    mMembershipCount = 0;
+    mMembershipSize = kObjectMembershipInlineCount;
+
+    mSignalSubscriptionCount = 0;
+
+    mMemberVersion = 0;
+    mDebuggerEpoch = 0;
 }
 
 // ====================================================================================================================
@@ -82,6 +123,68 @@ CObjectEntry::~CObjectEntry()
         mDynamicVariables->DestroyAll();
         TinFree(mDynamicVariables);
     }
+
+    if (mMembershipList != mMembershipInline)
+        TinFreeArray(mMembershipList);
+}
+
+// ====================================================================================================================
+// GetMembership():  Returns the set at the given index, of the sets this object is a member of.
+// ====================================================================================================================
+CObjectSet* CObjectEntry::GetMembership(int32 index) const
+{
+    if (index < 0 || index >= mMembershipCount)
+        return (NULL);
+
+    return (mMembershipList[index]);
+}
+
+// ====================================================================================================================
+// AddMembership():  Records that this object has been added to a set.  Returns false if it was already a member.
+// ====================================================================================================================
+bool8 CObjectEntry::AddMembership(CObjectSet* object_set)
+{
+    for (int32 i = 0; i < mMembershipCount; ++i)
+    {
+        if (mMembershipList[i] == object_set)
+            return (false);
+    }
+
+    // -- grow the list if needed - the larger array is kept for the life of the object
+    if (mMembershipCount >= mMembershipSize)
+    {
+        int32 new_size = mMembershipSize * 2;
+        CObjectSet** new_list = TinAllocArray(ALLOC_ObjectGroup, CObjectSet*, new_size);
+        for (int32 i = 0; i < mMembershipCount; ++i)
+            new_list[i] = mMembershipList[i];
+
+        if (mMembershipList != mMembershipInline)
+            TinFreeArray(mMembershipList);
+        mMembershipList = new_list;
+        mMembershipSize = new_size;
+    }
+
+    mMembershipList[mMembershipCount++] = object_set;
+    return (true);
+}
+
+// ====================================================================================================================
+// RemoveMembership():  Records that this object has been removed from a set.  Returns false if it wasn't a member.
+// ====================================================================================================================
+bool8 CObjectEntry::RemoveMembership(CObjectSet* object_set)
+{
+    // -- search from the end, as the most recent membership is the most likely to be removed
+    for (int32 i = mMembershipCount - 1; i >= 0; --i)
+    {
+        if (mMembershipList[i] == object_set)
+        {
+            // -- order doesn't matter, so move the last entry into the gap
+            mMembershipList[i] = mMembershipList[--mMembershipCount];
+            return (true);
+        }
+    }
+
+    return (false);
 }
 
 // ====================================================================================================================
@@ -118,6 +221,14 @@ CVariableEntry* CObjectEntry::GetVariableEntry(uint32 varhash)
 // ====================================================================================================================
 CFunctionEntry* CObjectEntry::GetFunctionEntry(uint32 nshash, uint32 funchash)
 {
+    // -- lifecycle methods are already resolved and cached by the namespace
+    if (nshash == 0 && GetNamespace())
+    {
+        eLifecycleHook hook = FindLifecycleHook(funchash);
+        if (hook != LIFECYCLE_COUNT)
+            return (GetNamespace()->GetLifecycleMethod(hook));
+    }
+
     CFunctionEntry* fe = NULL;
     CNamespace* objns = GetNamespace();
     while (!fe && objns)
@@ -190,6 +301,73 @@ void CObjectEntry::CallFunctionHierarchy(uint32 function_hash, bool8 ascending)
     }
 }
 
+// ====================================================================================================================
+// CallLifecycleHook():  Execute a lifecycle method for the entire derived hierarchy of the given object.
+// Same as CallFunctionHierarchy(), but using the namespace's cached hooks, so no methods are looked up.
+// ====================================================================================================================
+void CObjectEntry::CallLifecycleHook(eLifecycleHook hook, bool8 ascending)
+{
+    // -- only create an exec stack if there's something to execute
+    const CNamespace::tLifecycleHook* hooks = NULL;
+    if (GetNamespace()->GetLifecycleHooks(hook, hooks) == 0)
+        return;
+
+    CMethodBroadcast hook_call(GetScriptContext(), GetLifecycleHookHash(hook));
+    CallLifecycleHook(hook, ascending, hook_call);
+}
+
+// ====================================================================================================================
+// CallLifecycleHook():  Execute a lifecycle method hierarchy, sharing the exec stack of the given hook call.
+// Used when calling the same hook for a batch of objects.
+// ====================================================================================================================
+void CObjectEntry::CallLifecycleHook(eLifecycleHook hook, bool8 ascending, CMethodBroadcast& hook_call)
+{
+    const CNamespace::tLifecycleHook* hooks = NULL;
+    int32 count = GetNamespace()->GetLifecycleHooks(hook, hooks);
+    if (count == 0)
+        return;
+
+    // -- a hook may define methods or link namespaces, rebuilding the table - so we call from a copy
+    const int32 kMaxHookCopy = 16;
+    if (count > kMaxHookCopy)
+    {
+        CallFunctionHierarchy(GetLifecycleHookHash(hook), ascending);
+        return;
+    }
+
+    CNamespace::tLifecycleHook hook_list[kMaxHookCopy];
+    for (int32 i = 0; i < count; ++i)
+        hook_list[i] = hooks[i];
+
+    // -- every level shares the same exec stack
+    CScriptContext* script_context = GetScriptContext();
+    uint32 version = script_context->GetMethodTableVersion();
+    for (int32 i = 0; i < count; ++i)
+    {
+        const CNamespace::tLifecycleHook& cur_hook = hook_list[ascending ? count - 1 - i : i];
+        CFunctionEntry* fe = cur_hook.mFunction;
+        int32 local_var_count = cur_hook.mLocalVarCount;
+
+        // -- if the methods changed during a previous call, the cached entries may be stale
+        if (version != script_context->GetMethodTableVersion())
+        {
+            fe = cur_hook.mNamespace->GetFuncTable()->FindItem(GetLifecycleHookHash(hook));
+            if (!fe)
+                continue;
+            local_var_count = fe->GetType() != eFuncTypeGlobal
+                              ? fe->GetContext()->CalculateLocalVarStackSize()
+                              : 0;
+        }
+
+        if (!hook_call.CallMethod(this, fe, local_var_count))
+        {
+            ScriptAssert_(script_context, 0, "<internal>", -1,
+                          "Error - [%d] Object method %s::%s() failed\n",
+                          GetID(), UnHash(cur_hook.mNamespace->GetHash()), UnHash(fe->GetHash()));
+        }
+    }
+}
+
 // ====================================================================================================================
 // HasNamespace():  Search the linked list to see if this object is "derived" from a given namespace.
 // ====================================================================================================================
@@ -238,6 +416,7 @@ bool8 CObjectEntry::AddDynamicVariable(uint32 varhash, eVarType vartype, int32 a
 	ve = TinAlloc(ALLOC_VarEntry, CVariableEntry, GetScriptContext(), UnHash(varhash), varhash,
                   vartype, array_size, false, 0, true);
 	mDynamicVariables->AddItem(*ve, varhash);
+    ++mMemberVersion;
 
     return (ve != NULL);
 }
@@ -442,114 +621,174 @@ uint32 CScriptContext::GetNextObjectID()
 // ====================================================================================================================
 uint32 CScriptContext::CreateObject(uint32 classhash, uint32 objnamehash)
 {
-    uint32 objectid = GetNextObjectID();
+    uint32 objectid = 0;
+    if (CreateObjects(classhash, objnamehash, 1, &objectid) != 1)
+        return (0);
 
-    // -- find the creation function
-    CNamespace* namespaceentry = GetNamespaceDictionary()->FindItem(classhash);
-    if (namespaceentry != NULL)
+    return (objectid);
+}
+
+// ====================================================================================================================
+// CreateObjects():  Create a batch of object instances of the same class and name, filling in their IDs.
+// The namespaces are resolved once, and the OnCreate() hierarchies are called in a single loop, sharing an exec stack.
+// Returns the number of objects created.
+// ====================================================================================================================
+int32 CScriptContext::CreateObjects(uint32 classhash, uint32 objnamehash, int32 count, uint32* object_ids)
+{
+    if (count <= 0 || !object_ids)
+        return (0);
+
+    CNamespace* class_namespace = NULL;
+    CNamespace* objnamens = NULL;
+    if (!ResolveCreateNamespaces(classhash, objnamehash, class_namespace, objnamens))
+        return (0);
+
+    // -- create the objects and their entries
+    CNamespace::CreateInstance funcptr = class_namespace->GetCreateInstance();
+    CObjectEntry* first_oe = NULL;
+    for (int32 i = 0; i < count; ++i)
     {
-        // -- loop down the hierarchy, until you find the actual registered class namespace
-        CNamespace* class_namespace = namespaceentry;
-        while (class_namespace && !class_namespace->IsRegisteredClass())
-            class_namespace = class_namespace->GetNext();
-
-        // -- if we get all the way down and don't find a registered class, assume the CScriptObject base class,
-        // -- and the hierarchy of linked namespaces will uncover any errors
-        if (!class_namespace)
+        uint32 objectid = GetNextObjectID();
+        void* newobj = (*funcptr)();
+        CObjectEntry* oe = AddObjectEntry(objectid, objnamehash, objnamens, newobj, false);
+        if (i == 0)
+            first_oe = oe;
+        object_ids[i] = objectid;
+    }
+
+    // -- "OnCreate" is the equivalent of a constructor - we want to call every OnCreate
+    // -- from the bottom of the hierarchy to the highest derivation for which it is defined
+    // -- NOTE:  it is not required to be defined for any level
+    if (count == 1)
+    {
+        first_oe->CallLifecycleHook(LIFECYCLE_OnCreate, true);
+    }
+    else
+    {
+        const CNamespace::tLifecycleHook* hooks = NULL;
+        if (objnamens->GetLifecycleHooks(LIFECYCLE_OnCreate, hooks) > 0)
         {
-            class_namespace = GetNamespaceDictionary()->FindItem(Hash("CScriptObject"));
-            if (class_namespace)
+            CMethodBroadcast hook_call(this, GetLifecycleHookHash(LIFECYCLE_OnCreate));
+            for (int32 i = 0; i < count; ++i)
             {
-                LinkNamespaces(namespaceentry, class_namespace);
-                TinPrint(this, "Warning - CreateObject():  Unable to find registered class %s.\n"
-                               "Linking to default base class CScriptObject\n", UnHash(classhash));
+                // -- an earlier OnCreate() may have already destroyed the object
+                CObjectEntry* oe = i == 0 ? first_oe : GetObjectDictionary()->FindItem(object_ids[i]);
+                if (oe && !oe->IsDestroyed())
+                    oe->CallLifecycleHook(LIFECYCLE_OnCreate, true, hook_call);
             }
         }
+    }
+
+    return (count);
+}
 
-        CNamespace::CreateInstance funcptr = class_namespace ? class_namespace->GetCreateInstance() : NULL;
-        if (funcptr == NULL)
+// ====================================================================================================================
+// ResolveCreateNamespaces():  Find the registered class to instantiate, and link the object name namespace to it.
+// ====================================================================================================================
+bool8 CScriptContext::ResolveCreateNamespaces(uint32 classhash, uint32 objnamehash, CNamespace*& class_namespace,
+                                              CNamespace*& objnamens)
+{
+    // -- find the creation function
+    CNamespace* namespaceentry = GetNamespaceDictionary()->FindItem(classhash);
+    if (!namespaceentry)
+    {
+        ScriptAssert_(this, 0, "<internal>", -1,
+                      "Error - Class is not registered: %s\n", UnHash(classhash));
+        return (false);
+    }
+
+    // -- loop down the hierarchy, until you find the actual registered class namespace
+    class_namespace = namespaceentry;
+    while (class_namespace && !class_namespace->IsRegisteredClass())
+        class_namespace = class_namespace->GetNext();
+
+    // -- if we get all the way down and don't find a registered class, assume the CScriptObject base class,
+    // -- and the hierarchy of linked namespaces will uncover any errors
+    if (!class_namespace)
+    {
+        class_namespace = GetNamespaceDictionary()->FindItem(Hash("CScriptObject"));
+        if (class_namespace)
         {
-            ScriptAssert_(this, 0, "<internal>", -1,
-                          "Error - Class is not registered: %s\n", UnHash(classhash));
-            return 0;
+            LinkNamespaces(namespaceentry, class_namespace);
+            TinPrintWarning(this, "Warning - CreateObject():  Unable to find registered class %s.\n"
+                                  "Linking to default base class CScriptObject\n", UnHash(classhash));
         }
+    }
 
-        // -- create the object
-        void* newobj = (*funcptr)();
+    CNamespace::CreateInstance funcptr = class_namespace ? class_namespace->GetCreateInstance() : NULL;
+    if (funcptr == NULL)
+    {
+        ScriptAssert_(this, 0, "<internal>", -1,
+                      "Error - Class is not registered: %s\n", UnHash(classhash));
+        return (false);
+    }
 
-        // -- see if we can hook this object up to the namespace for it's object name
-        CNamespace* objnamens = namespaceentry;
-        if (objnamehash != 0)
+    // -- see if we can hook this object up to the namespace for it's object name
+    objnamens = namespaceentry;
+    if (objnamehash != 0)
+    {
+        objnamens = GetNamespaceDictionary()->FindItem(objnamehash);
+        if (!objnamens)
+            objnamens = namespaceentry;
+        else
         {
-            objnamens = GetNamespaceDictionary()->FindItem(objnamehash);
-            if (!objnamens)
-                objnamens = namespaceentry;
-            else
-            {
-                // -- link the namespaces
-                LinkNamespaces(objnamens, namespaceentry);
-            }
+            // -- link the namespaces
+            LinkNamespaces(objnamens, namespaceentry);
         }
+    }
 
-        // -- need to verify that if we're using an objnamens (scripted), that the namespaceentry
-        // -- is the highest level registered class
-        if (objnamens != namespaceentry)
-        {
-            CNamespace* tempns = objnamens;
-            while (tempns && tempns->GetCreateInstance() == NULL)
-                tempns = tempns->GetNext();
+    // -- need to verify that if we're using an objnamens (scripted), that the namespaceentry
+    // -- is the highest level registered class
+    if (objnamens != namespaceentry)
+    {
+        CNamespace* tempns = objnamens;
+        while (tempns && tempns->GetCreateInstance() == NULL)
+            tempns = tempns->GetNext();
 
-            // -- if we run out of namespaces... how'd we create this object?
-            if (!tempns)
-            {
-                ScriptAssert_(this, 0, "<internal>", -1,
-                              "Error - Unable to verify hierarchy for namespace: %s\n",
-                              UnHash(objnamens->GetHash()));
-                // $$$TZA find a way to delete the newly created, but non-registered object
-                //delete newobj;
-                return 0;
-            }
-            else if (tempns != class_namespace)
-            {
-                ScriptAssert_(this, 0, "<internal>", -1,
-                              "Error - Unable to create an instance of base class: %s, using object namespace: %s.\n"
-                              "Use derived class: %s\n",
-                              UnHash(class_namespace->GetHash()), UnHash(objnamehash), UnHash(tempns->GetHash()));
-                // $$$TZA find a way to delete the newly created, but non-registered object
-                //delete newobj;
-                return 0;
-            }
+        // -- if we run out of namespaces... how'd we create this object?
+        if (!tempns)
+        {
+            ScriptAssert_(this, 0, "<internal>", -1,
+                          "Error - Unable to verify hierarchy for namespace: %s\n",
+                          UnHash(objnamens->GetHash()));
+            return (false);
+        }
+        else if (tempns != class_namespace)
+        {
+            ScriptAssert_(this, 0, "<internal>", -1,
+                          "Error - Unable to create an instance of base class: %s, using object namespace: %s.\n"
+                          "Use derived class: %s\n",
+                          UnHash(class_namespace->GetHash()), UnHash(objnamehash), UnHash(tempns->GetHash()));
+            return (false);
         }
+    }
 
-        // -- add this object to the dictionary of all objects created from script
-        CObjectEntry* newobjectentry = TinAlloc(ALLOC_ObjEntry, CObjectEntry, this,
-                                                objectid, objnamehash, objnamens, newobj, false);
-        GetObjectDictionary()->AddItem(*newobjectentry, objectid);
+    return (true);
+}
 
-        // -- add the object to the dictionary by address
-        GetAddressDictionary()->AddItem(*newobjectentry, kPointerToUInt32(newobj));
+// ====================================================================================================================
+// AddObjectEntry():  Create the entry for a new object, and add it to the object dictionaries.
+// ====================================================================================================================
+CObjectEntry* CScriptContext::AddObjectEntry(uint32 objectid, uint32 objnamehash, CNamespace* objnamens,
+                                             void* objaddr, bool8 register_manual)
+{
+    // -- add this object to the dictionary of all objects created from script
+    CObjectEntry* newobjectentry = TinAlloc(ALLOC_ObjEntry, CObjectEntry, this,
+                                            objectid, objnamehash, objnamens, objaddr, register_manual);
+    GetObjectDictionary()->AddItem(*newobjectentry, objectid);
 
-        // -- if the item is named, add it to the name dictionary
-        // $$$TZA Note:  names are not guaranteed unique...  warn?
-        if (objnamehash != Hash(""))
-            GetNameDictionary()->AddItem(*newobjectentry, objnamehash);
+    // -- add the object to the dictionary by address
+    GetAddressDictionary()->AddItem(*newobjectentry, kPointerToUInt32(objaddr));
 
-        // -- notify the debugger of the new object (before we call OnCreate(), as that may add the object to a set)
-        DebuggerNotifyCreateObject(newobjectentry);
+    // -- if the item is named, add it to the name dictionary
+    // $$$TZA Note:  names are not guaranteed unique...  warn?
+    if (objnamehash != 0)
+        GetNameDictionary()->AddItem(*newobjectentry, objnamehash);
 
-        // -- "OnCreate" is the equivalent of a constructor - we want to call every OnCreate
-        // -- from the bottom of the hierarchy to the highest derivation for which it is defined
-        // -- NOTE:  it is not required to be defined for any level
-        newobjectentry->CallFunctionHierarchy(Hash("OnCreate"), true);
+    // -- notify the debugger of the new object (before we call OnCreate(), as that may add the object to a set)
+    DebuggerNotifyCreateObject(newobjectentry);
 
-        return (objectid);
-    }
-    else
-    {
-        ScriptAssert_(this, 0, "<internal>", -1,
-                      "Error - Class is not registered: %s\n", UnHash(classhash));
-        return 0;
-    }
+    return (newobjectentry);
 }
 
 // ====================================================================================================================
@@ -585,26 +824,13 @@ uint32 CScriptContext::RegisterObject(void* objaddr, const char* classname, cons
         }
     }
 
-    // -- add this object to the dictionary of all objects created from script
-    CObjectEntry* newobjectentry = TinAlloc(ALLOC_ObjEntry, CObjectEntry, this,
-                                            objectid, objnamehash, objnamens, objaddr, true);
-    GetObjectDictionary()->AddItem(*newobjectentry, objectid);
-
-    // -- add the object to the dictionary by address
-    GetAddressDictionary()->AddItem(*newobjectentry, kPointerToUInt32(objaddr));
-
-    // -- if the item is named, add it to the name dictionary
-    if (objnamehash != Hash("")) {
-        GetNameDictionary()->AddItem(*newobjectentry, objnamehash);
-    }
-
-    // -- notify the debugger of the new object (before we call OnCreate(), as that may add the object to a set)
-    DebuggerNotifyCreateObject(newobjectentry);
+    // -- add the object to the dictionaries
+    CObjectEntry* newobjectentry = AddObjectEntry(objectid, objnamehash, objnamens, objaddr, true);
 
     // -- "OnCreate" is the equivalent of a constructor - we want to call every OnCreate
     // -- from the bottom of the hierarchy to the highest derivation for which it is defined
     // -- NOTE:  it is not required to be defined for any level
-    newobjectentry->CallFunctionHierarchy(Hash("OnCreate"), true);
+    newobjectentry->CallLifecycleHook(LIFECYCLE_OnCreate, true);
 
     return objectid;
 }
@@ -629,75 +855,144 @@ void CScriptContext::UnregisterObject(void* objaddr)
 // ====================================================================================================================
 void CScriptContext::DestroyObject(uint32 objectid)
 {
-    // -- find this object in the dictionary of all objects created from script
-    CObjectEntry* oe = GetObjectDictionary()->FindItem(objectid);
-    if (!oe)
-    {
-        ScriptAssert_(this, 0, "<internal>", -1,
-                      "Error - Unable to find object: %d\n", objectid);
-        return;
-    }
+    DestroyObjects(&objectid, 1);
+}
+
+// ====================================================================================================================
+// CompareObjectIDs():  qsort() comparison, to sort the object IDs of a batch.
+// ====================================================================================================================
+static int CompareObjectIDs(const void* a, const void* b)
+{
+    uint32 id_a = *(const uint32*)a;
+    uint32 id_b = *(const uint32*)b;
+    return (id_a < id_b ? -1 : (id_a > id_b ? 1 : 0));
+}
 
-    // -- guard against re-entrant destruction.
-    // -- Happens if ::Unregister() is called from code, causing "OnDestroy()" to be called,
-    // -- which may contain a call back to code which leads to the re-entrant ::Unregister()
-    if (oe->IsDestroyed())
+// ====================================================================================================================
+// DestroyObjects():  Destroy a batch of objects, calling their OnDestroy() methods, and deleting them.
+// Each step is done for the whole batch before the next, so the OnDestroy() hierarchies share an exec stack, and
+// pending schedules for every object are cancelled in a single pass.
+// ====================================================================================================================
+void CScriptContext::DestroyObjects(const uint32* object_ids, int32 count)
+{
+    if (!object_ids || count <= 0)
         return;
-    oe->SetDestroyed();
 
-    // -- notify the master membership list to remove it from all groups
-    GetMasterMembershipList()->OnDelete(oe);
+    // -- small batches (e.g. a single object) don't need to allocate
+    const int32 kLocalBatchSize = 16;
+    CObjectEntry* local_list[kLocalBatchSize];
+    CObjectEntry** oe_list = count <= kLocalBatchSize ? local_list
+                                                      : TinAllocArray(ALLOC_ObjEntry, CObjectEntry*, count);
 
-    // -- get the namespace entry for the object
-    CNamespace* namespaceentry = oe->GetNamespace();
-    if (!namespaceentry)
+    // -- find and validate each object
+    int32 destroy_count = 0;
+    for (int32 i = 0; i < count; ++i)
     {
-        ScriptAssert_(this, 0, "<internal>", -1,
-                      "Error - Unable to find the namespace for object: %d\n", objectid);
-        return;
+        // -- find this object in the dictionary of all objects created from script
+        CObjectEntry* oe = GetObjectDictionary()->FindItem(object_ids[i]);
+        if (!oe)
+        {
+            ScriptAssert_(this, 0, "<internal>", -1,
+                          "Error - Unable to find object: %d\n", object_ids[i]);
+            continue;
+        }
+
+        // -- guard against re-entrant destruction.
+        // -- Happens if ::Unregister() is called from code, causing "OnDestroy()" to be called,
+        // -- which may contain a call back to code which leads to the re-entrant ::Unregister()
+        if (oe->IsDestroyed())
+            continue;
+
+        // -- get the namespace entry for the object, and ensure it has a Destroy function
+        CNamespace* namespaceentry = oe->GetNamespace();
+        if (!namespaceentry)
+        {
+            ScriptAssert_(this, 0, "<internal>", -1,
+                          "Error - Unable to find the namespace for object: %d\n", object_ids[i]);
+            continue;
+        }
+
+        if (namespaceentry->GetDestroyInstance() == NULL)
+        {
+            ScriptAssert_(this, 0, "<internal>", -1,
+                          "Error - no Destroy() function registered for class: %s\n",
+                          UnHash(namespaceentry->GetHash()));
+            continue;
+        }
+
+        // -- marking every object in the batch first also guards against re-entrant destruction
+        oe->SetDestroyed();
+        oe_list[destroy_count++] = oe;
     }
 
-    // -- get the Destroy function
-    CNamespace::DestroyInstance destroyptr = namespaceentry->GetDestroyInstance();
-    if (destroyptr == NULL)
+    // -- notify the master membership list to remove them from all groups, and remove any signal subscriptions
+    for (int32 i = 0; i < destroy_count; ++i)
     {
-        ScriptAssert_(this, 0, "<internal>", -1,
-                      "Error - no Destroy() function registered for class: %s\n",
-                      UnHash(namespaceentry->GetHash()));
-        return;
+        GetMasterMembershipList()->OnDelete(oe_list[i]);
+        GetSignalManager()->OnDelete(oe_list[i]);
     }
 
     // -- "OnDestroy" is the equivalent of a destructor - we want to call every OnDestroy
     // -- from the top of the hierarchy through to the root base implementation
     // -- NOTE:  it is not required to be defined for any level
-    oe->CallFunctionHierarchy(Hash("OnDestroy"), false);
+    if (destroy_count == 1)
+    {
+        oe_list[0]->CallLifecycleHook(LIFECYCLE_OnDestroy, false);
+    }
+    else if (destroy_count > 1)
+    {
+        CMethodBroadcast hook_call(this, GetLifecycleHookHash(LIFECYCLE_OnDestroy));
+        for (int32 i = 0; i < destroy_count; ++i)
+            oe_list[i]->CallLifecycleHook(LIFECYCLE_OnDestroy, false, hook_call);
+    }
 
-    // -- get the address of the object
-    void* objaddr = oe->GetAddr();
-    if (!objaddr)
+    // -- cancel all pending schedules related to these objects
+    if (destroy_count == 1)
     {
-        ScriptAssert_(this, 0, "<internal>", -1,
-                      "Error - no address for object: %d\n", objectid);
-        return;
+        GetScheduler()->CancelObject(oe_list[0]->GetID());
     }
+    else if (destroy_count > 1)
+    {
+        uint32* sorted_ids = TinAllocArray(ALLOC_ObjEntry, uint32, destroy_count);
+        for (int32 i = 0; i < destroy_count; ++i)
+            sorted_ids[i] = oe_list[i]->GetID();
+        qsort(sorted_ids, destroy_count, sizeof(uint32), CompareObjectIDs);
+        GetScheduler()->CancelObjects(sorted_ids, destroy_count);
+        TinFreeArray(sorted_ids);
+    }
+
+    for (int32 i = 0; i < destroy_count; ++i)
+    {
+        CObjectEntry* oe = oe_list[i];
+        uint32 objectid = oe->GetID();
+
+        // -- get the address of the object
+        void* objaddr = oe->GetAddr();
+        if (!objaddr)
+        {
+            ScriptAssert_(this, 0, "<internal>", -1,
+                          "Error - no address for object: %d\n", objectid);
+            continue;
+        }
 
-    // -- cancel all pending schedules related to this object
-    GetScheduler()->CancelObject(objectid);
+        // -- if the object was not registered externally, delete the actual object
+        if (!oe->IsManuallyRegistered())
+            (*oe->GetNamespace()->GetDestroyInstance())(objaddr);
 
-    // -- if the object was not registered externally, delete the actual object
-    if (!oe->IsManuallyRegistered())
-        (*destroyptr)(objaddr);
+        // -- notify the debugger, after the destructor has had a chance to send "RemoveFromSet" notifications
+        DebuggerNotifyDestroyObject(objectid);
 
-    // -- notify the debugger, after the destructor has had a chance to send "RemoveFromSet" notifications
-    DebuggerNotifyDestroyObject(objectid);
+        // -- remove the object from the dictionary, and delete the entry
+        GetObjectDictionary()->RemoveItem(objectid);
+        GetAddressDictionary()->RemoveItem(kPointerToUInt32(objaddr));
+        GetNameDictionary()->RemoveItem(oe, oe->GetNameHash());
 
-    // -- remove the object from the dictionary, and delete the entry
-    GetObjectDictionary()->RemoveItem(objectid);
-    GetAddressDictionary()->RemoveItem(kPointerToUInt32(objaddr));
-    GetNameDictionary()->RemoveItem(oe, oe->GetNameHash());
+        // -- delete the object entry *after* the object
+        TinFree(oe);
+    }
 
-    // -- delete the object entry *after* the object
-    TinFree(oe);
+    if (oe_list != local_list)
+        TinFreeArray(oe_list);
 }
 
 // ====================================================================================================================
@@ -1394,6 +1689,12 @@ CNamespace::CNamespace(CScriptContext* script_context, const char* _name, uint32
     mDestroyFuncptr = _destroyinstance;
     mMemberTable = TinAlloc(ALLOC_VarTable, tVarTable, kLocalVarTableSize);
     mMethodTable = TinAlloc(ALLOC_FuncTable, tFuncTable, kLocalFuncTableSize);
+
+    mLifecycleVersion = 0;
+    mLifecycleHooks = NULL;
+    mLifecycleHookSize = 0;
+    for (int32 i = 0; i <= LIFECYCLE_COUNT; ++i)
+        mLifecycleHookStart[i] = 0;
 }
 
 // ====================================================================================================================
@@ -1405,6 +1706,84 @@ CNamespace::~CNamespace()
     TinFree(mMemberTable);
     mMethodTable->DestroyAll();
     TinFree(mMethodTable);
+
+    if (mLifecycleHooks)
+        TinFreeArray(mLifecycleHooks);
+}
+
+// ====================================================================================================================
+// SetNext():  Link this namespace to its parent - any cached lifecycle hooks are now stale.
+// ====================================================================================================================
+void CNamespace::SetNext(CNamespace* _next)
+{
+    mNext = _next;
+    mContextOwner->NotifyMethodTableChanged();
+}
+
+// ====================================================================================================================
+// GetLifecycleHooks():  Returns the number of implementations of the hook, ordered from this namespace to the root.
+// ====================================================================================================================
+int32 CNamespace::GetLifecycleHooks(eLifecycleHook hook, const tLifecycleHook*& hooks)
+{
+    if (mLifecycleVersion != mContextOwner->GetMethodTableVersion())
+        BuildLifecycleHooks();
+
+    hooks = mLifecycleHooks ? &mLifecycleHooks[mLifecycleHookStart[hook]] : NULL;
+    return (mLifecycleHookStart[hook + 1] - mLifecycleHookStart[hook]);
+}
+
+// ====================================================================================================================
+// GetLifecycleMethod():  Returns the most derived implementation of the hook, the same as a virtual method call.
+// ====================================================================================================================
+CFunctionEntry* CNamespace::GetLifecycleMethod(eLifecycleHook hook)
+{
+    const tLifecycleHook* hooks = NULL;
+    int32 count = GetLifecycleHooks(hook, hooks);
+    return (count > 0 ? hooks[0].mFunction : NULL);
+}
+
+// ====================================================================================================================
+// BuildLifecycleHooks():  Resolve each lifecycle hook through the hierarchy, into a single ordered table.
+// ====================================================================================================================
+void CNamespace::BuildLifecycleHooks()
+{
+    mLifecycleVersion = mContextOwner->GetMethodTableVersion();
+
+    // -- size the table for the worst case, every namespace implementing every hook
+    int32 depth = 0;
+    for (CNamespace* ns = this; ns; ns = ns->GetNext())
+        ++depth;
+
+    int32 required_size = depth * LIFECYCLE_COUNT;
+    if (required_size > mLifecycleHookSize)
+    {
+        if (mLifecycleHooks)
+            TinFreeArray(mLifecycleHooks);
+        mLifecycleHooks = TinAllocArray(ALLOC_FuncTable, tLifecycleHook, required_size);
+        mLifecycleHookSize = required_size;
+    }
+
+    int32 count = 0;
+    for (int32 hook = 0; hook < LIFECYCLE_COUNT; ++hook)
+    {
+        mLifecycleHookStart[hook] = count;
+        uint32 hook_hash = GetLifecycleHookHash((eLifecycleHook)hook);
+        for (CNamespace* ns = this; ns; ns = ns->GetNext())
+        {
+            CFunctionEntry* fe = ns->GetFuncTable()->FindItem(hook_hash);
+            if (!fe)
+                continue;
+
+            tLifecycleHook& entry = mLifecycleHooks[count++];
+            entry.mNamespace = ns;
+            entry.mFunction = fe;
+            entry.mLocalVarCount = fe->GetType() != eFuncTypeGlobal
+                                   ? fe->GetContext()->CalculateLocalVarStackSize()
+                                   : 0;
+        }
+    }
+
+    mLifecycleHookStart[LIFECYCLE_COUNT] = count;
 }
 
 // ====================================================================================================================
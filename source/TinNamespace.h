@@ -96,11 +96,36 @@ class CVariableEntry;
 class CFunctionEntry;
 class CNamespace;
 class CNamespaceReg;
+class CObjectSet;
 class CObjectGroup;
+class CMethodBroadcast;
 
 typedef CHashTable<CVariableEntry> tVarTable;
 typedef CHashTable<CFunctionEntry> tFuncTable;
 
+// ====================================================================================================================
+// -- lifecycle hooks are the methods called on objects by the system - their resolution is cached per namespace
+#define LifecycleHookTuple                  \
+    LifecycleHookEntry(OnCreate)            \
+    LifecycleHookEntry(OnDestroy)           \
+    LifecycleHookEntry(OnInit)              \
+    LifecycleHookEntry(OnUpdate)            \
+
+enum eLifecycleHook
+{
+    #define LifecycleHookEntry(a) LIFECYCLE_##a,
+    LifecycleHookTuple
+    #undef LifecycleHookEntry
+
+    LIFECYCLE_COUNT
+};
+
+uint32 GetLifecycleHookHash(eLifecycleHook hook);
+eLifecycleHook FindLifecycleHook(uint32 method_hash);
+
+// -- number of set memberships an object entry can track before allocating
+const int32 kObjectMembershipInlineCount = 4;
+
 // ====================================================================================================================
 // class CObjectEntry:  Refers to an instance of an object, retrievable by name or hash, etc...
 // ====================================================================================================================
@@ -130,15 +155,34 @@ class CObjectEntry
 
         bool8 IsManuallyRegistered() { return (mManualRegister); }
 
+        // -- the sets this object is a member of - see CMasterMembershipList
+        int32 GetMembershipCount() const { return (mMembershipCount); }
+        CObjectSet* GetMembership(int32 index) const;
+        bool8 AddMembership(CObjectSet* object_set);
+        bool8 RemoveMembership(CObjectSet* object_set);
+
+        // -- the number of signals this object is subscribed to - see CSignalManager
+        int32 GetSignalSubscriptionCount() const { return (mSignalSubscriptionCount); }
+        void AdjustSignalSubscriptionCount(int32 delta) { mSignalSubscriptionCount += delta; }
+
         CVariableEntry* GetVariableEntry(uint32 varhash);
         CFunctionEntry* GetFunctionEntry(uint32 nshash, uint32 funchash);
         void CallFunctionHierarchy(uint32 function_hash, bool8 ascending);
+        void CallLifecycleHook(eLifecycleHook hook, bool8 ascending);
+        void CallLifecycleHook(eLifecycleHook hook, bool8 ascending, CMethodBroadcast& hook_call);
         CNamespace* HasNamespace(uint32 nshash);
 
         bool8 AddDynamicVariable(uint32 varhash, eVarType vartype, int32 array_size = 1);
         bool8 SetMemberVar(uint32 varhash, void* value);
         tVarTable* GetDynamicVarTable() { return (mDynamicVariables); }
 
+        // -- the member version changes whenever a member is added, so the debugger knows to re-send the layout
+        uint32 GetMemberVersion() const { return (mMemberVersion); }
+
+        // -- the debugger's object epoch in which this object was last sent to the object browser
+        uint32 GetDebuggerEpoch() const { return (mDebuggerEpoch); }
+        void SetDebuggerEpoch(uint32 epoch) { mDebuggerEpoch = epoch; }
+
     private:
         CScriptContext* mContextOwner;
 
@@ -150,6 +194,18 @@ class CObjectEntry
         bool8 mManualRegister;
         bool8 mIsDestroyed;
         CHashTable<CVariableEntry>* mDynamicVariables;
+
+        // -- most objects belong to only a few sets, so the membership list starts inline,
+        // -- and only moves to an allocated array (which is kept) if it outgrows it
+        CObjectSet* mMembershipInline[kObjectMembershipInlineCount];
+        CObjectSet** mMembershipList;
+        int32 mMembershipCount;
+        int32 mMembershipSize;
+
+        int32 mSignalSubscriptionCount;
+
+        uint32 mMemberVersion;
+        uint32 mDebuggerEpoch;
 };
 
 // ====================================================================================================================
@@ -179,7 +235,7 @@ class CNamespace
         }
 
         CNamespace* GetNext() const { return (mNext); }
-        void SetNext(CNamespace* _next) { mNext = _next; }
+        void SetNext(CNamespace* _next);
 
         CreateInstance GetCreateInstance() const { return (mCreateFuncptr); }
 
@@ -200,9 +256,22 @@ class CNamespace
         tVarTable* GetVarTable() { return (mMemberTable); }
         tFuncTable* GetFuncTable() { return (mMethodTable); }
 
+        // -- each implementation of a lifecycle hook in the hierarchy, ordered from this namespace to the root
+        struct tLifecycleHook
+        {
+            CNamespace* mNamespace;
+            CFunctionEntry* mFunction;
+            int32 mLocalVarCount;
+        };
+
+        int32 GetLifecycleHooks(eLifecycleHook hook, const tLifecycleHook*& hooks);
+        CFunctionEntry* GetLifecycleMethod(eLifecycleHook hook);
+
     private:
         CNamespace() { }
 
+        void BuildLifecycleHooks();
+
         CScriptContext* mContextOwner;
 
         const char* mName;
@@ -215,6 +284,12 @@ class CNamespace
 
         tVarTable* mMemberTable;
         tFuncTable* mMethodTable;
+
+        // -- the hook table is rebuilt when the context's method table version changes
+        uint32 mLifecycleVersion;
+        tLifecycleHook* mLifecycleHooks;
+        int32 mLifecycleHookSize;
+        int32 mLifecycleHookStart[LIFECYCLE_COUNT + 1];
 };
 
 // ====================================================================================================================
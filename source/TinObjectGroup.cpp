@@ -30,6 +30,7 @@
 
 #include "TinScript.h"
 #include "TinRegistration.h"
+#include "TinExecute.h"
 #include "TinObjectGroup.h"
 
 // == namespace TinScript =============================================================================================
@@ -42,12 +43,10 @@ namespace TinScript
 // ====================================================================================================================
 // Constructor
 // ====================================================================================================================
-CMasterMembershipList::CMasterMembershipList(CScriptContext* script_context, int _size)
+CMasterMembershipList::CMasterMembershipList(CScriptContext* script_context)
 {
-    assert(script_context != NULL && _size > 0);
+    assert(script_context != NULL);
     mContextOwner = script_context;
-
-    mMasterMembershipList = TinAlloc(ALLOC_ObjectGroup, CHashTable<tMembershipList>, _size);
 }
 
 // ====================================================================================================================
@@ -55,11 +54,6 @@ CMasterMembershipList::CMasterMembershipList(CScriptContext* script_context, int
 // ====================================================================================================================
 CMasterMembershipList::~CMasterMembershipList()
 {
-    if (mMasterMembershipList)
-    {
-        mMasterMembershipList->DestroyAll();
-        TinFree(mMasterMembershipList);
-    }
 }
 
 // ====================================================================================================================
@@ -71,23 +65,17 @@ void CMasterMembershipList::AddMembership(CObjectEntry* oe, CObjectSet* group)
     if (!oe || !group)
         return;
 
-    uint32 group_id = GetScriptContext()->FindIDByAddress(group);
-    uint32 object_id = oe->GetID();
+    // -- the object entry tracks its own memberships, and ensures we don't add this group twice
+    oe->AddMembership(group);
 
-    // -- get the member list for the specific object, and add this group to it
-    tMembershipList* member_list = mMasterMembershipList->FindItem(object_id);
-    if (!member_list)
+    // -- notify the debugger of the new membership
+    // -- (looking up the group ID is only worth doing if there's a debugger to tell)
+    int32 debugger_session = 0;
+    if (GetScriptContext()->IsDebuggerConnected(debugger_session))
     {
-        member_list = TinAlloc(ALLOC_ObjectGroup, tMembershipList, kObjectGroupTableSize);
-        mMasterMembershipList->AddItem(*member_list, object_id);
+        uint32 group_id = GetScriptContext()->FindIDByAddress(group);
+        GetScriptContext()->DebuggerNotifySetAddObject(group_id, oe->GetID(), (oe->GetGroupID() == group_id));
     }
-
-    // -- ensure we don't add this group twice
-    if (!member_list->FindItem(group_id))
-        member_list->AddItem(*group, group_id);
-
-    // -- notify the debugger of the discontinued membership
-    GetScriptContext()->DebuggerNotifySetAddObject(group_id, object_id, (oe->GetGroupID() == group_id));
 }
 
 // ====================================================================================================================
@@ -99,33 +87,20 @@ void CMasterMembershipList::RemoveMembership(CObjectEntry* oe, CObjectSet* group
     if (!oe || !group)
         return;
 
-    uint32 group_id = GetScriptContext()->FindIDByAddress(group);
-    uint32 object_id = oe->GetID();
-
-    // -- get the member list for the specific object, and add this group to it
-    tMembershipList* member_list = mMasterMembershipList->FindItem(object_id);
-    if (!member_list)
+    if (!oe->RemoveMembership(group))
     {
         ScriptAssert_(GetScriptContext(), 0, "<internal>", -1,
-                      "Error - RemoveMembership() - no membership list for object %d\n", object_id);
+                      "Error - RemoveMembership() - object %d is not a member of the set\n", oe->GetID());
         return;
     }
 
-    // -- ensure the object is actually in the group
-    if (member_list->FindItem(group_id))
+    // -- notify the debugger of the discontinued membership
+    int32 debugger_session = 0;
+    if (GetScriptContext()->IsDebuggerConnected(debugger_session))
     {
-        member_list->RemoveItem(group_id);
-
-        // -- if this is the last group the object is a member of, we can delete the group
-        if (member_list->Used() == 0)
-        {
-            mMasterMembershipList->RemoveItem(object_id);
-            TinFree(member_list);
-        }
+        uint32 group_id = GetScriptContext()->FindIDByAddress(group);
+        GetScriptContext()->DebuggerNotifySetRemoveObject(group_id, oe->GetID());
     }
-
-    // -- notify the debugger of the discontinued membership
-    GetScriptContext()->DebuggerNotifySetRemoveObject(group_id, object_id);
 }
 
 // ====================================================================================================================
@@ -137,32 +112,23 @@ void CMasterMembershipList::OnDelete(CObjectEntry* oe)
     if (!oe)
         return;
 
+    // -- remove the object from each set it belongs to, starting with the most recent
     uint32 objectid = oe->GetID();
-    // -- see if this object belongs to any groups
-    tMembershipList* member_list = mMasterMembershipList->FindItem(oe->GetID());
-    if (member_list)
+    int32 cur_count = oe->GetMembershipCount();
+    while (cur_count > 0)
     {
-        int32 cur_count = member_list->Used();
-        while (cur_count > 1)
-        {
-            CObjectSet* group = member_list->First();
-            group->RemoveObject(objectid);
+        CObjectSet* group = oe->GetMembership(cur_count - 1);
+        group->RemoveObject(objectid);
 
-            // -- ensure our count actually went down
-            int32 new_count = member_list->Used();
-            if (new_count != (cur_count - 1))
-            {
-                //Assert_(false, "Error - CMasterMembershipList::OnDelete() failed to remove object");
-                Assert_(false);
-            }
-            cur_count = new_count;
+        // -- ensure our count actually went down
+        int32 new_count = oe->GetMembershipCount();
+        if (new_count >= cur_count)
+        {
+            //Assert_(false, "Error - CMasterMembershipList::OnDelete() failed to remove object");
+            Assert_(false);
+            break;
         }
-
-        // -- delete the last membership entry separately since empty lists
-        // -- auto-delete themselves
-        CObjectSet* group = member_list->First();
-        if (group)
-            group->RemoveObject(objectid);
+        cur_count = new_count;
     }
 }
 
@@ -174,7 +140,19 @@ void CMasterMembershipList::OnDelete(CObjectEntry* oe)
 CObjectSet::CObjectSet()
 {
     mContextOwner = TinScript::GetContext();
-    mObjectList = TinAlloc(ALLOC_ObjectGroup, CHashTable<CObjectEntry>, kObjectGroupTableSize);
+    mMemberTable = TinAlloc(ALLOC_ObjectGroup, CHashTable<tSetMember>, kObjectGroupTableSize);
+
+    // -- sets are often filled and emptied every frame - reuse the table entries
+    mMemberTable->SetRecycleEntries(true);
+
+    mMemberArray = NULL;
+    mMemberCount = 0;
+    mMemberArraySize = 0;
+    mFreeMembers = NULL;
+
+    mDefaultIterator.mNextIndex = 0;
+    mIteratorList = TinAlloc(ALLOC_ObjectGroup, CHashTable<tSetIterator>, kObjectSetIteratorTableSize);
+    mNextIteratorID = 0;
 }
 
 // ====================================================================================================================
@@ -184,7 +162,30 @@ CObjectSet::~CObjectSet()
 {
     // -- use RemoveAll(), as it will call OnRemove cleanly
     RemoveAll();
-    TinFree(mObjectList);
+    TinFree(mMemberTable);
+
+    if (mMemberArray)
+        TinFreeArray(mMemberArray);
+
+    while (mFreeMembers)
+    {
+        tSetMember* next_free = mFreeMembers->mNextFree;
+        TinFree(mFreeMembers);
+        mFreeMembers = next_free;
+    }
+
+    // -- any iterators still outstanding belong to the set
+    mIteratorList->DestroyAll();
+    TinFree(mIteratorList);
+}
+
+// ====================================================================================================================
+// GetSelfID():  Returns the ID of this set, or 0 if it was constructed natively, and never registered.
+// ====================================================================================================================
+uint32 CObjectSet::GetSelfID()
+{
+    CObjectEntry* self_oe = GetScriptContext()->FindObjectByAddress(this);
+    return (self_oe ? self_oe->GetID() : 0);
 }
 
 // ====================================================================================================================
@@ -192,7 +193,7 @@ CObjectSet::~CObjectSet()
 // ====================================================================================================================
 bool8 CObjectSet::Contains(uint32 objectid)
 {
-    bool8 result = mObjectList->FindItem(objectid) != NULL;
+    bool8 result = mMemberTable->FindItem(objectid) != NULL;
     return (result);
 }
 
@@ -202,8 +203,8 @@ bool8 CObjectSet::Contains(uint32 objectid)
 bool8 CObjectSet::IsInHierarchy(uint32 objectid)
 {
     // -- if the given objectid is ourself, it's "in the hierarchy"
-    uint32 self_id = GetScriptContext()->FindObjectByAddress(this)->GetID();
-    if (self_id == objectid)
+    uint32 self_id = GetSelfID();
+    if (self_id != 0 && self_id == objectid)
     {
         return (true);
     }
@@ -215,9 +216,9 @@ bool8 CObjectSet::IsInHierarchy(uint32 objectid)
     }
 
     // -- loop through the child list - if any of them are sets, see if the object is contained within their hierarchy
-    CObjectEntry* child_oe = mObjectList->First();
-    while (child_oe)
+    for (int32 i = 0; i < mMemberCount; ++i)
     {
+        CObjectEntry* child_oe = mMemberArray[i]->mObjectEntry;
         static uint32 object_set_hash = Hash("CObjectSet");
         if (child_oe->HasNamespace(object_set_hash))
         {
@@ -227,9 +228,6 @@ bool8 CObjectSet::IsInHierarchy(uint32 objectid)
                 return (true);
             }
         }
-
-        // -- next child
-        child_oe = mObjectList->Next();
     }
 
     // -- the object is not in the hierarchy
@@ -242,7 +240,7 @@ bool8 CObjectSet::IsInHierarchy(uint32 objectid)
 void CObjectSet::AddObject(uint32 objectid)
 {
     // -- find the object entry
-    uint32 self_id = GetScriptContext()->FindObjectByAddress(this)->GetID();
+    uint32 self_id = GetSelfID();
     CObjectEntry* oe = GetScriptContext()->FindObjectEntry(objectid);
     if (!oe)
     {
@@ -253,8 +251,9 @@ void CObjectSet::AddObject(uint32 objectid)
     }
 
     // -- ensure we don't create a circular ownership
+    // -- (a set that was never registered can't be added to another set, so it can't be part of a cycle)
     static uint32 object_set_hash = Hash("CObjectSet");
-    if (oe->HasNamespace(object_set_hash))
+    if (self_id != 0 && oe->HasNamespace(object_set_hash))
     {
         CObjectSet* object_set = static_cast<CObjectSet*>(GetScriptContext()->FindObject(objectid));
         if (object_set->IsInHierarchy(self_id))
@@ -266,9 +265,9 @@ void CObjectSet::AddObject(uint32 objectid)
         }
     }
 
-    if (!mObjectList->FindItem(objectid))
+    if (!mMemberTable->FindItem(objectid))
     {
-        mObjectList->AddItem(*oe, objectid);
+        InsertMember(AllocMember(oe), mMemberCount);
 
         // -- notify the master membership list that an object has been added to a group
         GetScriptContext()->GetMasterMembershipList()->AddMembership(oe, this);
@@ -283,12 +282,13 @@ void CObjectSet::AddObject(uint32 objectid)
 }
 
 // ====================================================================================================================
-// InsertObject():  Add an object to this object set.
+// InsertObject():  Add an object to this object set, at the given index.
+// Inserting anywhere but the end shifts the objects after it, so unlike AddObject(), this is O(Used()).
 // ====================================================================================================================
 void CObjectSet::InsertObject(uint32 objectid, int32 index)
 {
     // -- find the object entry
-    uint32 self_id = GetScriptContext()->FindObjectByAddress(this)->GetID();
+    uint32 self_id = GetSelfID();
     CObjectEntry* oe = GetScriptContext()->FindObjectEntry(objectid);
     if (!oe)
     {
@@ -299,8 +299,9 @@ void CObjectSet::InsertObject(uint32 objectid, int32 index)
     }
 
     // -- ensure we don't create a circular ownership
+    // -- (a set that was never registered can't be added to another set, so it can't be part of a cycle)
     static uint32 object_set_hash = Hash("CObjectSet");
-    if (oe->HasNamespace(object_set_hash))
+    if (self_id != 0 && oe->HasNamespace(object_set_hash))
     {
         CObjectSet* object_set = static_cast<CObjectSet*>(GetScriptContext()->FindObject(objectid));
         if (object_set->IsInHierarchy(self_id))
@@ -312,9 +313,15 @@ void CObjectSet::InsertObject(uint32 objectid, int32 index)
         }
     }
 
-    if (!mObjectList->FindItem(objectid))
+    if (!mMemberTable->FindItem(objectid))
     {
-        mObjectList->InsertItem(*oe, objectid, index);
+        // -- any index past the end simply appends
+        if (index < 0)
+            index = 0;
+        else if (index > mMemberCount)
+            index = mMemberCount;
+
+        InsertMember(AllocMember(oe), index);
 
         // -- notify the master membership list that an object has been added to a group
         GetScriptContext()->GetMasterMembershipList()->AddMembership(oe, this);
@@ -339,18 +346,19 @@ void CObjectSet::RemoveObject(uint32 objectid)
     {
         ScriptAssert_(GetScriptContext(), 0, "<internal>", -1,
                       "Error - [%d] CObjectSet::RemoveObject(): unable to find object %d\n",
-                      GetScriptContext()->FindObjectByAddress(this)->GetID(), objectid);
+                      GetSelfID(), objectid);
         return;
     }
 
-    if (mObjectList->FindItem(objectid))
+    tSetMember* member = mMemberTable->FindItem(objectid);
+    if (member)
     {
-        mObjectList->RemoveItem(objectid);
+        RemoveMember(member);
 
-        // -- notify the master membership list that an object has been added to a group
+        // -- notify the master membership list that an object has been removed from a group
         GetScriptContext()->GetMasterMembershipList()->RemoveMembership(oe, this);
 
-        // -- automatically call "OnAdd" for the group
+        // -- automatically call "OnRemove" for the group
         if (GetScriptContext()->HasMethod(this, "OnRemove"))
         {
             int32 dummy = 0;
@@ -367,9 +375,15 @@ void CObjectSet::ListObjects(int32 indent)
     if (indent == 0)
         TinPrint(GetScriptContext(), "\n");
 
-    CObjectEntry* oe = mObjectList->First();
-    while (oe)
+    // -- listing children executes script, so use an iterator that tolerates the set changing
+    int32 iterator_id = CreateIterator();
+    if (iterator_id == 0)
+        return;
+
+    uint32 object_id = IterFirst(iterator_id);
+    while (object_id != 0)
     {
+        CObjectEntry* oe = GetScriptContext()->FindObjectEntry(object_id);
         GetScriptContext()->PrintObject(oe, indent);
 
         // -- if the object is an ObjectSet, list it's objects
@@ -380,8 +394,10 @@ void CObjectSet::ListObjects(int32 indent)
         }
 
         // -- next object
-        oe = mObjectList->Next();
+        object_id = IterNext(iterator_id);
     }
+
+    DestroyIterator(iterator_id);
 }
 
 // ====================================================================================================================
@@ -389,37 +405,34 @@ void CObjectSet::ListObjects(int32 indent)
 // ====================================================================================================================
 void CObjectSet::RemoveAll()
 {
-    int32 count = mObjectList->Used();
+    // -- removing from the end never moves another member
+    int32 count = mMemberCount;
     while (count > 0)
     {
-        CObjectEntry* oe = mObjectList->FindItemByIndex(count - 1);
-        RemoveObject(oe->GetID());
-        count = mObjectList->Used();
+        RemoveObject(mMemberArray[count - 1]->mObjectEntry->GetID());
+
+        // -- guard against an object that can't be removed
+        if (mMemberCount >= count)
+            break;
+        count = mMemberCount;
     }
 }
 
 // ====================================================================================================================
-// First():  Returns the first object in this set.  Note:  sets the internal iterator, in anticipation of Next().
+// First():  Returns the first object in this set.  Note:  resets the default iterator, in anticipation of Next().
 // ====================================================================================================================
 uint32 CObjectSet::First()
 {
-    CObjectEntry* oe = mObjectList->First();
-    if (oe)
-        return (oe->GetID());
-    else
-        return (0);
+    mDefaultIterator.mNextIndex = 0;
+    return (AdvanceIterator(&mDefaultIterator));
 }
 
 // ====================================================================================================================
-// Next():  Returns the next object added to the set, updating the internal iterator.
+// Next():  Returns the next object in the set, updating the default iterator.
 // ====================================================================================================================
 uint32 CObjectSet::Next()
 {
-    CObjectEntry* oe = mObjectList->Next();
-    if (oe)
-        return (oe->GetID());
-    else
-        return (0);
+    return (AdvanceIterator(&mDefaultIterator));
 }
 
 // ====================================================================================================================
@@ -427,20 +440,381 @@ uint32 CObjectSet::Next()
 // ====================================================================================================================
 int32 CObjectSet::Used()
 {
-    return mObjectList->Used();
+    return (mMemberCount);
 }
 
 // ====================================================================================================================
-// GetObjectByIndex():  Returns the nth object added to this object set.  Also sets the internal iterator.
+// GetObjectByIndex():  Returns the nth object in this object set.
+// Objects are in the order added, until one is removed - the last object is then moved into the removed one's place.
 // ====================================================================================================================
 uint32 CObjectSet::GetObjectByIndex(int32 index)
 {
     // -- sanity check
-    if (index < 0 || index >= Used())
+    if (index < 0 || index >= mMemberCount)
         return 0;
 
-    CObjectEntry* oe = mObjectList->FindItemByIndex(index);
-    return (oe->GetID());
+    return (mMemberArray[index]->mObjectEntry->GetID());
+}
+
+// ====================================================================================================================
+// CreateIterator():  Returns the ID of a new iterator for this set, to be used with IterFirst()/IterNext().
+// ====================================================================================================================
+int32 CObjectSet::CreateIterator()
+{
+    // -- every outstanding iterator is updated on each insert and remove, so an iterator that is never
+    // -- destroyed costs the set forever - a set can only have a bounded number
+    if (mIteratorList->Used() >= kObjectSetMaxIterators)
+    {
+        ScriptAssert_(GetScriptContext(), 0, "<internal>", -1,
+                      "Error - [%d] CObjectSet::CreateIterator(): %d iterators in use - use DestroyIterator()\n",
+                      GetSelfID(), kObjectSetMaxIterators);
+        return (0);
+    }
+
+    tSetIterator* iterator = TinAlloc(ALLOC_ObjectGroup, tSetIterator);
+    iterator->mNextIndex = 0;
+
+    // -- iterator IDs are never reused, so a stale ID can't refer to someone else's loop
+    int32 iterator_id = ++mNextIteratorID;
+    mIteratorList->AddItem(*iterator, iterator_id);
+    return (iterator_id);
+}
+
+// ====================================================================================================================
+// DestroyIterator():  Releases an iterator created by CreateIterator().
+// ====================================================================================================================
+void CObjectSet::DestroyIterator(int32 iterator_id)
+{
+    tSetIterator* iterator = mIteratorList->FindItem(iterator_id);
+    if (!iterator)
+    {
+        ScriptAssert_(GetScriptContext(), 0, "<internal>", -1,
+                      "Error - [%d] CObjectSet::DestroyIterator(): unknown iterator %d\n",
+                      GetSelfID(), iterator_id);
+        return;
+    }
+
+    mIteratorList->RemoveItem(iterator, iterator_id);
+    TinFree(iterator);
+}
+
+// ====================================================================================================================
+// IterFirst():  Resets the given iterator, and returns the first object in the set.
+// ====================================================================================================================
+uint32 CObjectSet::IterFirst(int32 iterator_id)
+{
+    tSetIterator* iterator = mIteratorList->FindItem(iterator_id);
+    if (!iterator)
+    {
+        ScriptAssert_(GetScriptContext(), 0, "<internal>", -1,
+                      "Error - [%d] CObjectSet::IterFirst(): unknown iterator %d\n",
+                      GetSelfID(), iterator_id);
+        return (0);
+    }
+
+    iterator->mNextIndex = 0;
+    return (AdvanceIterator(iterator));
+}
+
+// ====================================================================================================================
+// IterNext():  Returns the next object for the given iterator, or 0 when the set has been exhausted.
+// ====================================================================================================================
+uint32 CObjectSet::IterNext(int32 iterator_id)
+{
+    tSetIterator* iterator = mIteratorList->FindItem(iterator_id);
+    if (!iterator)
+    {
+        ScriptAssert_(GetScriptContext(), 0, "<internal>", -1,
+                      "Error - [%d] CObjectSet::IterNext(): unknown iterator %d\n",
+                      GetSelfID(), iterator_id);
+        return (0);
+    }
+
+    return (AdvanceIterator(iterator));
+}
+
+// ====================================================================================================================
+// BroadcastMethod():  Calls the method on every object in the set, returning the number of objects called.
+// The method is resolved once per namespace, and every call shares the same exec stack.
+// ====================================================================================================================
+int32 CObjectSet::BroadcastMethod(uint32 method_hash, int32 arg_count, const eVarType* arg_types, void** arg_values)
+{
+    CMethodBroadcast broadcast(GetScriptContext(), method_hash, arg_count, arg_types, arg_values);
+
+    // -- the methods execute script, so use an iterator that tolerates the set changing
+    int32 iterator_id = CreateIterator();
+    if (iterator_id == 0)
+        return (0);
+
+    uint32 object_id = IterFirst(iterator_id);
+    while (object_id != 0)
+    {
+        CObjectEntry* oe = GetScriptContext()->FindObjectEntry(object_id);
+        if (!broadcast.Call(oe))
+            break;
+
+        object_id = IterNext(iterator_id);
+    }
+
+    DestroyIterator(iterator_id);
+    return (broadcast.GetCallCount());
+}
+
+// ====================================================================================================================
+// Broadcast():  Calls the named method, with no arguments, on every object in the set.
+// ====================================================================================================================
+int32 CObjectSet::Broadcast(const char* method_name)
+{
+    if (!method_name || !method_name[0])
+        return (0);
+
+    return (BroadcastMethod(Hash(method_name)));
+}
+
+// ====================================================================================================================
+// BroadcastInt():  Calls the named method, with an int argument, on every object in the set.
+// ====================================================================================================================
+int32 CObjectSet::BroadcastInt(const char* method_name, int32 value)
+{
+    if (!method_name || !method_name[0])
+        return (0);
+
+    eVarType arg_type = TYPE_int;
+    void* arg_value = &value;
+    return (BroadcastMethod(Hash(method_name), 1, &arg_type, &arg_value));
+}
+
+// ====================================================================================================================
+// BroadcastFloat():  Calls the named method, with a float argument (e.g. a delta time), on every object in the set.
+// ====================================================================================================================
+int32 CObjectSet::BroadcastFloat(const char* method_name, float32 value)
+{
+    if (!method_name || !method_name[0])
+        return (0);
+
+    eVarType arg_type = TYPE_float;
+    void* arg_value = &value;
+    return (BroadcastMethod(Hash(method_name), 1, &arg_type, &arg_value));
+}
+
+// ====================================================================================================================
+// CreateObjects():  Creates a batch of objects of the given class, and adds them to the set.
+// ====================================================================================================================
+int32 CObjectSet::CreateObjects(const char* class_name, const char* object_name, int32 count)
+{
+    if (!class_name || !class_name[0] || count <= 0)
+        return (0);
+
+    uint32* object_ids = TinAllocArray(ALLOC_ObjEntry, uint32, count);
+    int32 created = GetScriptContext()->CreateObjects(Hash(class_name), Hash(object_name), count, object_ids);
+
+    // -- an OnCreate() may have destroyed an object already
+    for (int32 i = 0; i < created; ++i)
+    {
+        if (GetScriptContext()->IsObject(object_ids[i]))
+            AddObject(object_ids[i]);
+    }
+
+    TinFreeArray(object_ids);
+    return (created);
+}
+
+// ====================================================================================================================
+// DestroyObjects():  Destroys every object in the set, in batches, until the set is empty.
+// ====================================================================================================================
+void CObjectSet::DestroyObjects()
+{
+    if (!mMemberTable)
+        return;
+
+    // -- an OnDestroy() may add objects to the set, so repeat until it is empty
+    int32 count = mMemberCount;
+    while (count > 0)
+    {
+        // -- destroy in reverse order, since removing from the end of the list never moves another member
+        uint32* object_ids = TinAllocArray(ALLOC_ObjEntry, uint32, count);
+        for (int32 i = 0; i < count; ++i)
+            object_ids[i] = mMemberArray[count - 1 - i]->mObjectEntry->GetID();
+
+        GetScriptContext()->DestroyObjects(object_ids, count);
+        TinFreeArray(object_ids);
+
+        // -- guard against objects that can't be removed (e.g. already mid-destruction)
+        int32 remaining = mMemberCount;
+        if (remaining >= count)
+            break;
+        count = remaining;
+    }
+}
+
+// ====================================================================================================================
+// AdvanceIterator():  Returns the object at the iterator's index, and advances it.
+// ====================================================================================================================
+uint32 CObjectSet::AdvanceIterator(tSetIterator* iterator)
+{
+    if (iterator->mNextIndex < 0 || iterator->mNextIndex >= mMemberCount)
+        return (0);
+
+    tSetMember* member = mMemberArray[iterator->mNextIndex];
+    ++iterator->mNextIndex;
+    return (member->mObjectEntry->GetID());
+}
+
+// ====================================================================================================================
+// AllocMember():  Returns a member for the object entry, reusing a previously removed member if there is one.
+// ====================================================================================================================
+CObjectSet::tSetMember* CObjectSet::AllocMember(CObjectEntry* oe)
+{
+    tSetMember* member = mFreeMembers;
+    if (member)
+        mFreeMembers = member->mNextFree;
+    else
+        member = TinAlloc(ALLOC_ObjectGroup, tSetMember);
+
+    member->mObjectEntry = oe;
+    member->mIndex = -1;
+    member->mNextFree = NULL;
+    return (member);
+}
+
+// ====================================================================================================================
+// FreeMember():  Keeps a removed member, to be reused by the next AllocMember().
+// ====================================================================================================================
+void CObjectSet::FreeMember(tSetMember* member)
+{
+    member->mObjectEntry = NULL;
+    member->mIndex = -1;
+    member->mNextFree = mFreeMembers;
+    mFreeMembers = member;
+}
+
+// ====================================================================================================================
+// GrowMemberArray():  Doubles the capacity of the member array.
+// ====================================================================================================================
+void CObjectSet::GrowMemberArray()
+{
+    int32 new_size = mMemberArraySize > 0 ? mMemberArraySize * 2 : kObjectGroupTableSize;
+    tSetMember** new_array = TinAllocArray(ALLOC_ObjectGroup, tSetMember*, new_size);
+    for (int32 i = 0; i < mMemberCount; ++i)
+        new_array[i] = mMemberArray[i];
+
+    if (mMemberArray)
+        TinFreeArray(mMemberArray);
+
+    mMemberArray = new_array;
+    mMemberArraySize = new_size;
+}
+
+// ====================================================================================================================
+// MoveMember():  Places the member at the given index of the member array.
+// ====================================================================================================================
+void CObjectSet::MoveMember(tSetMember* member, int32 index)
+{
+    mMemberArray[index] = member;
+    member->mIndex = index;
+}
+
+// ====================================================================================================================
+// InsertMember():  Inserts the member at the given index, shifting the members after it.
+// ====================================================================================================================
+void CObjectSet::InsertMember(tSetMember* member, int32 index)
+{
+    if (mMemberCount >= mMemberArraySize)
+        GrowMemberArray();
+
+    for (int32 i = mMemberCount; i > index; --i)
+        MoveMember(mMemberArray[i - 1], i);
+    MoveMember(member, index);
+    ++mMemberCount;
+
+    mMemberTable->AddItem(*member, member->mObjectEntry->GetID());
+
+    // -- iterators that have passed the insertion point keep the same next object
+    // -- (an append is never before an iterator, so this is only the InsertObject() case)
+    if (index < mDefaultIterator.mNextIndex)
+        ++mDefaultIterator.mNextIndex;
+
+    tSetIterator* iterator = mIteratorList->First();
+    while (iterator)
+    {
+        if (index < iterator->mNextIndex)
+            ++iterator->mNextIndex;
+        iterator = mIteratorList->Next();
+    }
+}
+
+// ====================================================================================================================
+// AddIteratorBoundary():  Adds an iterator's next index to the sorted list of distinct indices past the removed one.
+// ====================================================================================================================
+static void AddIteratorBoundary(int32* boundary_list, int32& boundary_count, int32 next_index, int32 remove_index)
+{
+    if (next_index <= remove_index)
+        return;
+
+    int32 insert_index = boundary_count;
+    while (insert_index > 0 && boundary_list[insert_index - 1] >= next_index)
+    {
+        if (boundary_list[insert_index - 1] == next_index)
+            return;
+        --insert_index;
+    }
+
+    for (int32 i = boundary_count; i > insert_index; --i)
+        boundary_list[i] = boundary_list[i - 1];
+    boundary_list[insert_index] = next_index;
+    ++boundary_count;
+}
+
+// ====================================================================================================================
+// RemoveMember():  Removes the member by moving the last member into its place, so removal doesn't shift the array.
+// Each iterator divides the array into visited and unvisited members - to keep that true for every iterator, the
+// hole left by the removed member is first passed up across each iterator boundary past it (by moving the last
+// visited member on that side into the hole), and only then filled by the last member.
+// ====================================================================================================================
+void CObjectSet::RemoveMember(tSetMember* member)
+{
+    int32 remove_index = member->mIndex;
+    mMemberTable->RemoveItem(member, member->mObjectEntry->GetID());
+
+    // -- gather the distinct iterator boundaries past the removed index, in increasing order
+    int32 boundary_list[kObjectSetMaxIterators + 1];
+    int32 boundary_count = 0;
+    AddIteratorBoundary(boundary_list, boundary_count, mDefaultIterator.mNextIndex, remove_index);
+    tSetIterator* iterator = mIteratorList->First();
+    while (iterator)
+    {
+        AddIteratorBoundary(boundary_list, boundary_count, iterator->mNextIndex, remove_index);
+        iterator = mIteratorList->Next();
+    }
+
+    // -- pass the hole up to the last boundary, then fill it with the last member
+    int32 hole_index = remove_index;
+    for (int32 i = 0; i < boundary_count; ++i)
+    {
+        int32 boundary_index = boundary_list[i] - 1;
+        if (boundary_index != hole_index)
+            MoveMember(mMemberArray[boundary_index], hole_index);
+        hole_index = boundary_index;
+    }
+
+    --mMemberCount;
+    if (hole_index != mMemberCount)
+        MoveMember(mMemberArray[mMemberCount], hole_index);
+    mMemberArray[mMemberCount] = NULL;
+
+    // -- every iterator past the removed member has one fewer visited member
+    if (mDefaultIterator.mNextIndex > remove_index)
+        --mDefaultIterator.mNextIndex;
+
+    iterator = mIteratorList->First();
+    while (iterator)
+    {
+        if (iterator->mNextIndex > remove_index)
+            --iterator->mNextIndex;
+        iterator = mIteratorList->Next();
+    }
+
+    FreeMember(member);
 }
 
 // == class CObjectGroup ==============================================================================================
@@ -458,16 +832,7 @@ CObjectGroup::CObjectGroup() : CObjectSet()
 CObjectGroup::~CObjectGroup()
 {
     // -- object groups actually delete their children
-    if (mObjectList)
-    {
-        int32 count = mObjectList->Used();
-        while (count > 0)
-        {
-            CObjectEntry* oe = mObjectList->FindItemByIndex(count - 1);
-            GetScriptContext()->DestroyObject(oe->GetID());
-            count = mObjectList->Used();
-        }
-    }
+    DestroyObjects();
 }
 
 // ====================================================================================================================
@@ -481,7 +846,7 @@ void CObjectGroup::AddObject(uint32 objectid)
     {
         ScriptAssert_(GetScriptContext(), 0, "<internal>", -1,
                       "Error - [%d] CObjectGroup::AddObject(): unable to find object %d\n",
-                      GetScriptContext()->FindObjectByAddress(this)->GetID(), objectid);
+                      GetSelfID(), objectid);
         return;
     }
 
@@ -509,7 +874,7 @@ void CObjectGroup::RemoveObject(uint32 objectid)
     {
         ScriptAssert_(GetScriptContext(), 0, "<internal>", -1,
                       "Error - [%d] CObjectGroup::RemoveObject(): unable to find object %d\n",
-                      GetScriptContext()->FindObjectByAddress(this)->GetID(), objectid);
+                      GetSelfID(), objectid);
         return;
     }
 
@@ -537,6 +902,18 @@ REGISTER_METHOD_P0(CObjectSet, Next, Next, uint32);
 REGISTER_METHOD_P0(CObjectSet, Used, Used, int32);
 REGISTER_METHOD_P1(CObjectSet, GetObjectByIndex, GetObjectByIndex, uint32, int32);
 
+REGISTER_METHOD_P0(CObjectSet, CreateIterator, CreateIterator, int32);
+REGISTER_METHOD_P1(CObjectSet, DestroyIterator, DestroyIterator, void, int32);
+REGISTER_METHOD_P1(CObjectSet, IterFirst, IterFirst, uint32, int32);
+REGISTER_METHOD_P1(CObjectSet, IterNext, IterNext, uint32, int32);
+
+REGISTER_METHOD_P1(CObjectSet, Broadcast, Broadcast, int32, const char*);
+REGISTER_METHOD_P2(CObjectSet, BroadcastInt, BroadcastInt, int32, const char*, int32);
+REGISTER_METHOD_P2(CObjectSet, BroadcastFloat, BroadcastFloat, int32, const char*, float32);
+
+REGISTER_METHOD_P3(CObjectSet, CreateObjects, CreateObjects, int32, const char*, const char*, int32);
+REGISTER_METHOD_P0(CObjectSet, DestroyObjects, DestroyObjects, void);
+
 // =====================================================================================================================
 // -- CObjectGroup member/method registration
 IMPLEMENT_SCRIPT_CLASS_BEGIN(CObjectGroup, CObjectSet)
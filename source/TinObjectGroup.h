@@ -36,15 +36,13 @@ namespace TinScript
 class CObjectSet;
 
 // ====================================================================================================================
-// class CMasterMembershipList: This class is a "reverse lookup", where the has is the objectID, it returns
-// a list of all CObjectSet's that the object is a member of. 
+// class CMasterMembershipList: Tracks which CObjectSet's each object is a member of, so a deleted object can be
+// removed from all of them.  The memberships themselves are stored on the object entries.
 // ====================================================================================================================
 class CMasterMembershipList
 {
     public:
-        typedef CHashTable<CObjectSet> tMembershipList;
-
-        CMasterMembershipList(CScriptContext* script_context = NULL, int32 _size = 0);
+        CMasterMembershipList(CScriptContext* script_context = NULL);
         virtual ~CMasterMembershipList();
 
         CScriptContext* GetScriptContext() { return (mContextOwner); }
@@ -56,7 +54,6 @@ class CMasterMembershipList
 
     private:
         CScriptContext* mContextOwner;
-        CHashTable<tMembershipList>* mMasterMembershipList;
 };
 
 // ====================================================================================================================
@@ -87,9 +84,65 @@ class CObjectSet
         int32 Used();
         uint32 GetObjectByIndex(int32 index);
 
+        // -- iterators are independent of each other (nested loops are safe), and remain valid
+        // -- as objects are added to or removed from the set during the loop
+        // -- a set allows at most kObjectSetMaxIterators, so every iterator must be destroyed when done
+        int32 CreateIterator();
+        void DestroyIterator(int32 iterator_id);
+        uint32 IterFirst(int32 iterator_id);
+        uint32 IterNext(int32 iterator_id);
+
+        // -- call a method on every object in the set - see CMethodBroadcast
+        int32 BroadcastMethod(uint32 method_hash, int32 arg_count = 0, const eVarType* arg_types = NULL,
+                              void** arg_values = NULL);
+        int32 Broadcast(const char* method_name);
+        int32 BroadcastInt(const char* method_name, int32 value);
+        int32 BroadcastFloat(const char* method_name, float32 value);
+
+        // -- create a batch of objects (added to this set), or destroy every object in the set
+        int32 CreateObjects(const char* class_name, const char* object_name, int32 count);
+        void DestroyObjects();
+
     protected:
+        // -- an iterator is simply the index of the next object to visit, adjusted as the set changes
+        struct tSetIterator
+        {
+            int32 mNextIndex;
+        };
+
+        // -- the set is a dense array of members (so indexed access and iteration are a single lookup),
+        // -- and a hash table from object ID to member, where each member knows its own index in the array
+        struct tSetMember
+        {
+            CObjectEntry* mObjectEntry;
+            int32 mIndex;
+            tSetMember* mNextFree;
+        };
+
+        uint32 GetSelfID();
+        uint32 AdvanceIterator(tSetIterator* iterator);
+
+        tSetMember* AllocMember(CObjectEntry* oe);
+        void FreeMember(tSetMember* member);
+        void GrowMemberArray();
+        void MoveMember(tSetMember* member, int32 index);
+        void InsertMember(tSetMember* member, int32 index);
+        void RemoveMember(tSetMember* member);
+
         CScriptContext* mContextOwner;
-        CHashTable<CObjectEntry>* mObjectList;
+
+        CHashTable<tSetMember>* mMemberTable;
+        tSetMember** mMemberArray;
+        int32 mMemberCount;
+        int32 mMemberArraySize;
+
+        // -- sets are often filled and emptied every frame - removed members are kept for reuse
+        tSetMember* mFreeMembers;
+
+        // -- First()/Next() use the default iterator
+        tSetIterator mDefaultIterator;
+        CHashTable<tSetIterator>* mIteratorList;
+        int32 mNextIteratorID;
 };
 
 // ====================================================================================================================
@@ -259,8 +259,7 @@ bool8 GetStackValue(CScriptContext* script_context, CExecStack& execstack,
             }
 
 		    // -- if we have a debugger attached, also find the variable entry associated with the stack var
-		    int32 debugger_session = 0;
-		    if (script_context->IsDebuggerConnected(debugger_session))
+		    if (script_context->IsDebuggerActive())
 		    {
 			    int32 stacktop = 0;
 			    CObjectEntry* oe = NULL;
@@ -2688,6 +2687,179 @@ bool8 OpExecDestroyObject(CCodeBlock* cb, eOpCode op, const uint32*& instrptr, C
     return (true);
 }
 
+// ====================================================================================================================
+// OpExecWait():  Suspend the scheduled function, to be resumed by the scheduler after the delay.
+// ====================================================================================================================
+bool8 OpExecWait(CCodeBlock* cb, eOpCode op, const uint32*& instrptr, CExecStack& execstack,
+                 CFunctionCallStack& funccallstack)
+{
+    // -- pop the delay (a 'yield' pushes 0)
+    eVarType valtype;
+    void* valaddr = execstack.Pop(valtype);
+    CVariableEntry* ve = NULL;
+    CObjectEntry* oe = NULL;
+    if (!GetStackValue(cb->GetScriptContext(), execstack, funccallstack, valaddr, valtype, ve, oe))
+    {
+        DebuggerAssert_(false, cb, instrptr, execstack, funccallstack,
+                        "Error - Failed to pop the wait delay\n");
+        return false;
+    }
+
+    void* delayaddr = TypeConvert(cb->GetScriptContext(), valtype, valaddr, TYPE_int);
+    if (!delayaddr)
+    {
+        DebuggerAssert_(false, cb, instrptr, execstack, funccallstack,
+                        "Error - wait delay must be convertible to an int\n");
+        return false;
+    }
+
+    // -- script function calls recurse on the C++ stack, so only the function called by the scheduler can suspend
+    if (!funccallstack.CanSuspend())
+    {
+        DebuggerAssert_(false, cb, instrptr, execstack, funccallstack,
+                        "Error - wait/yield is only valid in a function called by schedule()\n");
+        return false;
+    }
+
+    int32 delay = *(int32*)delayaddr;
+    funccallstack.Suspend(cb, (uint32)(instrptr - cb->GetInstructionPtr()), delay);
+    DebugTrace(op, "Delay: %d", delay);
+    return (true);
+}
+
+// ====================================================================================================================
+// GetArrayOpVariable():  Pops an entire array variable off the stack, returning its entry and base address.
+// ====================================================================================================================
+static bool8 GetArrayOpVariable(CCodeBlock* cb, const uint32*& instrptr, CExecStack& execstack,
+                                CFunctionCallStack& funccallstack, CVariableEntry*& ve, void*& base_addr,
+                                bool8& is_stack_var)
+{
+    eVarType valtype;
+    void* val = execstack.Pop(valtype);
+    is_stack_var = (valtype == TYPE__stackvar);
+
+    CObjectEntry* oe = NULL;
+    if (!GetStackValue(cb->GetScriptContext(), execstack, funccallstack, val, valtype, ve, oe) || !ve)
+    {
+        DebuggerAssert_(false, cb, instrptr, execstack, funccallstack,
+                        "Error - ExecStack should contain an array variable\n");
+        return (false);
+    }
+
+    if (!ve->IsArray() || !val)
+    {
+        DebuggerAssert_(false, cb, instrptr, execstack, funccallstack,
+                        "Error - variable %s is not an array\n", UnHash(ve->GetHash()));
+        return (false);
+    }
+
+    // -- for arrays, the resolved value is the address of the first element
+    base_addr = val;
+    return (true);
+}
+
+// ====================================================================================================================
+// OpExecArrayCount():  Push the number of elements in an array variable.
+// ====================================================================================================================
+bool8 OpExecArrayCount(CCodeBlock* cb, eOpCode op, const uint32*& instrptr, CExecStack& execstack,
+                       CFunctionCallStack& funccallstack)
+{
+    CVariableEntry* ve = NULL;
+    void* base_addr = NULL;
+    bool8 is_stack_var = false;
+    if (!GetArrayOpVariable(cb, instrptr, execstack, funccallstack, ve, base_addr, is_stack_var))
+        return (false);
+
+    int32 count = ve->GetArraySize();
+    execstack.Push(&count, TYPE_int);
+    DebugTrace(op, "Array: %s[%d]", UnHash(ve->GetHash()), count);
+    return (true);
+}
+
+// ====================================================================================================================
+// OpExecArrayResize():  Resize a (non-stack) script array, preserving its contents.
+// ====================================================================================================================
+bool8 OpExecArrayResize(CCodeBlock* cb, eOpCode op, const uint32*& instrptr, CExecStack& execstack,
+                        CFunctionCallStack& funccallstack)
+{
+    // -- pull the new size from the stack
+    eVarType contenttype;
+    void* contentptr = execstack.Pop(contenttype);
+    if (contenttype != TYPE_int)
+    {
+        DebuggerAssert_(false, cb, instrptr, execstack, funccallstack,
+                        "Error - ExecStack should contain a positive TYPE_int value\n");
+        return false;
+    }
+    int32 new_size = *(int32*)contentptr;
+
+    CVariableEntry* ve = NULL;
+    void* base_addr = NULL;
+    bool8 is_stack_var = false;
+    if (!GetArrayOpVariable(cb, instrptr, execstack, funccallstack, ve, base_addr, is_stack_var))
+        return (false);
+
+    // -- local arrays have their space reserved on the stack, and parameters only refer to an array - a parameter
+    // -- can only resize the array it refers to, if that is a global or dynamic member array
+    if (ve->IsParameter() ? !ve->HasArraySource() : is_stack_var)
+    {
+        DebuggerAssert_(false, cb, instrptr, execstack, funccallstack,
+                        "Error - arrayresize() - local arrays (or parameters referring to them) can't be resized: %s\n",
+                        UnHash(ve->GetHash()));
+        return false;
+    }
+
+    if (!ve->ResizeArray(new_size))
+        return (false);
+
+    execstack.Push(&new_size, TYPE_int);
+    DebugTrace(op, "Array: %s[%d]", UnHash(ve->GetHash()), new_size);
+    return (true);
+}
+
+// ====================================================================================================================
+// OpExecArrayCopy():  Bulk copy the elements of one array into another of the same type.
+// ====================================================================================================================
+bool8 OpExecArrayCopy(CCodeBlock* cb, eOpCode op, const uint32*& instrptr, CExecStack& execstack,
+                      CFunctionCallStack& funccallstack)
+{
+    // -- the source was pushed last
+    CVariableEntry* src_ve = NULL;
+    void* src_addr = NULL;
+    bool8 src_is_stack_var = false;
+    if (!GetArrayOpVariable(cb, instrptr, execstack, funccallstack, src_ve, src_addr, src_is_stack_var))
+        return (false);
+
+    CVariableEntry* dest_ve = NULL;
+    void* dest_addr = NULL;
+    bool8 dest_is_stack_var = false;
+    if (!GetArrayOpVariable(cb, instrptr, execstack, funccallstack, dest_ve, dest_addr, dest_is_stack_var))
+        return (false);
+
+    // -- the elements are copied raw, so the types must match, and strings must go through the string table
+    eVarType vartype = dest_ve->GetType();
+    if (vartype != src_ve->GetType() || vartype == TYPE_string || vartype == TYPE_hashtable)
+    {
+        DebuggerAssert_(false, cb, instrptr, execstack, funccallstack,
+                        "Error - arraycopy() - unable to copy %s[] to %s[]\n",
+                        GetRegisteredTypeName(src_ve->GetType()), GetRegisteredTypeName(vartype));
+        return false;
+    }
+
+    // -- copy as many elements as both arrays hold
+    int32 count = dest_ve->GetArraySize() < src_ve->GetArraySize() ? dest_ve->GetArraySize()
+                                                                    : src_ve->GetArraySize();
+    if (count > 0 && dest_addr != src_addr)
+    {
+        memmove(dest_addr, src_addr, gRegisteredTypeSize[vartype] * count);
+        dest_ve->NotifyWrite(cb->GetScriptContext(), &execstack, &funccallstack);
+    }
+
+    execstack.Push(&count, TYPE_int);
+    DebugTrace(op, "Array: %s[%d] <- %s", UnHash(dest_ve->GetHash()), count, UnHash(src_ve->GetHash()));
+    return (true);
+}
+
 // ====================================================================================================================
 // OpExecEOF():  Notification of the end of the script file.
 // ====================================================================================================================
@@ -54,9 +54,13 @@ static const char gQuoteChars[kNumQuoteChars + 1] = "\"'`";
 // -- statics to prevent re-entrant parsing
 static int32 gGlobalExprParenDepth = 0;
 static bool8 gGlobalReturnStatement = false;
+static bool8 gGlobalWaitStatement = false;
 static bool8 gGlobalDestroyStatement = false;
 static bool8 gGlobalCreateStatement = false;
 
+// -- binary op precedence, beyond that of any operator in the BinaryOperatorTuple
+static const int32 kMaxBinOpPrecedence = 0x7fffffff;
+
 // -- stack for managing loops (break and continue statments need to know where to jump
 static const int32 gMaxWhileLoopDepth = 32;
 static int32 gWhileLoopDepth = 0;
@@ -761,29 +765,16 @@ void DumpTree(const CCompileTreeNode* root, int32 indent, bool8 isleft, bool8 is
 }
 
 // ====================================================================================================================
-// DestroyTree():  After a file is parsed, and the tree is compiled, we delete the tree recursively.
+// DestroyTree():  After a file is parsed, and the tree is compiled, we release the tree.
 // ====================================================================================================================
 void DestroyTree(CCompileTreeNode* root)
 {
-    while (root)
-    {
-        CCompileTreeNode* nextroot = root->next;
-
-        if (root->leftchild)
-        {
-            DestroyTree(root->leftchild);
-            root->leftchild = NULL;
-        }
-
-        if (root->rightchild)
-        {
-            DestroyTree(root->rightchild);
-            root->rightchild = NULL;
-        }
+    if (!root || !root->GetCodeBlock())
+        return;
 
-        TinFree(root);
-        root = nextroot;
-    }
+    // -- every node was allocated from the codeblock's parse arena, so rather than walking the tree,
+    // -- we release the arena - this also reclaims any nodes orphaned by a failed parse attempt
+    root->GetCodeBlock()->GetParseArena()->Reset();
 }
 
 // ====================================================================================================================
@@ -926,7 +917,7 @@ bool8 TryParseVarDeclaration(CCodeBlock* codeblock, tReadToken& filebuf, CCompil
         if (array_size <= 0)
         {
 			ScriptAssert_(codeblock->GetScriptContext(), 0, codeblock->GetFileName(), array_size_token.linenumber,
-                          "Error - expecting array size integer value, between 1 and %d\n", kMaxVariableArraySize);
+                          "Error - expecting a positive array size integer value\n");
             return (false);
         }
 
@@ -1033,19 +1024,13 @@ bool8 TryParseVarDeclaration(CCodeBlock* codeblock, tReadToken& filebuf, CCompil
         // -- committed to a hashtable dereference
         filebuf = idtoken;
 
-        int32 stacktopdummy = 0;
-        CObjectEntry* dummy = NULL;
-        CFunctionEntry* curfunction = codeblock->smFuncDefinitionStack->GetTop(dummy, stacktopdummy);
 		uint32 varhash = Hash(idtoken.tokenptr, idtoken.length);
-        uint32 funchash = curfunction ? curfunction->GetHash() : 0;
-        uint32 nshash = curfunction ? curfunction->GetNamespaceHash() : CScriptContext::kGlobalNamespaceHash;
         CVariableEntry* var = NULL;
 
         // -- the hashtable would have already had to have been declared, unless it's a self.hashtable
         if (!selfvardecl)
         {
-            var = GetVariable(codeblock->GetScriptContext(), codeblock->smCurrentGlobalVarTable, nshash, funchash,
-                              varhash, 0);
+            var = GetCompileVariable(codeblock, varhash);
             if (!var || var->GetType() != TYPE_hashtable)
             {
                 ScriptAssert_(codeblock->GetScriptContext(), 0, codeblock->GetFileName(),
@@ -1056,20 +1041,20 @@ bool8 TryParseVarDeclaration(CCodeBlock* codeblock, tReadToken& filebuf, CCompil
         }
 
         // -- create the ArrayVarDeclNode, leftchild is the hashtable var, right is the hash value
-        CArrayVarDeclNode* arrayvarnode = TinAlloc(ALLOC_TreeNode, CArrayVarDeclNode, codeblock,
-                                                   link, filebuf.linenumber, registeredtype);
+        CArrayVarDeclNode* arrayvarnode = TinAllocTreeNode(codeblock, CArrayVarDeclNode, codeblock,
+                                                           link, filebuf.linenumber, registeredtype);
 
         // -- if we're declaring an array variable belonging to a self.hashtable, then
         // -- the left child is an ObjMemberNode, not a ValueNode
         if (selfvardecl)
         {
-		    CObjMemberNode* objmember = TinAlloc(ALLOC_TreeNode, CObjMemberNode, codeblock, arrayvarnode->leftchild,
+		    CObjMemberNode* objmember = TinAllocTreeNode(codeblock, CObjMemberNode, codeblock, arrayvarnode->leftchild,
                                                  idtoken.linenumber, idtoken.tokenptr, idtoken.length);
             Unused_(objmember);
 
             // -- the left child is the branch that resolves to an object (self, in this case)
-            CSelfNode* selfnode = TinAlloc(ALLOC_TreeNode, CSelfNode, codeblock, objmember->leftchild,
-                                           idtoken.linenumber);
+            CSelfNode* selfnode = TinAllocTreeNode(codeblock, CSelfNode, codeblock, objmember->leftchild,
+                                                   idtoken.linenumber);
             Unused_(selfnode);
         }
 
@@ -1077,9 +1062,9 @@ bool8 TryParseVarDeclaration(CCodeBlock* codeblock, tReadToken& filebuf, CCompil
         else
         {
             // -- left child is the variable (which is obviously a hashtable)
-            CValueNode* valuenode = TinAlloc(ALLOC_TreeNode, CValueNode, codeblock,
-                                             arrayvarnode->leftchild, filebuf.linenumber,
-                                             idtoken.tokenptr, idtoken.length, true, TYPE_hashtable);
+            CValueNode* valuenode = TinAllocTreeNode(codeblock, CValueNode, codeblock,
+                                                     arrayvarnode->leftchild, filebuf.linenumber,
+                                                     idtoken.tokenptr, idtoken.length, true, TYPE_hashtable);
             Unused_(valuenode);
         }
 
@@ -1121,9 +1106,9 @@ bool8 TryParseVarDeclaration(CCodeBlock* codeblock, tReadToken& filebuf, CCompil
     else if (selfvardecl)
     {
         // -- create the node
-        CSelfVarDeclNode* self_var_node = TinAlloc(ALLOC_TreeNode, CSelfVarDeclNode, codeblock, link,
-                                                   idtoken.linenumber, idtoken.tokenptr, idtoken.length,
-                                                   registeredtype, array_size);
+        CSelfVarDeclNode* self_var_node = TinAllocTreeNode(codeblock, CSelfVarDeclNode, codeblock, link,
+                                                           idtoken.linenumber, idtoken.tokenptr, idtoken.length,
+                                                           registeredtype, array_size);
         Unused_(self_var_node);
     }
 
@@ -1185,19 +1170,19 @@ bool8 TryParseVarDeclaration(CCodeBlock* codeblock, tReadToken& filebuf, CCompil
             finaltoken = arrayhashtoken;
 
             // -- create the ArrayVarDeclNode, leftchild is the hashtable var, right is the hash value
-            CArrayVarDeclNode* arrayvarnode = TinAlloc(ALLOC_TreeNode, CArrayVarDeclNode, codeblock,
-                                                       link, filebuf.linenumber, registeredtype);
+            CArrayVarDeclNode* arrayvarnode = TinAllocTreeNode(codeblock, CArrayVarDeclNode, codeblock,
+                                                               link, filebuf.linenumber, registeredtype);
 
             // -- the right child is the hash value
             arrayvarnode->rightchild = array_root;
 
 
             // -- the left child is the member node
-		    CObjMemberNode* objmember = TinAlloc(ALLOC_TreeNode, CObjMemberNode, codeblock, arrayvarnode->leftchild,
+		    CObjMemberNode* objmember = TinAllocTreeNode(codeblock, CObjMemberNode, codeblock, arrayvarnode->leftchild,
                                                  member_token.linenumber, member_token.tokenptr, member_token.length);
 
             // -- the left child of the member node resolves tothe object
-		    CValueNode* valuenode = TinAlloc(ALLOC_TreeNode, CValueNode, codeblock, objmember->leftchild,
+		    CValueNode* valuenode = TinAllocTreeNode(codeblock, CValueNode, codeblock, objmember->leftchild,
                                              idtoken.linenumber, idtoken.tokenptr, idtoken.length, true, TYPE_object);
         }
 
@@ -1208,12 +1193,12 @@ bool8 TryParseVarDeclaration(CCodeBlock* codeblock, tReadToken& filebuf, CCompil
             finaltoken = member_token;
 
             // -- create the member node
-            CObjMemberDeclNode* obj_member_decl_node = TinAlloc(ALLOC_TreeNode, CObjMemberDeclNode, codeblock, link,
-                                                                member_token.linenumber, member_token.tokenptr,
-                                                                member_token.length, registeredtype, array_size);
+            CObjMemberDeclNode* obj_member_decl_node = TinAllocTreeNode(codeblock, CObjMemberDeclNode, codeblock, link,
+                                                                        member_token.linenumber, member_token.tokenptr,
+                                                                        member_token.length, registeredtype, array_size);
 
             // -- create the value node that resolves to an object
-		    CValueNode* valuenode = TinAlloc(ALLOC_TreeNode, CValueNode, codeblock, obj_member_decl_node->leftchild,
+		    CValueNode* valuenode = TinAllocTreeNode(codeblock, CValueNode, codeblock, obj_member_decl_node->leftchild,
                                              idtoken.linenumber, idtoken.tokenptr, idtoken.length, true, TYPE_object);
         }
 
@@ -1273,112 +1258,85 @@ bool8 TryParseVarDeclaration(CCodeBlock* codeblock, tReadToken& filebuf, CCompil
 }
 
 // ====================================================================================================================
-// SortBinOpPrecedence():  Operators have precedence, e.g.  multiplication before addition.
+// TryParseBinaryOpChain():  Parse an expression, followed by any sequence of binary/assignment ops and expressions.
+// Precedence is resolved as we parse (precedence climbing), so no sorting of the tree is required afterwards.
+// Note:  a lower precedence value binds tighter - only operators tighter than the given precedence are consumed.
 // ====================================================================================================================
-CCompileTreeNode** SortBinOpPrecedence(CCompileTreeNode** toplink, bool8& found_swap)
+static bool8 TryParseBinaryOpChain(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTreeNode*& link,
+                                   int32 precedence)
 {
-    // -- initialize the return value
-    found_swap = false;
-
-    // -- sanity check
-    if (toplink == NULL)
-        return (NULL);
-
-    // -- we need to sort binary non-assign ops by precedence, for any sequential binop nodes
-    // -- along the right children
-    CCompileTreeNode* head = *toplink;
-    CCompileTreeNode** parent = toplink;
-    while (head && (head->GetType() != eBinaryOp ||
-           static_cast<CBinaryOpNode*>(head)->GetBinaryOpPrecedence() == 0))
-    {
-        parent = &head->rightchild;
-        head = head->rightchild;
-    }
-
-    // -- if we didn't find a head, or a head->rightchild, nothing to sort
-    if (!head || !head->rightchild)
-        return (NULL);
-
-    // -- now look for the highest priority child to sort above "head"
-    // -- include a depth increment, since right-to-left applies to equal precedence ops
-    int32 headprecedence = static_cast<CBinaryOpNode*>(head)->GetBinaryOpPrecedence() * 1000;
-    int32 depth = 1;
-    CCompileTreeNode** swapparent = &head->rightchild;
-    CCompileTreeNode* swap = head->rightchild;
+    // -- every chain begins with an expression
+    tReadToken readexpr(filebuf);
+    if (!TryParseExpression(codeblock, readexpr, link))
+        return (false);
 
-    while (swap && swap->GetType() == eBinaryOp)
+    while (true)
     {
-        int32 swapprecedence = static_cast<CBinaryOpNode*>(swap)->GetBinaryOpPrecedence() * 1000 + depth;
-        if (swapprecedence <= headprecedence)
-        {
-            ++depth;
-            swapparent = &swap->rightchild;
-            swap = swap->rightchild;
-        }
-        else
+        // -- see if the expression is followed by an operator - if not, the chain is complete
+        tReadToken nexttoken(readexpr);
+        if (!GetToken(nexttoken))
             break;
-    }
-
-    // -- if we didn't find a node to swap, we're done
-    if (!swap || swap == head)
-        return (NULL);
-
-    // -- if swap isn't a binary op, we want to continue testing the next rightchild from head
-    if (swap->GetType() != eBinaryOp ||
-        static_cast<CBinaryOpNode*>(swap)->GetBinaryOpPrecedence() == 0)
-    {
-        return &head->rightchild;
-    }
-
-    // -- swap the two nodes:
-    // -- swap's leftchild take the place of swap (e.g. the right child of swap's parent)
-    // -- swap's new leftchild is head
-    // -- whatever was pointing at head, now points to swap
-    CCompileTreeNode* temp = swap->leftchild;
-    swap->leftchild = head;
-    *swapparent = temp;
-    *parent = swap;
-
-    // -- set the return value
-    found_swap = true;
 
-    // -- the new toplink we need to sort from is swap->leftchild
-    return (&swap->leftchild);
-}
+        // -- an assignment op applies to the expression immediately preceding it, and the
+        // -- entire remainder of the statement is the rhs (assignments are right-associative)
+        if (nexttoken.type == TOKEN_ASSOP)
+        {
+            // -- we're committed at this point
+            readexpr = nexttoken;
 
-// ====================================================================================================================
-// SortTreeBinaryOps():  Sort all binary op nodes in a branch.
-// ====================================================================================================================
-void SortTreeBinaryOps(CCompileTreeNode** toplink)
-{
-    static bool8 enablesort = true;
-    if (!enablesort)
-        return;
+            CCompileTreeNode* templeftchild = link;
+            eAssignOpType assoptype = GetAssignOpType(nexttoken.tokenptr, nexttoken.length);
+            CBinaryOpNode* binopnode = TinAllocTreeNode(codeblock, CBinaryOpNode, codeblock, link,
+                                                        readexpr.linenumber, assoptype, true, TYPE__resolve);
+            binopnode->leftchild = templeftchild;
 
-    // -- we need to do passes through the list, until we make it through with no swaps
-    while (true)
-    {
-        // -- we're looking to see if any of the passes in this loop performed a swap
-        bool8 loop_swap = false;
-        bool8 pass_swap = false;
+            // -- ensure we have an expression to fill the right child
+            if (!TryParseBinaryOpChain(codeblock, readexpr, binopnode->rightchild, kMaxBinOpPrecedence) ||
+                !binopnode->rightchild)
+            {
+                ScriptAssert_(codeblock->GetScriptContext(), 0, codeblock->GetFileName(),
+                              readexpr.linenumber,
+                              "Error - Assignment operator without a rhs expression\n");
+                return (false);
+            }
+        }
 
-        CCompileTreeNode** sorthead = SortBinOpPrecedence(toplink, pass_swap);
+        // -- a binary op is only consumed if it binds tighter than the chain we're a part of
+        else if (nexttoken.type == TOKEN_BINOP)
+        {
+            eBinaryOpType binoptype = GetBinaryOpType(nexttoken.tokenptr, nexttoken.length);
+            int32 binopprecedence = GetBinOpPrecedence(binoptype);
+            if (binopprecedence >= precedence)
+                break;
 
-        // -- set the loop bool after every pass
-        loop_swap = loop_swap || pass_swap;
+            // -- we're committed at this point
+            readexpr = nexttoken;
 
-        while (sorthead != NULL)
-        {
-            sorthead = SortBinOpPrecedence(sorthead, pass_swap);
+            // -- the chain so far becomes the left child - this makes equal precedence ops left-associative
+            CCompileTreeNode* templeftchild = link;
+            CBinaryOpNode* binopnode = TinAllocTreeNode(codeblock, CBinaryOpNode, codeblock, link,
+                                                        readexpr.linenumber, binoptype, false, TYPE__resolve);
+            binopnode->leftchild = templeftchild;
 
-            // -- set the loop bool after every pass
-            loop_swap = loop_swap || pass_swap;
+            // -- the right child consumes only operators that bind tighter than this one
+            if (!TryParseBinaryOpChain(codeblock, readexpr, binopnode->rightchild, binopprecedence) ||
+                !binopnode->rightchild)
+            {
+                ScriptAssert_(codeblock->GetScriptContext(), 0, codeblock->GetFileName(),
+                              readexpr.linenumber,
+                              "Error - Binary operator without a rhs expression\n");
+                return (false);
+            }
         }
 
-        // -- if we made it all the way through with no loops, we're done
-        if (!loop_swap)
+        // -- anything else terminates the chain - the caller is responsible for validating the terminator
+        else
             break;
     }
+
+    // -- success
+    filebuf = readexpr;
+    return (true);
 }
 
 // ====================================================================================================================
@@ -1418,6 +1376,12 @@ bool8 TryParseStatement(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTree
         return (true);
     }
 
+    // -- check for a wait or yield statement
+    if (TryParseWait(codeblock, filebuf, link))
+    {
+        return (true);
+    }
+
     // -- check for a destroy statement
     if (TryParseDestroyObject(codeblock, filebuf, link))
     {
@@ -1432,157 +1396,55 @@ bool8 TryParseStatement(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTree
 
     // -- use a temporary root to construct the statement, before hooking it into the tree
     CCompileTreeNode* statementroot = NULL;
-    CCompileTreeNode** templink = &statementroot;
 
-    // -- use a temporary link to see if we have an expression
+    // -- parse the expression, and any chain of binary/assignment ops that follow
     tReadToken readexpr(filebuf);
-    if (!TryParseExpression(codeblock, readexpr, *templink))
+    if (!TryParseBinaryOpChain(codeblock, readexpr, statementroot, kMaxBinOpPrecedence))
     {
         return (false);
     }
 
-    // -- see if we've got a semicolon, a binop, an assop or an object dereference
+    // -- the chain is followed by either a semicolon, a comma, or a closing paren
     tReadToken nexttoken(readexpr);
     if (!GetToken(nexttoken))
         return (false);
 
-    // -- reached the end of the statement
-    while (true)
+    // -- if we find a closing parenthesis that we're expecting, we're done
+    if (nexttoken.type == TOKEN_PAREN_CLOSE || nexttoken.type == TOKEN_SQUARE_CLOSE)
     {
-        // -- see if we've reached the end of the statement
-        // -- if we find a closing parenthesis that we're expecting, we're done
-        if (nexttoken.type == TOKEN_PAREN_CLOSE || nexttoken.type == TOKEN_SQUARE_CLOSE)
-        {
-            // -- make sure we were expecting it
-            if (gGlobalExprParenDepth == 0)
-            {
-                return (false);
-            }
-
-            // -- otherwise we're done successfully
-            else
-            {
-                // -- don't consume the ')' - let the expression handle it
-                filebuf = readexpr;
-                link = statementroot;
+        // -- make sure we were expecting it
+        if (gGlobalExprParenDepth == 0)
+            return (false);
 
-                // -- at the end of the statement, we need to sort sequences of binary op nodes
-                SortTreeBinaryOps(&link);
+        // -- don't consume the ')' - let the expression handle it
+        filebuf = readexpr;
+        link = statementroot;
+        return (true);
+    }
 
-                return (true);
-            }
-        }
+    else if (nexttoken.type == TOKEN_COMMA)
+    {
+        // -- don't consume the ',' - let the expression handle it
+        filebuf = readexpr;
+        link = statementroot;
+        return (true);
+    }
 
-        else if (nexttoken.type == TOKEN_COMMA)
-        {
-            // -- don't consume the ',' - let the expression handle it
+    else if (nexttoken.type == TOKEN_SEMICOLON)
+    {
+        // $$$TZA From within a 'For' loop, we have valid ';' within parenthesis
+        // -- if so, do not consume the ';'
+        if (gGlobalExprParenDepth > 0)
             filebuf = readexpr;
-            link = statementroot;
-
-            // -- at the end of the statement, we need to sort sequences of binary op nodes
-            SortTreeBinaryOps(&link);
-
-            return (true);
-        }
-
-        else if (nexttoken.type == TOKEN_SEMICOLON)
-        {
-            // $$$TZA From within a 'For' loop, we have valid ';' within parenthesis
-            // -- if so, do not consume the ';'
-            if (gGlobalExprParenDepth > 0)
-                filebuf = readexpr;
-            // -- otherwise this is a complete statement - consume the ';'
-            else
-                filebuf = nexttoken;
-            link = statementroot;
-
-            // -- at the end of the statement, we need to sort sequences of binary op nodes
-            SortTreeBinaryOps(&link);
-
-            return (true);
-        }
-
-        // -- see if we've got a binary operation
-        else if (nexttoken.type == TOKEN_BINOP)
-        {
-            // -- we're committed to a statement at this point
-            readexpr = nexttoken;
-
-            CCompileTreeNode* templeftchild = *templink;
-		    eBinaryOpType binoptype = GetBinaryOpType(nexttoken.tokenptr, nexttoken.length);
-            CBinaryOpNode* binopnode = TinAlloc(ALLOC_TreeNode, CBinaryOpNode, codeblock,
-                                                *templink, readexpr.linenumber, binoptype,
-                                                false, TYPE__resolve);
-            binopnode->leftchild = templeftchild;
-
-		    // -- ensure we have an expression to fill the right child
-		    bool8 result = TryParseExpression(codeblock, readexpr, binopnode->rightchild);
-		    if (!result || !binopnode->rightchild)
-            {
-                ScriptAssert_(codeblock->GetScriptContext(), 0, codeblock->GetFileName(),
-                              readexpr.linenumber,
-                              "Error - Binary operator without a rhs expression\n");
-			    return (false);
-		    }
-
-            // -- update our temporary root
-            templink = &binopnode->rightchild;
-
-            // -- successfully read the rhs, get the next token
-            nexttoken = readexpr;
-            if (!GetToken(nexttoken))
-            {
-			    ScriptAssert_(codeblock->GetScriptContext(), 0, codeblock->GetFileName(),
-                              readexpr.linenumber, "Error - expecting ';'\n");
-			    return (false);
-            }
-        }
-
-        // -- see if we've got an assignment op
-        else if (nexttoken.type == TOKEN_ASSOP)
-        {
-            // -- we're committed to a statement at this point
-            readexpr = nexttoken;
-
-            CCompileTreeNode* templeftchild = *templink;
-            eAssignOpType assoptype = GetAssignOpType(nexttoken.tokenptr, nexttoken.length);
-		    CBinaryOpNode* binopnode = TinAlloc(ALLOC_TreeNode, CBinaryOpNode, codeblock,
-                                                *templink, readexpr.linenumber, assoptype,
-                                                true, TYPE__resolve);
-            binopnode->leftchild = templeftchild;
-
-		    // -- ensure we have an expression to fill the right child
-		    bool8 result = TryParseExpression(codeblock, readexpr, binopnode->rightchild);
-		    if (!result || !binopnode->rightchild)
-            {
-			    ScriptAssert_(codeblock->GetScriptContext(), 0, codeblock->GetFileName(),
-                              readexpr.linenumber,
-                              "Error - Assignment operator without a rhs expression\n");
-			    return (false);
-		    }
-
-            // -- update our temporary root
-            templink = &binopnode->rightchild;
-
-            // -- successfully read the rhs, get the next token
-            nexttoken = readexpr;
-            if (!GetToken(nexttoken))
-            {
-			    ScriptAssert_(codeblock->GetScriptContext(), 0, codeblock->GetFileName(),
-                              readexpr.linenumber, "Error - expecting ';'\n");
-			    return (false);
-            }
-        }
-
+        // -- otherwise this is a complete statement - consume the ';'
         else
-        {
-		    ScriptAssert_(codeblock->GetScriptContext(), 0, codeblock->GetFileName(),
-                          readexpr.linenumber, "Error - expecting ';'\n");
-		    return (false);
-        }
+            filebuf = nexttoken;
+        link = statementroot;
+        return (true);
     }
 
-    // -- should be impossible to exit the while loop - fail
+    ScriptAssert_(codeblock->GetScriptContext(), 0, codeblock->GetFileName(),
+                  readexpr.linenumber, "Error - expecting ';'\n");
     return (false);
 }
 
@@ -1611,7 +1473,7 @@ bool8 TryParseExpression(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTre
     if (firsttoken.type == TOKEN_UNARY)
     {
         eUnaryOpType unarytype = GetUnaryOpType(firsttoken.tokenptr, firsttoken.length);
-		unarynode = TinAlloc(ALLOC_TreeNode, CUnaryOpNode, codeblock, link, filebuf.linenumber,
+		unarynode = TinAllocTreeNode(codeblock, CUnaryOpNode, codeblock, link, filebuf.linenumber,
                              unarytype);
 
         // -- committed
@@ -1634,8 +1496,8 @@ bool8 TryParseExpression(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTre
     if (firsttoken.type == TOKEN_PAREN_OPEN)
     {
         filebuf = firsttoken;
-        CParenOpenNode* parenopennode = TinAlloc(ALLOC_TreeNode, CParenOpenNode, codeblock, *temp_link,
-                                                 filebuf.linenumber);
+        CParenOpenNode* parenopennode = TinAllocTreeNode(codeblock, CParenOpenNode, codeblock, *temp_link,
+                                                         filebuf.linenumber);
 
         // -- increment the parenthesis stack
         ++gGlobalExprParenDepth;
@@ -1661,16 +1523,10 @@ bool8 TryParseExpression(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTre
         --gGlobalExprParenDepth;
 
         // -- the leftchild of the parenopennode is our value, so we use it
-        // -- hook up the link to the correct subtree, and delete the unneeded paren node
+        // -- hook up the link to the correct subtree - the unneeded paren node is reclaimed with the parse arena
+        // -- note:  precedence is resolved as the statement is parsed, so the sub-tree is already complete
         *temp_link = parenopennode->leftchild;
         parenopennode->leftchild = NULL;
-        TinFree(parenopennode);
-
-        // -- override the binary op precedence, as we don't sort past a parenthesized sub-tree
-        if ((*temp_link)->GetType() == eBinaryOp)
-        {
-            static_cast<CBinaryOpNode*>(*temp_link)->OverrideBinaryOpPrecedence(0);
-        }
 
         // -- hook the parenthetical expression up to the actual tree (possibly as the child of the unary op)
         exprlink = expression_root;
@@ -1695,7 +1551,7 @@ bool8 TryParseExpression(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTre
         // -- committed to value
         filebuf = firsttoken;
 
-		CValueNode* valuenode = TinAlloc(ALLOC_TreeNode, CValueNode, codeblock, exprlink, filebuf.linenumber,
+		CValueNode* valuenode = TinAllocTreeNode(codeblock, CValueNode, codeblock, exprlink, filebuf.linenumber,
                                          firsttoken.tokenptr, firsttoken.length, false,
                                          firstclassvartype);
         return (true);
@@ -1705,6 +1561,10 @@ bool8 TryParseExpression(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTre
     if (TryParseHash(codeblock, filebuf, exprlink))
         return (true);
 
+    // -- an array operation completes an expression
+    if (TryParseArrayOp(codeblock, filebuf, exprlink))
+        return (true);
+
     // -- after the potential unary op, an expression may start with:
     // -- a 'self'
     // -- a function call (not a method)
@@ -1717,7 +1577,7 @@ bool8 TryParseExpression(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTre
         {
             // -- committed to self
             filebuf = firsttoken;
-		    CSelfNode* selfnode = TinAlloc(ALLOC_TreeNode, CSelfNode, codeblock, *temp_link, filebuf.linenumber);
+		    CSelfNode* selfnode = TinAllocTreeNode(codeblock, CSelfNode, codeblock, *temp_link, filebuf.linenumber);
         }
         else
             return (false);
@@ -1735,21 +1595,15 @@ bool8 TryParseExpression(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTre
         // -- committed to value
         filebuf = firsttoken;
 
-		TinAlloc(ALLOC_TreeNode, CValueNode, codeblock, *temp_link, filebuf.linenumber, firsttoken.tokenptr,
+		TinAllocTreeNode(codeblock, CValueNode, codeblock, *temp_link, filebuf.linenumber, firsttoken.tokenptr,
                  firsttoken.length, false, firstclassvartype);
     }
 
     // -- if we've got an identifier, see if it's a variable
 	else if (firsttoken.type == TOKEN_IDENTIFIER)
     {
-        int32 stacktopdummy = 0;
-        CObjectEntry* dummy = NULL;
-        CFunctionEntry* curfunction = codeblock->smFuncDefinitionStack->GetTop(dummy, stacktopdummy);
 		uint32 varhash = Hash(firsttoken.tokenptr, firsttoken.length);
-        uint32 funchash = curfunction ? curfunction->GetHash() : 0;
-        uint32 nshash = curfunction ? curfunction->GetNamespaceHash() : CScriptContext::kGlobalNamespaceHash;
-        CVariableEntry* var = GetVariable(codeblock->GetScriptContext(), codeblock->smCurrentGlobalVarTable, nshash,
-                                          funchash, varhash, 0);
+        CVariableEntry* var = GetCompileVariable(codeblock, varhash);
 		if (var)
         {
             // -- we're committed to the variable
@@ -1765,11 +1619,11 @@ bool8 TryParseExpression(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTre
                 filebuf = arrayhashtoken;
 
                 // -- create the ArrayVarNode, leftchild is the hashtable var, right is the hash value
-                CArrayVarNode* arrayvarnode = TinAlloc(ALLOC_TreeNode, CArrayVarNode, codeblock, *temp_link,
-                                                       filebuf.linenumber);
+                CArrayVarNode* arrayvarnode = TinAllocTreeNode(codeblock, CArrayVarNode, codeblock, *temp_link,
+                                                               filebuf.linenumber);
 
                 // -- create the variable node
-		        CValueNode* valuenode = TinAlloc(ALLOC_TreeNode, CValueNode, codeblock, arrayvarnode->leftchild,
+		        CValueNode* valuenode = TinAllocTreeNode(codeblock, CValueNode, codeblock, arrayvarnode->leftchild,
                                                  filebuf.linenumber, firsttoken.tokenptr, firsttoken.length, true,
                                                  TYPE_hashtable);
 
@@ -1783,7 +1637,7 @@ bool8 TryParseExpression(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTre
             // -- not a hash table - create the value node
             else
             {
-		        CValueNode* valuenode = TinAlloc(ALLOC_TreeNode, CValueNode, codeblock, *temp_link, filebuf.linenumber,
+		        CValueNode* valuenode = TinAllocTreeNode(codeblock, CValueNode, codeblock, *temp_link, filebuf.linenumber,
                                                  firsttoken.tokenptr, firsttoken.length, true, var->GetType());
             }
 		}
@@ -1835,7 +1689,7 @@ bool8 TryParseExpression(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTre
                 // -- create an object method node, the left child will resolve to the objectID
                 // -- and the right child will be the tree handling the method call
                 CCompileTreeNode* temprightchild = *temp_link;
-		        CObjMethodNode* objmethod = TinAlloc(ALLOC_TreeNode, CObjMethodNode, codeblock, *temp_link,
+		        CObjMethodNode* objmethod = TinAllocTreeNode(codeblock, CObjMethodNode, codeblock, *temp_link,
                                                      membertoken.linenumber, membertoken.tokenptr, membertoken.length);
 
                 // -- the left child is the branch that resolves to an object
@@ -1859,11 +1713,11 @@ bool8 TryParseExpression(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTre
                     filebuf = arrayhashtoken;
 
                     // -- create the ArrayVarNode, leftchild is the hashtable var, right is the hash value
-                    CArrayVarNode* arrayvarnode = TinAlloc(ALLOC_TreeNode, CArrayVarNode, codeblock,
-                                                           *temp_link, filebuf.linenumber);
+                    CArrayVarNode* arrayvarnode = TinAllocTreeNode(codeblock, CArrayVarNode, codeblock,
+                                                                   *temp_link, filebuf.linenumber);
 
                     // -- create the member node
-		            CObjMemberNode* objmember = TinAlloc(ALLOC_TreeNode, CObjMemberNode, codeblock, arrayvarnode->leftchild,
+		            CObjMemberNode* objmember = TinAllocTreeNode(codeblock, CObjMemberNode, codeblock, arrayvarnode->leftchild,
                                                          membertoken.linenumber, membertoken.tokenptr, membertoken.length);
 
                     // -- the left child is the branch that resolves to an object
@@ -1877,7 +1731,7 @@ bool8 TryParseExpression(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTre
                 else
                 {
                     // -- create the member node
-		            CObjMemberNode* objmember = TinAlloc(ALLOC_TreeNode, CObjMemberNode, codeblock, *temp_link,
+		            CObjMemberNode* objmember = TinAllocTreeNode(codeblock, CObjMemberNode, codeblock, *temp_link,
                                                          membertoken.linenumber, membertoken.tokenptr, membertoken.length);
 
                     // -- the left child is the branch that resolves to an object
@@ -1909,7 +1763,7 @@ bool8 TryParseExpression(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTre
             filebuf = membertoken;
 
             // -- create the member node
-		    CPODMemberNode* objmember = TinAlloc(ALLOC_TreeNode, CPODMemberNode, codeblock, *temp_link,
+		    CPODMemberNode* objmember = TinAllocTreeNode(codeblock, CPODMemberNode, codeblock, *temp_link,
                                                  membertoken.linenumber, membertoken.tokenptr, membertoken.length);
 
             // -- the left child is the branch that resolves to an object
@@ -1971,7 +1825,7 @@ bool8 TryParseIfStatement(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTr
 
 	// -- an 'if' statement has the expression tree as it's left child,
 	// -- and a branch node as it's right child, based on the true/false
-	CIfStatementNode* ifstmtnode = TinAlloc(ALLOC_TreeNode, CIfStatementNode, codeblock, link,
+	CIfStatementNode* ifstmtnode = TinAllocTreeNode(codeblock, CIfStatementNode, codeblock, link,
                                             filebuf.linenumber);
 
 	// we need to have a valid expression for the left hand child
@@ -1996,7 +1850,7 @@ bool8 TryParseIfStatement(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTr
     --gGlobalExprParenDepth;
 
 	// -- we've got our conditional expression - the right child is a branch node
-	CCondBranchNode* condbranchnode = TinAlloc(ALLOC_TreeNode, CCondBranchNode, codeblock,
+	CCondBranchNode* condbranchnode = TinAllocTreeNode(codeblock, CCondBranchNode, codeblock,
                                                ifstmtnode->rightchild, filebuf.linenumber);
 
 	// -- the left side of the condbranchnode is the 'true' branch
@@ -2136,7 +1990,7 @@ bool8 TryParseWhileLoop(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTree
 
 	// -- a while loop has the expression tree as it's left child,
 	// -- and the body as a statement block as its right child
-	CWhileLoopNode* whileloopnode = TinAlloc(ALLOC_TreeNode, CWhileLoopNode, codeblock, link,
+	CWhileLoopNode* whileloopnode = TinAllocTreeNode(codeblock, CWhileLoopNode, codeblock, link,
                                              filebuf.linenumber);
 
     // -- push the while loop onto the stack
@@ -2283,7 +2137,7 @@ bool8 TryParseForLoop(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTreeNo
 	}
 
 	// add the while loop node
-	CWhileLoopNode* whileloopnode = TinAlloc(ALLOC_TreeNode, CWhileLoopNode, codeblock,
+	CWhileLoopNode* whileloopnode = TinAllocTreeNode(codeblock, CWhileLoopNode, codeblock,
                                              AppendToRoot(*forlooproot), filebuf.linenumber);
 
     // -- push the while loop onto the stack
@@ -2452,10 +2306,11 @@ bool8 TryParseFuncDefinition(CCodeBlock* codeblock, tReadToken& filebuf, CCompil
 
     // -- find the namespace to which this function belongs
     tFuncTable* functable = NULL;
+    CNamespace* nsentry = NULL;
     if (usenamespace)
     {
         // -- see if we need to create a new namespace
-        CNamespace* nsentry = codeblock->GetScriptContext()->
+        nsentry = codeblock->GetScriptContext()->
                                          FindOrCreateNamespace(TokenPrint(nsnametoken), true);
         if (!nsentry)
         {
@@ -2472,7 +2327,8 @@ bool8 TryParseFuncDefinition(CCodeBlock* codeblock, tReadToken& filebuf, CCompil
     // -- no namespace - must be a global function
     else
     {
-        functable = codeblock->GetScriptContext()->GetGlobalNamespace()->GetFuncTable();
+        nsentry = codeblock->GetScriptContext()->GetGlobalNamespace();
+        functable = nsentry->GetFuncTable();
     }
 
     if (!functable)
@@ -2489,8 +2345,19 @@ bool8 TryParseFuncDefinition(CCodeBlock* codeblock, tReadToken& filebuf, CCompil
 	CFunctionEntry* exists = functable->FindItem(funchash);
     CFunctionEntry* curfunction = exists;
 
+    // -- when reloading, the function is always defined from scratch, into an entry detached from the function
+    // -- table - the existing entry may still be executing, and is only replaced if the compiled code differs
+    if (codeblock->IsReloading())
+    {
+        exists = NULL;
+        curfunction = TinAlloc(ALLOC_FuncEntry, CFunctionEntry, codeblock->GetScriptContext(), nsentry->GetHash(),
+                               TokenPrint(idtoken), Hash(TokenPrint(idtoken)), eFuncTypeScript, (void*)NULL);
+        codeblock->AddReloadFunction(curfunction);
+        codeblock->smFuncDefinitionStack->Push(curfunction, NULL, 0);
+    }
+
     // -- if thus function doesn't exist, we're defining it now
-    if (! exists)
+    else if (! exists)
     {
 	    curfunction = FuncDeclaration(codeblock->GetScriptContext(), nshash, TokenPrint(idtoken),
                                       Hash(TokenPrint(idtoken)), eFuncTypeScript);
@@ -2749,10 +2616,10 @@ bool8 TryParseFuncDefinition(CCodeBlock* codeblock, tReadToken& filebuf, CCompil
     filebuf = peektoken;
 
     // -- add a funcdecl node, and set its left child to be the statement block
-    CFuncDeclNode* funcdeclnode = TinAlloc(ALLOC_TreeNode, CFuncDeclNode, codeblock, link,
-                                           filebuf.linenumber, idtoken.tokenptr, idtoken.length,
-                                           usenamespace ? nsnametoken.tokenptr : "",
-                                           usenamespace ? nsnametoken.length : 0, derived_hash);
+    CFuncDeclNode* funcdeclnode = TinAllocTreeNode(codeblock, CFuncDeclNode, codeblock, link,
+                                                   filebuf.linenumber, idtoken.tokenptr, idtoken.length,
+                                                   usenamespace ? nsnametoken.tokenptr : "",
+                                                   usenamespace ? nsnametoken.length : 0, derived_hash);
 
     // -- read the function body
     int32 result = ParseStatementBlock(codeblock, funcdeclnode->leftchild, filebuf, true);
@@ -2767,13 +2634,13 @@ bool8 TryParseFuncDefinition(CCodeBlock* codeblock, tReadToken& filebuf, CCompil
     // -- we're going to force every script function to have a return value, to ensure
     // -- we can consistently pop the stack after every function call regardless of return type
     // -- this node will never be hit, if a "real" return statement was found
-    CFuncReturnNode* funcreturnnode = TinAlloc(ALLOC_TreeNode, CFuncReturnNode, codeblock,
-                                               AppendToRoot(*funcdeclnode->leftchild),
-                                               filebuf.linenumber);
+    CFuncReturnNode* funcreturnnode = TinAllocTreeNode(codeblock, CFuncReturnNode, codeblock,
+                                                       AppendToRoot(*funcdeclnode->leftchild),
+                                                       filebuf.linenumber);
 
-    CValueNode* nullreturn = TinAlloc(ALLOC_TreeNode, CValueNode, codeblock,
-                                      funcreturnnode->leftchild, filebuf.linenumber, "", 0, false,
-                                      TYPE_int);
+    CValueNode* nullreturn = TinAllocTreeNode(codeblock, CValueNode, codeblock,
+                                              funcreturnnode->leftchild, filebuf.linenumber, "", 0, false,
+                                              TYPE_int);
     Unused_(nullreturn);
 
     // -- clear the active function definition
@@ -2837,11 +2704,11 @@ bool8 TryParseFuncCall(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTreeN
     // -- object available, there's no way to know, so methods currently require the 'self' keyword
 
     // -- add a funccall node, and set its left child to be the tree of parameter assignments
-    CFuncCallNode* funccallnode = TinAlloc(ALLOC_TreeNode, CFuncCallNode, codeblock, link,
-                                           filebuf.linenumber, idtoken.tokenptr, idtoken.length,
-                                           usenamespace ? nsnametoken.tokenptr : "",
-                                           usenamespace ? nsnametoken.length : 0,
-                                           ismethod);
+    CFuncCallNode* funccallnode = TinAllocTreeNode(codeblock, CFuncCallNode, codeblock, link,
+                                                   filebuf.linenumber, idtoken.tokenptr, idtoken.length,
+                                                   usenamespace ? nsnametoken.tokenptr : "",
+                                                   usenamespace ? nsnametoken.length : 0,
+                                                   ismethod);
 
     // -- $$$TZA add default args
 
@@ -2887,12 +2754,12 @@ bool8 TryParseFuncCall(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTreeN
         ++paramindex;
 
         // -- create an assignment binary op
-		CBinaryOpNode* binopnode = TinAlloc(ALLOC_TreeNode, CBinaryOpNode, codeblock,
+		CBinaryOpNode* binopnode = TinAllocTreeNode(codeblock, CBinaryOpNode, codeblock,
                                             AppendToRoot(*assignments), filebuf.linenumber,
                                             ASSOP_Assign, true, TYPE__resolve);
 
    		// -- create the (parameter) value node, add it to the assignment node
-		CValueNode* valuenode = TinAlloc(ALLOC_TreeNode, CValueNode, codeblock,
+		CValueNode* valuenode = TinAllocTreeNode(codeblock, CValueNode, codeblock,
                                          binopnode->leftchild, filebuf.linenumber, paramindex,
                                          TYPE__var);
         Unused_(valuenode);
@@ -2946,8 +2813,8 @@ bool8 TryParseBreakContinue(CCodeBlock* codeblock, tReadToken& filebuf, CCompile
     filebuf = peektoken;
 
     // -- add a return node to the tree, and parse the return expression
-    CLoopJumpNode* loopJumpNode = TinAlloc(ALLOC_TreeNode, CLoopJumpNode, codeblock, link, filebuf.linenumber,
-                                           gWhileLoopStack[gWhileLoopDepth - 1], reservedwordtype == KEYWORD_break);
+    CLoopJumpNode* loopJumpNode = TinAllocTreeNode(codeblock, CLoopJumpNode, codeblock, link, filebuf.linenumber,
+                                                   gWhileLoopStack[gWhileLoopDepth - 1], reservedwordtype == KEYWORD_break);
 
     // -- success
     return (true);
@@ -2987,8 +2854,8 @@ bool8 TryParseReturn(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTreeNod
     gGlobalReturnStatement = true;
 
     // -- add a return node to the tree, and parse the return expression
-    CFuncReturnNode* returnnode = TinAlloc(ALLOC_TreeNode, CFuncReturnNode, codeblock, link,
-                                           filebuf.linenumber);
+    CFuncReturnNode* returnnode = TinAllocTreeNode(codeblock, CFuncReturnNode, codeblock, link,
+                                                   filebuf.linenumber);
     bool8 result = TryParseStatement(codeblock, filebuf, returnnode->leftchild);
 	if (!result)
     {
@@ -3002,9 +2869,9 @@ bool8 TryParseReturn(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTreeNod
     // -- ensure we have a non-empty return - all functions return a value
     if (!returnnode->leftchild)
     {
-        CValueNode* nullreturn = TinAlloc(ALLOC_TreeNode, CValueNode, codeblock,
-                                          returnnode->leftchild, filebuf.linenumber, "", 0, false,
-                                          TYPE_int);
+        CValueNode* nullreturn = TinAllocTreeNode(codeblock, CValueNode, codeblock,
+                                                  returnnode->leftchild, filebuf.linenumber, "", 0, false,
+                                                  TYPE_int);
         Unused_(nullreturn);
     }
 
@@ -3015,6 +2882,78 @@ bool8 TryParseReturn(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTreeNod
     return (true);
 }
 
+// ====================================================================================================================
+// TryParseWait():  A "wait" (or "yield") statement suspends the function, valid within a function definition.
+// "wait <delay ms>;" resumes after the delay, "yield;" resumes on the next update.
+// ====================================================================================================================
+bool8 TryParseWait(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTreeNode*& link)
+{
+    // -- if we're already parsing a wait statement, ensure this is non-reentrant
+    if (gGlobalWaitStatement)
+        return (false);
+
+    // -- a wait is a statement, not an expression
+    if (gGlobalExprParenDepth > 0)
+        return (false);
+
+    // -- can't suspend a function, if there's no active function being defined
+    int32 stacktopdummy = 0;
+    CObjectEntry* dummy = NULL;
+    if (codeblock->smFuncDefinitionStack->GetTop(dummy, stacktopdummy) == NULL)
+        return (false);
+
+    // -- ensure the next token is the 'wait' or 'yield' keyword
+    tReadToken peektoken(filebuf);
+    if (!GetToken(peektoken) || peektoken.type != TOKEN_KEYWORD)
+        return (false);
+
+	int32 reservedwordtype = GetReservedKeywordType(peektoken.tokenptr, peektoken.length);
+    if (reservedwordtype != KEYWORD_wait && reservedwordtype != KEYWORD_yield)
+        return (false);
+
+    // -- committed
+    filebuf = peektoken;
+    gGlobalWaitStatement = true;
+
+    // -- add a wait node to the tree, and parse the delay expression
+    CWaitNode* waitnode = TinAllocTreeNode(codeblock, CWaitNode, codeblock, link, filebuf.linenumber);
+    bool8 result = TryParseStatement(codeblock, filebuf, waitnode->leftchild);
+	if (!result)
+    {
+		ScriptAssert_(codeblock->GetScriptContext(), 0, codeblock->GetFileName(),
+                      filebuf.linenumber,
+                      "Error - failed to parse '%s' statement\n",
+                      reservedwordtype == KEYWORD_wait ? "wait" : "yield");
+		gGlobalWaitStatement = false;
+		return (false);
+	}
+
+    // -- a yield has no delay, and a wait must have one
+    if (reservedwordtype == KEYWORD_yield ? waitnode->leftchild != NULL : waitnode->leftchild == NULL)
+    {
+		ScriptAssert_(codeblock->GetScriptContext(), 0, codeblock->GetFileName(),
+                      filebuf.linenumber,
+                      "Error - usage is 'wait <delay ms>;' or 'yield;'\n");
+		gGlobalWaitStatement = false;
+		return (false);
+    }
+
+    // -- a yield is simply a wait with no delay
+    if (!waitnode->leftchild)
+    {
+        CValueNode* nodelay = TinAllocTreeNode(codeblock, CValueNode, codeblock,
+                                               waitnode->leftchild, filebuf.linenumber, "", 0, false,
+                                               TYPE_int);
+        Unused_(nodelay);
+    }
+
+    // -- reset the global
+    gGlobalWaitStatement = false;
+
+    // -- success
+    return (true);
+}
+
 // ====================================================================================================================
 // TryParseArrayHash():  Used to dereference for both arrays and hashtables, parse an expression within []'s.
 // ====================================================================================================================
@@ -3031,8 +2970,8 @@ bool8 TryParseArrayHash(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTree
 
     // -- first we push a "0" hash - this will get bumped down every time we create a new
     // -- CArrayHash node
-    CValueNode* valnode = TinAlloc(ALLOC_TreeNode, CValueNode, codeblock, link,
-                                   filebuf.linenumber, "", 0, false, TYPE_int);
+    CValueNode* valnode = TinAllocTreeNode(codeblock, CValueNode, codeblock, link,
+                                           filebuf.linenumber, "", 0, false, TYPE_int);
     Unused_(valnode);
 
     // -- create a temp link, to look for the next array hash statement
@@ -3083,8 +3022,8 @@ bool8 TryParseArrayHash(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTree
         ++hashexprcount;
         ++gGlobalExprParenDepth;
         CCompileTreeNode* templink = NULL;
-        CArrayHashNode* ahn = TinAlloc(ALLOC_TreeNode, CArrayHashNode, codeblock, templink,
-                                       filebuf.linenumber);
+        CArrayHashNode* ahn = TinAllocTreeNode(codeblock, CArrayHashNode, codeblock, templink,
+                                               filebuf.linenumber);
 
         if (!TryParseStatement(codeblock, filebuf, ahn->rightchild))
         {
@@ -3170,8 +3109,90 @@ bool8 TryParseHash(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTreeNode*
     uint32 hash_value = Hash(string_token.tokenptr, string_token.length, true);
     char hash_value_buf[32];
     sprintf_s(hash_value_buf, 32, "%d", hash_value);
-    CValueNode* hash_node = TinAlloc(ALLOC_TreeNode, CValueNode, codeblock, link, filebuf.linenumber, hash_value_buf,
-                                     strlen(hash_value_buf), false, TYPE_int);
+    CValueNode* hash_node = TinAllocTreeNode(codeblock, CValueNode, codeblock, link, filebuf.linenumber, hash_value_buf,
+                                             strlen(hash_value_buf), false, TYPE_int);
+
+    // -- success
+    return (true);
+}
+
+// ====================================================================================================================
+// TryParseArrayOp():  The keywords "arraycount", "arrayresize" and "arraycopy" operate on an entire array variable.
+// ====================================================================================================================
+bool8 TryParseArrayOp(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTreeNode*& link)
+{
+    // -- ensure the next token is one of the array keywords
+    tReadToken peektoken(filebuf);
+    if (!GetToken(peektoken) || peektoken.type != TOKEN_KEYWORD)
+        return (false);
+
+	int32 reservedwordtype = GetReservedKeywordType(peektoken.tokenptr, peektoken.length);
+    eOpCode array_op = OP_NULL;
+    if (reservedwordtype == KEYWORD_arraycount)
+        array_op = OP_ArrayCount;
+    else if (reservedwordtype == KEYWORD_arrayresize)
+        array_op = OP_ArrayResize;
+    else if (reservedwordtype == KEYWORD_arraycopy)
+        array_op = OP_ArrayCopy;
+    else
+        return (false);
+
+    // -- we're committed to an array op
+    tReadToken keywordtoken(peektoken);
+    filebuf = peektoken;
+
+    // -- the formats are:  arraycount(array), arrayresize(array, size), arraycopy(dest_array, src_array)
+    if (!GetToken(peektoken) || peektoken.type != TOKEN_PAREN_OPEN)
+    {
+        ScriptAssert_(codeblock->GetScriptContext(), 0, codeblock->GetFileName(), filebuf.linenumber,
+                      "Error - %s() expression, expecting '('\n", TokenPrint(keywordtoken));
+        return (false);
+    }
+    filebuf = peektoken;
+
+    // -- increment the paren stack
+    ++gGlobalExprParenDepth;
+
+    CArrayOpNode* array_op_node = TinAllocTreeNode(codeblock, CArrayOpNode, codeblock, link, filebuf.linenumber,
+                                                   array_op);
+
+    // -- the first argument is always the array variable
+    if (!TryParseStatement(codeblock, filebuf, array_op_node->leftchild))
+    {
+        ScriptAssert_(codeblock->GetScriptContext(), 0, codeblock->GetFileName(), filebuf.linenumber,
+                      "Error - %s() expression, expecting an array variable\n", TokenPrint(keywordtoken));
+        return (false);
+    }
+
+    // -- resize takes the new size, copy takes the source array
+    if (array_op != OP_ArrayCount)
+    {
+        if (!GetToken(filebuf) || filebuf.type != TOKEN_COMMA)
+        {
+            ScriptAssert_(codeblock->GetScriptContext(), 0, codeblock->GetFileName(), filebuf.linenumber,
+                          "Error - %s() expression, expecting ','\n", TokenPrint(keywordtoken));
+            return (false);
+        }
+
+        if (!TryParseStatement(codeblock, filebuf, array_op_node->rightchild))
+        {
+            ScriptAssert_(codeblock->GetScriptContext(), 0, codeblock->GetFileName(), filebuf.linenumber,
+                          "Error - %s() expression, unable to evaluate the second argument\n",
+                          TokenPrint(keywordtoken));
+            return (false);
+        }
+    }
+
+    // -- read the closing parenthesis
+    if (!GetToken(filebuf) || filebuf.type != TOKEN_PAREN_CLOSE)
+    {
+        ScriptAssert_(codeblock->GetScriptContext(), 0, codeblock->GetFileName(), filebuf.linenumber,
+                      "Error - %s() expression, expecting ')'\n", TokenPrint(keywordtoken));
+        return (false);
+    }
+
+    // -- decrement the paren stack
+    --gGlobalExprParenDepth;
 
     // -- success
     return (true);
@@ -3266,16 +3287,16 @@ bool8 TryParseSchedule(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTreeN
     filebuf = peektoken;
 
     // -- add a CScheduleNode node
-    CScheduleNode* schedulenode = TinAlloc(ALLOC_TreeNode, CScheduleNode, codeblock, link,
-                                           filebuf.linenumber, delaytime, repeat_execution);
+    CScheduleNode* schedulenode = TinAllocTreeNode(codeblock, CScheduleNode, codeblock, link,
+                                                   filebuf.linenumber, delaytime, repeat_execution);
 
     // -- set its left child to be the tree resolving to an object ID
     schedulenode->leftchild = templink;
 
     // -- add a CSchedFuncNode node
-    CSchedFuncNode* schedulefunc = TinAlloc(ALLOC_TreeNode, CSchedFuncNode, codeblock,
-                                            schedulenode->rightchild, filebuf.linenumber,
-                                            immediate_execution);
+    CSchedFuncNode* schedulefunc = TinAllocTreeNode(codeblock, CSchedFuncNode, codeblock,
+                                                    schedulenode->rightchild, filebuf.linenumber,
+                                                    immediate_execution);
 
     // -- the left child is the tree resolving to a function hash
     result = TryParseStatement(codeblock, filebuf, schedulefunc->leftchild);
@@ -3326,7 +3347,7 @@ bool8 TryParseSchedule(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTreeN
         ++paramindex;
 
         // -- create a schedule param node
-		CSchedParamNode* schedparamnode = TinAlloc(ALLOC_TreeNode, CSchedParamNode, codeblock,
+		CSchedParamNode* schedparamnode = TinAllocTreeNode(codeblock, CSchedParamNode, codeblock,
                                                    AppendToRoot(*assignments), filebuf.linenumber,
                                                    paramindex);
 
@@ -3415,19 +3436,19 @@ bool8 TryParseCreateObject(CCodeBlock* codeblock, tReadToken& filebuf, CCompileT
     // -- create the node
     if (obj_name_expr_root != NULL)
     {
-        CCreateObjectNode* newobjnode = TinAlloc(ALLOC_TreeNode, CCreateObjectNode, codeblock,
-                                                 link, filebuf.linenumber, classtoken.tokenptr,
-                                                 classtoken.length);
+        CCreateObjectNode* newobjnode = TinAllocTreeNode(codeblock, CCreateObjectNode, codeblock,
+                                                         link, filebuf.linenumber, classtoken.tokenptr,
+                                                         classtoken.length);
         newobjnode->leftchild = obj_name_expr_root;
     }
     else
     {
-        CCreateObjectNode* newobjnode = TinAlloc(ALLOC_TreeNode, CCreateObjectNode, codeblock,
-                                                 link, filebuf.linenumber, classtoken.tokenptr,
-                                                 classtoken.length);
-        CValueNode* emptyname = TinAlloc(ALLOC_TreeNode, CValueNode, codeblock,
-                                         newobjnode->leftchild, filebuf.linenumber, "", 0, false,
-                                         TYPE_string);
+        CCreateObjectNode* newobjnode = TinAllocTreeNode(codeblock, CCreateObjectNode, codeblock,
+                                                         link, filebuf.linenumber, classtoken.tokenptr,
+                                                         classtoken.length);
+        CValueNode* emptyname = TinAllocTreeNode(codeblock, CValueNode, codeblock,
+                                                 newobjnode->leftchild, filebuf.linenumber, "", 0, false,
+                                                 TYPE_string);
 
         Unused_(emptyname);
     }
@@ -3466,8 +3487,8 @@ bool8 TryParseDestroyObject(CCodeBlock* codeblock, tReadToken& filebuf, CCompile
     gGlobalDestroyStatement = true;
 
     // -- create a destroy object node
-    CDestroyObjectNode* destroyobjnode = TinAlloc(ALLOC_TreeNode, CDestroyObjectNode, codeblock,
-                                                  link, filebuf.linenumber);
+    CDestroyObjectNode* destroyobjnode = TinAllocTreeNode(codeblock, CDestroyObjectNode, codeblock,
+                                                          link, filebuf.linenumber);
 
     // -- ensure we have a valid statement
     if (!TryParseStatement(codeblock, filebuf, destroyobjnode->leftchild))
@@ -3606,17 +3627,17 @@ static bool8 gDebugParseTree = false;
 // ====================================================================================================================
 // ParseFile():  Parse and compile a given file.
 // ====================================================================================================================
-CCodeBlock* ParseFile(CScriptContext* script_context, const char* filename)
+CCodeBlock* ParseFile(CScriptContext* script_context, const char* filename, bool8 is_reload)
 {
 	// -- see if we can open the file
 	const char* filebuf = ReadFileAllocBuf(filename);
-    return ParseText(script_context, filename, filebuf);
+    return ParseText(script_context, filename, filebuf, is_reload);
 }
 
 // ====================================================================================================================
 // ParseText();  Parse and compile a text block (loaded from the given file)
 // ====================================================================================================================
-CCodeBlock* ParseText(CScriptContext* script_context, const char* filename, const char* filebuf)
+CCodeBlock* ParseText(CScriptContext* script_context, const char* filename, const char* filebuf, bool8 is_reload)
 {
 
 #if DEBUG_CODEBLOCK
@@ -3634,6 +3655,7 @@ CCodeBlock* ParseText(CScriptContext* script_context, const char* filename, cons
         return (NULL);
 
     CCodeBlock* codeblock = TinAlloc(ALLOC_CodeBlock, CCodeBlock, script_context, filename);
+    codeblock->SetReloading(is_reload);
 
 	// create the starting root, initial token, and parse the existing statements
 	CCompileTreeNode* root = CCompileTreeNode::CreateTreeRoot(codeblock);
@@ -3643,6 +3665,7 @@ CCodeBlock* ParseText(CScriptContext* script_context, const char* filename, cons
 		ScriptAssert_(script_context, 0, codeblock->GetFileName(), parsetoken.linenumber,
                       "Error - failed to ParseStatementBlock()\n");
         codeblock->SetFinishedParsing();
+        DestroyTree(root);
         return (NULL);
 	}
 
@@ -3652,6 +3675,13 @@ CCodeBlock* ParseText(CScriptContext* script_context, const char* filename, cons
 	    DumpTree(root, 0, false, false);
     }
 
+#if DEBUG_CODEBLOCK
+    if (GetDebugCodeBlock())
+    {
+        TinPrint(script_context, "*** PARSE TREE: %d bytes\n", codeblock->GetParseArena()->GetAllocatedSize());
+    }
+#endif
+
     // we successfully created the tree, now calculate the size needed by running through the tree
     int32 size = codeblock->CalcInstrCount(*root);
     if (size < 0)
@@ -4053,6 +4083,31 @@ CVariableEntry* GetObjectMember(CScriptContext* script_context, CObjectEntry*& o
     return (ve);
 }
 
+// ====================================================================================================================
+// GetCompileVariable():  Find a variable referenced by the code being compiled - a local of the function being
+// defined, or else a global.
+// ====================================================================================================================
+CVariableEntry* GetCompileVariable(CCodeBlock* codeblock, uint32 var_hash)
+{
+    // -- the function being defined isn't necessarily in its function table (e.g. during a reload),
+    // -- so look up its locals directly, instead of resolving the function by hash
+    int32 stacktopdummy = 0;
+    CObjectEntry* dummy = NULL;
+    CFunctionEntry* curfunction = codeblock->smFuncDefinitionStack->GetTop(dummy, stacktopdummy);
+    if (curfunction)
+    {
+        CVariableEntry* ve = curfunction->GetContext()->GetLocalVar(var_hash);
+        if (ve)
+        {
+            // -- mark the variable entry with the owning function
+            ve->SetFunctionEntry(curfunction);
+            return (ve);
+        }
+    }
+
+    return (GetVariable(codeblock->GetScriptContext(), codeblock->smCurrentGlobalVarTable, 0, 0, var_hash, 0));
+}
+
 // ====================================================================================================================
 // GetVariable():  Given a NS hash, function or object ID, Var Hash, and an array hash, find the variable entry
 // ====================================================================================================================
@@ -4235,6 +4290,9 @@ CFunctionEntry* FuncDeclaration(CScriptContext* script_context, CNamespace* nsen
         TinFree(fe);
     }
 
+    // -- the namespace's method table is changing
+    script_context->NotifyMethodTableChanged();
+
 	// -- create the function entry, and add it to the global table
 	fe = TinAlloc(ALLOC_FuncEntry, CFunctionEntry, script_context, nsentry->GetHash(), funcname,
                                                    funchash, type, (void*)NULL);
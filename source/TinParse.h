@@ -180,10 +180,15 @@ enum eUnaryOpType
 	ReservedKeywordEntry(schedule)	\
     ReservedKeywordEntry(execute)	\
 	ReservedKeywordEntry(repeat)	\
+	ReservedKeywordEntry(wait)	    \
+	ReservedKeywordEntry(yield)	    \
     ReservedKeywordEntry(hash)	    \
 	ReservedKeywordEntry(create)   	\
 	ReservedKeywordEntry(destroy) 	\
 	ReservedKeywordEntry(self)   	\
+	ReservedKeywordEntry(arraycount)	\
+	ReservedKeywordEntry(arrayresize)	\
+	ReservedKeywordEntry(arraycopy)		\
 
 enum eReservedKeyword
 {
@@ -246,8 +251,9 @@ const char* ReadFileAllocBuf(const char* filename);
 CCompileTreeNode*& AppendToRoot(CCompileTreeNode& root);
 bool8 ParseStatementBlock(CCodeBlock* codeblock, CCompileTreeNode*& root, tReadToken& filebuf,
                          bool8 requiresbraceclose);
-CCodeBlock* ParseFile(CScriptContext* script_context, const char* filename);
-CCodeBlock* ParseText(CScriptContext* script_context, const char* filename, const char* filebuf);
+CCodeBlock* ParseFile(CScriptContext* script_context, const char* filename, bool8 is_reload = false);
+CCodeBlock* ParseText(CScriptContext* script_context, const char* filename, const char* filebuf,
+                      bool8 is_reload = false);
 
 bool8 SaveBinary(CCodeBlock* codeblock, const char* binfilename);
 CCodeBlock* LoadBinary(CScriptContext* script_context, const char* filename, const char* binfilename, bool8 must_exist,
@@ -256,6 +262,7 @@ CCodeBlock* LoadBinary(CScriptContext* script_context, const char* filename, con
 bool8 TryParseVarDeclaration(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTreeNode*& link);
 bool8 TryParseBreakContinue(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTreeNode*& link);
 bool8 TryParseReturn(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTreeNode*& link);
+bool8 TryParseWait(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTreeNode*& link);
 bool8 TryParseStatement(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTreeNode*& link);
 bool8 TryParseExpression(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTreeNode*& link);
 bool8 TryParseIfStatement(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTreeNode*& link);
@@ -266,6 +273,7 @@ bool8 TryParseFuncCall(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTreeN
                       bool8 ismethod);
 bool8 TryParseArrayHash(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTreeNode*& link);
 bool8 TryParseHash(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTreeNode*& link);
+bool8 TryParseArrayOp(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTreeNode*& link);
 bool8 TryParseSchedule(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTreeNode*& link);
 bool8 TryParseCreateObject(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTreeNode*& link);
 bool8 TryParseDestroyObject(CCodeBlock* codeblock, tReadToken& filebuf, CCompileTreeNode*& link);
@@ -278,6 +286,7 @@ CVariableEntry* AddVariable(CScriptContext* script_context, tVarTable* curglobal
 
 CVariableEntry* GetVariable(CScriptContext* script_context, tVarTable* globalVarTable, uint32 ns_hash,
                             uint32 func_or_obj, uint32 var_hash, uint32 array_hash);
+CVariableEntry* GetCompileVariable(CCodeBlock* codeblock, uint32 var_hash);
 
 CVariableEntry* GetObjectMember(CScriptContext* script_context, CObjectEntry*& oe, uint32 ns_hash,
                                 uint32 func_or_obj, uint32 var_hash, uint32 array_hash);
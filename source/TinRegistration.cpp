@@ -54,6 +54,8 @@ CVariableEntry::CVariableEntry(CScriptContext* script_context, const char* _name
     mAddr = _addr;
     mIsDynamic = false;
     mScriptVar = false;
+    mIsResizedArray = false;
+    mArraySource = NULL;
     mStringValueHash = 0;
     mStringHashArray = NULL;
     mStackOffset = -1;
@@ -91,6 +93,8 @@ CVariableEntry::CVariableEntry(CScriptContext* script_context, const char* _name
     mOffset = 0;
     mIsDynamic = _isdynamic;
     mScriptVar = false;
+    mIsResizedArray = false;
+    mArraySource = NULL;
     mStringValueHash = 0;
     mStringHashArray = NULL;
     mStackOffset = -1;
@@ -229,7 +233,7 @@ bool8 CVariableEntry::ConvertToArray(int32 array_size)
     }
 
     // -- validate the array size
-    if (array_size < 1 || array_size > kMaxVariableArraySize)
+    if (array_size < 1)
     {
         ScriptAssert_(GetScriptContext(), false, "<internal>", -1,
                       "Error - calling ConvertToArray() with an\ninvalid size %d, variable (%s)\n", array_size,
@@ -238,9 +242,10 @@ bool8 CVariableEntry::ConvertToArray(int32 array_size)
     }
 
     // -- see if the conversion has already happened - if we already have an allocated 
+    // -- (an array that has since been resized keeps its current storage, e.g. when its script is re-executed)
     if (mAddr)
     {
-        if (mArraySize != array_size)
+        if (mArraySize != array_size && !mIsResizedArray)
         {
             ScriptAssert_(GetScriptContext(), false, "<internal>", -1,
                           "Error - calling ConvertToArray() on a variable\nthat has already been allocated (%s)\n",
@@ -262,6 +267,61 @@ bool8 CVariableEntry::ConvertToArray(int32 array_size)
     return (true);
 }
 
+// ====================================================================================================================
+// ResizeArray():  Reallocates a script array, preserving its contents and zero-filling any new elements.
+// Only arrays owned by a variable may be resized - not registered or stack arrays - but a parameter bound to an owned
+// array resizes its source.
+// ====================================================================================================================
+bool8 CVariableEntry::ResizeArray(int32 new_size)
+{
+    if (mIsParameter && mArraySource)
+        return (mArraySource->ResizeArray(new_size));
+
+    if (!mScriptVar || mIsParameter || mOffset != 0 || !mAddr || !IsArray())
+    {
+        ScriptAssert_(GetScriptContext(), false, "<internal>", -1,
+                      "Error - calling ResizeArray() on an\ninvalid variable (%s)\n", UnHash(GetHash()));
+        return (false);
+    }
+
+    // -- string arrays maintain a parallel array of refcounted hashes, and hashtables can't be arrays
+    if (mType == TYPE_string || mType == TYPE_hashtable)
+    {
+        ScriptAssert_(GetScriptContext(), false, "<internal>", -1,
+                      "Error - ResizeArray() is not supported for type %s, variable (%s)\n",
+                      GetRegisteredTypeName(mType), UnHash(GetHash()));
+        return (false);
+    }
+
+    if (new_size < 1)
+    {
+        ScriptAssert_(GetScriptContext(), false, "<internal>", -1,
+                      "Error - calling ResizeArray() with an\ninvalid size %d, variable (%s)\n", new_size,
+                      UnHash(GetHash()));
+        return (false);
+    }
+
+    // -- once resized, this remains an array, regardless of its size
+    mIsResizedArray = true;
+    if (new_size == mArraySize)
+        return (true);
+
+    // -- allocate the new storage, and copy across the elements that survive
+    int32 type_size = gRegisteredTypeSize[mType];
+    int32 copy_count = new_size < mArraySize ? new_size : mArraySize;
+    char* new_addr = TinAllocArray(ALLOC_VarStorage, char, type_size * new_size);
+    memcpy(new_addr, mAddr, type_size * copy_count);
+    if (new_size > copy_count)
+        memset(new_addr + (type_size * copy_count), 0, type_size * (new_size - copy_count));
+
+    TinFreeArray((char*)mAddr);
+    mAddr = (void*)new_addr;
+    mArraySize = new_size;
+
+    // -- success
+    return (true);
+}
+
 // ====================================================================================================================
 // ClearArrayParameter():  Array parameters are like references, clear the details upon function return.
 // ====================================================================================================================
@@ -272,6 +332,8 @@ void CVariableEntry::ClearArrayParameter()
                     "Error - calling ClearArrayParameter() on an invalid variable (%s)\n",
                     UnHash(GetHash()));
     mArraySize = -1;
+    mIsResizedArray = false;
+    mArraySource = NULL;
     mAddr = NULL;
     mStringHashArray = NULL;
 }
@@ -296,6 +358,7 @@ void CVariableEntry::InitializeArrayParameter(CVariableEntry* assign_from_ve, CO
     mIsDynamic = assign_from_ve->mIsDynamic;
     mScriptVar = assign_from_ve->mScriptVar;
     mArraySize = assign_from_ve->mArraySize;
+    mIsResizedArray = assign_from_ve->mIsResizedArray;
     mStringHashArray = assign_from_ve->mStringHashArray;
 
     // -- the address is the usual complication, based on object member, dynamic var, global, registered, ...
@@ -311,7 +374,16 @@ void CVariableEntry::InitializeArrayParameter(CVariableEntry* assign_from_ve, CO
     else if (assign_from_oe && !assign_from_ve->mIsDynamic)
         valueaddr = (void*)((char*)assign_from_oe->GetAddr() + assign_from_ve->mOffset);
     else
+    {
         valueaddr = assign_from_ve->mAddr;
+
+        // -- an array owned by a script variable can be resized while the parameter is bound to it, so the
+        // -- parameter refers to the source for its storage and size (following a parameter passed on)
+        if (assign_from_ve->mIsParameter)
+            mArraySource = assign_from_ve->mArraySource;
+        else if (assign_from_ve->mScriptVar && assign_from_ve->mOffset == 0)
+            mArraySource = assign_from_ve;
+    }
     mAddr = valueaddr;
 }
 
@@ -796,6 +868,7 @@ CFunctionEntry::CFunctionEntry(CScriptContext* script_context, uint32 _nshash, c
 	SafeStrcpy(mName, _name, kMaxNameLength);
 	mType = _type;
 	mHash = _hash;
+    mEntryID = script_context->GetNextFunctionEntryID();
     mNamespaceHash = _nshash;
 	mAddr = _addr;
     mCodeblock = NULL;
@@ -814,6 +887,7 @@ CFunctionEntry::CFunctionEntry(CScriptContext* script_context, uint32 _nshash, c
 	SafeStrcpy(mName, _name, kMaxNameLength);
 	mType = _type;
 	mHash = _hash;
+    mEntryID = script_context->GetNextFunctionEntryID();
     mNamespaceHash = _nshash;
     mCodeblock = NULL;
 	mInstrOffset = 0;
@@ -851,14 +925,20 @@ void* CFunctionEntry::GetAddr() const
 // ====================================================================================================================
 void CFunctionEntry::SetCodeBlockOffset(CCodeBlock* _codeblock, uint32 _offset)
 {
-    // -- if we're switching codeblocks (recompiling...) change owners
-    if (mCodeblock && mCodeblock != _codeblock)
-        mCodeblock->RemoveFunction(this);
+    // -- if we're switching codeblocks (recompiling...) change owners - each entry holds one codeblock reference
+    if (mCodeblock != _codeblock)
+    {
+        if (_codeblock)
+            _codeblock->AddFunction(this);
+        if (mCodeblock)
+            mCodeblock->RemoveFunction(this);
+    }
 
     mCodeblock = _codeblock;
     mInstrOffset = _offset;
-    if (mCodeblock)
-        mCodeblock->AddFunction(this);
+
+    // -- a (re)defined function may have a different set of locals, invalidating cached lifecycle hooks
+    GetScriptContext()->NotifyMethodTableChanged();
 }
 
 // ====================================================================================================================
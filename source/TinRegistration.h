@@ -157,6 +157,7 @@ class CFunctionEntry
 		}
 
 		uint32 GetHash() const { return (mHash); }
+		uint32 GetEntryID() const { return (mEntryID); }
 		void* GetAddr() const;
 
         void SetCodeBlockOffset(CCodeBlock* _codeblock, uint32 _offset);
@@ -174,6 +175,7 @@ class CFunctionEntry
 
 		char mName[kMaxNameLength];
 		uint32 mHash;
+		uint32 mEntryID;
 		EFunctionType mType;
         uint32 mNamespaceHash;
 
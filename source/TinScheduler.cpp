@@ -34,6 +34,7 @@
 #include "TinInterface.h"
 #include "TinExecute.h"
 #include "TinScheduler.h"
+#include "TinSnapshot.h"
 
 // == namespace TinScript =============================================================================================
 
@@ -50,8 +51,10 @@ CScheduler::CScheduler(CScriptContext* script_context)
     mContextOwner = script_context;
     mHead = NULL;
     mCurrentSimTime = 0;
+    mScheduleID = 0;
     mCurrentSchedule = NULL;
     mSimTimeScale = 1.0f;
+    mDebuggerListCursor = NULL;
 }
 
 // ====================================================================================================================
@@ -81,18 +84,25 @@ void CScheduler::Update(uint32 curtime)
         // -- get the current command, and remove it from the list - now, before we execute,
         // -- since executing this command could 
         CCommand* curcommand = mHead;
+        DebuggerUnlinkCommand(curcommand);
         if (curcommand->mNext)
             curcommand->mNext->mPrev = NULL;
         mHead = curcommand->mNext;
 
-        // -- notify the debugger
-        DebuggerRemoveSchedule(curcommand->mReqID);
-
-        // -- dispatch the command - see if it's a direct function call, or a command buf
-        if (curcommand->mFuncHash != 0)
+        // -- dispatch the command - resume a suspended function, or see if it's a direct function call,
+        // -- or a command buf
+        if (curcommand->mCoroutine)
+        {
+            if (!curcommand->mCoroutine->Resume() || !curcommand->mCoroutine->IsSuspended())
+            {
+                TinFree(curcommand->mCoroutine);
+                curcommand->mCoroutine = NULL;
+            }
+        }
+        else if (curcommand->mFuncHash != 0)
         {
             ExecuteScheduledFunction(GetScriptContext(), curcommand->mObjectID, 0, curcommand->mFuncHash,
-                                     curcommand->mFuncContext);
+                                     curcommand->mFuncContext, &curcommand->mCoroutine);
         }
         else
         {
@@ -108,45 +118,70 @@ void CScheduler::Update(uint32 curtime)
             }
         }
 
-        // -- if the command is to be repeated, re-insert it back into the list
-        if (curcommand->mRepeatTime > 0)
+        // -- if the function suspended itself, re-insert the command to resume it
+        // -- (unless the method's object was destroyed while it was executing)
+        if (curcommand->mCoroutine)
         {
-            // -- first, update the dispatch time
-            curcommand->mDispatchTime = mCurrentSimTime + curcommand->mRepeatTime;
-
-            // -- see if it goes at the front of the list
-            if (!mHead || curcommand->mDispatchTime < mHead->mDispatchTime)
+            if (curcommand->mObjectID != 0 && !GetScriptContext()->FindObjectEntry(curcommand->mObjectID))
             {
-                curcommand->mNext = mHead;
-                curcommand->mPrev = NULL;
-                if(mHead)
-                    mHead->mPrev = curcommand;
-                mHead = curcommand;
+                DebuggerRemoveSchedule(curcommand->mReqID);
+                TinFree(curcommand);
             }
             else
             {
-                // -- insert it into the list, in after curschedule
-                CCommand* curschedule = mHead;
-                while (curschedule->mNext && curschedule->mDispatchTime < curcommand->mDispatchTime)
-                    curschedule = curschedule->mNext;
-                curcommand->mNext = curschedule->mNext;
-                curcommand->mPrev = curschedule;
-                if (curschedule->mNext)
-                    curschedule->mNext->mPrev = curcommand;
-                curschedule->mNext = curcommand;
+                // -- a yield (or wait 0) resumes on the next update
+                int32 delay = curcommand->mCoroutine->GetResumeDelay();
+                curcommand->mDispatchTime = mCurrentSimTime + (delay > 0 ? delay : 1);
+                InsertCommand(curcommand);
+                DebuggerRescheduleSchedule(*curcommand);
             }
+        }
 
-            // -- notify the debugger
-            DebuggerAddSchedule(*curcommand);
+        // -- if the command is to be repeated, re-insert it back into the list
+        else if (curcommand->mRepeatTime > 0)
+        {
+            // -- first, update the dispatch time
+            curcommand->mDispatchTime = mCurrentSimTime + curcommand->mRepeatTime;
+            InsertCommand(curcommand);
+            DebuggerRescheduleSchedule(*curcommand);
         }
         else
         {
-            // -- delete the command
+            // -- notify the debugger, and delete the command
+            DebuggerRemoveSchedule(curcommand->mReqID);
             TinFree(curcommand);
         }
     }
 }
 
+// ====================================================================================================================
+// InsertCommand():  Insert a command back into the list, sorted by its dispatch time.
+// ====================================================================================================================
+void CScheduler::InsertCommand(CCommand* curcommand)
+{
+    // -- see if it goes at the front of the list
+    if (!mHead || curcommand->mDispatchTime < mHead->mDispatchTime)
+    {
+        curcommand->mNext = mHead;
+        curcommand->mPrev = NULL;
+        if(mHead)
+            mHead->mPrev = curcommand;
+        mHead = curcommand;
+    }
+    else
+    {
+        // -- insert it into the list, in after curschedule
+        CCommand* curschedule = mHead;
+        while (curschedule->mNext && curschedule->mDispatchTime < curcommand->mDispatchTime)
+            curschedule = curschedule->mNext;
+        curcommand->mNext = curschedule->mNext;
+        curcommand->mPrev = curschedule;
+        if (curschedule->mNext)
+            curschedule->mNext->mPrev = curcommand;
+        curschedule->mNext = curcommand;
+    }
+}
+
 // ====================================================================================================================
 // SetSimTimeScale():  Allows the scheduler to communicate with the debugger for accurate reflection of schedules.
 // ====================================================================================================================
@@ -157,11 +192,7 @@ void CScheduler::SetSimTimeScale(float time_scale)
         mSimTimeScale = 0.0f;
 
     // -- if we're connected, notify the debugger
-    int32 debugger_session = 0;
-    if (GetScriptContext()->IsDebuggerConnected(debugger_session))
-    {
-        SocketManager::SendCommandf("DebuggerNotifyTimeScale(%f);", mSimTimeScale);
-    }
+    GetScriptContext()->DebuggerNotifyTimeScale(mSimTimeScale);
 }
 
 // ====================================================================================================================
@@ -174,6 +205,122 @@ void CScheduler::CancelObject(uint32 objectid)
     Cancel(objectid, 0);
 }
 
+// ====================================================================================================================
+// CancelObjects():  On destruction of many objects, cancel all their scheduled method calls in a single pass.
+// The object IDs must be sorted in ascending order.
+// ====================================================================================================================
+void CScheduler::CancelObjects(const uint32* sorted_object_ids, int32 count)
+{
+    if (!sorted_object_ids || count <= 0)
+        return;
+
+    CCommand** prevcommand = &mHead;
+    CCommand* curcommand = mHead;
+    while (curcommand)
+    {
+        // -- binary search for the command's object
+        bool8 found = false;
+        if (curcommand->mObjectID != 0)
+        {
+            int32 low = 0;
+            int32 high = count - 1;
+            while (low <= high)
+            {
+                int32 mid = (low + high) / 2;
+                if (sorted_object_ids[mid] == curcommand->mObjectID)
+                {
+                    found = true;
+                    break;
+                }
+                else if (sorted_object_ids[mid] < curcommand->mObjectID)
+                    low = mid + 1;
+                else
+                    high = mid - 1;
+            }
+        }
+
+        if (found)
+        {
+            // -- notify the debugger
+            DebuggerUnlinkCommand(curcommand);
+            DebuggerRemoveSchedule(curcommand->mReqID);
+
+            *prevcommand = curcommand->mNext;
+            TinFree(curcommand);
+            curcommand = *prevcommand;
+        }
+        else
+        {
+            prevcommand = &curcommand->mNext;
+            curcommand = curcommand->mNext;
+        }
+    }
+}
+
+// ====================================================================================================================
+// CancelCoroutines():  Cancel the suspended executions of a function that is being retired - NULL cancels all.
+// ====================================================================================================================
+void CScheduler::CancelCoroutines(CFunctionEntry* fe)
+{
+    CCommand** prevcommand = &mHead;
+    CCommand* curcommand = mHead;
+    while (curcommand)
+    {
+        if (curcommand->mCoroutine && (!fe || curcommand->mCoroutine->GetFunctionEntry() == fe))
+        {
+            // -- notify the debugger
+            DebuggerUnlinkCommand(curcommand);
+            DebuggerRemoveSchedule(curcommand->mReqID);
+
+            *prevcommand = curcommand->mNext;
+            if (curcommand->mNext)
+                curcommand->mNext->mPrev = curcommand->mPrev;
+            TinFree(curcommand);
+            curcommand = *prevcommand;
+        }
+        else
+        {
+            prevcommand = &curcommand->mNext;
+            curcommand = curcommand->mNext;
+        }
+    }
+}
+
+// ====================================================================================================================
+// MoveCoroutines():  Move the suspended executions of a function that a reload moved, unchanged, to a new codeblock.
+// ====================================================================================================================
+void CScheduler::MoveCoroutines(CFunctionEntry* fe, CCodeBlock* from_codeblock, CCodeBlock* to_codeblock,
+                                int32 offset_delta)
+{
+    CCommand* curcommand = mHead;
+    while (curcommand)
+    {
+        if (curcommand->mCoroutine && curcommand->mCoroutine->GetFunctionEntry() == fe)
+        {
+            // -- a coroutine suspended in an earlier definition of the function isn't moved (it can't be resumed)
+            uint32 resume_offset = 0;
+            if (curcommand->mCoroutine->GetFuncCallStack().GetSuspendCodeBlock(resume_offset) == from_codeblock)
+                curcommand->mCoroutine->MoveCodeBlock(to_codeblock, offset_delta);
+        }
+        curcommand = curcommand->mNext;
+    }
+}
+
+// ====================================================================================================================
+// GetCoroutineCount():  Returns the number of suspended functions waiting to be resumed.
+// ====================================================================================================================
+int32 CScheduler::GetCoroutineCount() const
+{
+    int32 count = 0;
+    for (const CCommand* curcommand = mHead; curcommand; curcommand = curcommand->mNext)
+    {
+        if (curcommand->mCoroutine)
+            ++count;
+    }
+
+    return (count);
+}
+
 // ====================================================================================================================
 // CancelRequest():  Cancel a scheduled function/method call by ID
 // ====================================================================================================================
@@ -197,6 +344,7 @@ void CScheduler::Cancel(uint32 objectid, int32 reqid)
         if (curcommand->mObjectID == objectid || curcommand->mReqID == reqid)
         {
             // -- notify the debugger
+            DebuggerUnlinkCommand(curcommand);
             DebuggerRemoveSchedule(curcommand->mReqID);
 
             *prevcommand = curcommand->mNext;
@@ -235,7 +383,37 @@ void CScheduler::Dump()
 }
 
 // ====================================================================================================================
-// DebuggerListSchedules():  Send the connected debugger a list of schedules
+// DumpPage():  Display a page of the scheduled requests, in dispatch order - returns the number displayed.
+// ====================================================================================================================
+int32 CScheduler::DumpPage(int32 first, int32 count)
+{
+    // -- skip to the first request of the page
+    CCommand* curcommand = mHead;
+    for (int32 i = 0; curcommand && i < first; ++i)
+        curcommand = curcommand->mNext;
+
+    int32 dump_count = 0;
+    while (curcommand && dump_count < count)
+    {
+        if (curcommand->mFuncHash != 0)
+        {
+            TinPrint(GetScriptContext(), "ReqID: %d, ObjID: %d, Function: %s\n", curcommand->mReqID,
+                     curcommand->mObjectID, UnHash(curcommand->mFuncHash));
+        }
+        else
+        {
+            TinPrint(GetScriptContext(), "ReqID: %d, ObjID: %d, Command: %s\n", curcommand->mReqID,
+                     curcommand->mObjectID, curcommand->mCommandBuf);
+        }
+        curcommand = curcommand->mNext;
+        ++dump_count;
+    }
+
+    return (dump_count);
+}
+
+// ====================================================================================================================
+// DebuggerListSchedules():  Begin sending the connected debugger the list of schedules, a budget at a time.
 // ====================================================================================================================
 void CScheduler::DebuggerListSchedules()
 {
@@ -245,14 +423,39 @@ void CScheduler::DebuggerListSchedules()
         return;
 
     // -- this is a good time to notify the debugger of our current timescale, as it tends to be called "on connect"
-    SocketManager::SendCommandf("DebuggerNotifyTimeScale(%f);", mSimTimeScale);
+    GetScriptContext()->DebuggerNotifyTimeScale(mSimTimeScale);
 
-    // -- loop through and delete any schedules pending for this object
-    CCommand* curcommand = mHead;
-    while (curcommand)
+    // -- any listing in progress is restarted
+    mDebuggerListCursor = mHead;
+}
+
+// ====================================================================================================================
+// DebuggerUpdateListSchedules():  Send the next budget of schedules from the pending listing.
+// Schedules added, rescheduled or removed while the listing is in progress are notified as they change, so the
+// cursor only needs to be kept valid as commands are removed from the list (see DebuggerUnlinkCommand()).
+// ====================================================================================================================
+void CScheduler::DebuggerUpdateListSchedules()
+{
+    int32 budget = kDebuggerListScheduleBudget;
+    while (mDebuggerListCursor && budget-- > 0)
     {
-        DebuggerAddSchedule(*curcommand);
-        curcommand = curcommand->mNext;
+        DebuggerAddSchedule(*mDebuggerListCursor);
+        mDebuggerListCursor = mDebuggerListCursor->mNext;
+    }
+}
+
+// ====================================================================================================================
+// DebuggerUnlinkCommand():  Called before a command is removed from the list, to keep the listing cursor valid.
+// This may list the command, so a removed command must be unlinked before DebuggerRemoveSchedule() is sent.
+// ====================================================================================================================
+void CScheduler::DebuggerUnlinkCommand(CCommand* command)
+{
+    // -- a repeating or resumed command is inserted again, possibly before the cursor, so rather than skip it,
+    // -- it's listed now - if it isn't inserted again, its removal follows
+    if (mDebuggerListCursor == command)
+    {
+        DebuggerAddSchedule(*command);
+        mDebuggerListCursor = command->mNext;
     }
 }
 
@@ -270,22 +473,44 @@ void CScheduler::DebuggerAddSchedule(const CCommand& command)
     if (time_remaining_ms < 0)
         time_remaining_ms = 0;
 
-    char debug_msg[kMaxTokenLength];
+    // -- a function schedule is displayed as a call
+    char func_call[kMaxNameLength];
+    const char* command_str = command.mCommandBuf;
     if (command.mFuncHash != 0)
     {
-        sprintf_s(debug_msg, "DebuggerAddSchedule(%d, %s, %d, %d, `%s();`);", command.mReqID,
-                  command.mRepeatTime > 0 ? "true" : "false", time_remaining_ms, command.mObjectID,
-                  UnHash(command.mFuncHash));
+        sprintf_s(func_call, "%s();", UnHash(command.mFuncHash));
+        command_str = func_call;
     }
-    else
+
+    // -- send the notification
+    GetScriptContext()->DebuggerNotifyAddSchedule(command.mReqID, command.mRepeatTime > 0, time_remaining_ms,
+                                                  command.mObjectID, command_str);
+}
+
+// ====================================================================================================================
+// DebuggerRescheduleSchedule():  Send the connected debugger the new time remaining, of a repeated or resumed schedule.
+// ====================================================================================================================
+void CScheduler::DebuggerRescheduleSchedule(const CCommand& command)
+{
+    // -- nothing to send if we're not connected
+    int32 debugger_session = 0;
+    if (!GetScriptContext()->IsDebuggerConnected(debugger_session))
+        return;
+
+    // -- while a listing is in progress, a command may have moved from after the cursor to before it, in which
+    // -- case the debugger doesn't have it yet, and needs the whole command
+    if (mDebuggerListCursor != NULL)
     {
-        sprintf_s(debug_msg, "DebuggerAddSchedule(%d, %s, %d, %d, `%s`);", command.mReqID,
-                  command.mRepeatTime > 0 ? "true" : "false", time_remaining_ms, command.mObjectID,
-                  command.mCommandBuf);
+        DebuggerAddSchedule(command);
+        return;
     }
 
-    // -- send the command
-    SocketManager::SendCommand(debug_msg);
+    int32 time_remaining_ms = static_cast<int32>(command.mDispatchTime) - static_cast<int32>(mCurrentSimTime);
+    if (time_remaining_ms < 0)
+        time_remaining_ms = 0;
+
+    // -- the debugger already has the command, so only the time is sent
+    GetScriptContext()->DebuggerNotifyRescheduleSchedule(command.mReqID, time_remaining_ms);
 }
 
 // ====================================================================================================================
@@ -298,8 +523,8 @@ void CScheduler::DebuggerRemoveSchedule(int32 req_id)
     if (!GetScriptContext()->IsDebuggerConnected(debugger_session))
         return;
 
-    // -- send the command
-    SocketManager::SendCommandf("DebuggerRemoveSchedule(%d);", req_id);
+    // -- send the notification
+    GetScriptContext()->DebuggerNotifyRemoveSchedule(req_id);
 }
 
 // == class CScheduler::CCommand ======================================================================================
@@ -325,6 +550,7 @@ CScheduler::CCommand::CCommand(CScriptContext* script_context, int32 _reqid, uin
     // -- command string, null out the direct function call members
     mFuncHash = 0;
     mFuncContext = NULL;
+    mCoroutine = NULL;
 }
 
 // ====================================================================================================================
@@ -347,6 +573,7 @@ CScheduler::CCommand::CCommand(CScriptContext* script_context, int32 _reqid, uin
     // -- command string, null out the direct function call members
     mFuncHash = _funchash;
     mFuncContext = TinAlloc(ALLOC_FuncContext, CFunctionContext, script_context);
+    mCoroutine = NULL;
 }
 
 // ====================================================================================================================
@@ -354,6 +581,10 @@ CScheduler::CCommand::CCommand(CScriptContext* script_context, int32 _reqid, uin
 // ====================================================================================================================
 CScheduler::CCommand::~CCommand()
 {
+    // -- clean up a suspended function
+    if (mCoroutine)
+        TinFree(mCoroutine);
+
     // clean up the function context, if it exists
     if(mFuncContext)
         TinFree(mFuncContext);
@@ -362,10 +593,9 @@ CScheduler::CCommand::~CCommand()
 // ====================================================================================================================
 // Schedule():  Schedule a raw text command.
 // ====================================================================================================================
-static int32 gScheduleID = 0;
 int32 CScheduler::Schedule(uint32 objectid, int32 delay, bool8 repeat, const char* commandstring)
 {
-    ++gScheduleID;
+    ++mScheduleID;
 
     // -- ensure we have a valid command string
     if(!commandstring || !commandstring[0])
@@ -377,7 +607,7 @@ int32 CScheduler::Schedule(uint32 objectid, int32 delay, bool8 repeat, const cha
     uint32 repeat_time = repeat ? delay_time : 0;
 
     // -- create the new commmand
-    CCommand* newcommand = TinAlloc(ALLOC_SchedCmd, CCommand, GetScriptContext(), gScheduleID,
+    CCommand* newcommand = TinAlloc(ALLOC_SchedCmd, CCommand, GetScriptContext(), mScheduleID,
                                     objectid, dispatchtime, repeat_time, commandstring);
 
     // -- see if it goes at the front of the list
@@ -416,7 +646,7 @@ int32 CScheduler::Schedule(uint32 objectid, int32 delay, bool8 repeat, const cha
 CScheduler::CCommand* CScheduler::ScheduleCreate(uint32 objectid, int32 delay, uint32 funchash, bool8 immediate,
                                                  bool8 repeat)
 {
-    ++gScheduleID;
+    ++mScheduleID;
 
     // -- calculate the dispatch time - enforce a one-frame delay
     uint32 delay_time = (delay > 0 ? delay : 1);
@@ -424,7 +654,7 @@ CScheduler::CCommand* CScheduler::ScheduleCreate(uint32 objectid, int32 delay, u
     uint32 repeat_time = repeat ? delay_time : 0;
 
     // -- create the new commmand
-    CCommand* newcommand = TinAlloc(ALLOC_SchedCmd, CCommand, GetScriptContext(), gScheduleID,
+    CCommand* newcommand = TinAlloc(ALLOC_SchedCmd, CCommand, GetScriptContext(), mScheduleID,
                                     objectid, dispatchtime, repeat_time, funchash, immediate);
 
     // -- add space to store a return value
@@ -471,6 +701,162 @@ int32 CScheduler::Thread(int32 reqid, uint32 objectid, int32 delay, const char*
     return newreqid;
 }
 
+// ====================================================================================================================
+// WriteSnapshot():  Write the pending requests, with their remaining delay.
+// ====================================================================================================================
+void CScheduler::WriteSnapshot(CSnapshotWriter& writer)
+{
+    int32 count_offset = writer.ReserveInt32();
+    int32 count = 0;
+    int32 skipped_count = 0;
+
+    CCommand* curcommand = mHead;
+    while (curcommand)
+    {
+        // -- a suspended function, or a parameter that refers to a hashtable, can't be restored
+        bool8 can_write = (curcommand->mCoroutine == NULL);
+        int32 param_count = curcommand->mFuncHash != 0 ? curcommand->mFuncContext->GetParameterCount() : 0;
+        for (int32 i = 1; can_write && i < param_count; ++i)
+        {
+            CVariableEntry* ve = curcommand->mFuncContext->GetParameter(i);
+            can_write = writer.CanWriteVariable(ve) && ve->GetType() != TYPE_hashtable;
+        }
+
+        if (!can_write)
+        {
+            ++skipped_count;
+            curcommand = curcommand->mNext;
+            continue;
+        }
+
+        uint32 delay = curcommand->mDispatchTime > mCurrentSimTime ? curcommand->mDispatchTime - mCurrentSimTime : 1;
+        writer.WriteInt32(curcommand->mReqID);
+        writer.WriteUInt32(curcommand->mObjectID);
+        writer.WriteUInt32(delay);
+        writer.WriteUInt32(curcommand->mRepeatTime);
+        writer.WriteHashString(curcommand->mFuncHash);
+
+        // -- parameter 0 is the return value
+        if (curcommand->mFuncHash != 0)
+        {
+            writer.WriteInt32(param_count > 0 ? param_count - 1 : 0);
+            for (int32 i = 1; i < param_count; ++i)
+                writer.WriteVariable(curcommand->mFuncContext->GetParameter(i), NULL);
+        }
+        else
+        {
+            writer.WriteString(curcommand->mCommandBuf);
+        }
+
+        ++count;
+        curcommand = curcommand->mNext;
+    }
+
+    writer.PatchInt32(count_offset, count);
+    if (skipped_count > 0)
+    {
+        TinPrintWarning(GetScriptContext(), "Warning - snapshot skipped %d suspended or unrestorable schedules\n",
+                        skipped_count);
+    }
+}
+
+// ====================================================================================================================
+// ReadSnapshot():  Restore the pending requests, keeping their request IDs unless they're already in use.
+// Requests for objects that weren't restored are skipped.  The object of a request, and its object parameters, are
+// remapped to the restored IDs - but a command string is restored verbatim, so any object IDs within its text
+// (e.g. "Foo(1234);") still refer to the saved IDs.  Schedule a function by hash, to pass an object.
+// ====================================================================================================================
+bool8 CScheduler::ReadSnapshot(CSnapshotReader& reader)
+{
+    int32 last_issued_id = mScheduleID;
+    int32 count = reader.ReadCount();
+    for (int32 i = 0; i < count && !reader.HasError(); ++i)
+    {
+        int32 reqid = reader.ReadInt32();
+        uint32 saved_object_id = reader.ReadUInt32();
+        uint32 delay = reader.ReadUInt32();
+        uint32 repeat_time = reader.ReadUInt32();
+        uint32 funchash = reader.ReadHashString();
+
+        uint32 objectid = reader.RemapObjectID(saved_object_id);
+        bool8 restore = (saved_object_id == 0 || objectid != 0);
+
+        // -- request IDs may be stored in script variables, so keep them if we can
+        if (restore && reqid <= last_issued_id)
+        {
+            for (CCommand* command = mHead; command != NULL; command = command->mNext)
+            {
+                if (command->mReqID == reqid)
+                {
+                    reqid = ++mScheduleID;
+                    break;
+                }
+            }
+        }
+
+        uint32 dispatchtime = mCurrentSimTime + (delay > 0 ? delay : 1);
+        CCommand* newcommand = NULL;
+        if (funchash != 0)
+        {
+            if (restore)
+            {
+                newcommand = TinAlloc(ALLOC_SchedCmd, CCommand, GetScriptContext(), reqid, objectid, dispatchtime,
+                                      repeat_time, funchash, false);
+                newcommand->mFuncContext->AddParameter("__return", Hash("__return"), TYPE__resolve, 1, 0);
+            }
+
+            int32 param_count = reader.ReadCount();
+            for (int32 param_index = 1; param_index <= param_count; ++param_index)
+            {
+                uint32 var_hash = 0;
+                eVarType type = TYPE_void;
+                int32 value_count = 0;
+                if (!reader.ReadVariableHeader(var_hash, type, value_count))
+                    break;
+
+                CVariableEntry* ve = NULL;
+                if (newcommand)
+                {
+                    // -- the value count is the array size the parameter was saved with (1 for a non-array)
+                    int32 array_size = value_count > 0 ? value_count : 1;
+                    newcommand->mFuncContext->AddParameter(UnHash(var_hash), var_hash, type, array_size,
+                                                           param_index, 0);
+                    ve = newcommand->mFuncContext->GetParameter(param_index);
+                }
+
+                if (!reader.ReadVariableValues(ve, NULL, type, value_count))
+                    break;
+            }
+        }
+        else
+        {
+            const char* commandstring = reader.ReadString();
+            if (restore && commandstring[0])
+            {
+                newcommand = TinAlloc(ALLOC_SchedCmd, CCommand, GetScriptContext(), reqid, objectid, dispatchtime,
+                                      repeat_time, commandstring);
+            }
+        }
+
+        if (reader.HasError())
+        {
+            if (newcommand)
+                TinFree(newcommand);
+            return (false);
+        }
+
+        if (newcommand)
+        {
+            if (reqid > mScheduleID)
+                mScheduleID = reqid;
+            InsertCommand(newcommand);
+            DebuggerAddSchedule(*newcommand);
+        }
+    }
+
+    return (!reader.HasError());
+}
+
 } // TinScript
 
 // ------------------------------------------------------------------------------------------------
@@ -34,6 +34,10 @@ namespace TinScript
 // --------------------------------------------------------------------------------------------------------------------
 // -- forward declarations
 class CFunctionContext;
+class CFunctionEntry;
+class CCoroutine;
+class CSnapshotWriter;
+class CSnapshotReader;
 
 // ====================================================================================================================
 // class CScheduler:  Manages the requests for deferred function and method calls.
@@ -50,6 +54,7 @@ class CScheduler
         // -- the update is what really matters, as it's expected to be called accurately by the application.
         // -- the set/get timescale is for communicating with the debugger, so it's schedule reflection is accurate
         void Update(uint32 curtime);
+        uint32 GetCurrentSimTime() const { return (mCurrentSimTime); }
         float GetSimTimeScale() const { return (mSimTimeScale); }
         void SetSimTimeScale(float sim_time_scale);
 
@@ -81,29 +86,54 @@ class CScheduler
 
                 uint32 mFuncHash;
                 CFunctionContext* mFuncContext;
+
+                // -- if the function suspended itself (wait/yield), the command is reinserted to resume it
+                CCoroutine* mCoroutine;
         };
 
         int Schedule(uint32 objectid, int delay, bool8 repeat, const char* commandstring);
         int Thread(int reqid, uint32 objectid, int delay, const char* commandstring);
         void CancelObject(uint32 objectid);
+        void CancelObjects(const uint32* sorted_object_ids, int32 count);
         void CancelRequest(int reqid);
         void Cancel(uint32 objectid, int reqid);
+        void CancelCoroutines(CFunctionEntry* fe);
+        void MoveCoroutines(CFunctionEntry* fe, CCodeBlock* from_codeblock, CCodeBlock* to_codeblock,
+                            int32 offset_delta);
+        int32 GetCoroutineCount() const;
         void Dump();
+        int32 DumpPage(int32 first, int32 count);
+
+        // -- snapshot support - suspended coroutines can't be saved, and are skipped
+        void WriteSnapshot(CSnapshotWriter& writer);
+        bool8 ReadSnapshot(CSnapshotReader& reader);
 
-        // -- debugger hook
+        // -- debugger hook - the listing is sent a budget at a time, from the context's update
         void DebuggerListSchedules();
+        void DebuggerUpdateListSchedules();
+        void DebuggerStopListSchedules() { mDebuggerListCursor = NULL; }
         void DebuggerAddSchedule(const CCommand& command);
+        void DebuggerRescheduleSchedule(const CCommand& command);
         void DebuggerRemoveSchedule(int32 request_id);
 
         CCommand* ScheduleCreate(uint32 objectid, int delay, uint32 funchash, bool8 immediate, bool8 repeat);
         CScheduler::CCommand* mCurrentSchedule;
 
     private:
+        void InsertCommand(CCommand* command);
+        void DebuggerUnlinkCommand(CCommand* command);
+
         CScriptContext* mContextOwner;
 
         CCommand* mHead;
         uint32 mCurrentSimTime;
+
+        // -- request IDs are issued per scheduler, so contexts (and their threads) don't share state
+        int32 mScheduleID;
         float mSimTimeScale;
+
+        // -- the next command to be sent by a debugger listing in progress
+        CCommand* mDebuggerListCursor;
 };
 
 } // TinScript
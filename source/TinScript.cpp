@@ -33,6 +33,9 @@
     #include "windows.h"
     #include "conio.h"
     #include "direct.h"
+#else
+    #include <chrono>
+    #include <pthread.h>
 #endif
 
 #include "integration.h"
@@ -43,6 +46,7 @@
 #include "TinExecute.h"
 #include "TinNamespace.h"
 #include "TinScheduler.h"
+#include "TinSignal.h"
 #include "TinObjectGroup.h"
 #include "TinStringTable.h"
 #include "TinRegistration.h"
@@ -61,6 +65,9 @@ namespace TinScript
 // -- statics
 static const char* gStringTableFileName = "stringtable.txt";
 
+// -- a debugger batch packet begins with the batch packet ID and the message count
+static const int32 kDebuggerBatchHeaderSize = 2 * sizeof(int32);
+
 bool8 CScriptContext::gDebugParseTree = false;
 bool8 CScriptContext::gDebugCodeBlock = false;
 bool8 CScriptContext::gDebugTrace = false;
@@ -149,6 +156,16 @@ bool8 IncludeScript(const char* filename)
     return (script_context->ExecScript(filename, true, false));
 }
 
+// ====================================================================================================================
+// ReloadScript():  Recompiles a script, and swaps in only the changed functions - top-level statements aren't executed.
+// ====================================================================================================================
+bool8 ReloadScript(const char* filename)
+{
+    CScriptContext* script_context = GetContext();
+    assert(script_context != NULL);
+    return (script_context->ReloadScript(filename));
+}
+
 // ====================================================================================================================
 // SetTimeScale():  Allows for accurate communication with the debugger, if the application adjusts timescale
 // ====================================================================================================================
@@ -162,6 +179,7 @@ void SetTimeScale(float time_scale)
 REGISTER_FUNCTION_P1(Compile, CompileScript, bool8, const char*);
 REGISTER_FUNCTION_P1(Exec, ExecScript, bool8, const char*);
 REGISTER_FUNCTION_P1(Include, IncludeScript, bool8, const char*);
+REGISTER_FUNCTION_P1(Reload, ReloadScript, bool8, const char*);
 
 // ====================================================================================================================
 // NullAssertHandler():  Default assert handler called, if one isn't provided
@@ -231,9 +249,16 @@ CScriptContext::CScriptContext(TinPrintHandler printfunction, TinAssertHandler a
     // -- initialize the ID generator
     mObjectIDGenerator = 0;
 
+    // -- namespaces start with version 0, so their lifecycle hooks are built on first use
+    mMethodTableVersion = 1;
+    mFunctionEntryIDGenerator = 0;
+
     // -- set the thread local singleton
     gThreadContext = this;
 
+    // -- create the log first, so everything that follows can print
+    mLog = TinAlloc(ALLOC_Log, CScriptLog, this);
+
     // -- initialize and populate the string table
     mStringTable = TinAlloc(ALLOC_StringTable, CStringTable, this, kStringTableSize);
     LoadStringTable();
@@ -271,11 +296,18 @@ CScriptContext::CScriptContext(TinPrintHandler printfunction, TinAssertHandler a
     // -- initialize the scheduler
     mScheduler = TinAlloc(ALLOC_SchedCmd, CScheduler, this);
 
+    // -- initialize the signals
+    mSignalManager = TinAlloc(ALLOC_Signal, CSignalManager, this);
+
     // -- initialize the master object list
-    mMasterMembershipList = TinAlloc(ALLOC_ObjectGroup, CMasterMembershipList, this, kMasterMembershipTableSize);
+    mMasterMembershipList = TinAlloc(ALLOC_ObjectGroup, CMasterMembershipList, this);
 
     // -- initialize the code block hash table
     mCodeBlockList = TinAlloc(ALLOC_HashTable, CHashTable<CCodeBlock>, kGlobalFuncTableSize);
+    mDeadCodeBlockList = NULL;
+
+    // -- function entries replaced by a reload, deleted once nothing can still be executing them
+    mRetiredFunctionList = TinAlloc(ALLOC_FuncTable, tFuncTable, kLocalFuncTableSize);
 
     // -- initialize the scratch buffer index
     mScratchBufferIndex = 0;
@@ -284,6 +316,7 @@ CScriptContext::CScriptContext(TinPrintHandler printfunction, TinAssertHandler a
 	mDebuggerSessionNumber = 0;
     mDebuggerConnected = false;
     mDebuggerActionForceBreak = false;
+    mDebuggerAttention = false;
     mDebuggerActionStep = false;
     mDebuggerActionStepOver = false;
     mDebuggerActionStepOut = false;
@@ -293,6 +326,34 @@ CScriptContext::CScriptContext(TinPrintHandler printfunction, TinAssertHandler a
 	mDebuggerBreakFuncCallStack = NULL;
 	mDebuggerBreakExecStack = NULL;
 	mDebuggerVarWatchRequestID = 0;
+    mDebuggerWatchExecStack = NULL;
+    mDebuggerWatchFuncCallStack = NULL;
+    mDebuggerWatchStacksInUse = false;
+
+    // -- the batch buffer holds a full packet, and the batch header, as a message too large to batch is sent alone
+    for (int32 i = 0; i < DEBUGGER_CHANNEL_COUNT; ++i)
+    {
+        mDebuggerBatch[i].mBuffer = TinAllocArray(ALLOC_Debugger, char, k_MaxPacketSize + kDebuggerBatchHeaderSize);
+        mDebuggerBatch[i].mSize = kDebuggerBatchHeaderSize;
+        mDebuggerBatch[i].mCount = 0;
+    }
+    mDebuggerMessageChannel = 0;
+    mDebuggerMessageOffset = -1;
+    mDebuggerMessageSize = 0;
+
+    // -- object listing, and inspected objects
+    mDebuggerListQueue = NULL;
+    mDebuggerListSize = 0;
+    mDebuggerListCount = 0;
+    mDebuggerListIndex = 0;
+    mDebuggerObjectEpoch = 1;
+    mDebuggerObjectListEpoch = 0;
+
+    mDebuggerInspectCount = 0;
+    mDebuggerInspectNext = 0;
+    mDebuggerInspectUpdateTime = 0;
+
+    mDebuggerCallstackSize = 0;
 
     // -- initialize the thread command
     mThreadBufPtr = NULL;
@@ -416,26 +477,51 @@ void CScriptContext::InitializeDictionaries()
 // ====================================================================================================================
 CScriptContext::~CScriptContext()
 {
+    // -- suspended functions hold references to their codeblocks, and must be cancelled first
+    mScheduler->CancelCoroutines(NULL);
+
     // -- cleanup the namespace context
     // -- note:  the global namespace is owned by the namespace dictionary
     // -- within the context - it'll be automatically cleaned up
     ShutdownDictionaries();
 
+    // -- delete any function entries retired by a reload
+    mRetiredFunctionList->DestroyAll();
+    TinFree(mRetiredFunctionList);
+
     // -- cleanup all related codeblocks
     // -- by deleting the namespace dictionaries, all codeblocks should now be unused
-    CCodeBlock::DestroyUnusedCodeBlocks(mCodeBlockList);
+    DestroyDeadCodeBlocks();
     assert(mCodeBlockList->IsEmpty());
     TinFree(mCodeBlockList);
 
     // -- clean up the scheduleer
     TinFree(mScheduler);
 
+    // -- clean up the signals
+    TinFree(mSignalManager);
+
     // -- cleanup the membership list
     TinFree(mMasterMembershipList);
 
     // -- clean up the string table
     TinFree(mStringTable);
 
+    // -- any debugger messages not yet sent are discarded
+    for (int32 i = 0; i < DEBUGGER_CHANNEL_COUNT; ++i)
+        TinFreeArray(mDebuggerBatch[i].mBuffer);
+
+    // -- the stacks used to evaluate watch expressions
+    if (mDebuggerWatchExecStack)
+        TinFree(mDebuggerWatchExecStack);
+    if (mDebuggerWatchFuncCallStack)
+        TinFree(mDebuggerWatchFuncCallStack);
+
+    // -- as well as any pending object listing, and inspected objects
+    if (mDebuggerListQueue)
+        TinFreeArray(mDebuggerListQueue);
+    DebuggerClearInspectObjects();
+
     // -- if this is the MainThread context, shutdown types
     if (mIsMainThread)
     {
@@ -471,6 +557,33 @@ void CScriptContext::ShutdownDictionaries()
         mNameDictionary->RemoveAll();
         TinFree(mNameDictionary);
     }
+
+    // -- deliver anything left in the log, and destroy it last
+    mLog->Drain();
+    TinFree(mLog);
+    mLog = NULL;
+}
+
+// ====================================================================================================================
+// GetCurrentTimeUS():  High resolution timer, in microseconds, used to budget work spread across updates.
+// ====================================================================================================================
+static int64 GetCurrentTimeUS()
+{
+#ifdef WIN32
+    // -- the frequency is fixed at boot, so it's only queried once (a race only writes the same value)
+    static LARGE_INTEGER frequency = { 0 };
+    if (frequency.QuadPart == 0)
+        QueryPerformanceFrequency(&frequency);
+
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return ((counter.QuadPart / frequency.QuadPart) * 1000000 +
+            ((counter.QuadPart % frequency.QuadPart) * 1000000) / frequency.QuadPart);
+#else
+    // -- wall time, not CPU time (clock()), so the budget includes time the thread is blocked
+    return (std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
 }
 
 void CScriptContext::Update(uint32 curtime)
@@ -480,8 +593,45 @@ void CScriptContext::Update(uint32 curtime)
     // -- execute any commands queued from a different thread
     ProcessThreadCommands();
 
-    // $$$TZA This doesn't need to happen every frame...
-    CCodeBlock::DestroyUnusedCodeBlocks(mCodeBlockList);
+    // -- between updates, no script is executing - functions replaced by a reload can be deleted
+    mRetiredFunctionList->DestroyAll();
+
+    // -- destroy (some of) the codeblocks no longer in use
+    if (mDeadCodeBlockList)
+        DestroyDeadCodeBlocks(kCodeBlockDestroyBudgetUS);
+
+    // -- stream the next part of any object or schedule listing, and the changes to inspected objects
+    int32 debugger_session = 0;
+    if (IsDebuggerConnected(debugger_session))
+    {
+        DebuggerUpdateListObjects();
+        DebuggerUpdateInspectObjects(curtime);
+        mScheduler->DebuggerUpdateListSchedules();
+    }
+
+    // -- send everything the debugger was notified of during this update, as a single packet
+    DebuggerFlushMessages();
+
+    // -- deliver the messages logged during this update, unless the application drains the log itself
+    if (mLog->IsDrainOnUpdate())
+        mLog->Drain();
+}
+
+// ====================================================================================================================
+// DestroyDeadCodeBlocks():  Destroy the codeblocks no longer in use, until the time budget is spent (-1 for all).
+// ====================================================================================================================
+void CScriptContext::DestroyDeadCodeBlocks(int32 time_budget_us)
+{
+    int64 start_time = GetCurrentTimeUS();
+    while (mDeadCodeBlockList)
+    {
+        // -- destroying the codeblock unlinks it from the dead list
+        CCodeBlock::DestroyCodeBlock(mDeadCodeBlockList);
+
+        // -- always destroy at least one, so the list drains, even if the budget is smaller than a single destroy
+        if (time_budget_us >= 0 && GetCurrentTimeUS() - start_time >= time_budget_us)
+            break;
+    }
 }
 
 // ====================================================================================================================
@@ -951,6 +1101,78 @@ bool8 CScriptContext::ExecScript(const char* filename, bool8 must_exist, bool8 r
     return result;
 }
 
+// ====================================================================================================================
+// ReloadScript():  Recompile a script, and swap in only the functions whose code has changed.
+// The script is not executed - top-level statements are not replayed, and frames executing the replaced functions
+// continue safely with the previous code, which is retired until the next update.  The recompiled codeblock replaces
+// the previous one for the file, including the unchanged functions.
+// ====================================================================================================================
+bool8 CScriptContext::ReloadScript(const char* filename)
+{
+    char binfilename[kMaxNameLength];
+    if (!GetBinaryFileName(filename, binfilename, kMaxNameLength))
+    {
+        ScriptAssert_(this, 0, "<internal>", -1, "Error - invalid script filename: %s\n", filename ? filename : "");
+        ResetAssertStack();
+        return (false);
+    }
+
+    // -- if the script isn't loaded, there's nothing to reload - it's executed as usual
+    uint32 filename_hash = Hash(filename, -1, false);
+    if (!GetCodeBlockList()->FindItem(filename_hash))
+        return (ExecScript(filename, true, true));
+
+    // -- compile the source - the function entries are created detached, so nothing changes until the commit
+    CCodeBlock* codeblock = ParseFile(this, filename, true);
+    if (codeblock == NULL)
+    {
+        ScriptAssert_(this, 0, "<internal>", -1, "Error - unable to parse file: %s\n", filename);
+        ResetAssertStack();
+        return (false);
+    }
+
+    // -- swap in the changed functions
+    int32 function_count = 0;
+    int32 changed_count = codeblock->CommitReloadFunctions(function_count);
+    codeblock->SetReloading(false);
+    codeblock->SetFinishedParsing();
+
+    bool8 result = (changed_count >= 0);
+    if (result)
+    {
+        TinPrint(this, "Reload: %s - %d of %d functions updated\n", filename, changed_count, function_count);
+
+        // -- write the binary, so it isn't older than the source
+        if (SaveBinary(codeblock, binfilename) && mIsMainThread)
+            SaveStringTable();
+
+        // -- notify the debugger, if one is connected - the file is now executing from the new codeblock
+        if (codeblock->IsInUse() && mDebuggerConnected)
+            DebuggerCodeblockLoaded(codeblock->GetFilenameHash());
+    }
+
+    // -- if the file no longer defines any functions (or the commit failed), the new codeblock isn't needed, and the
+    // -- file remains registered to the previous codeblock
+    if (!codeblock->IsInUse())
+        CCodeBlock::DestroyCodeBlock(codeblock);
+
+    ResetAssertStack();
+    return (result);
+}
+
+// ====================================================================================================================
+// RetireFunctionEntry():  A function entry replaced by a reload may still be executing - delete it at the next update.
+// ====================================================================================================================
+void CScriptContext::RetireFunctionEntry(CFunctionEntry* fe)
+{
+    if (!fe)
+        return;
+
+    // -- suspended executions of the function can't be resumed in the new definition
+    mScheduler->CancelCoroutines(fe);
+    mRetiredFunctionList->AddItem(*fe, fe->GetHash());
+}
+
 // ====================================================================================================================
 // CompileCommand():  Compile a text block into byte code.
 // ====================================================================================================================
@@ -1065,11 +1287,37 @@ void CScriptContext::SetDebuggerConnected(bool connected)
     mDebuggerActionStepOut = false;
     mDebuggerActionRun = true;
 
+    // -- while connected, running VMs without the debugger hooks switch to them
+    UpdateDebuggerAttention();
+
 	mDebuggerBreakLoopGuard = false;
 	mDebuggerBreakFuncCallStack = NULL;
 	mDebuggerBreakExecStack = NULL;
 	mDebuggerVarWatchRequestID = 0;
 
+    // -- debugger messages batched for a previous session are discarded - the other channels (prints, objects,
+    // -- schedules) may have other clients still subscribed, so their batches are left to be sent
+    mDebuggerBatch[DEBUGGER_CHANNEL_Debugger].mSize = kDebuggerBatchHeaderSize;
+    mDebuggerBatch[DEBUGGER_CHANNEL_Debugger].mCount = 0;
+
+    // -- the object browser of a new client needs a full listing (the listing itself is restarted on request)
+    ++mDebuggerObjectEpoch;
+
+    // -- listings are only sent while a debugger is connected
+    if (!connected)
+    {
+        mDebuggerListCount = 0;
+        mDebuggerListIndex = 0;
+        mScheduler->DebuggerStopListSchedules();
+    }
+
+    // -- a new client has no callstack to apply a delta to
+    mDebuggerCallstackSize = 0;
+
+    // -- inspected objects are only updated while a debugger is connected
+    if (!connected)
+        DebuggerClearInspectObjects();
+
     // -- if we're now connected, send back the current working directory
     if (connected)
     {
@@ -1201,6 +1449,7 @@ void CScriptContext::SetForceBreak(int32 watch_var_request_id)
 {
     // -- this is usually set to when requested by the debugger, and auto set back to false when the break is handled.
     mDebuggerActionForceBreak = true;
+    UpdateDebuggerAttention();
 
 	// -- it's also how variable watches trigger - set the request ID
 	mDebuggerVarWatchRequestID = watch_var_request_id;
@@ -1217,6 +1466,9 @@ void CScriptContext::SetBreakActionStep(bool8 torf, bool8 step_over, bool8 step_
     mDebuggerActionStepOver = torf ? step_over : false;
     mDebuggerActionStepOut = torf ? step_out : false;
 
+    // -- the break request has been consumed - without a debugger, calls no longer need the hooks
+    UpdateDebuggerAttention();
+
 	// -- clear the var watch requst ID - it'll be set on the next write if necessary
 	mDebuggerVarWatchRequestID = 0;
 }
@@ -1599,22 +1851,20 @@ bool8 CScriptContext::HasTraceExpression(CDebuggerWatchExpression& debugger_watc
 
 // ====================================================================================================================
 // InitWatchExpression():  Given a watch structure, create and compile a codeblock that can be stored and evaluated.
+// The expression is compiled once, and bound to the stack slots of the executing function.
 // ====================================================================================================================
 bool8 CScriptContext::InitWatchExpression(CDebuggerWatchExpression& debugger_watch, bool use_trace,
                                           CFunctionCallStack& call_stack)
 {
     // -- depending on whether we're initializing the trace expression or the conditional, set the local vars
     const char* expression = use_trace ? debugger_watch.mTrace : debugger_watch.mConditional;
-    CFunctionEntry*& watch_function = use_trace ? debugger_watch.mTraceFunctionEntry
-                                                : debugger_watch.mWatchFunctionEntry;
+    CDebuggerWatchExpression::tWatchFunction& watch_function = use_trace ? debugger_watch.mTraceFunction
+                                                                         : debugger_watch.mWatchFunction;
 
-    // -- if we have no expression, or we've already initialized, then we're done
-    if (!expression[0] || watch_function != NULL)
+    // -- if we have no expression, we're done
+    if (!expression[0])
         return (true);
 
-    // -- every time a watch is initialized, we bump the ID to ensure a 100% unique name
-    int32 watch_id = CDebuggerWatchExpression::gWatchExpressionID++;
-
     // -- find the function we're currently executing
     int32 stacktop = 0;
     CFunctionEntry* cur_function = NULL;
@@ -1625,9 +1875,25 @@ bool8 CScriptContext::InitWatchExpression(CDebuggerWatchExpression& debugger_wat
     if (!cur_function)
         return (false);
 
+    // -- if we've already compiled the expression for this function, we're done
+    // -- note:  an expression that failed to compile isn't retried, until the expression is changed
+    if (watch_function.mBoundFunctionID == cur_function->GetEntryID())
+        return (watch_function.mFunctionEntry != NULL);
+
+    // -- otherwise, any previous compile is bound to the locals of a different function
+    // -- note:  not while nested within an evaluation, which might be executing the previous compile
+    if (mDebuggerWatchStacksInUse && watch_function.mFunctionEntry)
+        return (false);
+    debugger_watch.ClearWatchFunction(watch_function);
+    watch_function.mBoundFunctionID = cur_function->GetEntryID();
+
+    // -- every time a watch is initialized, we bump the ID to ensure a 100% unique name
+    int32 watch_id = CDebuggerWatchExpression::gWatchExpressionID++;
+
     // -- create the name to uniquely identify both the codeblock and the associated function
     char watch_name[kMaxNameLength];
-    sprintf_s(watch_name, "_%s_expr_%d_", use_trace ? "trace" : debugger_watch.mIsConditional ? "cond" : "watch", watch_id);
+    sprintf_s(watch_name, "_%s_expr_%d_", use_trace ? "trace" : debugger_watch.mIsConditional ? "cond" : "watch",
+              watch_id);
     uint32 watch_name_hash = Hash(watch_name);
 
 	// create the code block and the starting root node
@@ -1666,13 +1932,33 @@ bool8 CScriptContext::InitWatchExpression(CDebuggerWatchExpression& debugger_wat
     // -- initialize the stack offsets
     temp_context->InitStackVarOffsets(fe);
 
+    // -- bind each cloned local to the stack slot of the variable in the current function, so evaluating only
+    // -- has to copy the slots, and not look up the variables
+    int32 slot_count = 0;
+    int32* slots = TinAllocArray(ALLOC_Debugger, int32, 2 * (cur_var_table->Used() + 1));
+    returnAdded = false;
+    cur_ve = cur_var_table->First();
+    while (cur_ve)
+    {
+        CVariableEntry* watch_ve = !returnAdded ? temp_context->GetParameter(0)
+                                                : temp_context->GetLocalVar(cur_ve->GetHash());
+        returnAdded = true;
+        if (watch_ve && cur_ve->GetStackOffset() >= 0 && watch_ve->GetStackOffset() >= 0)
+        {
+            slots[2 * slot_count] = cur_ve->GetStackOffset();
+            slots[2 * slot_count + 1] = watch_ve->GetStackOffset();
+            ++slot_count;
+        }
+        cur_ve = cur_var_table->Next();
+    }
+
     // -- push the temporary function entry onto the temp code block, so we can compile our watch function
     codeblock->smFuncDefinitionStack->Push(fe, cur_object, 0);
 
     // -- add a funcdecl node, and set its left child to be the statement block
     // -- for fun, use the watch_id as the line number - to find it while debugging
-    CFuncDeclNode* funcdeclnode = TinAlloc(ALLOC_TreeNode, CFuncDeclNode, codeblock, root->next,
-                                           watch_id, watch_name, strlen(watch_name), "", 0, 0);
+    CFuncDeclNode* funcdeclnode = TinAllocTreeNode(codeblock, CFuncDeclNode, codeblock, root->next,
+                                                   watch_id, watch_name, strlen(watch_name), "", 0, 0);
 
     // -- the body of our watch function, is to simply return the given expression
     // -- parsing and returning the expression will also identify the type for us
@@ -1689,7 +1975,7 @@ bool8 CScriptContext::InitWatchExpression(CDebuggerWatchExpression& debugger_wat
     // -- now we've got a temporary function with exactly the same set of local variables
     // -- see if we can parse the expression
 	tReadToken parsetoken(expr_result, 0);
-    success == !success || !ParseStatementBlock(codeblock, funcdeclnode->leftchild, parsetoken, false);
+    success = ParseStatementBlock(codeblock, funcdeclnode->leftchild, parsetoken, false);
 
     // -- if we successfully created the tree, calculate the size needed by running through the tree
     int32 size = 0;
@@ -1719,14 +2005,21 @@ bool8 CScriptContext::InitWatchExpression(CDebuggerWatchExpression& debugger_wat
     DestroyTree(root);
 
     // -- if we were unsuccessful, destroy the codeblock and return failure
+    // -- the watch remains bound, so a failed expression isn't recompiled every time it's hit
     if (!success)
     {
+        GetGlobalNamespace()->GetFuncTable()->RemoveItem(fe->GetHash());
+        TinFree(fe);
         CCodeBlock::DestroyCodeBlock(codeblock);
+        TinFreeArray(slots);
         return (false);
     }
 
-    // -- we were successful - set the function entry, and return success
-    watch_function = fe;
+    // -- we were successful - set the function entry and the stack bindings, and return success
+    watch_function.mFunctionEntry = fe;
+    watch_function.mLocalVarCount = temp_context->CalculateLocalVarStackSize();
+    watch_function.mSlotCount = slot_count;
+    watch_function.mSlots = slots;
     return (true);
 }
 
@@ -1738,15 +2031,15 @@ bool8 CScriptContext::EvalWatchExpression(CDebuggerWatchExpression& debugger_wat
 {
     // -- depending on whether we're initializing the trace expression or the conditional, set the local vars
     const char* expression = use_trace ? debugger_watch.mTrace : debugger_watch.mConditional;
-    CFunctionEntry*& watch_function = use_trace ? debugger_watch.mTraceFunctionEntry
-                                                : debugger_watch.mWatchFunctionEntry;
+    CDebuggerWatchExpression::tWatchFunction& watch_function = use_trace ? debugger_watch.mTraceFunction
+                                                                         : debugger_watch.mWatchFunction;
 
     // -- if we have no expression, we've successfully evaluated
     if (!expression[0])
         return (true);
 
     // -- if we have no function entry, we're done
-    if (!watch_function)
+    if (!watch_function.mFunctionEntry)
         return (false);
 
     // -- find the function we're currently executing
@@ -1755,43 +2048,60 @@ bool8 CScriptContext::EvalWatchExpression(CDebuggerWatchExpression& debugger_wat
     CObjectEntry* cur_object = NULL;
     cur_function = cur_call_stack.GetExecuting(cur_object, stacktop);
 
-    // -- make sure we've got a valid function
-    if (!cur_function)
+    // -- make sure we've got a valid function, and it's the one the watch was compiled for
+    if (!cur_function || cur_function->GetEntryID() != watch_function.mBoundFunctionID)
         return (false);
 
-    // -- create the stack used to execute the function
-	CExecStack execstack(this, kExecStackSize);
-    CFunctionCallStack funccallstack(kExecFuncCallDepth);
+    // -- use the preallocated stacks, unless this is nested within another evaluation (e.g. a breakpoint
+    // -- within a function called by the expression)
+    CExecStack* execstack = NULL;
+    CFunctionCallStack* funccallstack = NULL;
+    bool8 use_watch_stacks = !mDebuggerWatchStacksInUse;
+    if (use_watch_stacks)
+    {
+        if (!mDebuggerWatchExecStack)
+        {
+            mDebuggerWatchExecStack = TinAlloc(ALLOC_Debugger, CExecStack, this, kExecStackSize);
+            mDebuggerWatchFuncCallStack = TinAlloc(ALLOC_Debugger, CFunctionCallStack, kExecFuncCallDepth);
+        }
+
+        mDebuggerWatchStacksInUse = true;
+        execstack = mDebuggerWatchExecStack;
+        funccallstack = mDebuggerWatchFuncCallStack;
+    }
+    else
+    {
+        execstack = TinAlloc(ALLOC_Debugger, CExecStack, this, kExecStackSize);
+        funccallstack = TinAlloc(ALLOC_Debugger, CFunctionCallStack, kExecFuncCallDepth);
+    }
 
     // -- push the function entry onto the call stack
-    funccallstack.Push(watch_function, cur_object, 0);
+    funccallstack->mDebuggerObjectDeleted = 0;
+    funccallstack->mDebuggerFunctionReload = 0;
+    funccallstack->Push(watch_function.mFunctionEntry, cur_object, 0);
 
     // -- create space on the execstack for the local variables
-    int32 localvarcount = watch_function->GetContext()->CalculateLocalVarStackSize();
-    execstack.Reserve(localvarcount * MAX_TYPE_SIZE);
+    execstack->Reserve(watch_function.mLocalVarCount * MAX_TYPE_SIZE);
 
-    // -- copy the local values from the currently executing function, to stack
-    CVariableEntry* cur_ve = cur_function->GetLocalVarTable()->First();
-    while (cur_ve)
+    // -- copy the local values from the currently executing function, to the bound stack slots
+    for (int32 i = 0; i < watch_function.mSlotCount; ++i)
     {
-        void* dest_stack_addr = execstack.GetStackVarAddr(0, cur_ve->GetStackOffset());
-        void* cur_stack_addr = cur_exec_stack.GetStackVarAddr(stacktop, cur_ve->GetStackOffset());
-
-        void* var_addr = cur_ve->GetAddr(NULL);
-        memcpy(dest_stack_addr, cur_stack_addr, kMaxTypeSize);
-        cur_ve = cur_function->GetLocalVarTable()->Next();
+        void* cur_stack_addr = cur_exec_stack.GetStackVarAddr(stacktop, watch_function.mSlots[2 * i]);
+        void* dest_stack_addr = execstack->GetStackVarAddr(0, watch_function.mSlots[2 * i + 1]);
+        if (cur_stack_addr && dest_stack_addr)
+            memcpy(dest_stack_addr, cur_stack_addr, kMaxTypeSize);
     }
 
     // -- call the function
-    funccallstack.BeginExecution();
-    bool8 result = CodeBlockCallFunction(watch_function, NULL, execstack, funccallstack, false);
+    funccallstack->BeginExecution();
+    bool8 result = CodeBlockCallFunction(watch_function.mFunctionEntry, NULL, *execstack, *funccallstack, false);
 
     // -- if we executed succesfully...
     if (result)
     {
         // -- if we can retrieve the return value
         eVarType returnType;
-        void* returnValue = execstack.Pop(returnType);
+        void* returnValue = execstack->Pop(returnType);
         if (returnValue)
         {
             // -- set the return value in the context, so it is retrievable by whoever needs it
@@ -1803,6 +2113,24 @@ bool8 CScriptContext::EvalWatchExpression(CDebuggerWatchExpression& debugger_wat
         }
     }
 
+    // -- leave the stacks empty for the next evaluation (a failed execution may not have unwound them)
+    if (use_watch_stacks)
+    {
+        execstack->UnReserve(execstack->GetStackTop());
+        while (funccallstack->GetStackDepth() > 0)
+        {
+            int32 var_offset = 0;
+            CObjectEntry* oe = NULL;
+            funccallstack->Pop(oe, var_offset);
+        }
+        mDebuggerWatchStacksInUse = false;
+    }
+    else
+    {
+        TinFree(execstack);
+        TinFree(funccallstack);
+    }
+
     // -- return the result
     return (result);
 }
@@ -1875,8 +2203,8 @@ bool8 CScriptContext::EvaluateWatchExpression(const char* expression, bool8 cond
     codeblock->smFuncDefinitionStack->Push(fe, NULL, 0);
 
         // -- add a funcdecl node, and set its left child to be the statement block
-    CFuncDeclNode* funcdeclnode = TinAlloc(ALLOC_TreeNode, CFuncDeclNode, codeblock, root->next,
-                                           -1, temp_func_name, strlen(temp_func_name), "", 0 , 0);
+    CFuncDeclNode* funcdeclnode = TinAllocTreeNode(codeblock, CFuncDeclNode, codeblock, root->next,
+                                                   -1, temp_func_name, strlen(temp_func_name), "", 0 , 0);
 
     // -- if this is a conditional, then we want to see if the value of it is true/false
     char expr_result[kMaxTokenLength];
@@ -1984,6 +2312,96 @@ void CScriptContext::ToggleVarWatch(int32 watch_request_id, uint32 object_id, ui
 		ve->SetBreakOnWrite(watch_request_id, mDebuggerSessionNumber, breakOnWrite, condition, trace, trace_on_cond);
 }
 
+// ====================================================================================================================
+// DebuggerBeginMessage():  Reserve space in a channel's batch for a message of the given size (including its ID).
+// ====================================================================================================================
+int32* CScriptContext::DebuggerBeginMessage(int32 size, eDebuggerChannel channel)
+{
+    // -- ensure we're able to send, and the previous message was ended
+    // -- if no client subscribes to the channel, the message isn't even written
+    assert(mDebuggerMessageOffset < 0);
+    if (size <= 0 || size > k_MaxPacketSize || !SocketManager::IsSubscribed(1 << channel))
+        return (NULL);
+
+    // -- if the message doesn't fit, send the current batch first
+    tDebuggerBatch& batch = mDebuggerBatch[channel];
+    int32 aligned_size = (size + 3) & ~3;
+    if (batch.mSize + (int32)sizeof(int32) + aligned_size > k_MaxPacketSize)
+        DebuggerFlushChannel(channel);
+
+    // -- a message too large to be batched at all is written at the start of the buffer, and sent on its own
+    mDebuggerMessageChannel = channel;
+    mDebuggerMessageSize = size;
+    if (batch.mSize + (int32)sizeof(int32) + aligned_size > k_MaxPacketSize)
+    {
+        mDebuggerMessageOffset = 0;
+        return ((int32*)batch.mBuffer);
+    }
+
+    // -- write the message size, and zero the padding
+    int32* message_size = (int32*)&batch.mBuffer[batch.mSize];
+    *message_size = aligned_size;
+    mDebuggerMessageOffset = batch.mSize + (int32)sizeof(int32);
+    memset(&batch.mBuffer[mDebuggerMessageOffset + aligned_size - sizeof(int32)], 0, sizeof(int32));
+    return ((int32*)&batch.mBuffer[mDebuggerMessageOffset]);
+}
+
+// ====================================================================================================================
+// DebuggerEndMessage():  Commit the message written since DebuggerBeginMessage().
+// ====================================================================================================================
+void CScriptContext::DebuggerEndMessage()
+{
+    assert(mDebuggerMessageOffset >= 0);
+
+    // -- a message written at the start of the buffer wasn't batched - send it now
+    tDebuggerBatch& batch = mDebuggerBatch[mDebuggerMessageChannel];
+    if (mDebuggerMessageOffset == 0)
+    {
+        SocketManager::tPacketHeader header(k_PacketVersion, SocketManager::tPacketHeader::DATA,
+                                            mDebuggerMessageSize);
+        SocketManager::SendDataPacket(&header, batch.mBuffer, 1 << mDebuggerMessageChannel);
+    }
+    else
+    {
+        batch.mSize = mDebuggerMessageOffset + ((mDebuggerMessageSize + 3) & ~3);
+        ++batch.mCount;
+    }
+
+    mDebuggerMessageOffset = -1;
+}
+
+// ====================================================================================================================
+// DebuggerFlushMessages():  Send the batch of messages for each channel.
+// ====================================================================================================================
+void CScriptContext::DebuggerFlushMessages()
+{
+    for (int32 i = 0; i < DEBUGGER_CHANNEL_COUNT; ++i)
+        DebuggerFlushChannel(i);
+}
+
+// ====================================================================================================================
+// DebuggerFlushChannel():  Send the batch of messages for a channel, as a single packet.
+// ====================================================================================================================
+void CScriptContext::DebuggerFlushChannel(int32 channel)
+{
+    tDebuggerBatch& batch = mDebuggerBatch[channel];
+    if (batch.mCount == 0)
+        return;
+
+    // -- fill in the batch header
+    int32* dataPtr = (int32*)batch.mBuffer;
+    *dataPtr++ = k_DebuggerBatchPacketID;
+    *dataPtr++ = batch.mCount;
+
+    // -- the packet is serialized once, and copied to the send queue of each client subscribed to the channel
+    // -- (if we've been disconnected, the messages are simply discarded)
+    SocketManager::tPacketHeader header(k_PacketVersion, SocketManager::tPacketHeader::DATA, batch.mSize);
+    SocketManager::SendDataPacket(&header, batch.mBuffer, 1 << channel);
+
+    batch.mSize = kDebuggerBatchHeaderSize;
+    batch.mCount = 0;
+}
+
 // ====================================================================================================================
 // DebuggerCurrentWorkingDir():  Use the packet type DATA, and notify the debugger of our current working directory
 // ====================================================================================================================
@@ -2002,29 +2420,22 @@ void CScriptContext::DebuggerCurrentWorkingDir(const char* cwd)
     int strLength = strlen(cwd) + 1;
     total_size += strLength;
 
-    // -- declare a header
-    // -- note, if we ever implement a request/acknowledge approach, we can use the mID field
-    SocketManager::tPacketHeader header(k_PacketVersion, SocketManager::tPacketHeader::DATA, total_size);
-
-    // -- create the packet (null data, as we'll fill in the data directly into the packet)
-    SocketManager::tDataPacket* newPacket = SocketManager::CreateDataPacket(&header, NULL);
-    if (!newPacket)
+    // -- reserve the message in the debugger batch (the data is written directly into the batch)
+    int32* dataPtr = DebuggerBeginMessage(total_size);
+    if (!dataPtr)
     {
-        TinPrint(this, "Error - DebuggerCurrentWorkingDir():  unable to send\n");
+        TinPrintError(this, "Error - DebuggerCurrentWorkingDir():  unable to send\n");
         return;
     }
 
-    // -- initialize the ptr to the data buffer
-    int32* dataPtr = (int32*)newPacket->mData;
-
     // -- write the identifier - defined in the debugger constants near the top of TinScript.h
     *dataPtr++ = k_DebuggerCurrentWorkingDirPacketID;
 
     // -- write the string
     SafeStrcpy((char*)dataPtr, cwd, strLength);
 
-    // -- send the packet
-    SocketManager::SendDataPacket(newPacket);
+    // -- commit the message, to be sent with the batch
+    DebuggerEndMessage();
 }
 
 // ====================================================================================================================
@@ -2043,29 +2454,22 @@ void CScriptContext::DebuggerCodeblockLoaded(uint32 codeblock_hash)
     int strLength = strlen(filename) + 1;
     total_size += strLength;
 
-    // -- declare a header
-    // -- note, if we ever implement a request/acknowledge approach, we can use the mID field
-    SocketManager::tPacketHeader header(k_PacketVersion, SocketManager::tPacketHeader::DATA, total_size);
-
-    // -- create the packet (null data, as we'll fill in the data directly into the packet)
-    SocketManager::tDataPacket* newPacket = SocketManager::CreateDataPacket(&header, NULL);
-    if (!newPacket)
+    // -- reserve the message in the debugger batch (the data is written directly into the batch)
+    int32* dataPtr = DebuggerBeginMessage(total_size);
+    if (!dataPtr)
     {
-        TinPrint(this, "Error - DebuggerCodeblockLoaded():  unable to send\n");
+        TinPrintError(this, "Error - DebuggerCodeblockLoaded():  unable to send\n");
         return;
     }
 
-    // -- initialize the ptr to the data buffer
-    int32* dataPtr = (int32*)newPacket->mData;
-
     // -- write the identifier - defined in the debugger constants near the top of TinScript.h
     *dataPtr++ = k_DebuggerCodeblockLoadedPacketID;
 
     // -- write the string
     SafeStrcpy((char*)dataPtr, filename, strLength);
 
-    // -- send the packet
-    SocketManager::SendDataPacket(newPacket);
+    // -- commit the message, to be sent with the batch
+    DebuggerEndMessage();
 }
 
 // ====================================================================================================================
@@ -2088,21 +2492,14 @@ void CScriptContext::DebuggerBreakpointHit(int32 watch_var_request_id, uint32 co
     // -- final int32 will be the line_number
     total_size += sizeof(int32);
 
-    // -- declare a header
-    // -- note, if we ever implement a request/acknowledge approach, we can use the mID field
-    SocketManager::tPacketHeader header(k_PacketVersion, SocketManager::tPacketHeader::DATA, total_size);
-
-    // -- create the packet (null data, as we'll fill in the data directly into the packet)
-    SocketManager::tDataPacket* newPacket = SocketManager::CreateDataPacket(&header, NULL);
-    if (!newPacket)
+    // -- reserve the message in the debugger batch (the data is written directly into the batch)
+    int32* dataPtr = DebuggerBeginMessage(total_size);
+    if (!dataPtr)
     {
-        TinPrint(this, "Error - DebuggerBreakpointHit():  unable to send\n");
+        TinPrintError(this, "Error - DebuggerBreakpointHit():  unable to send\n");
         return;
     }
 
-    // -- initialize the ptr to the data buffer
-    int32* dataPtr = (int32*)newPacket->mData;
-
     // -- write the identifier - defined in the debugger constants near the top of TinScript.h
     *dataPtr++ = k_DebuggerBreakpointHitPacketID;
 
@@ -2115,8 +2512,8 @@ void CScriptContext::DebuggerBreakpointHit(int32 watch_var_request_id, uint32 co
     // -- write the line number
     *dataPtr++ = line_number;
 
-    // -- send the packet
-    SocketManager::SendDataPacket(newPacket);
+    // -- commit the message, to be sent with the batch
+    DebuggerEndMessage();
 }
 
 // ====================================================================================================================
@@ -2139,21 +2536,14 @@ void CScriptContext::DebuggerBreakpointConfirm(uint32 codeblock_hash, int32 line
     // -- last int32 will be the actual line
     total_size += sizeof(int32);
 
-    // -- declare a header
-    // -- note, if we ever implement a request/acknowledge approach, we can use the mID field
-    SocketManager::tPacketHeader header(k_PacketVersion, SocketManager::tPacketHeader::DATA, total_size);
-
-    // -- create the packet (null data, as we'll fill in the data directly into the packet)
-    SocketManager::tDataPacket* newPacket = SocketManager::CreateDataPacket(&header, NULL);
-    if (!newPacket)
+    // -- reserve the message in the debugger batch (the data is written directly into the batch)
+    int32* dataPtr = DebuggerBeginMessage(total_size);
+    if (!dataPtr)
     {
-        TinPrint(this, "Error - DebuggerBreakpointConfirm():  unable to send\n");
+        TinPrintError(this, "Error - DebuggerBreakpointConfirm():  unable to send\n");
         return;
     }
 
-    // -- initialize the ptr to the data buffer
-    int32* dataPtr = (int32*)newPacket->mData;
-
     // -- write the identifier - defined in the debugger constants near the top of TinScript.h
     *dataPtr++ = k_DebuggerBreakpointConfirmPacketID;
 
@@ -2166,8 +2556,8 @@ void CScriptContext::DebuggerBreakpointConfirm(uint32 codeblock_hash, int32 line
     // -- write the line number
     *dataPtr++ = actual_line;
 
-    // -- send the packet
-    SocketManager::SendDataPacket(newPacket);
+    // -- commit the message, to be sent with the batch
+    DebuggerEndMessage();
 }
 
 // ====================================================================================================================
@@ -2190,21 +2580,14 @@ void CScriptContext::DebuggerVarWatchConfirm(int32 request_id, uint32 watch_obje
     // -- next int32 will be the var_name_hash
     total_size += sizeof(int32);
 
-    // -- declare a header
-    // -- note, if we ever implement a request/acknowledge approach, we can use the mID field
-    SocketManager::tPacketHeader header(k_PacketVersion, SocketManager::tPacketHeader::DATA, total_size);
-
-    // -- create the packet (null data, as we'll fill in the data directly into the packet)
-    SocketManager::tDataPacket* newPacket = SocketManager::CreateDataPacket(&header, NULL);
-    if (!newPacket)
+    // -- reserve the message in the debugger batch (the data is written directly into the batch)
+    int32* dataPtr = DebuggerBeginMessage(total_size);
+    if (!dataPtr)
     {
-        TinPrint(this, "Error - DebuggerVarWatchConfirm():  unable to send\n");
+        TinPrintError(this, "Error - DebuggerVarWatchConfirm():  unable to send\n");
         return;
     }
 
-    // -- initialize the ptr to the data buffer
-    int32* dataPtr = (int32*)newPacket->mData;
-
     // -- write the identifier - defined in the debugger constants near the top of TinScript.h
     *dataPtr++ = k_DebuggerVarWatchConfirmPacketID;
 
@@ -2217,74 +2600,81 @@ void CScriptContext::DebuggerVarWatchConfirm(int32 request_id, uint32 watch_obje
     // -- write the var name has
     *dataPtr++ = var_name_hash;
 
-    // -- send the packet
-    SocketManager::SendDataPacket(newPacket);
+    // -- commit the message, to be sent with the batch
+    DebuggerEndMessage();
 }
 
 // ====================================================================================================================
-// DebuggerSendCallstack():  Use the packet type DATA, and send the callstack data packet directly to the debugger.
+// DebuggerSendCallstack():  Send the debugger the callstack, as a delta from the callstack last sent.
+// Stepping and breaking within the same calls only changes the innermost frames, so the outermost frames that are
+// unchanged are counted, rather than re-sent.
 // ====================================================================================================================
 void CScriptContext::DebuggerSendCallstack(uint32* codeblock_array, uint32* objid_array,
                                            uint32* namespace_array,uint32* func_array,
                                            uint32* linenumber_array, int array_size)
 {
-    // -- calculate the size of the data
-    int32 total_size = 0;
-
-    // -- first int32 will be identifying this data packet
-    total_size += sizeof(int32);
+    if (array_size > kDebuggerCallstackSize)
+        array_size = kDebuggerCallstackSize;
 
-    // -- second int32 will be the array size
-    total_size += sizeof(int32);
+    // -- count the outermost frames (at the end of the arrays) that match those last sent
+    int32 unchanged_count = 0;
+    while (unchanged_count < array_size && unchanged_count < mDebuggerCallstackSize)
+    {
+        int32 index = array_size - 1 - unchanged_count;
+        const tDebuggerCallstackFrame& frame = mDebuggerCallstack[mDebuggerCallstackSize - 1 - unchanged_count];
+        if (frame.mCodeblockHash != codeblock_array[index] || frame.mObjectID != objid_array[index] ||
+            frame.mNamespaceHash != namespace_array[index] || frame.mFunctionHash != func_array[index] ||
+            frame.mLineNumber != linenumber_array[index])
+        {
+            break;
+        }
+        ++unchanged_count;
+    }
 
-    // -- finally, we have a uint32 for each of codeblock, objid, namespace, function, and line number
-    // -- note:  the debugger suppors a callstack of up to 32, so our max packet size is about 640 bytes
+    // -- the ID, the array size, and the unchanged count, followed by the 5 arrays of changed frames
+    // -- note:  the debugger supports a callstack of up to 32, so our max message size is about 660 bytes
     // -- which is less than the max packet size (1024) specified in socket.h
-    total_size += 5 * (sizeof(uint32)) * array_size;
+    int32 changed_count = array_size - unchanged_count;
+    int32 total_size = 3 * sizeof(int32) + 5 * (sizeof(uint32)) * changed_count;
 
-    // -- declare a header
-    // -- note, if we ever implement a request/acknowledge approach, we can use the mID field
-    SocketManager::tPacketHeader header(k_PacketVersion, SocketManager::tPacketHeader::DATA, total_size);
-
-    // -- create the packet (null data, as we'll fill in the data directly into the packet)
-    SocketManager::tDataPacket* newPacket = SocketManager::CreateDataPacket(&header, NULL);
-    if (!newPacket)
+    // -- reserve the message in the debugger batch (the data is written directly into the batch)
+    int32* dataPtr = DebuggerBeginMessage(total_size);
+    if (!dataPtr)
     {
-        TinPrint(this, "Error - DebuggerSendCallstack():  unable to send\n");
+        TinPrintError(this, "Error - DebuggerSendCallstack():  unable to send\n");
         return;
     }
 
-    // -- initialize the ptr to the data buffer
-    int32* dataPtr = (int32*)newPacket->mData;
-
-    // -- write the identifier - defined in the debugger constants near the top of TinScript.h
-    *dataPtr++ = k_DebuggerCallstackPacketID;
-
-    // -- write the array size
+    *dataPtr++ = k_DebuggerCallstackDeltaPacketID;
     *dataPtr++ = array_size;
-
-    // -- write the codeblocks
-    memcpy(dataPtr, codeblock_array, sizeof(uint32) * array_size);
-    dataPtr += array_size;
-
-    // -- write the objid's
-    memcpy(dataPtr, objid_array, sizeof(uint32) * array_size);
-    dataPtr += array_size;
-
-    // -- write the namespaces
-    memcpy(dataPtr, namespace_array, sizeof(uint32) * array_size);
-    dataPtr += array_size;
-
-    // -- write the functions
-    memcpy(dataPtr, func_array, sizeof(uint32) * array_size);
-    dataPtr += array_size;
-
-    // -- write the line numbers
-    memcpy(dataPtr, linenumber_array, sizeof(uint32) * array_size);
-    dataPtr += array_size;
-
-    // -- now send the packet
-    SocketManager::SendDataPacket(newPacket);
+    *dataPtr++ = unchanged_count;
+
+    // -- write the codeblocks, objid's, namespaces, functions and line numbers of the changed frames
+    memcpy(dataPtr, codeblock_array, sizeof(uint32) * changed_count);
+    dataPtr += changed_count;
+    memcpy(dataPtr, objid_array, sizeof(uint32) * changed_count);
+    dataPtr += changed_count;
+    memcpy(dataPtr, namespace_array, sizeof(uint32) * changed_count);
+    dataPtr += changed_count;
+    memcpy(dataPtr, func_array, sizeof(uint32) * changed_count);
+    dataPtr += changed_count;
+    memcpy(dataPtr, linenumber_array, sizeof(uint32) * changed_count);
+    dataPtr += changed_count;
+
+    // -- commit the message, to be sent with the batch
+    DebuggerEndMessage();
+
+    // -- remember what the debugger now has
+    for (int32 i = 0; i < array_size; ++i)
+    {
+        tDebuggerCallstackFrame& frame = mDebuggerCallstack[i];
+        frame.mCodeblockHash = codeblock_array[i];
+        frame.mObjectID = objid_array[i];
+        frame.mNamespaceHash = namespace_array[i];
+        frame.mFunctionHash = func_array[i];
+        frame.mLineNumber = linenumber_array[i];
+    }
+    mDebuggerCallstackSize = array_size;
 }
 
 // ====================================================================================================================
@@ -2347,21 +2737,14 @@ void CScriptContext::DebuggerSendWatchVariable(CDebuggerWatchVarEntry* watch_var
     // -- cached var object ID
     total_size += sizeof(int32);
 
-    // -- declare a header
-    // -- note, if we ever implement a request/acknowledge approach, we can use the mID field
-    SocketManager::tPacketHeader header(k_PacketVersion, SocketManager::tPacketHeader::DATA, total_size);
-
-    // -- create the packet (null data, as we'll fill in the data directly into the packet)
-    SocketManager::tDataPacket* newPacket = SocketManager::CreateDataPacket(&header, NULL);
-    if (!newPacket)
+    // -- reserve the message in the debugger batch (the data is written directly into the batch)
+    int32* dataPtr = DebuggerBeginMessage(total_size);
+    if (!dataPtr)
     {
-        TinPrint(this, "Error - DebuggerSendWatchVariable():  unable to send\n");
+        TinPrintError(this, "Error - DebuggerSendWatchVariable():  unable to send\n");
         return;
     }
 
-    // -- initialize the ptr to the data buffer
-    int32* dataPtr = (int32*)newPacket->mData;
-
     // -- write the identifier - defined in the debugger constants near the top of TinScript.h
     *dataPtr++ = k_DebuggerWatchVarEntryPacketID;
 
@@ -2412,103 +2795,134 @@ void CScriptContext::DebuggerSendWatchVariable(CDebuggerWatchVarEntry* watch_var
     // -- write the cached var object ID
     *dataPtr++ = watch_var_entry->mVarObjectID;
 
-    // -- send the packet
-    SocketManager::SendDataPacket(newPacket);
+    // -- commit the message, to be sent with the batch
+    DebuggerEndMessage();
 }
 
 // ====================================================================================================================
 // void DebuggerSendObjectMembers():  Given an object ID, send the entire hierarchy of members to the debugger
+// If an inspected object is given, only the members that changed since they were last sent are sent.
 // ====================================================================================================================
-void CScriptContext::DebuggerSendObjectMembers(CDebuggerWatchVarEntry* callingFunction, uint32 object_id)
+void CScriptContext::DebuggerSendObjectMembers(CDebuggerWatchVarEntry* callingFunction, uint32 object_id,
+                                               tDebuggerInspectObject* inspect)
 {
     CObjectEntry* oe = FindObjectEntry(object_id);
     if (!oe)
         return;
 
+    // -- send everything, unless we're diffing an inspected object that's been sent, and its layout hasn't changed
+    bool8 send_all = !inspect || inspect->mMemberCount < 0 || inspect->mMemberVersion != oe->GetMemberVersion();
+    if (inspect && send_all)
+    {
+        inspect->mMemberVersion = oe->GetMemberVersion();
+        inspect->mMemberCount = 0;
+    }
+
+    int32 member_index = 0;
+
     // -- send the dynamic var table
     if (oe->GetDynamicVarTable())
     {
-        // -- send the header to the debugger
-        CDebuggerWatchVarEntry watch_entry;
+        // -- the namespace labels are part of the layout, so they're only sent with everything else
+        if (send_all)
+        {
+            // -- send the header to the debugger
+            CDebuggerWatchVarEntry watch_entry;
 
-		// -- Inherit the calling function request ID
-		watch_entry.mWatchRequestID = callingFunction ? callingFunction->mWatchRequestID : 0;
-        watch_entry.mStackLevel = callingFunction ? callingFunction->mStackLevel : -1;
+		    // -- Inherit the calling function request ID
+		    watch_entry.mWatchRequestID = callingFunction ? callingFunction->mWatchRequestID : 0;
+            watch_entry.mStackLevel = callingFunction ? callingFunction->mStackLevel : -1;
 
-        watch_entry.mFuncNamespaceHash = callingFunction ? callingFunction->mFuncNamespaceHash : 0;
-        watch_entry.mFunctionHash = callingFunction ? callingFunction->mFunctionHash : 0;
-        watch_entry.mFunctionObjectID = callingFunction ? callingFunction->mFunctionObjectID : 0;
+            watch_entry.mFuncNamespaceHash = callingFunction ? callingFunction->mFuncNamespaceHash : 0;
+            watch_entry.mFunctionHash = callingFunction ? callingFunction->mFunctionHash : 0;
+            watch_entry.mFunctionObjectID = callingFunction ? callingFunction->mFunctionObjectID : 0;
 
-        watch_entry.mObjectID = object_id;
-        watch_entry.mNamespaceHash = Hash("self");
+            watch_entry.mObjectID = object_id;
+            watch_entry.mNamespaceHash = Hash("self");
 
-        // -- TYPE_void marks this as a namespace label, and set the object's name as the value
-        watch_entry.mType = TYPE_void;
-        SafeStrcpy(watch_entry.mVarName, "self", kMaxNameLength);
-        SafeStrcpy(watch_entry.mValue, oe->GetName(), kMaxNameLength);
+            // -- TYPE_void marks this as a namespace label, and set the object's name as the value
+            watch_entry.mType = TYPE_void;
+            SafeStrcpy(watch_entry.mVarName, "self", kMaxNameLength);
+            SafeStrcpy(watch_entry.mValue, oe->GetName(), kMaxNameLength);
 
-        // -- zero out the size
-        watch_entry.mArraySize = 0;
+            // -- zero out the size
+            watch_entry.mArraySize = 0;
 
-        // -- fill in the cached members
-        watch_entry.mVarHash = watch_entry.mNamespaceHash;
-        watch_entry.mVarObjectID = 0;
+            // -- fill in the cached members
+            watch_entry.mVarHash = watch_entry.mNamespaceHash;
+            watch_entry.mVarObjectID = 0;
 
-        // -- send to the Debugger
-        DebuggerSendWatchVariable(&watch_entry);
+            // -- send to the Debugger
+            DebuggerSendWatchVariable(&watch_entry);
+        }
 
         // -- now send var table members
-        DebuggerSendObjectVarTable(callingFunction, oe, watch_entry.mNamespaceHash, oe->GetDynamicVarTable());
+        static uint32 self_hash = Hash("self");
+        member_index = DebuggerSendObjectVarTable(callingFunction, oe, self_hash, oe->GetDynamicVarTable(), inspect,
+                                                  member_index, send_all);
     }
 
     // -- loop through the hierarchy of namespaces
     CNamespace* ns = oe->GetNamespace();
-    while (ns)
+    while (ns && member_index >= 0)
     {
-        CDebuggerWatchVarEntry ns_entry;
+        if (send_all)
+        {
+            CDebuggerWatchVarEntry ns_entry;
 
-		// -- Inherit the calling function request ID
-		ns_entry.mWatchRequestID = callingFunction ? callingFunction->mWatchRequestID : 0;;
-        ns_entry.mStackLevel = callingFunction ? callingFunction->mStackLevel : -1;
+		    // -- Inherit the calling function request ID
+		    ns_entry.mWatchRequestID = callingFunction ? callingFunction->mWatchRequestID : 0;;
+            ns_entry.mStackLevel = callingFunction ? callingFunction->mStackLevel : -1;
 
-        ns_entry.mFuncNamespaceHash = callingFunction ? callingFunction->mFuncNamespaceHash : 0;
-        ns_entry.mFunctionHash = callingFunction ? callingFunction->mFunctionHash : 0;
-        ns_entry.mFunctionObjectID = callingFunction ? callingFunction->mFunctionObjectID : 0;
+            ns_entry.mFuncNamespaceHash = callingFunction ? callingFunction->mFuncNamespaceHash : 0;
+            ns_entry.mFunctionHash = callingFunction ? callingFunction->mFunctionHash : 0;
+            ns_entry.mFunctionObjectID = callingFunction ? callingFunction->mFunctionObjectID : 0;
 
-        ns_entry.mObjectID = object_id;
-        ns_entry.mNamespaceHash = ns->GetHash();
+            ns_entry.mObjectID = object_id;
+            ns_entry.mNamespaceHash = ns->GetHash();
 
-        // -- TYPE_void marks this as a namespace label
-        ns_entry.mType = TYPE_void;
-        SafeStrcpy(ns_entry.mVarName, UnHash(ns->GetHash()), kMaxNameLength);
-        ns_entry.mValue[0] = '\0';
+            // -- TYPE_void marks this as a namespace label
+            ns_entry.mType = TYPE_void;
+            SafeStrcpy(ns_entry.mVarName, UnHash(ns->GetHash()), kMaxNameLength);
+            ns_entry.mValue[0] = '\0';
 
-        // -- zero out the size
-        ns_entry.mArraySize = 0;
+            // -- zero out the size
+            ns_entry.mArraySize = 0;
 
-        // -- fill in the cached members
-        ns_entry.mVarHash = ns_entry.mNamespaceHash;
-        ns_entry.mVarObjectID = 0;
+            // -- fill in the cached members
+            ns_entry.mVarHash = ns_entry.mNamespaceHash;
+            ns_entry.mVarObjectID = 0;
 
-        // -- send to the Debugger
-        DebuggerSendWatchVariable(&ns_entry);
+            // -- send to the Debugger
+            DebuggerSendWatchVariable(&ns_entry);
+        }
 
         // -- dump the vtable
-        DebuggerSendObjectVarTable(callingFunction, oe, ns_entry.mNamespaceHash, ns->GetVarTable());
+        member_index = DebuggerSendObjectVarTable(callingFunction, oe, ns->GetHash(), ns->GetVarTable(), inspect,
+                                                  member_index, send_all);
 
         // -- get the next namespace
         ns = ns->GetNext();
     }
+
+    // -- if the members no longer match those last sent (e.g. a namespace was recompiled), send everything
+    if (!send_all && member_index != inspect->mMemberCount)
+    {
+        inspect->mMemberCount = -1;
+        DebuggerSendObjectMembers(callingFunction, object_id, inspect);
+    }
 }
 
 // ====================================================================================================================
 // DebuggerSendObjectVarTable():  Send a tVarTable to the debugger.
+// When diffing an inspected object, returns the next member index, or -1 if the members don't match those last sent.
 // ====================================================================================================================
-void CScriptContext::DebuggerSendObjectVarTable(CDebuggerWatchVarEntry* callingFunction, CObjectEntry* oe,
-                                                uint32 ns_hash, tVarTable* var_table)
+int32 CScriptContext::DebuggerSendObjectVarTable(CDebuggerWatchVarEntry* callingFunction, CObjectEntry* oe,
+                                                 uint32 ns_hash, tVarTable* var_table,
+                                                 tDebuggerInspectObject* inspect, int32 member_index, bool8 send_all)
 {
     if (!var_table)
-        return;
+        return (member_index);
 
     CVariableEntry* member = var_table->First();
     while (member)
@@ -2547,12 +2961,61 @@ void CScriptContext::DebuggerSendObjectVarTable(CDebuggerWatchVarEntry* callingF
              member_entry.mVarObjectID = *(uint32*)(member->GetAddr(oe->GetAddr()));
         }
 
+        // -- an inspected object remembers the hash of each value sent
+        // -- note:  registered members can be written directly by code, and member entries are shared by every
+        // -- instance of a namespace, so the value itself is compared, rather than tracking writes
+        bool8 send_member = send_all;
+        if (inspect)
+        {
+            uint32 value_hash = Hash(member_entry.mValue, -1, false);
+            if (send_all)
+            {
+                // -- grow the member array, if needed
+                if (member_index >= inspect->mMemberSize)
+                {
+                    int32 new_size = inspect->mMemberSize > 0 ? inspect->mMemberSize * 2 : kLocalVarTableSize;
+                    tDebuggerInspectMember* new_members =
+                        TinAllocArray(ALLOC_Debugger, tDebuggerInspectMember, new_size);
+                    if (inspect->mMembers)
+                    {
+                        memcpy(new_members, inspect->mMembers, sizeof(tDebuggerInspectMember) * member_index);
+                        TinFreeArray(inspect->mMembers);
+                    }
+                    inspect->mMembers = new_members;
+                    inspect->mMemberSize = new_size;
+                }
+
+                inspect->mMembers[member_index].mNamespaceHash = ns_hash;
+                inspect->mMembers[member_index].mVarHash = member->GetHash();
+                inspect->mMembers[member_index].mValueHash = value_hash;
+                inspect->mMemberCount = member_index + 1;
+            }
+            else
+            {
+                // -- if the layout doesn't match, the caller will re-send everything
+                if (member_index >= inspect->mMemberCount ||
+                    inspect->mMembers[member_index].mNamespaceHash != ns_hash ||
+                    inspect->mMembers[member_index].mVarHash != member->GetHash())
+                {
+                    return (-1);
+                }
+
+                send_member = inspect->mMembers[member_index].mValueHash != value_hash;
+                inspect->mMembers[member_index].mValueHash = value_hash;
+            }
+
+            ++member_index;
+        }
+
         // -- send to the debugger
-        DebuggerSendWatchVariable(&member_entry);
+        if (send_member)
+            DebuggerSendWatchVariable(&member_entry);
 
         // -- get the next member
         member = var_table->Next();
     }
+
+    return (member_index);
 }
 
 // ====================================================================================================================
@@ -2584,21 +3047,14 @@ void CScriptContext::DebuggerSendAssert(const char* assert_msg, uint32 codeblock
     // -- send the line number
     total_size += sizeof(int32);
 
-    // -- declare a header
-    // -- note, if we ever implement a request/acknowledge approach, we can use the mID field
-    SocketManager::tPacketHeader header(k_PacketVersion, SocketManager::tPacketHeader::DATA, total_size);
-
-    // -- create the packet (null data, as we'll fill in the data directly into the packet)
-    SocketManager::tDataPacket* newPacket = SocketManager::CreateDataPacket(&header, NULL);
-    if (!newPacket)
+    // -- reserve the message in the debugger batch (the data is written directly into the batch)
+    int32* dataPtr = DebuggerBeginMessage(total_size);
+    if (!dataPtr)
     {
-        TinPrint(this, "Error - DebuggerSendAssert():  unable to send\n");
+        TinPrintError(this, "Error - DebuggerSendAssert():  unable to send\n");
         return;
     }
 
-    // -- initialize the ptr to the data buffer
-    int32* dataPtr = (int32*)newPacket->mData;
-
     // -- write the identifier - defined in the debugger constants near the top of TinScript.h
     *dataPtr++ = k_DebuggerAssertMsgPacketID;
 
@@ -2615,67 +3071,8 @@ void CScriptContext::DebuggerSendAssert(const char* assert_msg, uint32 codeblock
     // -- send the line number
     *dataPtr++ = line_number;
 
-    // -- send the packet
-    SocketManager::SendDataPacket(newPacket);
-}
-
-// ====================================================================================================================
-// DebuggerSendPrint():  Send a print message to the debugger (usually to echo the local output)
-// ====================================================================================================================
-void CScriptContext::DebuggerSendPrint(const char* fmt, ...)
-{
-    // -- ensure we have a valid string, and a connected debugger
-    if (!fmt || !SocketManager::IsConnected())
-        return;
-
-    // -- compose the message
-    va_list args;
-    va_start(args, fmt);
-    char msg_buf[512];
-    vsprintf_s(msg_buf, 512, fmt, args);
-    va_end(args);
-
-    // -- calculate the size of the data
-    int32 total_size = 0;
-
-    // -- first int32 will be identifying this data packet
-    total_size += sizeof(int32);
-
-    // -- send the length of the assert message, including EOL, and 4-byte aligned
-    int32 msgLength = strlen(msg_buf) + 1;
-    msgLength += 4 - (msgLength % 4);
-
-    // -- we'll be sending the length of the message, followed by the actual message string
-    total_size += sizeof(int32);
-    total_size += msgLength;
-
-    // -- declare a header
-    // -- note, if we ever implement a request/acknowledge approach, we can use the mID field
-    SocketManager::tPacketHeader header(k_PacketVersion, SocketManager::tPacketHeader::DATA, total_size);
-
-    // -- create the packet (null data, as we'll fill in the data directly into the packet)
-    SocketManager::tDataPacket* newPacket = SocketManager::CreateDataPacket(&header, NULL);
-    if (!newPacket)
-    {
-        TinPrint(this, "Error - DebuggerSendPrint():  unable to send\n");
-        return;
-    }
-
-    // -- initialize the ptr to the data buffer
-    int32* dataPtr = (int32*)newPacket->mData;
-
-    // -- write the identifier - defined in the debugger constants near the top of TinScript.h
-    *dataPtr++ = k_DebuggerPrintMsgPacketID;
-
-    // -- send the length of the assert message, including EOL, and 4-byte aligned
-    *dataPtr++ = msgLength;
-
-    // -- write the message string
-    SafeStrcpy((char*)dataPtr, msg_buf, msgLength);
-    dataPtr += (msgLength / 4);
-
-    // -- send the packet
-    SocketManager::SendDataPacket(newPacket);
+    // -- commit the message, to be sent with the batch
+    DebuggerEndMessage();
 }
 
 // ====================================================================================================================
@@ -2791,21 +3188,14 @@ void CScriptContext::DebuggerSendFunctionAssistEntry(const CDebuggerFunctionAssi
     // -- parameter name hash (x parameter count)
     total_size += (sizeof(int32) * function_assist_entry.mParameterCount);;
 
-    // -- declare a header
-    // -- note, if we ever implement a request/acknowledge approach, we can use the mID field
-    SocketManager::tPacketHeader header(k_PacketVersion, SocketManager::tPacketHeader::DATA, total_size);
-
-    // -- create the packet (null data, as we'll fill in the data directly into the packet)
-    SocketManager::tDataPacket* newPacket = SocketManager::CreateDataPacket(&header, NULL);
-    if (!newPacket)
+    // -- reserve the message in the debugger batch (the data is written directly into the batch)
+    int32* dataPtr = DebuggerBeginMessage(total_size);
+    if (!dataPtr)
     {
-        TinPrint(this, "Error - DebuggerSendFunctionAssistEntry():  unable to send\n");
+        TinPrintError(this, "Error - DebuggerSendFunctionAssistEntry():  unable to send\n");
         return;
     }
 
-    // -- initialize the ptr to the data buffer
-    int32* dataPtr = (int32*)newPacket->mData;
-
     // -- write the identifier - defined in the debugger constants near the top of TinScript.h
     *dataPtr++ = k_DebuggerFunctionAssistPacketID;
 
@@ -2841,8 +3231,8 @@ void CScriptContext::DebuggerSendFunctionAssistEntry(const CDebuggerFunctionAssi
         *dataPtr++ = function_assist_entry.mNameHash[i];
     }
 
-    // -- send the packet
-    SocketManager::SendDataPacket(newPacket);
+    // -- commit the message, to be sent with the batch
+    DebuggerEndMessage();
 }
 
 // ====================================================================================================================
@@ -2883,9 +3273,38 @@ void CScriptContext::DebuggerNotifyCreateObject(CObjectEntry* oe)
     // -- ensure the buffer is null terminated
     derivation_buf[kMaxNameLength - 1] = '\0';
 
-    // -- send the entry
-    SocketManager::SendCommandf("DebuggerNotifyCreateObject(%d, `%s`, `%s`);", oe->GetID(),
-                                oe->GetNameHash() != 0 ? oe->GetName() : "", derivation_buf);
+    // -- the ID, the object ID, and the name and derivation strings, each preceeded by its 4-byte aligned length
+    const char* name = oe->GetNameHash() != 0 ? oe->GetName() : "";
+    int32 nameLength = strlen(name) + 1;
+    nameLength += 4 - (nameLength % 4);
+    int32 derivationLength = strlen(derivation_buf) + 1;
+    derivationLength += 4 - (derivationLength % 4);
+    int32 total_size = 4 * sizeof(int32) + nameLength + derivationLength;
+
+    // -- reserve the message in the debugger batch
+    int32* dataPtr = DebuggerBeginMessage(total_size, DEBUGGER_CHANNEL_Objects);
+    // -- (not an error - no client may be subscribed to the object browser)
+    if (!dataPtr)
+    {
+        DebuggerDropObjectNotification();
+        return;
+    }
+
+    // -- the object won't need to be sent again, unless a later notification is dropped
+    oe->SetDebuggerEpoch(mDebuggerObjectEpoch);
+
+    *dataPtr++ = k_DebuggerObjectCreatedPacketID;
+    *dataPtr++ = oe->GetID();
+
+    *dataPtr++ = nameLength;
+    SafeStrcpy((char*)dataPtr, name, nameLength);
+    dataPtr += (nameLength / 4);
+
+    *dataPtr++ = derivationLength;
+    SafeStrcpy((char*)dataPtr, derivation_buf, derivationLength);
+    dataPtr += (derivationLength / 4);
+
+    DebuggerEndMessage();
 }
 
 // ====================================================================================================================
@@ -2898,8 +3317,17 @@ void CScriptContext::DebuggerNotifyDestroyObject(uint32 object_id)
     if (object_id == 0 || !IsDebuggerConnected(debugger_session))
         return;
 
-    // -- send the entry
-    SocketManager::SendCommandf("DebuggerNotifyDestroyObject(%d);", object_id);
+    // -- the message is the ID, and the object ID
+    int32* dataPtr = DebuggerBeginMessage(2 * sizeof(int32), DEBUGGER_CHANNEL_Objects);
+    if (!dataPtr)
+    {
+        DebuggerDropObjectNotification();
+        return;
+    }
+
+    *dataPtr++ = k_DebuggerObjectDestroyedPacketID;
+    *dataPtr++ = object_id;
+    DebuggerEndMessage();
 }
 
 // ====================================================================================================================
@@ -2912,9 +3340,19 @@ void CScriptContext::DebuggerNotifySetAddObject(uint32 parent_id, uint32 object_
     if (parent_id == 0 || object_id == 0 || !IsDebuggerConnected(debugger_session))
         return;
 
-    // -- send the entry
-    SocketManager::SendCommandf("DebuggerNotifySetAddObject(%d, %d, %s);", parent_id, object_id,
-                                owned ? "true" : "false");
+    // -- the message is the ID, the set ID, the object ID, and whether the set owns the object
+    int32* dataPtr = DebuggerBeginMessage(4 * sizeof(int32), DEBUGGER_CHANNEL_Objects);
+    if (!dataPtr)
+    {
+        DebuggerDropObjectNotification();
+        return;
+    }
+
+    *dataPtr++ = k_DebuggerSetAddObjectPacketID;
+    *dataPtr++ = parent_id;
+    *dataPtr++ = object_id;
+    *dataPtr++ = owned ? 1 : 0;
+    DebuggerEndMessage();
 }
 
 // ====================================================================================================================
@@ -2927,31 +3365,167 @@ void CScriptContext::DebuggerNotifySetRemoveObject(uint32 parent_id, uint32 obje
     if (parent_id == 0 || object_id == 0 || !IsDebuggerConnected(debugger_session))
         return;
 
-    // -- send the entry
-    SocketManager::SendCommandf("DebuggerNotifySetRemoveObject(%d, %d);", parent_id, object_id);
+    // -- the message is the ID, the set ID, and the object ID
+    int32* dataPtr = DebuggerBeginMessage(3 * sizeof(int32), DEBUGGER_CHANNEL_Objects);
+    if (!dataPtr)
+    {
+        DebuggerDropObjectNotification();
+        return;
+    }
+
+    *dataPtr++ = k_DebuggerSetRemoveObjectPacketID;
+    *dataPtr++ = parent_id;
+    *dataPtr++ = object_id;
+    DebuggerEndMessage();
+}
+
+// ====================================================================================================================
+// DebuggerNotifyClearObjectBrowser():  Notify the debugger the object list is about to be resent.
+// ====================================================================================================================
+void CScriptContext::DebuggerNotifyClearObjectBrowser()
+{
+    int32 debugger_session = 0;
+    if (!IsDebuggerConnected(debugger_session))
+        return;
+
+    int32* dataPtr = DebuggerBeginMessage(sizeof(int32), DEBUGGER_CHANNEL_Objects);
+    if (!dataPtr)
+    {
+        DebuggerDropObjectNotification();
+        return;
+    }
+
+    *dataPtr++ = k_DebuggerClearObjectBrowserPacketID;
+    DebuggerEndMessage();
+}
+
+// ====================================================================================================================
+// DebuggerNotifyTimeScale():  Notify the debugger of the scheduler's sim time scale.
+// ====================================================================================================================
+void CScriptContext::DebuggerNotifyTimeScale(float32 time_scale)
+{
+    int32 debugger_session = 0;
+    if (!IsDebuggerConnected(debugger_session))
+        return;
+
+    // -- the message is the ID, and the time scale
+    int32* dataPtr = DebuggerBeginMessage(2 * sizeof(int32), DEBUGGER_CHANNEL_Schedules);
+    if (!dataPtr)
+        return;
+
+    *dataPtr++ = k_DebuggerTimeScalePacketID;
+    *(float32*)dataPtr++ = time_scale;
+    DebuggerEndMessage();
+}
+
+// ====================================================================================================================
+// DebuggerNotifyAddSchedule():  Notify the debugger of a pending schedule.
+// ====================================================================================================================
+void CScriptContext::DebuggerNotifyAddSchedule(int32 req_id, bool8 repeat, int32 time_remaining_ms,
+                                               uint32 object_id, const char* command)
+{
+    int32 debugger_session = 0;
+    if (!IsDebuggerConnected(debugger_session))
+        return;
+
+    if (!command)
+        command = "";
+
+    // -- the ID, request ID, repeat flag, time remaining, object ID, and the command string and its aligned length
+    int32 cmdLength = strlen(command) + 1;
+    cmdLength += 4 - (cmdLength % 4);
+    int32 total_size = 6 * sizeof(int32) + cmdLength;
+
+    int32* dataPtr = DebuggerBeginMessage(total_size, DEBUGGER_CHANNEL_Schedules);
+    // -- (not an error - no client may be subscribed to schedules)
+    if (!dataPtr)
+        return;
+
+    *dataPtr++ = k_DebuggerAddSchedulePacketID;
+    *dataPtr++ = req_id;
+    *dataPtr++ = repeat ? 1 : 0;
+    *dataPtr++ = time_remaining_ms;
+    *dataPtr++ = object_id;
+
+    *dataPtr++ = cmdLength;
+    SafeStrcpy((char*)dataPtr, command, cmdLength);
+    dataPtr += (cmdLength / 4);
+
+    DebuggerEndMessage();
+}
+
+// ====================================================================================================================
+// DebuggerNotifyRescheduleSchedule():  Notify the debugger a repeated or resumed schedule is pending again.
+// ====================================================================================================================
+void CScriptContext::DebuggerNotifyRescheduleSchedule(int32 req_id, int32 time_remaining_ms)
+{
+    int32 debugger_session = 0;
+    if (!IsDebuggerConnected(debugger_session))
+        return;
+
+    // -- the message is the ID, the request ID, and the new time remaining
+    int32* dataPtr = DebuggerBeginMessage(3 * sizeof(int32), DEBUGGER_CHANNEL_Schedules);
+    if (!dataPtr)
+        return;
+
+    *dataPtr++ = k_DebuggerRescheduleSchedulePacketID;
+    *dataPtr++ = req_id;
+    *dataPtr++ = time_remaining_ms;
+    DebuggerEndMessage();
+}
+
+// ====================================================================================================================
+// DebuggerNotifyRemoveSchedule():  Notify the debugger a schedule has been dispatched or cancelled.
+// ====================================================================================================================
+void CScriptContext::DebuggerNotifyRemoveSchedule(int32 req_id)
+{
+    int32 debugger_session = 0;
+    if (!IsDebuggerConnected(debugger_session))
+        return;
+
+    // -- the message is the ID, and the request ID
+    int32* dataPtr = DebuggerBeginMessage(2 * sizeof(int32), DEBUGGER_CHANNEL_Schedules);
+    if (!dataPtr)
+        return;
+
+    *dataPtr++ = k_DebuggerRemoveSchedulePacketID;
+    *dataPtr++ = req_id;
+    DebuggerEndMessage();
 }
 
 // ====================================================================================================================
 // DebuggerListObjects():  Instead of printing the hierarchy of objects, this method send the entries to the debugger.
+// The listing is sent a budget at a time, from Update(), and objects the debugger already has are skipped.
 // ====================================================================================================================
-void CScriptContext::DebuggerListObjects(uint32 parent_id, uint32 object_id)
+void CScriptContext::DebuggerListObjects(uint32 object_id)
 {
     // -- ensure we have a debugger connected
 	int32 debugger_session = 0;
     if (!IsDebuggerConnected(debugger_session))
         return;
 
+    // -- if a notification was dropped since the last full listing, the debugger's browser may be out of date
+    // -- so it's cleared, and every object is sent again (bumping the epoch ensures none are skipped)
+    if (object_id == 0 && mDebuggerObjectListEpoch != mDebuggerObjectEpoch)
+    {
+        ++mDebuggerObjectEpoch;
+        DebuggerNotifyClearObjectBrowser();
+        mDebuggerObjectListEpoch = mDebuggerObjectEpoch;
+    }
+
+    // -- any listing in progress is restarted
+    mDebuggerListCount = 0;
+    mDebuggerListIndex = 0;
+
     // -- see if we're supposed to list all objects
     if (object_id == 0)
     {
         CObjectEntry* oe = GetObjectDictionary()->First();
         while (oe)
         {
-            // -- if we're listing all objects, then we only iterate through the
+            // -- if we're listing all objects, then we only iterate through the root level objects
             if (oe->GetObjectGroup() == NULL)
-            {
-                DebuggerListObjects(0, oe->GetID());
-            }
+                DebuggerPushListEntry(0, oe->GetID(), false);
 
             // -- next object
             oe = GetObjectDictionary()->Next();
@@ -2961,39 +3535,104 @@ void CScriptContext::DebuggerListObjects(uint32 parent_id, uint32 object_id)
     // -- else we have a specific object to dump
     else
     {
-        CObjectEntry* oe = FindObjectEntry(object_id);
-        if (oe)
+        DebuggerPushListEntry(0, object_id, false);
+    }
+}
+
+// ====================================================================================================================
+// DebuggerPushListEntry():  Add an object to the pending listing, growing the queue if needed.
+// ====================================================================================================================
+void CScriptContext::DebuggerPushListEntry(uint32 parent_id, uint32 object_id, bool8 parent_sent)
+{
+    if (mDebuggerListCount >= mDebuggerListSize)
+    {
+        // -- if entries have already been sent, reclaim their space first
+        if (mDebuggerListIndex > 0)
         {
-            // -- if we found the object entry, send it to the debugger
-            DebuggerNotifyCreateObject(oe);
+            mDebuggerListCount -= mDebuggerListIndex;
+            memmove(mDebuggerListQueue, &mDebuggerListQueue[mDebuggerListIndex],
+                    sizeof(tDebuggerListEntry) * mDebuggerListCount);
+            mDebuggerListIndex = 0;
+        }
 
-            // -- if we have a parent_id, then notify the debugger of the membership
-            if (parent_id != 0)
+        // -- otherwise, grow the queue
+        if (mDebuggerListCount >= mDebuggerListSize)
+        {
+            int32 new_size = mDebuggerListSize > 0 ? mDebuggerListSize * 2 : kDebuggerListObjectBudget;
+            tDebuggerListEntry* new_queue = TinAllocArray(ALLOC_Debugger, tDebuggerListEntry, new_size);
+            if (mDebuggerListQueue)
             {
-                DebuggerNotifySetAddObject(parent_id, oe->GetID(), oe->GetGroupID() == parent_id);
+                memcpy(new_queue, mDebuggerListQueue, sizeof(tDebuggerListEntry) * mDebuggerListCount);
+                TinFreeArray(mDebuggerListQueue);
             }
+            mDebuggerListQueue = new_queue;
+            mDebuggerListSize = new_size;
+        }
+    }
 
-            // -- if the object is an object set, recursively send its children
-            static uint32 object_set_hash = Hash("CObjectSet");
-            if (oe->HasNamespace(object_set_hash))
+    tDebuggerListEntry& entry = mDebuggerListQueue[mDebuggerListCount++];
+    entry.mParentID = parent_id;
+    entry.mObjectID = object_id;
+    entry.mParentSent = parent_sent;
+}
+
+// ====================================================================================================================
+// DebuggerUpdateListObjects():  Send the next budget of objects from the pending listing.
+// ====================================================================================================================
+void CScriptContext::DebuggerUpdateListObjects()
+{
+    static uint32 object_set_hash = Hash("CObjectSet");
+
+    int32 budget = kDebuggerListObjectBudget;
+    while (mDebuggerListIndex < mDebuggerListCount && budget-- > 0)
+    {
+        // -- copy the entry, as pushing the children may move the queue
+        tDebuggerListEntry entry = mDebuggerListQueue[mDebuggerListIndex++];
+
+        // -- the object may have been destroyed since it was queued (and the debugger notified)
+        CObjectEntry* oe = FindObjectEntry(entry.mObjectID);
+        if (!oe)
+            continue;
+
+        // -- objects already sent in this epoch (e.g. created since the debugger connected) are skipped
+        bool8 sent = false;
+        if (oe->GetDebuggerEpoch() != mDebuggerObjectEpoch)
+        {
+            DebuggerNotifyCreateObject(oe);
+            sent = true;
+        }
+
+        // -- the membership was notified when it changed, unless either object is only now being sent
+        if (entry.mParentID != 0 && (sent || entry.mParentSent))
+            DebuggerNotifySetAddObject(entry.mParentID, oe->GetID(), oe->GetGroupID() == entry.mParentID);
+
+        // -- if the object is an object set, queue its children
+        if (oe->HasNamespace(object_set_hash))
+        {
+            CObjectSet* object_set = static_cast<CObjectSet*>(FindObject(oe->GetID()));
+            if (object_set)
             {
-                CObjectSet* object_set = static_cast<CObjectSet*>(FindObject(oe->GetID()));
-                if (object_set)
+                uint32 child_id = object_set->First();
+                while (child_id != 0)
                 {
-                    uint32 child_id = object_set->First();
-                    while (child_id != 0)
-                    {
-                        DebuggerListObjects(oe->GetID(), child_id);
-                        child_id = object_set->Next();
-                    }
+                    DebuggerPushListEntry(oe->GetID(), child_id, sent);
+                    child_id = object_set->Next();
                 }
             }
         }
     }
+
+    // -- once the listing is complete, reset the queue
+    if (mDebuggerListIndex >= mDebuggerListCount)
+    {
+        mDebuggerListCount = 0;
+        mDebuggerListIndex = 0;
+    }
 }
 
 // ====================================================================================================================
 // DebuggerInspectObject():  Send the object members and methods to the debugger.
+// The object remains inspected, and changes to its members are sent from Update(), until the inspection is stopped.
 // ====================================================================================================================
 void CScriptContext::DebuggerInspectObject(uint32 object_id)
 {
@@ -3004,15 +3643,108 @@ void CScriptContext::DebuggerInspectObject(uint32 object_id)
 
     // -- see if we're supposed to list all objects
     CObjectEntry* oe = FindObjectEntry(object_id);
-    if (oe)
+    if (!oe)
+        return;
+
+    // -- find the inspected object, or add it
+    tDebuggerInspectObject* inspect = NULL;
+    for (int32 i = 0; i < mDebuggerInspectCount; ++i)
+    {
+        if (mDebuggerInspectObjects[i].mObjectID == object_id)
+        {
+            inspect = &mDebuggerInspectObjects[i];
+            break;
+        }
+    }
+
+    // -- if we're already inspecting as many objects as we can, the object is sent, but won't be updated
+    if (!inspect && mDebuggerInspectCount < kDebuggerInspectMaxObjects)
+    {
+        inspect = &mDebuggerInspectObjects[mDebuggerInspectCount++];
+        inspect->mObjectID = object_id;
+        inspect->mMemberVersion = 0;
+        inspect->mMembers = NULL;
+        inspect->mMemberSize = 0;
+    }
+
+    // -- a request always sends everything
+    if (inspect)
+        inspect->mMemberCount = -1;
+
+    // -- send a dump of the object to the debugger
+    DebuggerSendObjectMembers(NULL, object_id, inspect);
+}
+
+// ====================================================================================================================
+// DebuggerStopInspectObject():  Stop sending changes to an object's members to the debugger.
+// ====================================================================================================================
+void CScriptContext::DebuggerStopInspectObject(uint32 object_id)
+{
+    for (int32 i = 0; i < mDebuggerInspectCount; ++i)
     {
-        // -- send a dump of the object to the debugger
-        DebuggerSendObjectMembers(NULL, object_id);
+        if (mDebuggerInspectObjects[i].mObjectID == object_id)
+        {
+            if (mDebuggerInspectObjects[i].mMembers)
+                TinFreeArray(mDebuggerInspectObjects[i].mMembers);
+
+            // -- the order doesn't matter - move the last inspected object into the slot
+            mDebuggerInspectObjects[i] = mDebuggerInspectObjects[--mDebuggerInspectCount];
+            return;
+        }
     }
 }
 
 // ====================================================================================================================
-// DebuggerListSchedules():  Send the connected debugger, a dump of the current pending schedules.
+// DebuggerClearInspectObjects():  Stop inspecting all objects.
+// ====================================================================================================================
+void CScriptContext::DebuggerClearInspectObjects()
+{
+    for (int32 i = 0; i < mDebuggerInspectCount; ++i)
+    {
+        if (mDebuggerInspectObjects[i].mMembers)
+            TinFreeArray(mDebuggerInspectObjects[i].mMembers);
+    }
+
+    mDebuggerInspectCount = 0;
+    mDebuggerInspectNext = 0;
+}
+
+// ====================================================================================================================
+// DebuggerUpdateInspectObjects():  Send the members of inspected objects that have changed, at a limited rate.
+// ====================================================================================================================
+void CScriptContext::DebuggerUpdateInspectObjects(uint32 curtime)
+{
+    if (mDebuggerInspectCount == 0 || curtime - mDebuggerInspectUpdateTime < (uint32)kDebuggerInspectUpdateMS)
+        return;
+
+    mDebuggerInspectUpdateTime = curtime;
+
+    // -- each update compares up to a budget of members, continuing from where the last update left off
+    int32 budget = kDebuggerInspectMemberBudget;
+    int32 visited = 0;
+    while (budget > 0 && visited < mDebuggerInspectCount)
+    {
+        if (mDebuggerInspectNext >= mDebuggerInspectCount)
+            mDebuggerInspectNext = 0;
+
+        // -- if the object has been destroyed, stop inspecting it (the debugger closes the inspector)
+        tDebuggerInspectObject& inspect = mDebuggerInspectObjects[mDebuggerInspectNext];
+        if (!FindObjectEntry(inspect.mObjectID))
+        {
+            DebuggerStopInspectObject(inspect.mObjectID);
+            continue;
+        }
+
+        DebuggerSendObjectMembers(NULL, inspect.mObjectID, &inspect);
+        budget -= inspect.mMemberCount > 0 ? inspect.mMemberCount : 1;
+
+        ++mDebuggerInspectNext;
+        ++visited;
+    }
+}
+
+// ====================================================================================================================
+// DebuggerListSchedules():  Send the connected debugger the current pending schedules, a budget per update.
 // ====================================================================================================================
 void CScriptContext::DebuggerListSchedules()
 {
@@ -3028,8 +3760,6 @@ void CScriptContext::DebuggerListSchedules()
 // ====================================================================================================================
 // AddThreadCommand():  This enqueues a command, to be process during the normal update
 // ====================================================================================================================
-// -- Thread commands are only supported in WIN32
-#ifdef WIN32
 bool8 CScriptContext::AddThreadCommand(const char* command)
 {
     // -- sanity check
@@ -3049,7 +3779,7 @@ bool8 CScriptContext::AddThreadCommand(const char* command)
 
     // -- ensure we've got room
     uint32 cmdLength = strlen(command);
-    uint32 lengthRemaining = kThreadExecBufferSize - ((uint32)mThreadBufPtr - (uint32)mThreadExecBuffer);
+    uint32 lengthRemaining = kThreadExecBufferSize - (uint32)(mThreadBufPtr - mThreadExecBuffer);
     if (lengthRemaining < cmdLength)
     {
         // -- no need to assert - the socket will re-enqueue the command after the buffer has been processed
@@ -3097,8 +3827,6 @@ void CScriptContext::ProcessThreadCommands()
     ExecCommand(local_exec_buffer);
 }
 
-#endif // WIN32
-
 // -- Debugger Registration -------------------------------------------------------------------------------------------
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -3272,11 +4000,8 @@ void DebuggerListObjects(int32 root_object_id)
     if (!script_context->IsDebuggerConnected(debugger_session))
         return;
 
-    // -- as we've just received the request, send the initial "clear" response
-    SocketManager::SendCommand("DebuggerClearObjectBrowser();");
-
-    // -- send the list of objects
-    script_context->DebuggerListObjects(0, root_object_id);
+    // -- send the list of objects (the browser is cleared first, if it may be out of date)
+    script_context->DebuggerListObjects(root_object_id);
 }
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -3298,6 +4023,19 @@ void DebuggerInspectObject(int32 object_id)
     script_context->DebuggerInspectObject(object_id);
 }
 
+// --------------------------------------------------------------------------------------------------------------------
+// DebuggerStopInspectObject():  Stop sending the connected debugger changes to an object's members.
+// --------------------------------------------------------------------------------------------------------------------
+void DebuggerStopInspectObject(int32 object_id)
+{
+    // -- ensure we have a script context
+    CScriptContext* script_context = GetContext();
+    if (!script_context)
+        return;
+
+    script_context->DebuggerStopInspectObject(object_id);
+}
+
 // --------------------------------------------------------------------------------------------------------------------
 // DebuggerListSchedules():  Send the connected debugger, a dump of the current pending schedules.
 // --------------------------------------------------------------------------------------------------------------------
@@ -3353,12 +4091,13 @@ REGISTER_FUNCTION_P3(DebuggerModifyVariableWatch, DebuggerModifyVariableWatch, v
 
 REGISTER_FUNCTION_P1(DebuggerListObjects, DebuggerListObjects, void, int32);
 REGISTER_FUNCTION_P1(DebuggerInspectObject, DebuggerInspectObject, void, int32);
+REGISTER_FUNCTION_P1(DebuggerStopInspectObject, DebuggerStopInspectObject, void, int32);
 
 REGISTER_FUNCTION_P0(DebuggerListSchedules, DebuggerListSchedules, void);
 REGISTER_FUNCTION_P1(DebuggerRequestFunctionAssist, DebuggerRequestFunctionAssist, void, int32);
 
 // == class CThreadMutex ==============================================================================================
-// -- CThreadMutex is only functional in WIN32
+// -- CThreadMutex uses a win32 mutex, or a pthread mutex otherwise
 
 // ====================================================================================================================
 // Constructor
@@ -3368,9 +4107,31 @@ CThreadMutex::CThreadMutex()
 {
     #ifdef WIN32
         mThreadMutex = CreateMutex(NULL, false, NULL);
+    #else
+        // -- recursive, to match the behavior of a win32 mutex
+        pthread_mutexattr_t mutex_attr;
+        pthread_mutexattr_init(&mutex_attr);
+        pthread_mutexattr_settype(&mutex_attr, PTHREAD_MUTEX_RECURSIVE);
+        mThreadMutex = new pthread_mutex_t;
+        pthread_mutex_init((pthread_mutex_t*)mThreadMutex, &mutex_attr);
+        pthread_mutexattr_destroy(&mutex_attr);
     #endif
 }
 
+// ====================================================================================================================
+// Destructor
+// ====================================================================================================================
+CThreadMutex::~CThreadMutex()
+{
+    #ifdef WIN32
+        CloseHandle(mThreadMutex);
+    #else
+        pthread_mutex_destroy((pthread_mutex_t*)mThreadMutex);
+        delete (pthread_mutex_t*)mThreadMutex;
+    #endif
+    mThreadMutex = NULL;
+}
+
 // ====================================================================================================================
 // Lock():  Lock access to the following structure/code from any other thread, until Unlocked()
 // ====================================================================================================================
@@ -3380,6 +4141,8 @@ void CThreadMutex::Lock()
     //printf("[0x%x] Thread locked: %s\n", (unsigned int)this, mIsLocked ? "true" : "false");
     #ifdef WIN32
         WaitForSingleObject(mThreadMutex, INFINITE);
+    #else
+        pthread_mutex_lock((pthread_mutex_t*)mThreadMutex);
     #endif
 }
 
@@ -3390,6 +4153,8 @@ void CThreadMutex::Unlock()
 {
     #ifdef WIN32
         ReleaseMutex(mThreadMutex);
+    #else
+        pthread_mutex_unlock((pthread_mutex_t*)mThreadMutex);
     #endif
     mIsLocked = false;
     //printf("[0x%x] Thread locked: %s\n", (unsigned int)this, mIsLocked ? "true" : "false");
@@ -3412,8 +4177,8 @@ CDebuggerWatchExpression::CDebuggerWatchExpression(bool8 isConditional, bool8 br
     SafeStrcpy(mConditional, condition, kMaxNameLength);
     SafeStrcpy(mTrace, trace, kMaxNameLength);
     mTraceOnCondition = trace_on_condition;
-    mWatchFunctionEntry = NULL;
-    mTraceFunctionEntry = NULL;
+    memset(&mWatchFunction, 0, sizeof(mWatchFunction));
+    memset(&mTraceFunction, 0, sizeof(mTraceFunction));
 }
 
 // ====================================================================================================================
@@ -3445,16 +4210,7 @@ void CDebuggerWatchExpression::SetAttributes(bool break_enabled, const char* new
     // -- if the conditional has changed, and the previous had been compiled, we need to delete it
     if (strcmp(mConditional, new_conditional) != 0)
     {
-        if (mWatchFunctionEntry)
-        {
-            // -- to delete a function, remove it from it's namespace, and then deleting it will automatically
-            // -- remove it from whatever codeblock owned it...
-            CCodeBlock* codeblock = mWatchFunctionEntry->GetCodeBlock();
-            TinScript::GetContext()->GetGlobalNamespace()->GetFuncTable()->RemoveItem(mWatchFunctionEntry->GetHash());
-            TinFree(mWatchFunctionEntry);
-            CCodeBlock::DestroyCodeBlock(codeblock);
-            mWatchFunctionEntry = NULL;
-        }
+        ClearWatchFunction(mWatchFunction);
 
         // -- the first time this is needed, it'll be evaluated
         SafeStrcpy(mConditional, new_conditional, kMaxNameLength);
@@ -3463,20 +4219,35 @@ void CDebuggerWatchExpression::SetAttributes(bool break_enabled, const char* new
     // -- same for the trace
     if (strcmp(mTrace, new_trace) != 0)
     {
-        if (mTraceFunctionEntry)
-        {
-            CCodeBlock* codeblock = mTraceFunctionEntry->GetCodeBlock();
-            TinScript::GetContext()->GetGlobalNamespace()->GetFuncTable()->RemoveItem(mTraceFunctionEntry->GetHash());
-            TinFree(mTraceFunctionEntry);
-            CCodeBlock::DestroyCodeBlock(codeblock);
-            mTraceFunctionEntry = NULL;
-        }
+        ClearWatchFunction(mTraceFunction);
 
         // -- the first time this is needed, it'll be evaluated
         SafeStrcpy(mTrace, new_trace, kMaxNameLength);
     }
 }
 
+// ====================================================================================================================
+// ClearWatchFunction():  Delete the compiled function (if any), so the expression is compiled again when evaluated.
+// ====================================================================================================================
+void CDebuggerWatchExpression::ClearWatchFunction(tWatchFunction& watch_function)
+{
+    if (watch_function.mFunctionEntry)
+    {
+        // -- to delete a function, remove it from it's namespace, and then deleting it will automatically
+        // -- remove it from whatever codeblock owned it...
+        CFunctionEntry* fe = watch_function.mFunctionEntry;
+        CCodeBlock* codeblock = fe->GetCodeBlock();
+        TinScript::GetContext()->GetGlobalNamespace()->GetFuncTable()->RemoveItem(fe->GetHash());
+        TinFree(fe);
+        CCodeBlock::DestroyCodeBlock(codeblock);
+    }
+
+    if (watch_function.mSlots)
+        TinFreeArray(watch_function.mSlots);
+
+    memset(&watch_function, 0, sizeof(watch_function));
+}
+
 } // TinScript
 
 // ====================================================================================================================
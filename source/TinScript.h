@@ -33,6 +33,7 @@
 #include "integration.h"
 #include "TinTypes.h"
 #include "TinNamespace.h"
+#include "TinLog.h"
 
 // --------------------------------------------------------------------------------------------------------------------
 // -- compile flags
@@ -53,7 +54,7 @@
 // -- executed through their hash values...
 #define CASE_SENSITIVE 1
 
-const int32 kCompilerVersion = 3;
+const int32 kCompilerVersion = 6;
 
 // --------------------------------------------------------------------------------------------------------------------
 // -- only case_sensitive has been extensively tested, however theoretically TinScript should function as a
@@ -128,13 +129,12 @@ const int32 kMaxArgLength = 256;
 // -- change this constant, if you genregclasses.py -maxparam X, to generate higher count templated bindings
 const int32 kMaxRegisteredParameterCount = 8;
 
-const int32 kMaxVariableArraySize = 256;
-
 const int32 kScriptContextThreadSize = 7;
 
 const int32 kDebuggerCallstackSize = 32;
 const int32 kDebuggerWatchWindowSize = 128;
 const int32 kBreakpointTableSize = 17;
+const int32 kLineNumberTableBlockSize = 16;
 
 const int32 kGlobalFuncTableSize = 97;
 const int32 kGlobalVarTableSize = 97;
@@ -143,6 +143,9 @@ const int32 kLocalFuncTableSize = 17;
 const int32 kLocalVarTableSize = 17;
 
 const int32 kFunctionCallStackSize = 2048;
+const int32 kParseArenaChunkSize = 64 * 1024;
+
+const int32 kCodeBlockDestroyBudgetUS = 250;
 
 const int32 kExecStackSize = 4096;
 const int32 kExecFuncCallDepth = 2048;
@@ -152,8 +155,12 @@ const int32 kStringTableDictionarySize = 577;
 
 const int32 kObjectTableSize = 10007;
 
-const int32 kMasterMembershipTableSize = 97;
 const int32 kObjectGroupTableSize = 17;
+const int32 kObjectSetIteratorTableSize = 7;
+const int32 kObjectSetMaxIterators = 32;
+
+const int32 kSignalTableSize = 97;
+const int32 kSignalSubscriptionMinSize = 8;
 
 const int32 kMaxScratchBuffers = 32;
 
@@ -171,8 +178,51 @@ const int32 k_DebuggerWatchVarEntryPacketID         = 0x07;
 const int32 k_DebuggerAssertMsgPacketID             = 0x08;
 const int32 k_DebuggerPrintMsgPacketID              = 0x09;
 const int32 k_DebuggerFunctionAssistPacketID        = 0x0a;
+const int32 k_DebuggerObjectCreatedPacketID         = 0x0b;
+const int32 k_DebuggerObjectDestroyedPacketID       = 0x0c;
+const int32 k_DebuggerSetAddObjectPacketID          = 0x0d;
+const int32 k_DebuggerSetRemoveObjectPacketID       = 0x0e;
+const int32 k_DebuggerClearObjectBrowserPacketID    = 0x0f;
+const int32 k_DebuggerTimeScalePacketID             = 0x10;
+const int32 k_DebuggerAddSchedulePacketID           = 0x11;
+const int32 k_DebuggerRemoveSchedulePacketID        = 0x12;
+const int32 k_DebuggerBatchPacketID                 = 0x13;
+const int32 k_DebuggerLogMsgPacketID                = 0x14;
+const int32 k_DebuggerRescheduleSchedulePacketID    = 0x15;
+const int32 k_DebuggerCallstackDeltaPacketID        = 0x16;
 const int32 k_DebuggerMaxPacketID                   = 0xff;
 
+// -- a batch packet is the ID, the message count, then each message:  its (4-byte aligned) size, and its data
+// -- the data of each message is identical to that of a packet sent on its own, beginning with its packet ID
+
+// -- a callstack delta is the ID, the callstack size, the number of outermost frames unchanged since the previous
+// -- callstack sent, then the codeblock, object, namespace, function and line arrays of only the changed frames
+
+// -- debugger messages are sent on channels - each connected client only receives the channels it subscribes to
+#define DebuggerChannelTuple                                                              \
+    DebuggerChannelEntry(Debugger)      /* breakpoints, callstacks, watches, asserts */  \
+    DebuggerChannelEntry(Print)         /* remote prints */                              \
+    DebuggerChannelEntry(Objects)       /* the object browser */                         \
+    DebuggerChannelEntry(Schedules)     /* pending schedules, and the sim time scale */  \
+
+enum eDebuggerChannel
+{
+    #define DebuggerChannelEntry(a) DEBUGGER_CHANNEL_##a,
+    DebuggerChannelTuple
+    #undef DebuggerChannelEntry
+
+    DEBUGGER_CHANNEL_COUNT
+};
+
+const uint32 k_DebuggerChannelMaskAll = (1 << DEBUGGER_CHANNEL_COUNT) - 1;
+
+// -- object and schedule listings, and inspected object updates, are spread across updates, so large scenes don't stall
+const int32 kDebuggerListObjectBudget = 256;
+const int32 kDebuggerListScheduleBudget = 256;
+const int32 kDebuggerInspectMaxObjects = 16;
+const int32 kDebuggerInspectUpdateMS = 100;
+const int32 kDebuggerInspectMemberBudget = 512;
+
 // == namespace TinScript =============================================================================================
 
 namespace TinScript
@@ -187,6 +237,8 @@ class CNamespace;
 class CCodeBlock;
 class CStringTable;
 class CScheduler;
+class CSignalManager;
+class CContextImage;
 class CScriptContext;
 class CObjectEntry;
 class CMasterMembershipList;
@@ -208,12 +260,18 @@ class CThreadMutex
 {
     public:
         CThreadMutex();
+        ~CThreadMutex();
         void Lock();
         void Unlock();
 
     protected:
         void* mThreadMutex;
         bool8 mIsLocked;
+
+    private:
+        // -- the mutex is owned, so it can't be copied
+        CThreadMutex(const CThreadMutex&);
+        CThreadMutex& operator=(const CThreadMutex&);
 };
 
 // ====================================================================================================================
@@ -286,14 +344,31 @@ class CDebuggerWatchExpression
 
         void SetAttributes(bool8 break_enabled, const char* conditional, const char* trace, bool8 trace_on_condition);
 
+        // -- each expression is compiled once, into a function whose locals are bound to the stack slots of the
+        // -- function it was compiled within - it's only recompiled if evaluated within a different function
+        // -- (a bound function without a function entry is an expression that failed to compile)
+        // -- note:  the binding is to the function's entry ID, so a redefinition of the function is a new binding
+        struct tWatchFunction
+        {
+            CFunctionEntry* mFunctionEntry;
+            uint32 mBoundFunctionID;
+            int32 mLocalVarCount;
+
+            // -- pairs of (source stack offset, watch function stack offset)
+            int32 mSlotCount;
+            int32* mSlots;
+        };
+
+        void ClearWatchFunction(tWatchFunction& watch_function);
+
         static int gWatchExpressionID;
         bool8 mIsEnabled;
         bool8 mIsConditional;
         char mConditional[kMaxNameLength];
         char mTrace[kMaxNameLength];
         bool8 mTraceOnCondition;
-        CFunctionEntry* mWatchFunctionEntry;
-        CFunctionEntry* mTraceFunctionEntry;
+        tWatchFunction mWatchFunction;
+        tWatchFunction mTraceFunction;
 };
 
 // ====================================================================================================================
@@ -336,6 +411,8 @@ class CScriptContext
 
         CCodeBlock* CompileScript(const char* filename);
         bool8 ExecScript(const char* filename, bool8 must_exist, bool8 re_exec);
+        bool8 ReloadScript(const char* filename);
+        void RetireFunctionEntry(CFunctionEntry* fe);
 
         CCodeBlock* CompileCommand(const char* statement);
         bool8 ExecCommand(const char* statement);
@@ -358,7 +435,28 @@ class CScriptContext
         CNamespace* GetGlobalNamespace() { return (mGlobalNamespace); }
         CStringTable* GetStringTable() { return (mStringTable); }
         CHashTable<CCodeBlock>* GetCodeBlockList() { return (mCodeBlockList); }
+
+        // -- codeblocks no longer in use are destroyed incrementally, a time budget's worth per update
+        CCodeBlock*& GetDeadCodeBlockList() { return (mDeadCodeBlockList); }
+        void DestroyDeadCodeBlocks(int32 time_budget_us = -1);
         CScheduler* GetScheduler() { return (mScheduler); }
+        CSignalManager* GetSignalManager() { return (mSignalManager); }
+        CScriptLog* GetLog() { return (mLog); }
+
+        // -- the log filter is tested before a message is formatted (see TinLog())
+        bool8 IsLogEnabled(eLogSeverity severity, int32 channel) const
+        {
+            return (mLog != NULL && mLog->IsEnabled(severity, channel));
+        }
+        void Log(eLogSeverity severity, int32 channel, const char* fmt, ...);
+
+        // -- deliver what has been logged so far - e.g. before an assert, so its output follows the prints
+        // -- that led to it, or while broken in the debugger, when Update() isn't draining the log
+        void DrainLog()
+        {
+            if (mLog != NULL)
+                mLog->Drain();
+        }
         CMasterMembershipList* GetMasterMembershipList() { return (mMasterMembershipList); }
 
         CHashTable<CNamespace>* GetNamespaceDictionary() { return (mNamespaceDictionary); }
@@ -371,12 +469,25 @@ class CScriptContext
         bool8 LinkNamespaces(const char* parentnsname, const char* childnsname);
         bool8 LinkNamespaces(CNamespace* parentns, CNamespace* childns);
 
+        // -- bumped whenever a method is defined or removed, or namespaces are linked
+        // -- namespaces compare against it to know when their cached lifecycle hooks are stale
+        uint32 GetMethodTableVersion() const { return (mMethodTableVersion); }
+        void NotifyMethodTableChanged() { ++mMethodTableVersion; }
+
+        // -- every function entry is given a unique ID - a function that is redefined may be allocated at the
+        // -- address of the entry it replaced, so anything bound to a specific definition compares IDs
+        uint32 GetNextFunctionEntryID() { return (++mFunctionEntryIDGenerator); }
+
         uint32 GetNextObjectID();
         uint32 CreateObject(uint32 classhash, uint32 objnamehash);
         uint32 RegisterObject(void* objaddr, const char* classname, const char* objectname);
         void UnregisterObject(void* objaddr);
         void DestroyObject(uint32 objectid);
 
+        // -- batch versions, resolving namespaces and sharing the OnCreate()/OnDestroy() exec stack for the batch
+        int32 CreateObjects(uint32 classhash, uint32 objnamehash, int32 count, uint32* object_ids);
+        void DestroyObjects(const uint32* object_ids, int32 count);
+
         bool8 IsObject(uint32 objectid);
         void* FindObject(uint32 objectid, const char* required_namespace = NULL);
 
@@ -410,12 +521,25 @@ class CScriptContext
         bool8 SaveObjectTree(uint32 object_id, const char* savefilename);
         bool8 FileWritef(FILE* filehandle, const char* fmt, ...);
 
+        // -- binary snapshot of the objects, globals, schedules and signals - see TinSnapshot.h
+        bool8 SaveSnapshot(const char* filename);
+        bool8 LoadSnapshot(const char* filename);
+        uint32 RestoreObject(uint32 classhash, uint32 objnamehash);
+
+        // -- clone a context into a new context (e.g. on another thread), from a captured image - see TinClone.h
+        bool8 InstantiateImage(const CContextImage* image);
+
         // -- convenience buffer
         char* GetScratchBuffer();
 
         // -- debugger interface
         void SetDebuggerConnected(bool8 connected);
         bool IsDebuggerConnected(int32& debugger_session);
+
+        // -- while a debugger is connected, or a break has been requested, calls use the debugger aware VM
+        bool8 IsDebuggerActive() const { return (mDebuggerConnected || mDebuggerActionForceBreak); }
+        bool8 NeedsDebuggerAttention() const { return (mDebuggerAttention); }
+        void UpdateDebuggerAttention() { mDebuggerAttention = IsDebuggerActive(); }
         void DebuggerNotifyAssert();
         void AddBreakpoint(const char* filename, int32 line_number, bool8 break_enabled, const char* conditional,
                            const char* trace, bool8 trace_on_condition);
@@ -444,6 +568,11 @@ class CScriptContext
 		int32 mDebuggerSessionNumber;
         bool8 mDebuggerConnected;
         bool8 mDebuggerActionForceBreak;
+
+        // -- set (possibly from the socket thread) when a VM already running without the debugger hooks
+        // -- needs to continue with them - tested only on backward branches and on returning from calls
+        // -- note:  it mirrors IsDebuggerActive(), so it's cleared once a requested break has been consumed
+        volatile bool8 mDebuggerAttention;
         bool8 mDebuggerActionStep;
         bool8 mDebuggerActionStepOver;
         bool8 mDebuggerActionStepOut;
@@ -454,6 +583,78 @@ class CScriptContext
 		CExecStack* mDebuggerBreakExecStack;
         int32 mDebuggerVarWatchRequestID;
 
+        // -- watch and condition expressions are evaluated on a preallocated pair of stacks, unless nested
+        CExecStack* mDebuggerWatchExecStack;
+        CFunctionCallStack* mDebuggerWatchFuncCallStack;
+        bool8 mDebuggerWatchStacksInUse;
+
+        // -- messages to the debugger are coalesced into a batch per channel, sent once per update (or as it fills)
+        // -- begin returns the buffer to write the message data to (NULL if no client subscribes to the channel)
+        // -- end commits it
+        int32* DebuggerBeginMessage(int32 size, eDebuggerChannel channel = DEBUGGER_CHANNEL_Debugger);
+        void DebuggerEndMessage();
+        void DebuggerFlushMessages();
+        void DebuggerFlushChannel(int32 channel);
+
+        struct tDebuggerBatch
+        {
+            char* mBuffer;
+            int32 mSize;
+            int32 mCount;
+        };
+
+        tDebuggerBatch mDebuggerBatch[DEBUGGER_CHANNEL_COUNT];
+        int32 mDebuggerMessageChannel;
+        int32 mDebuggerMessageOffset;
+        int32 mDebuggerMessageSize;
+
+        // -- the object browser is kept in sync by the object notifications - each object records the epoch in
+        // -- which it was sent, and the epoch is bumped whenever a notification is dropped (e.g. no subscriber)
+        // -- so a listing only sends the objects the client may be missing, a budget at a time
+        struct tDebuggerListEntry
+        {
+            uint32 mParentID;
+            uint32 mObjectID;
+            bool8 mParentSent;
+        };
+
+        void DebuggerPushListEntry(uint32 parent_id, uint32 object_id, bool8 parent_sent);
+        void DebuggerUpdateListObjects();
+        void DebuggerDropObjectNotification() { ++mDebuggerObjectEpoch; }
+
+        tDebuggerListEntry* mDebuggerListQueue;
+        int32 mDebuggerListSize;
+        int32 mDebuggerListCount;
+        int32 mDebuggerListIndex;
+        uint32 mDebuggerObjectEpoch;
+        uint32 mDebuggerObjectListEpoch;
+
+        // -- inspected objects are diffed against the hash of each member's last sent value, and only the
+        // -- members that changed are sent - a change in the member layout re-sends the whole object
+        struct tDebuggerInspectMember
+        {
+            uint32 mNamespaceHash;
+            uint32 mVarHash;
+            uint32 mValueHash;
+        };
+
+        struct tDebuggerInspectObject
+        {
+            uint32 mObjectID;
+            uint32 mMemberVersion;
+            tDebuggerInspectMember* mMembers;
+            int32 mMemberCount;
+            int32 mMemberSize;
+        };
+
+        void DebuggerUpdateInspectObjects(uint32 curtime);
+        void DebuggerClearInspectObjects();
+
+        tDebuggerInspectObject mDebuggerInspectObjects[kDebuggerInspectMaxObjects];
+        int32 mDebuggerInspectCount;
+        int32 mDebuggerInspectNext;
+        uint32 mDebuggerInspectUpdateTime;
+
         // -- communication with the debugger
         void DebuggerCurrentWorkingDir(const char* cwd);
         void DebuggerCodeblockLoaded(uint32 codeblock_hash);
@@ -463,20 +664,44 @@ class CScriptContext
         void DebuggerSendCallstack(uint32* codeblock_array, uint32* objid_array,
                                    uint32* namespace_array,uint32* func_array,
                                    uint32* linenumber_array, int array_size);
+
+        // -- the callstack last sent this session, so a break only sends the frames that changed
+        struct tDebuggerCallstackFrame
+        {
+            uint32 mCodeblockHash;
+            uint32 mObjectID;
+            uint32 mNamespaceHash;
+            uint32 mFunctionHash;
+            uint32 mLineNumber;
+        };
+
+        tDebuggerCallstackFrame mDebuggerCallstack[kDebuggerCallstackSize];
+        int32 mDebuggerCallstackSize;
+
         void DebuggerSendWatchVariable(CDebuggerWatchVarEntry* watch_var_entry);
-        void DebuggerSendObjectMembers(CDebuggerWatchVarEntry* callingFunction, uint32 objectID);
-        void DebuggerSendObjectVarTable(CDebuggerWatchVarEntry* callingFunction, CObjectEntry* oe, uint32 ns_hash,
-                                        tVarTable* var_table);
+        void DebuggerSendObjectMembers(CDebuggerWatchVarEntry* callingFunction, uint32 objectID,
+                                       tDebuggerInspectObject* inspect = NULL);
+        int32 DebuggerSendObjectVarTable(CDebuggerWatchVarEntry* callingFunction, CObjectEntry* oe, uint32 ns_hash,
+                                         tVarTable* var_table, tDebuggerInspectObject* inspect = NULL,
+                                         int32 member_index = 0, bool8 send_all = true);
         void DebuggerSendAssert(const char* assert_msg, uint32 codeblock_hash, int32 line_number);
-        void DebuggerSendPrint(const char* fmt, ...);
 
         // -- methods to send object status updates to the debugger
         void DebuggerNotifyCreateObject(CObjectEntry* oe);
         void DebuggerNotifyDestroyObject(uint32 object_id);
         void DebuggerNotifySetAddObject(uint32 parent_id, uint32 object_id, bool8 owned);
         void DebuggerNotifySetRemoveObject(uint32 parent_id, uint32 object_id);
-        void DebuggerListObjects(uint32 parent_id, uint32 object_id);
+        void DebuggerNotifyClearObjectBrowser();
+
+        // -- scheduler notifications
+        void DebuggerNotifyTimeScale(float32 time_scale);
+        void DebuggerNotifyAddSchedule(int32 req_id, bool8 repeat, int32 time_remaining_ms, uint32 object_id,
+                                       const char* command);
+        void DebuggerNotifyRescheduleSchedule(int32 req_id, int32 time_remaining_ms);
+        void DebuggerNotifyRemoveSchedule(int32 req_id);
+        void DebuggerListObjects(uint32 object_id);
         void DebuggerInspectObject(uint32 object_id);
+        void DebuggerStopInspectObject(uint32 object_id);
 
         // -- methods to send schedule updates to the debugger
         void DebuggerListSchedules();
@@ -490,11 +715,9 @@ class CScriptContext
         static bool8 gDebugCodeBlock;
         static bool8 gDebugTrace;
 
-        // -- Thread commands are only supported in WIN32
-        #ifdef WIN32
-            bool8 AddThreadCommand(const char* command);
-            void ProcessThreadCommands();
-        #endif // WIN32
+        // -- thread commands queue script commands received from other threads (e.g. the socket thread)
+        bool8 AddThreadCommand(const char* command);
+        void ProcessThreadCommands();
 
     private:
         // -- use the static Create() method
@@ -505,6 +728,12 @@ class CScriptContext
         // -- not virtual - this is a final class
         ~CScriptContext();
 
+        // -- object creation helpers, shared by the single and batch versions
+        bool8 ResolveCreateNamespaces(uint32 classhash, uint32 objnamehash, CNamespace*& class_namespace,
+                                      CNamespace*& objnamens);
+        CObjectEntry* AddObjectEntry(uint32 objectid, uint32 objnamehash, CNamespace* objnamens, void* objaddr,
+                                     bool8 register_manual);
+
         // -- in case we need to differentiate - likely only the main thread
         // -- will be permitted to write out the string dictionary
         bool mIsMainThread;
@@ -524,16 +753,28 @@ class CScriptContext
 
         // -- context codeblock list
         CHashTable<CCodeBlock>* mCodeBlockList;
+        CCodeBlock* mDeadCodeBlockList;
+
+        // -- function entries replaced by a reload
+        tFuncTable* mRetiredFunctionList;
 
         // -- context namespace dictionaries
         CHashTable<CNamespace>* mNamespaceDictionary;
         CHashTable<CObjectEntry>* mObjectDictionary;
         CHashTable<CObjectEntry>* mAddressDictionary;
         CHashTable<CObjectEntry>* mNameDictionary;
+        uint32 mMethodTableVersion;
+        uint32 mFunctionEntryIDGenerator;
 
         // -- context scheduler
         CScheduler* mScheduler;
 
+        // -- context signals
+        CSignalManager* mSignalManager;
+
+        // -- context log
+        CScriptLog* mLog;
+
         // -- when a script function returns (even void), a value is always pushed
         // -- if ExecF() calls a script function, we'll want to return that value to code
         char mFunctionReturnValue[kMaxTypeSize];
@@ -555,12 +796,9 @@ class CScriptContext
 
         // -- We may need to queue script commands from a remote connection
         // -- which requires a thread lock
-        // -- Thread commands are only supported in WIN32
-        #ifdef WIN32
-            CThreadMutex mThreadLock;
-            char mThreadExecBuffer[kThreadExecBufferSize];
-        #endif // WIN32
-            char* mThreadBufPtr;
+        CThreadMutex mThreadLock;
+        char mThreadExecBuffer[kThreadExecBufferSize];
+        char* mThreadBufPtr;
 };
 
 }  // TinScript
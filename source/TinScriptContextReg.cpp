@@ -286,6 +286,15 @@ void ContextListSchedules()
     script_context->GetScheduler()->Dump();
 }
 
+// ====================================================================================================================
+// ContextListSchedulesPage():  Dump a page of the pending scheduled requests, returns the number dumped.
+// ====================================================================================================================
+int32 ContextListSchedulesPage(int32 first, int32 count)
+{
+    CScriptContext* script_context = TinScript::GetContext();
+    return (script_context->GetScheduler()->DumpPage(first, count));
+}
+
 // ====================================================================================================================
 // ContextScheduleCancel():  Cancel a pending scheduled request in the current thread's CScriptContext.
 // ====================================================================================================================
@@ -323,6 +332,7 @@ REGISTER_FUNCTION_P1(GetObjectNamespace, ContextGetObjectNamespace, const char*,
 REGISTER_FUNCTION_P2(SaveObjects, ContextSaveObjects, void, uint32, const char*);
 
 REGISTER_FUNCTION_P0(ListSchedules, ContextListSchedules, void);
+REGISTER_FUNCTION_P2(ListSchedulesPage, ContextListSchedulesPage, int32, int32, int32);
 REGISTER_FUNCTION_P1(ScheduleCancel, ContextScheduleCancel, void, int32);
 REGISTER_FUNCTION_P1(ScheduleCancelObject, ContextScheduleCancelObject, void, uint32);
 
@@ -0,0 +1,493 @@
+// ------------------------------------------------------------------------------------------------
+//  The MIT License
+//
+//  Copyright (c) 2013 Tim Andersen
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+//  and associated documentation files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or
+//  substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// ------------------------------------------------------------------------------------------------
+
+// ====================================================================================================================
+// TinSignal.cpp
+// ====================================================================================================================
+
+// -- includes
+#include "stdafx.h"
+#include "assert.h"
+
+#include "TinScript.h"
+#include "TinRegistration.h"
+#include "TinInterface.h"
+#include "TinExecute.h"
+#include "TinSignal.h"
+#include "TinSnapshot.h"
+
+// == namespace TinScript =============================================================================================
+
+namespace TinScript
+{
+
+// == class CSignalManager ============================================================================================
+
+// ====================================================================================================================
+// Constructor
+// ====================================================================================================================
+CSignalManager::CSignalManager(CScriptContext* script_context)
+{
+    assert(script_context != NULL);
+    mContextOwner = script_context;
+
+    mSignalDictionary = TinAlloc(ALLOC_Signal, CHashTable<tSignal>, kSignalTableSize);
+}
+
+// ====================================================================================================================
+// Destructor
+// ====================================================================================================================
+CSignalManager::~CSignalManager()
+{
+    tSignal* signal = mSignalDictionary->First();
+    while (signal)
+    {
+        if (signal->mSubscriptions)
+            TinFreeArray(signal->mSubscriptions);
+        signal = mSignalDictionary->Next();
+    }
+
+    mSignalDictionary->DestroyAll();
+    TinFree(mSignalDictionary);
+}
+
+// ====================================================================================================================
+// Subscribe():  Subscribe the method of an object to a signal.  Subscribing the same method twice has no effect.
+// ====================================================================================================================
+bool8 CSignalManager::Subscribe(uint32 signal_hash, uint32 object_id, uint32 method_hash)
+{
+    // -- sanity check
+    CObjectEntry* oe = GetScriptContext()->FindObjectEntry(object_id);
+    if (!oe || oe->IsDestroyed() || signal_hash == 0 || method_hash == 0)
+    {
+        ScriptAssert_(GetScriptContext(), 0, "<internal>", -1,
+                      "Error - Subscribe(): invalid signal %s, object %d, or method %s\n",
+                      UnHash(signal_hash), object_id, UnHash(method_hash));
+        return (false);
+    }
+
+    // -- find or create the signal
+    tSignal* signal = mSignalDictionary->FindItem(signal_hash);
+    if (!signal)
+    {
+        signal = TinAlloc(ALLOC_Signal, tSignal);
+        signal->mSubscriptions = NULL;
+        signal->mCount = 0;
+        signal->mSize = 0;
+        signal->mEmitDepth = 0;
+        signal->mHasRemoved = false;
+        mSignalDictionary->AddItem(*signal, signal_hash);
+    }
+
+    // -- ensure we don't subscribe the same method twice
+    for (int32 i = 0; i < signal->mCount; ++i)
+    {
+        const tSubscription& subscription = signal->mSubscriptions[i];
+        if (subscription.mObjectID == object_id && subscription.mMethodHash == method_hash)
+            return (true);
+    }
+
+    // -- grow the subscription list if needed
+    if (signal->mCount >= signal->mSize)
+    {
+        int32 new_size = signal->mSize > 0 ? signal->mSize * 2 : kSignalSubscriptionMinSize;
+        tSubscription* new_list = TinAllocArray(ALLOC_Signal, tSubscription, new_size);
+        for (int32 i = 0; i < signal->mCount; ++i)
+            new_list[i] = signal->mSubscriptions[i];
+
+        if (signal->mSubscriptions)
+            TinFreeArray(signal->mSubscriptions);
+        signal->mSubscriptions = new_list;
+        signal->mSize = new_size;
+    }
+
+    // -- the method is resolved when the signal is first emitted
+    tSubscription& subscription = signal->mSubscriptions[signal->mCount++];
+    subscription.mObjectID = object_id;
+    subscription.mMethodHash = method_hash;
+    subscription.mNamespace = NULL;
+    subscription.mFunction = NULL;
+    subscription.mLocalVarCount = 0;
+    subscription.mMethodTableVersion = 0;
+
+    // -- the object keeps count, so only subscribers need to be looked for when an object is destroyed
+    oe->AdjustSignalSubscriptionCount(1);
+
+    return (true);
+}
+
+// ====================================================================================================================
+// Unsubscribe():  Remove the subscription of an object method from a signal.
+// ====================================================================================================================
+void CSignalManager::Unsubscribe(uint32 signal_hash, uint32 object_id, uint32 method_hash)
+{
+    tSignal* signal = mSignalDictionary->FindItem(signal_hash);
+    if (!signal)
+        return;
+
+    for (int32 i = 0; i < signal->mCount; ++i)
+    {
+        const tSubscription& subscription = signal->mSubscriptions[i];
+        if (subscription.mObjectID == object_id && subscription.mMethodHash == method_hash)
+        {
+            RemoveSubscription(signal, i);
+            return;
+        }
+    }
+}
+
+// ====================================================================================================================
+// GetSubscriberCount():  Returns the number of methods subscribed to a signal.
+// ====================================================================================================================
+int32 CSignalManager::GetSubscriberCount(uint32 signal_hash)
+{
+    tSignal* signal = mSignalDictionary->FindItem(signal_hash);
+    if (!signal)
+        return (0);
+
+    int32 count = 0;
+    for (int32 i = 0; i < signal->mCount; ++i)
+    {
+        if (signal->mSubscriptions[i].mObjectID != 0)
+            ++count;
+    }
+
+    return (count);
+}
+
+// ====================================================================================================================
+// Emit():  Calls every method subscribed to the signal, with the given arguments.
+// ====================================================================================================================
+int32 CSignalManager::Emit(uint32 signal_hash, int32 arg_count, const eVarType* arg_types, void** arg_values)
+{
+    tSignal* signal = mSignalDictionary->FindItem(signal_hash);
+    if (!signal || signal->mCount == 0)
+        return (0);
+
+    // -- subscriptions added during the emit are not called until the next one
+    // -- note:  the list may be reallocated by a handler, so we index it, rather than keeping pointers
+    int32 count = signal->mCount;
+    ++signal->mEmitDepth;
+
+    // -- every subscriber shares the same exec stack
+    CScriptContext* script_context = GetScriptContext();
+    CMethodBroadcast signal_call(script_context, 0, arg_count, arg_types, arg_values);
+    for (int32 i = 0; i < count; ++i)
+    {
+        tSubscription& subscription = signal->mSubscriptions[i];
+        if (subscription.mObjectID == 0)
+            continue;
+
+        CObjectEntry* oe = script_context->FindObjectEntry(subscription.mObjectID);
+        if (!oe || oe->IsDestroyed())
+            continue;
+
+        // -- resolve the method if this is the first emit, or methods have been defined or reloaded since
+        uint32 version = script_context->GetMethodTableVersion();
+        if (subscription.mMethodTableVersion != version || subscription.mNamespace != oe->GetNamespace())
+        {
+            subscription.mNamespace = oe->GetNamespace();
+            subscription.mFunction = oe->GetFunctionEntry(0, subscription.mMethodHash);
+            subscription.mLocalVarCount = 0;
+            if (subscription.mFunction && subscription.mFunction->GetType() != eFuncTypeGlobal)
+                subscription.mLocalVarCount = subscription.mFunction->GetContext()->CalculateLocalVarStackSize();
+            subscription.mMethodTableVersion = version;
+        }
+
+        if (!subscription.mFunction)
+            continue;
+
+        // -- if the call fails, the rest of the emit is abandoned, same as a failed broadcast
+        if (!signal_call.CallMethod(oe, subscription.mFunction, subscription.mLocalVarCount))
+            break;
+    }
+
+    // -- now that we're no longer iterating, clean up any subscriptions removed during the emit
+    --signal->mEmitDepth;
+    if (signal->mEmitDepth == 0 && signal->mHasRemoved)
+        CompactSignal(signal);
+
+    return (signal_call.GetCallCount());
+}
+
+// ====================================================================================================================
+// OnDelete():  Removes all subscriptions for an object being destroyed.
+// ====================================================================================================================
+void CSignalManager::OnDelete(CObjectEntry* oe)
+{
+    // -- most objects never subscribe to anything
+    if (!oe || oe->GetSignalSubscriptionCount() == 0)
+        return;
+
+    uint32 object_id = oe->GetID();
+    tSignal* signal = mSignalDictionary->First();
+    while (signal && oe->GetSignalSubscriptionCount() > 0)
+    {
+        for (int32 i = signal->mCount - 1; i >= 0; --i)
+        {
+            if (signal->mSubscriptions[i].mObjectID == object_id)
+                RemoveSubscription(signal, i);
+        }
+
+        signal = mSignalDictionary->Next();
+    }
+}
+
+// ====================================================================================================================
+// Dump():  Display the list of signals, and their subscribers.
+// ====================================================================================================================
+void CSignalManager::Dump()
+{
+    uint32 signal_hash = 0;
+    tSignal* signal = mSignalDictionary->First(&signal_hash);
+    while (signal)
+    {
+        TinPrint(GetScriptContext(), "Signal: %s\n", UnHash(signal_hash));
+        for (int32 i = 0; i < signal->mCount; ++i)
+        {
+            const tSubscription& subscription = signal->mSubscriptions[i];
+            if (subscription.mObjectID != 0)
+            {
+                TinPrint(GetScriptContext(), "    ObjID: %d, Method: %s\n", subscription.mObjectID,
+                         UnHash(subscription.mMethodHash));
+            }
+        }
+
+        signal = mSignalDictionary->Next(&signal_hash);
+    }
+}
+
+// ====================================================================================================================
+// WriteSnapshot():  Write each signal, and the object ID and method of its subscribers.
+// ====================================================================================================================
+void CSignalManager::WriteSnapshot(CSnapshotWriter& writer)
+{
+    int32 count_offset = writer.ReserveInt32();
+    int32 signal_count = 0;
+
+    uint32 signal_hash = 0;
+    tSignal* signal = mSignalDictionary->First(&signal_hash);
+    while (signal)
+    {
+        writer.WriteHashString(signal_hash);
+        int32 subscription_count_offset = writer.ReserveInt32();
+        int32 subscription_count = 0;
+        for (int32 i = 0; i < signal->mCount; ++i)
+        {
+            const tSubscription& subscription = signal->mSubscriptions[i];
+            if (subscription.mObjectID != 0)
+            {
+                writer.WriteUInt32(subscription.mObjectID);
+                writer.WriteHashString(subscription.mMethodHash);
+                ++subscription_count;
+            }
+        }
+        writer.PatchInt32(subscription_count_offset, subscription_count);
+
+        ++signal_count;
+        signal = mSignalDictionary->Next(&signal_hash);
+    }
+
+    writer.PatchInt32(count_offset, signal_count);
+}
+
+// ====================================================================================================================
+// ReadSnapshot():  Subscribe the restored objects - subscriptions for objects that weren't restored are skipped.
+// ====================================================================================================================
+bool8 CSignalManager::ReadSnapshot(CSnapshotReader& reader)
+{
+    int32 signal_count = reader.ReadCount();
+    for (int32 i = 0; i < signal_count && !reader.HasError(); ++i)
+    {
+        uint32 signal_hash = reader.ReadHashString();
+        int32 subscription_count = reader.ReadCount();
+        for (int32 sub_index = 0; sub_index < subscription_count && !reader.HasError(); ++sub_index)
+        {
+            uint32 object_id = reader.RemapObjectID(reader.ReadUInt32());
+            uint32 method_hash = reader.ReadHashString();
+            if (object_id != 0 && !reader.HasError())
+                Subscribe(signal_hash, object_id, method_hash);
+        }
+    }
+
+    return (!reader.HasError());
+}
+
+// ====================================================================================================================
+// RemoveSubscription():  Removes a subscription, deferring the compaction if the signal is being emitted.
+// ====================================================================================================================
+void CSignalManager::RemoveSubscription(tSignal* signal, int32 index)
+{
+    tSubscription& subscription = signal->mSubscriptions[index];
+    if (subscription.mObjectID == 0)
+        return;
+
+    CObjectEntry* oe = GetScriptContext()->FindObjectEntry(subscription.mObjectID);
+    if (oe)
+        oe->AdjustSignalSubscriptionCount(-1);
+
+    // -- subscribers are called in the order they subscribed, so preserve the order
+    if (signal->mEmitDepth > 0)
+    {
+        subscription.mObjectID = 0;
+        signal->mHasRemoved = true;
+    }
+    else
+    {
+        for (int32 i = index + 1; i < signal->mCount; ++i)
+            signal->mSubscriptions[i - 1] = signal->mSubscriptions[i];
+        --signal->mCount;
+    }
+}
+
+// ====================================================================================================================
+// CompactSignal():  Removes the subscriptions cleared during an emit.
+// ====================================================================================================================
+void CSignalManager::CompactSignal(tSignal* signal)
+{
+    int32 count = 0;
+    for (int32 i = 0; i < signal->mCount; ++i)
+    {
+        if (signal->mSubscriptions[i].mObjectID != 0)
+            signal->mSubscriptions[count++] = signal->mSubscriptions[i];
+    }
+
+    signal->mCount = count;
+    signal->mHasRemoved = false;
+}
+
+// == script interface ================================================================================================
+
+// ====================================================================================================================
+// SignalSubscribe():  Subscribe the method of an object to the named signal.
+// ====================================================================================================================
+bool8 SignalSubscribe(const char* signal_name, uint32 object_id, const char* method_name)
+{
+    if (!signal_name || !signal_name[0] || !method_name || !method_name[0])
+        return (false);
+
+    CScriptContext* script_context = ::TinScript::GetContext();
+    return (script_context->GetSignalManager()->Subscribe(Hash(signal_name), object_id, Hash(method_name)));
+}
+
+// ====================================================================================================================
+// SignalUnsubscribe():  Remove the subscription of an object method from the named signal.
+// ====================================================================================================================
+void SignalUnsubscribe(const char* signal_name, uint32 object_id, const char* method_name)
+{
+    if (!signal_name || !signal_name[0] || !method_name || !method_name[0])
+        return;
+
+    CScriptContext* script_context = ::TinScript::GetContext();
+    script_context->GetSignalManager()->Unsubscribe(Hash(signal_name), object_id, Hash(method_name));
+}
+
+// ====================================================================================================================
+// EmitSignal():  Calls every method subscribed to the named signal, with no arguments.
+// ====================================================================================================================
+int32 EmitSignal(const char* signal_name)
+{
+    if (!signal_name || !signal_name[0])
+        return (0);
+
+    CScriptContext* script_context = ::TinScript::GetContext();
+    return (script_context->GetSignalManager()->Emit(Hash(signal_name)));
+}
+
+// ====================================================================================================================
+// SignalEmitInt():  Calls every method subscribed to the named signal, with an int argument.
+// ====================================================================================================================
+int32 SignalEmitInt(const char* signal_name, int32 value)
+{
+    if (!signal_name || !signal_name[0])
+        return (0);
+
+    eVarType arg_type = TYPE_int;
+    void* arg_value = &value;
+    CScriptContext* script_context = ::TinScript::GetContext();
+    return (script_context->GetSignalManager()->Emit(Hash(signal_name), 1, &arg_type, &arg_value));
+}
+
+// ====================================================================================================================
+// SignalEmitFloat():  Calls every method subscribed to the named signal, with a float argument.
+// ====================================================================================================================
+int32 SignalEmitFloat(const char* signal_name, float32 value)
+{
+    if (!signal_name || !signal_name[0])
+        return (0);
+
+    eVarType arg_type = TYPE_float;
+    void* arg_value = &value;
+    CScriptContext* script_context = ::TinScript::GetContext();
+    return (script_context->GetSignalManager()->Emit(Hash(signal_name), 1, &arg_type, &arg_value));
+}
+
+// ====================================================================================================================
+// SignalEmitObject():  Calls every method subscribed to the named signal, with an object argument.
+// ====================================================================================================================
+int32 SignalEmitObject(const char* signal_name, uint32 object_id)
+{
+    if (!signal_name || !signal_name[0])
+        return (0);
+
+    eVarType arg_type = TYPE_object;
+    void* arg_value = &object_id;
+    CScriptContext* script_context = ::TinScript::GetContext();
+    return (script_context->GetSignalManager()->Emit(Hash(signal_name), 1, &arg_type, &arg_value));
+}
+
+// ====================================================================================================================
+// SignalCount():  Returns the number of methods subscribed to the named signal.
+// ====================================================================================================================
+int32 SignalCount(const char* signal_name)
+{
+    if (!signal_name || !signal_name[0])
+        return (0);
+
+    CScriptContext* script_context = ::TinScript::GetContext();
+    return (script_context->GetSignalManager()->GetSubscriberCount(Hash(signal_name)));
+}
+
+// ====================================================================================================================
+// ListSignals():  Display the list of signals, and their subscribers.
+// ====================================================================================================================
+void ListSignals()
+{
+    CScriptContext* script_context = ::TinScript::GetContext();
+    script_context->GetSignalManager()->Dump();
+}
+
+} // TinScript
+
+// --------------------------------------------------------------------------------------------------------------------
+// -- script registered interface
+REGISTER_FUNCTION_P3(SignalSubscribe, TinScript::SignalSubscribe, bool8, const char*, uint32, const char*);
+REGISTER_FUNCTION_P3(SignalUnsubscribe, TinScript::SignalUnsubscribe, void, const char*, uint32, const char*);
+REGISTER_FUNCTION_P1(SignalEmit, TinScript::EmitSignal, int32, const char*);
+REGISTER_FUNCTION_P2(SignalEmitInt, TinScript::SignalEmitInt, int32, const char*, int32);
+REGISTER_FUNCTION_P2(SignalEmitFloat, TinScript::SignalEmitFloat, int32, const char*, float32);
+REGISTER_FUNCTION_P2(SignalEmitObject, TinScript::SignalEmitObject, int32, const char*, uint32);
+REGISTER_FUNCTION_P1(SignalCount, TinScript::SignalCount, int32, const char*);
+REGISTER_FUNCTION_P0(ListSignals, TinScript::ListSignals, void);
+
+// ====================================================================================================================
+// EOF
+// ====================================================================================================================
@@ -0,0 +1,105 @@
+// ------------------------------------------------------------------------------------------------
+//  The MIT License
+//
+//  Copyright (c) 2013 Tim Andersen
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+//  and associated documentation files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or
+//  substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// ------------------------------------------------------------------------------------------------
+
+// ====================================================================================================================
+// TinSignal.h
+// ====================================================================================================================
+
+#ifndef __TINSIGNAL_H
+#define __TINSIGNAL_H
+
+// == namespace TinScript =============================================================================================
+
+namespace TinScript
+{
+
+// --------------------------------------------------------------------------------------------------------------------
+// -- forward declarations
+class CObjectEntry;
+class CSnapshotWriter;
+class CSnapshotReader;
+
+// ====================================================================================================================
+// class CSignalManager:  Manages named signals, each with a list of object methods subscribed to it.
+// Emitting a signal calls every subscribed method directly, with the method entries cached per subscription,
+// so objects that only need to react to an event don't need a repeating schedule to poll for it.
+// Subscriptions are removed automatically when the object is destroyed.
+// ====================================================================================================================
+class CSignalManager
+{
+    public:
+        CSignalManager(CScriptContext* script_context = NULL);
+        virtual ~CSignalManager();
+
+        CScriptContext* GetScriptContext() { return (mContextOwner); }
+
+        bool8 Subscribe(uint32 signal_hash, uint32 object_id, uint32 method_hash);
+        void Unsubscribe(uint32 signal_hash, uint32 object_id, uint32 method_hash);
+        int32 GetSubscriberCount(uint32 signal_hash);
+
+        // -- calls every subscriber, returns the number of methods called
+        // -- the argument types and values are converted to each method's parameter types
+        int32 Emit(uint32 signal_hash, int32 arg_count = 0, const eVarType* arg_types = NULL,
+                   void** arg_values = NULL);
+
+        void OnDelete(CObjectEntry* oe);
+        void Dump();
+
+        // -- snapshot support
+        void WriteSnapshot(CSnapshotWriter& writer);
+        bool8 ReadSnapshot(CSnapshotReader& reader);
+
+    private:
+        // -- the method is resolved on the first emit, and again only if the method table changes
+        struct tSubscription
+        {
+            uint32 mObjectID;
+            uint32 mMethodHash;
+            CNamespace* mNamespace;
+            CFunctionEntry* mFunction;
+            int32 mLocalVarCount;
+            uint32 mMethodTableVersion;
+        };
+
+        // -- subscriptions removed during an emit are only cleared (object ID of 0), and compacted afterward
+        struct tSignal
+        {
+            tSubscription* mSubscriptions;
+            int32 mCount;
+            int32 mSize;
+            int32 mEmitDepth;
+            bool8 mHasRemoved;
+        };
+
+        void RemoveSubscription(tSignal* signal, int32 index);
+        void CompactSignal(tSignal* signal);
+
+        CScriptContext* mContextOwner;
+        CHashTable<tSignal>* mSignalDictionary;
+};
+
+} // TinScript
+
+#endif // __TINSIGNAL_H
+
+// ====================================================================================================================
+// EOF
+// ====================================================================================================================
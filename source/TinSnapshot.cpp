@@ -0,0 +1,1079 @@
+// ------------------------------------------------------------------------------------------------
+//  The MIT License
+//
+//  Copyright (c) 2013 Tim Andersen
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+//  and associated documentation files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or
+//  substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// ------------------------------------------------------------------------------------------------
+
+
+// ====================================================================================================================
+// TinSnapshot.cpp
+// ====================================================================================================================
+
+// -- includes
+#include "stdafx.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "assert.h"
+
+#include "TinScript.h"
+#include "TinRegistration.h"
+#include "TinNamespace.h"
+#include "TinObjectGroup.h"
+#include "TinScheduler.h"
+#include "TinSignal.h"
+#include "TinStringTable.h"
+#include "TinSnapshot.h"
+
+// == namespace TinScript =============================================================================================
+
+namespace TinScript
+{
+
+// --------------------------------------------------------------------------------------------------------------------
+// -- the initial size of the buffer a snapshot is written to (grows as needed)
+static const int32 kSnapshotBufferSize = 64 * 1024;
+
+// --------------------------------------------------------------------------------------------------------------------
+// -- section names, for error messages
+static const char* gSnapshotSectionNames[] =
+{
+    #define SnapshotSectionEntry(a) #a,
+    SnapshotSectionTuple
+    #undef SnapshotSectionEntry
+};
+
+// == class CSnapshotWriter ===========================================================================================
+
+// ====================================================================================================================
+// Constructor
+// ====================================================================================================================
+CSnapshotWriter::CSnapshotWriter(CScriptContext* script_context)
+{
+    mContextOwner = script_context;
+    mSize = kSnapshotBufferSize;
+    mUsed = 0;
+    mBuffer = TinAllocArray(ALLOC_FileBuf, char, mSize);
+}
+
+// ====================================================================================================================
+// Destructor
+// ====================================================================================================================
+CSnapshotWriter::~CSnapshotWriter()
+{
+    TinFreeArray(mBuffer);
+}
+
+// ====================================================================================================================
+// BeginSection():  Each section begins with its ID, so the reader can verify it's still in sync.
+// ====================================================================================================================
+void CSnapshotWriter::BeginSection(eSnapshotSection section)
+{
+    WriteUInt32((uint32)section);
+}
+
+// ====================================================================================================================
+// WriteBytes():  Append raw data to the snapshot, growing the buffer as needed.
+// ====================================================================================================================
+void CSnapshotWriter::WriteBytes(const void* data, int32 count)
+{
+    if (count <= 0)
+        return;
+
+    if (mUsed + count > mSize)
+    {
+        int32 new_size = mSize * 2;
+        while (mUsed + count > new_size)
+            new_size *= 2;
+
+        char* new_buffer = TinAllocArray(ALLOC_FileBuf, char, new_size);
+        memcpy(new_buffer, mBuffer, mUsed);
+        TinFreeArray(mBuffer);
+        mBuffer = new_buffer;
+        mSize = new_size;
+    }
+
+    memcpy(&mBuffer[mUsed], data, count);
+    mUsed += count;
+}
+
+// ====================================================================================================================
+// WriteString():  Strings are written as a length, followed by the characters (no terminator).
+// ====================================================================================================================
+void CSnapshotWriter::WriteString(const char* string)
+{
+    int32 length = string ? (int32)strlen(string) : 0;
+    WriteInt32(length);
+    WriteBytes(string, length);
+}
+
+// ====================================================================================================================
+// WriteAlign():  Pad the snapshot to a 4-byte boundary.
+// ====================================================================================================================
+void CSnapshotWriter::WriteAlign()
+{
+    static const char padding[sizeof(uint32)] = { 0, 0, 0, 0 };
+    int32 remainder = mUsed % (int32)sizeof(uint32);
+    if (remainder != 0)
+        WriteBytes(padding, (int32)sizeof(uint32) - remainder);
+}
+
+// ====================================================================================================================
+// ReserveInt32():  Write a placeholder, returning its offset, to be patched once the value is known.
+// ====================================================================================================================
+int32 CSnapshotWriter::ReserveInt32()
+{
+    int32 offset = mUsed;
+    WriteInt32(0);
+    return (offset);
+}
+
+// ====================================================================================================================
+// PatchInt32():  Fill in a placeholder written by ReserveInt32().
+// ====================================================================================================================
+void CSnapshotWriter::PatchInt32(int32 offset, int32 value)
+{
+    assert(offset >= 0 && offset + (int32)sizeof(int32) <= mUsed);
+    memcpy(&mBuffer[offset], &value, sizeof(int32));
+}
+
+// ====================================================================================================================
+// CanWriteVariable():  Returns true if the variable holds a value that can be restored.
+// ====================================================================================================================
+bool8 CSnapshotWriter::CanWriteVariable(CVariableEntry* ve) const
+{
+    if (!ve || ve->GetType() < FIRST_VALID_TYPE || ve->GetType() >= TYPE_COUNT)
+        return (false);
+
+    // -- parameters refer to hashtables and arrays they don't own, and unallocated arrays have no values
+    if (ve->GetType() == TYPE_hashtable)
+        return (!ve->IsParameter());
+    if (ve->IsArray() && ve->GetArraySize() < 0)
+        return (false);
+
+    return (true);
+}
+
+// ====================================================================================================================
+// WriteVariable():  Write the name, type, count, and values of a variable.
+// ====================================================================================================================
+void CSnapshotWriter::WriteVariable(CVariableEntry* ve, void* objaddr)
+{
+    WriteHashString(ve->GetHash());
+    WriteUInt32((uint32)ve->GetType());
+
+    // -- the count of a hashtable is the number of entries, each written as a variable
+    if (ve->GetType() == TYPE_hashtable)
+    {
+        tVarTable* hashtable = (tVarTable*)ve->GetAddr(objaddr);
+        int32 count_offset = ReserveInt32();
+        int32 count = 0;
+        CVariableEntry* hte = hashtable ? hashtable->First() : NULL;
+        while (hte)
+        {
+            if (CanWriteVariable(hte))
+            {
+                WriteVariable(hte, NULL);
+                ++count;
+            }
+            hte = hashtable->Next();
+        }
+        PatchInt32(count_offset, count);
+        return;
+    }
+
+    if (!ve->IsArray())
+    {
+        WriteInt32(1);
+        WriteValue(ve->GetType(), ve->GetAddr(objaddr));
+    }
+    else
+    {
+        int32 count = ve->GetArraySize();
+        WriteInt32(count);
+        for (int32 i = 0; i < count; ++i)
+            WriteValue(ve->GetType(), ve->GetArrayVarAddr(objaddr, i));
+    }
+}
+
+// ====================================================================================================================
+// WriteValue():  Strings are written as text, everything else in its native layout.
+// ====================================================================================================================
+void CSnapshotWriter::WriteValue(eVarType type, void* addr)
+{
+    // -- note:  the address of a string variable is the address of its string table hash
+    if (type == TYPE_string)
+    {
+        uint32 string_hash = addr ? *(uint32*)addr : 0;
+        WriteString(string_hash != 0 ? GetScriptContext()->GetStringTable()->FindString(string_hash) : "");
+    }
+    else if (addr)
+    {
+        WriteBytes(addr, gRegisteredTypeSize[type]);
+    }
+    else
+    {
+        char nullvalue[kMaxTypeSize];
+        memset(nullvalue, 0, kMaxTypeSize);
+        WriteBytes(nullvalue, gRegisteredTypeSize[type]);
+    }
+}
+
+// ====================================================================================================================
+// SaveToFile():  Write the snapshot buffer to the file.
+// ====================================================================================================================
+bool8 CSnapshotWriter::SaveToFile(const char* filename)
+{
+    FILE* filehandle = NULL;
+    int32 result = fopen_s(&filehandle, filename, "wb");
+    if (result != 0 || !filehandle)
+        return (false);
+
+    int32 bytes_written = (int32)fwrite(mBuffer, sizeof(char), mUsed, filehandle);
+    fclose(filehandle);
+    return (bytes_written == mUsed);
+}
+
+// ====================================================================================================================
+// DetachBuffer():  Returns the snapshot buffer, and the size written - the writer is left empty.
+// ====================================================================================================================
+char* CSnapshotWriter::DetachBuffer(int32& size)
+{
+    char* buffer = mBuffer;
+    size = mUsed;
+
+    mSize = kSnapshotBufferSize;
+    mUsed = 0;
+    mBuffer = TinAllocArray(ALLOC_FileBuf, char, mSize);
+    return (buffer);
+}
+
+// == class CSnapshotReader ===========================================================================================
+
+// ====================================================================================================================
+// Constructor
+// ====================================================================================================================
+CSnapshotReader::CSnapshotReader(CScriptContext* script_context)
+{
+    mContextOwner = script_context;
+    mBuffer = NULL;
+    mOwnsBuffer = false;
+    mSize = 0;
+    mReadOffset = 0;
+    mError = false;
+
+    mObjectIDs = NULL;
+    mObjectIDCount = 0;
+    mObjectIDSize = 0;
+}
+
+// ====================================================================================================================
+// Destructor
+// ====================================================================================================================
+CSnapshotReader::~CSnapshotReader()
+{
+    if (mBuffer && mOwnsBuffer)
+        TinFreeArray(const_cast<char*>(mBuffer));
+    if (mObjectIDs)
+        TinFreeArray(mObjectIDs);
+}
+
+// ====================================================================================================================
+// LoadFromFile():  Read the entire snapshot file into memory.
+// ====================================================================================================================
+bool8 CSnapshotReader::LoadFromFile(const char* filename)
+{
+    FILE* filehandle = NULL;
+    int32 result = fopen_s(&filehandle, filename, "rb");
+    if (result != 0 || !filehandle)
+        return (false);
+
+    // -- get the size of the file
+    if (fseek(filehandle, 0, SEEK_END) != 0)
+    {
+        fclose(filehandle);
+        return (false);
+    }
+
+    int32 filesize = ftell(filehandle);
+    if (filesize <= 0)
+    {
+        fclose(filehandle);
+        return (false);
+    }
+    fseek(filehandle, 0, SEEK_SET);
+
+    char* buffer = TinAllocArray(ALLOC_FileBuf, char, filesize);
+    mBuffer = buffer;
+    mOwnsBuffer = true;
+    mSize = (int32)fread(buffer, sizeof(char), filesize, filehandle);
+    mReadOffset = 0;
+    fclose(filehandle);
+
+    return (mSize == filesize);
+}
+
+// ====================================================================================================================
+// SetBuffer():  Read from a buffer owned by the caller, which must remain valid until the reader is done.
+// ====================================================================================================================
+void CSnapshotReader::SetBuffer(const char* buffer, int32 size)
+{
+    assert(mBuffer == NULL);
+    mBuffer = buffer;
+    mOwnsBuffer = false;
+    mSize = buffer ? size : 0;
+    mReadOffset = 0;
+}
+
+// ====================================================================================================================
+// ReadSection():  Verify the next section in the snapshot is the one expected.
+// ====================================================================================================================
+bool8 CSnapshotReader::ReadSection(eSnapshotSection section)
+{
+    uint32 section_id = ReadUInt32();
+    if (mError || section_id != (uint32)section)
+    {
+        mError = true;
+        return (false);
+    }
+
+    return (true);
+}
+
+// ====================================================================================================================
+// ReadBytes():  Read raw data from the snapshot - reading past the end sets the error flag, and zeroes the data.
+// ====================================================================================================================
+bool8 CSnapshotReader::ReadBytes(void* data, int32 count)
+{
+    if (mError || count < 0 || mReadOffset + count > mSize)
+    {
+        mError = true;
+        if (count > 0)
+            memset(data, 0, count);
+        return (false);
+    }
+
+    memcpy(data, &mBuffer[mReadOffset], count);
+    mReadOffset += count;
+    return (true);
+}
+
+// ====================================================================================================================
+// ReadUInt32():  Read an unsigned value.
+// ====================================================================================================================
+uint32 CSnapshotReader::ReadUInt32()
+{
+    uint32 value = 0;
+    ReadBytes(&value, sizeof(uint32));
+    return (value);
+}
+
+// ====================================================================================================================
+// ReadInt32():  Read a signed value.
+// ====================================================================================================================
+int32 CSnapshotReader::ReadInt32()
+{
+    int32 value = 0;
+    ReadBytes(&value, sizeof(int32));
+    return (value);
+}
+
+// ====================================================================================================================
+// ReadCount():  Read a count of entries (or bytes) - as each is at least a byte, it can't exceed the data remaining.
+// ====================================================================================================================
+int32 CSnapshotReader::ReadCount()
+{
+    int32 count = ReadInt32();
+    if (count < 0 || count > mSize - mReadOffset)
+    {
+        mError = true;
+        return (0);
+    }
+
+    return (count);
+}
+
+// ====================================================================================================================
+// ReadString():  Read a string, returning the copy in the string table.
+// ====================================================================================================================
+const char* CSnapshotReader::ReadString(bool8 inc_refcount)
+{
+    int32 length = ReadCount();
+    if (mError || length == 0)
+        return ("");
+
+    const char* string = GetScriptContext()->GetStringTable()->AddString(&mBuffer[mReadOffset], length, 0,
+                                                                         inc_refcount);
+    mReadOffset += length;
+    if (!string)
+    {
+        mError = true;
+        return ("");
+    }
+
+    return (string);
+}
+
+// ====================================================================================================================
+// ReadHashString():  Read a string, returning its hash.
+// ====================================================================================================================
+uint32 CSnapshotReader::ReadHashString()
+{
+    return (Hash(ReadString()));
+}
+
+// ====================================================================================================================
+// ReadAlign():  Skip the padding written by WriteAlign().
+// ====================================================================================================================
+void CSnapshotReader::ReadAlign()
+{
+    int32 remainder = mReadOffset % (int32)sizeof(uint32);
+    if (remainder != 0)
+        ReadInPlace((int32)sizeof(uint32) - remainder);
+}
+
+// ====================================================================================================================
+// ReadInPlace():  Skip over the data, returning its address within the buffer (NULL if it extends past the end).
+// ====================================================================================================================
+const void* CSnapshotReader::ReadInPlace(int32 count)
+{
+    if (mError || count < 0 || mReadOffset + count > mSize)
+    {
+        mError = true;
+        return (NULL);
+    }
+
+    const void* data = &mBuffer[mReadOffset];
+    mReadOffset += count;
+    return (data);
+}
+
+// ====================================================================================================================
+// ReadVariableHeader():  Read the name, type, and count of a variable.
+// ====================================================================================================================
+bool8 CSnapshotReader::ReadVariableHeader(uint32& var_hash, eVarType& type, int32& count)
+{
+    var_hash = ReadHashString();
+    uint32 type_id = ReadUInt32();
+    count = ReadCount();
+    if (mError || var_hash == 0 || type_id < (uint32)FIRST_VALID_TYPE || type_id >= (uint32)TYPE_COUNT)
+    {
+        mError = true;
+        return (false);
+    }
+
+    type = (eVarType)type_id;
+    return (true);
+}
+
+// ====================================================================================================================
+// ReadVariableValues():  Read the values of a variable, and if given a variable of a matching type, assign them.
+// ====================================================================================================================
+bool8 CSnapshotReader::ReadVariableValues(CVariableEntry* ve, void* objaddr, eVarType type, int32 count)
+{
+    // -- a variable that no longer matches the snapshot is skipped
+    if (ve && ve->GetType() != type)
+    {
+        TinPrintWarning(GetScriptContext(), "Warning - snapshot variable %s is type %s, expecting %s - skipped\n",
+                        UnHash(ve->GetHash()), GetRegisteredTypeName(type), GetRegisteredTypeName(ve->GetType()));
+        ve = NULL;
+    }
+
+    // -- hashtable entries are added as needed (by definition, hash table entries are dynamic)
+    if (type == TYPE_hashtable)
+    {
+        tVarTable* hashtable = ve ? (tVarTable*)ve->GetAddr(objaddr) : NULL;
+        for (int32 i = 0; i < count; ++i)
+        {
+            uint32 entry_hash = 0;
+            eVarType entry_type = TYPE_void;
+            int32 entry_count = 0;
+            if (!ReadVariableHeader(entry_hash, entry_type, entry_count))
+                return (false);
+
+            CVariableEntry* hte = hashtable ? hashtable->FindItem(entry_hash) : NULL;
+            if (hashtable && !hte)
+            {
+                int32 array_size = entry_type != TYPE_hashtable ? entry_count : 1;
+                hte = TinAlloc(ALLOC_VarEntry, CVariableEntry, GetScriptContext(), UnHash(entry_hash), entry_hash,
+                               entry_type, array_size, false, 0, true);
+                hashtable->AddItem(*hte, entry_hash);
+            }
+
+            if (!ReadVariableValues(hte, NULL, entry_type, entry_count))
+                return (false);
+        }
+
+        return (!mError);
+    }
+
+    int32 apply_count = 0;
+    if (ve)
+        apply_count = ve->IsArray() ? ve->GetArraySize() : 1;
+
+    for (int32 i = 0; i < count; ++i)
+    {
+        char value[kMaxTypeSize];
+        if (!ReadValue(type, value))
+            return (false);
+
+        if (i < apply_count)
+            ve->SetValue(objaddr, value, NULL, NULL, i);
+    }
+
+    return (true);
+}
+
+// ====================================================================================================================
+// ReadValue():  Read a single value - strings are added to the string table, and object IDs are remapped.
+// Only TYPE_object values are known to be object IDs - an ID stored in an int is restored unchanged, and will refer
+// to whatever object (if any) now has that ID.
+// ====================================================================================================================
+bool8 CSnapshotReader::ReadValue(eVarType type, void* value)
+{
+    if (type == TYPE_string)
+    {
+        *(uint32*)value = Hash(ReadString());
+    }
+    else if (type == TYPE_object)
+    {
+        *(uint32*)value = RemapObjectID(ReadUInt32());
+    }
+    else
+    {
+        ReadBytes(value, gRegisteredTypeSize[type]);
+    }
+
+    return (!mError);
+}
+
+// ====================================================================================================================
+// AddObjectID():  Map the ID an object had when it was saved, to the ID of the restored object.
+// ====================================================================================================================
+void CSnapshotReader::AddObjectID(uint32 saved_id, uint32 restored_id)
+{
+    if (mObjectIDCount >= mObjectIDSize)
+    {
+        int32 new_size = mObjectIDSize > 0 ? mObjectIDSize * 2 : 64;
+        tObjectIDPair* new_list = TinAllocArray(ALLOC_FileBuf, tObjectIDPair, new_size);
+        if (mObjectIDs)
+        {
+            memcpy(new_list, mObjectIDs, sizeof(tObjectIDPair) * mObjectIDCount);
+            TinFreeArray(mObjectIDs);
+        }
+        mObjectIDs = new_list;
+        mObjectIDSize = new_size;
+    }
+
+    mObjectIDs[mObjectIDCount].mSavedID = saved_id;
+    mObjectIDs[mObjectIDCount].mRestoredID = restored_id;
+    ++mObjectIDCount;
+}
+
+// ====================================================================================================================
+// CompareSavedObjectIDs():  qsort() comparison, to order the object ID map by saved ID.
+// ====================================================================================================================
+static int CompareSavedObjectIDs(const void* a, const void* b)
+{
+    uint32 id_a = *(const uint32*)a;
+    uint32 id_b = *(const uint32*)b;
+    return (id_a < id_b ? -1 : (id_a > id_b ? 1 : 0));
+}
+
+// ====================================================================================================================
+// SortObjectIDs():  Once all objects are restored, sort the map for RemapObjectID().
+// ====================================================================================================================
+void CSnapshotReader::SortObjectIDs()
+{
+    if (mObjectIDCount > 1)
+        qsort(mObjectIDs, mObjectIDCount, sizeof(tObjectIDPair), CompareSavedObjectIDs);
+}
+
+// ====================================================================================================================
+// RemapObjectID():  Returns the restored ID of a saved object - references to objects not saved become 0.
+// ====================================================================================================================
+uint32 CSnapshotReader::RemapObjectID(uint32 saved_id) const
+{
+    int32 low = 0;
+    int32 high = mObjectIDCount - 1;
+    while (saved_id != 0 && low <= high)
+    {
+        int32 mid = (low + high) / 2;
+        if (mObjectIDs[mid].mSavedID == saved_id)
+            return (mObjectIDs[mid].mRestoredID);
+        else if (mObjectIDs[mid].mSavedID < saved_id)
+            low = mid + 1;
+        else
+            high = mid - 1;
+    }
+
+    return (0);
+}
+
+// == Snapshot sections ===============================================================================================
+
+// ====================================================================================================================
+// IsSnapshotObject():  Objects registered from code are owned by code, and are not part of the snapshot.
+// ====================================================================================================================
+static bool8 IsSnapshotObject(CObjectEntry* oe)
+{
+    return (oe && !oe->IsManuallyRegistered() && !oe->IsDestroyed());
+}
+
+// ====================================================================================================================
+// WriteSnapshotObjects():  Write the ID, name, and namespace hierarchy of each object.
+// ====================================================================================================================
+static void WriteSnapshotObjects(CScriptContext* script_context, CSnapshotWriter& writer, int32& object_count)
+{
+    writer.BeginSection(SNAPSHOT_Objects);
+    int32 count_offset = writer.ReserveInt32();
+    object_count = 0;
+
+    CObjectEntry* oe = script_context->GetObjectDictionary()->First();
+    while (oe)
+    {
+        if (IsSnapshotObject(oe))
+        {
+            writer.WriteUInt32(oe->GetID());
+            writer.WriteHashString(oe->GetNameHash());
+
+            // -- the namespaces are written from the object's namespace, down to its registered class
+            int32 ns_count_offset = writer.ReserveInt32();
+            int32 ns_count = 0;
+            for (CNamespace* ns = oe->GetNamespace(); ns != NULL; ns = ns->GetNext())
+            {
+                writer.WriteString(ns->GetName());
+                ++ns_count;
+            }
+            writer.PatchInt32(ns_count_offset, ns_count);
+
+            ++object_count;
+        }
+
+        oe = script_context->GetObjectDictionary()->Next();
+    }
+
+    writer.PatchInt32(count_offset, object_count);
+}
+
+// ====================================================================================================================
+// ReadSnapshotObjects():  Link the namespace hierarchies, and create the objects (without calling OnCreate()).
+// ====================================================================================================================
+static bool8 ReadSnapshotObjects(CScriptContext* script_context, CSnapshotReader& reader, int32& object_count)
+{
+    if (!reader.ReadSection(SNAPSHOT_Objects))
+        return (false);
+
+    object_count = reader.ReadCount();
+    for (int32 i = 0; i < object_count && !reader.HasError(); ++i)
+    {
+        uint32 saved_id = reader.ReadUInt32();
+        uint32 name_hash = reader.ReadHashString();
+
+        CNamespace* object_ns = NULL;
+        CNamespace* child_ns = NULL;
+        int32 ns_count = reader.ReadCount();
+        for (int32 ns_index = 0; ns_index < ns_count && !reader.HasError(); ++ns_index)
+        {
+            CNamespace* ns = script_context->FindOrCreateNamespace(reader.ReadString(), true);
+            if (child_ns)
+                script_context->LinkNamespaces(child_ns, ns);
+            else
+                object_ns = ns;
+            child_ns = ns;
+        }
+
+        if (reader.HasError() || !object_ns)
+            return (false);
+
+        // -- an object that can't be restored maps to 0, so references to it are cleared
+        uint32 restored_id = script_context->RestoreObject(object_ns->GetHash(), name_hash);
+        reader.AddObjectID(saved_id, restored_id);
+    }
+
+    // -- with all objects restored, the remaining sections can remap object values
+    reader.SortObjectIDs();
+    return (!reader.HasError());
+}
+
+// ====================================================================================================================
+// WriteSnapshotVarTable():  Write every restorable variable in a table, returning the number written.
+// ====================================================================================================================
+static int32 WriteSnapshotVarTable(CSnapshotWriter& writer, tVarTable* var_table, void* objaddr, bool8 is_dynamic,
+                                   bool8 script_vars_only = false)
+{
+    int32 count = 0;
+    CVariableEntry* ve = var_table ? var_table->First() : NULL;
+    while (ve)
+    {
+        if (writer.CanWriteVariable(ve) && (!script_vars_only || ve->IsScriptVar()))
+        {
+            // -- object members are flagged, as dynamic variables must be added before they're restored
+            if (objaddr)
+                writer.WriteUInt32(is_dynamic ? 1 : 0);
+            writer.WriteVariable(ve, objaddr);
+            ++count;
+        }
+        ve = var_table->Next();
+    }
+
+    return (count);
+}
+
+// ====================================================================================================================
+// WriteSnapshotMembers():  Write the dynamic variables, and the registered members, of each object.
+// ====================================================================================================================
+static void WriteSnapshotMembers(CScriptContext* script_context, CSnapshotWriter& writer)
+{
+    writer.BeginSection(SNAPSHOT_Members);
+    int32 count_offset = writer.ReserveInt32();
+    int32 object_count = 0;
+
+    CObjectEntry* oe = script_context->GetObjectDictionary()->First();
+    while (oe)
+    {
+        if (IsSnapshotObject(oe))
+        {
+            writer.WriteUInt32(oe->GetID());
+            int32 var_count_offset = writer.ReserveInt32();
+            int32 var_count = WriteSnapshotVarTable(writer, oe->GetDynamicVarTable(), oe->GetAddr(), true);
+            for (CNamespace* ns = oe->GetNamespace(); ns != NULL; ns = ns->GetNext())
+                var_count += WriteSnapshotVarTable(writer, ns->GetVarTable(), oe->GetAddr(), false);
+            writer.PatchInt32(var_count_offset, var_count);
+
+            ++object_count;
+        }
+
+        oe = script_context->GetObjectDictionary()->Next();
+    }
+
+    writer.PatchInt32(count_offset, object_count);
+}
+
+// ====================================================================================================================
+// ReadSnapshotMembers():  Add the dynamic variables, and restore the member values, of each object.
+// ====================================================================================================================
+static bool8 ReadSnapshotMembers(CScriptContext* script_context, CSnapshotReader& reader)
+{
+    if (!reader.ReadSection(SNAPSHOT_Members))
+        return (false);
+
+    int32 object_count = reader.ReadCount();
+    for (int32 i = 0; i < object_count && !reader.HasError(); ++i)
+    {
+        CObjectEntry* oe = script_context->FindObjectEntry(reader.RemapObjectID(reader.ReadUInt32()));
+        int32 var_count = reader.ReadCount();
+        for (int32 var_index = 0; var_index < var_count; ++var_index)
+        {
+            bool8 is_dynamic = reader.ReadUInt32() != 0;
+            uint32 var_hash = 0;
+            eVarType type = TYPE_void;
+            int32 count = 0;
+            if (!reader.ReadVariableHeader(var_hash, type, count))
+                return (false);
+
+            if (oe && is_dynamic)
+                oe->AddDynamicVariable(var_hash, type, type != TYPE_hashtable ? count : 1);
+
+            CVariableEntry* ve = oe ? oe->GetVariableEntry(var_hash) : NULL;
+            if (!reader.ReadVariableValues(ve, oe ? oe->GetAddr() : NULL, type, count))
+                return (false);
+        }
+    }
+
+    return (!reader.HasError());
+}
+
+// ====================================================================================================================
+// WriteSnapshotSets():  Write the contents of each set (and group), in order.
+// ====================================================================================================================
+static void WriteSnapshotSets(CScriptContext* script_context, CSnapshotWriter& writer)
+{
+    writer.BeginSection(SNAPSHOT_Sets);
+    int32 count_offset = writer.ReserveInt32();
+    int32 set_count = 0;
+
+    static uint32 object_set_hash = Hash("CObjectSet");
+    CObjectEntry* oe = script_context->GetObjectDictionary()->First();
+    while (oe)
+    {
+        if (IsSnapshotObject(oe) && oe->HasNamespace(object_set_hash))
+        {
+            CObjectSet* set = static_cast<CObjectSet*>(oe->GetAddr());
+            writer.WriteUInt32(oe->GetID());
+            int32 child_count = set->Used();
+            writer.WriteInt32(child_count);
+            for (int32 i = 0; i < child_count; ++i)
+                writer.WriteUInt32(set->GetObjectByIndex(i));
+
+            ++set_count;
+        }
+
+        oe = script_context->GetObjectDictionary()->Next();
+    }
+
+    writer.PatchInt32(count_offset, set_count);
+}
+
+// ====================================================================================================================
+// ReadSnapshotSets():  Add the restored objects to their sets (groups take ownership, as usual).
+// ====================================================================================================================
+static bool8 ReadSnapshotSets(CScriptContext* script_context, CSnapshotReader& reader)
+{
+    if (!reader.ReadSection(SNAPSHOT_Sets))
+        return (false);
+
+    static uint32 object_set_hash = Hash("CObjectSet");
+    int32 set_count = reader.ReadCount();
+    for (int32 i = 0; i < set_count && !reader.HasError(); ++i)
+    {
+        CObjectEntry* oe = script_context->FindObjectEntry(reader.RemapObjectID(reader.ReadUInt32()));
+        CObjectSet* set = oe && oe->HasNamespace(object_set_hash) ? static_cast<CObjectSet*>(oe->GetAddr()) : NULL;
+
+        int32 child_count = reader.ReadCount();
+        for (int32 child_index = 0; child_index < child_count; ++child_index)
+        {
+            uint32 child_id = reader.RemapObjectID(reader.ReadUInt32());
+            if (set && child_id != 0)
+                set->AddObject(child_id);
+        }
+    }
+
+    return (!reader.HasError());
+}
+
+// ====================================================================================================================
+// WriteSnapshotGlobals():  Write the global variables.
+// ====================================================================================================================
+static void WriteSnapshotGlobals(CScriptContext* script_context, CSnapshotWriter& writer, bool8 script_globals_only)
+{
+    writer.BeginSection(SNAPSHOT_Globals);
+    int32 count_offset = writer.ReserveInt32();
+    int32 count = WriteSnapshotVarTable(writer, script_context->GetGlobalNamespace()->GetVarTable(), NULL, false,
+                                        script_globals_only);
+    writer.PatchInt32(count_offset, count);
+}
+
+// ====================================================================================================================
+// ReadSnapshotGlobals():  Restore the global variables, declaring any that don't yet exist.
+// ====================================================================================================================
+static bool8 ReadSnapshotGlobals(CScriptContext* script_context, CSnapshotReader& reader)
+{
+    if (!reader.ReadSection(SNAPSHOT_Globals))
+        return (false);
+
+    tVarTable* global_var_table = script_context->GetGlobalNamespace()->GetVarTable();
+    int32 count = reader.ReadCount();
+    for (int32 i = 0; i < count && !reader.HasError(); ++i)
+    {
+        uint32 var_hash = 0;
+        eVarType type = TYPE_void;
+        int32 value_count = 0;
+        if (!reader.ReadVariableHeader(var_hash, type, value_count))
+            return (false);
+
+        CVariableEntry* ve = global_var_table->FindItem(var_hash);
+        if (!ve)
+        {
+            int32 array_size = type != TYPE_hashtable ? value_count : 1;
+            ve = TinAlloc(ALLOC_VarEntry, CVariableEntry, script_context, UnHash(var_hash), var_hash, type,
+                          array_size, false, 0, false);
+            global_var_table->AddItem(*ve, var_hash);
+        }
+
+        if (!reader.ReadVariableValues(ve, NULL, type, value_count))
+            return (false);
+    }
+
+    return (!reader.HasError());
+}
+
+// ====================================================================================================================
+// WriteSnapshotState():  Write the objects, their members and sets, the globals, schedules, and signals.
+// ====================================================================================================================
+void WriteSnapshotState(CScriptContext* script_context, CSnapshotWriter& writer, bool8 script_globals_only,
+                        int32& object_count)
+{
+    WriteSnapshotObjects(script_context, writer, object_count);
+    WriteSnapshotMembers(script_context, writer);
+    WriteSnapshotSets(script_context, writer);
+    WriteSnapshotGlobals(script_context, writer, script_globals_only);
+
+    writer.BeginSection(SNAPSHOT_Schedules);
+    script_context->GetScheduler()->WriteSnapshot(writer);
+
+    writer.BeginSection(SNAPSHOT_Signals);
+    script_context->GetSignalManager()->WriteSnapshot(writer);
+}
+
+// ====================================================================================================================
+// ReadSnapshotState():  Restore each state section in order, returning the section that failed, or SNAPSHOT_COUNT.
+// Note:  anything restored before a failure remains.
+// ====================================================================================================================
+eSnapshotSection ReadSnapshotState(CScriptContext* script_context, CSnapshotReader& reader, int32& object_count)
+{
+    if (!ReadSnapshotObjects(script_context, reader, object_count))
+        return (SNAPSHOT_Objects);
+    if (!ReadSnapshotMembers(script_context, reader))
+        return (SNAPSHOT_Members);
+    if (!ReadSnapshotSets(script_context, reader))
+        return (SNAPSHOT_Sets);
+    if (!ReadSnapshotGlobals(script_context, reader))
+        return (SNAPSHOT_Globals);
+    if (!reader.ReadSection(SNAPSHOT_Schedules) || !script_context->GetScheduler()->ReadSnapshot(reader))
+        return (SNAPSHOT_Schedules);
+    if (!reader.ReadSection(SNAPSHOT_Signals) || !script_context->GetSignalManager()->ReadSnapshot(reader))
+        return (SNAPSHOT_Signals);
+
+    return (SNAPSHOT_COUNT);
+}
+
+// ====================================================================================================================
+// GetSnapshotSectionName():  Returns the name of a section, for error messages.
+// ====================================================================================================================
+const char* GetSnapshotSectionName(eSnapshotSection section)
+{
+    if (section < 0 || section >= SNAPSHOT_COUNT)
+        return ("<invalid>");
+    return (gSnapshotSectionNames[section]);
+}
+
+// == class CScriptContext ============================================================================================
+
+// ====================================================================================================================
+// RestoreObject():  Create an object instance without calling its OnCreate() hierarchy, as its members are
+// about to be restored directly.  Returns the new object ID, or 0 if the class can't be instantiated.
+// ====================================================================================================================
+uint32 CScriptContext::RestoreObject(uint32 classhash, uint32 objnamehash)
+{
+    CNamespace* class_namespace = NULL;
+    CNamespace* objnamens = NULL;
+    if (!ResolveCreateNamespaces(classhash, objnamehash, class_namespace, objnamens))
+        return (0);
+
+    uint32 objectid = GetNextObjectID();
+    void* newobj = (*class_namespace->GetCreateInstance())();
+    AddObjectEntry(objectid, objnamehash, objnamens, newobj, false);
+    return (objectid);
+}
+
+// ====================================================================================================================
+// SaveSnapshot():  Writes the objects, their members and sets, the globals, pending schedules, and signal
+// subscriptions to a binary file, that can be restored without parsing or executing any script.
+// ====================================================================================================================
+bool8 CScriptContext::SaveSnapshot(const char* filename)
+{
+    if (!filename || !filename[0])
+    {
+        ScriptAssert_(this, 0, "<internal>", -1, "Error - SaveSnapshot() with no filename\n");
+        return (false);
+    }
+
+    CSnapshotWriter writer(this);
+    writer.WriteUInt32(kSnapshotMagic);
+    writer.WriteInt32(kSnapshotVersion);
+
+    int32 object_count = 0;
+    WriteSnapshotState(this, writer, false, object_count);
+
+    if (!writer.SaveToFile(filename))
+    {
+        ScriptAssert_(this, 0, "<internal>", -1, "Error - unable to write file %s\n", filename);
+        return (false);
+    }
+
+    TinPrint(this, "Snapshot of %d objects saved to file: %s\n", object_count, filename);
+    return (true);
+}
+
+// ====================================================================================================================
+// LoadSnapshot():  Restores a snapshot written by SaveSnapshot().  The scripts defining the namespaces and methods
+// must already have been executed - objects are added to the context (with new IDs), and OnCreate() is not called.
+// Object IDs are remapped in object variables, members and parameters - not in ints, nor within the text of a
+// scheduled command string.
+// ====================================================================================================================
+bool8 CScriptContext::LoadSnapshot(const char* filename)
+{
+    if (!filename || !filename[0])
+    {
+        ScriptAssert_(this, 0, "<internal>", -1, "Error - LoadSnapshot() with no filename\n");
+        return (false);
+    }
+
+    CSnapshotReader reader(this);
+    if (!reader.LoadFromFile(filename))
+    {
+        ScriptAssert_(this, 0, "<internal>", -1, "Error - unable to read file %s\n", filename);
+        return (false);
+    }
+
+    if (reader.ReadUInt32() != kSnapshotMagic)
+    {
+        ScriptAssert_(this, 0, "<internal>", -1, "Error - LoadSnapshot() file %s is not a snapshot\n", filename);
+        return (false);
+    }
+
+    int32 version = reader.ReadInt32();
+    if (version != kSnapshotVersion)
+    {
+        ScriptAssert_(this, 0, "<internal>", -1, "Error - LoadSnapshot() file %s is version %d, expecting %d\n",
+                      filename, version, kSnapshotVersion);
+        return (false);
+    }
+
+    // -- restore each section in order - note:  anything restored before a failure remains
+    int32 object_count = 0;
+    eSnapshotSection failed_section = ReadSnapshotState(this, reader, object_count);
+    if (failed_section != SNAPSHOT_COUNT)
+    {
+        ScriptAssert_(this, 0, "<internal>", -1, "Error - LoadSnapshot() failed reading %s, file: %s\n",
+                      GetSnapshotSectionName(failed_section), filename);
+        return (false);
+    }
+
+    TinPrint(this, "Snapshot of %d objects restored from file: %s\n", object_count, filename);
+    return (true);
+}
+
+// ====================================================================================================================
+// ContextSaveSnapshot():  Save a snapshot of the current thread's CScriptContext.
+// ====================================================================================================================
+bool8 ContextSaveSnapshot(const char* filename)
+{
+    CScriptContext* script_context = ::TinScript::GetContext();
+    return (script_context->SaveSnapshot(filename));
+}
+
+// ====================================================================================================================
+// ContextLoadSnapshot():  Restore a snapshot into the current thread's CScriptContext.
+// ====================================================================================================================
+bool8 ContextLoadSnapshot(const char* filename)
+{
+    CScriptContext* script_context = ::TinScript::GetContext();
+    return (script_context->LoadSnapshot(filename));
+}
+
+} // TinScript
+
+// --------------------------------------------------------------------------------------------------------------------
+// -- script registered interface
+REGISTER_FUNCTION_P1(SaveSnapshot, TinScript::ContextSaveSnapshot, bool8, const char*);
+REGISTER_FUNCTION_P1(LoadSnapshot, TinScript::ContextLoadSnapshot, bool8, const char*);
+
+// ====================================================================================================================
+// EOF
+// ====================================================================================================================
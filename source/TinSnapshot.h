@@ -0,0 +1,185 @@
+// ------------------------------------------------------------------------------------------------
+//  The MIT License
+//
+//  Copyright (c) 2013 Tim Andersen
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+//  and associated documentation files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all copies or
+//  substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// ------------------------------------------------------------------------------------------------
+
+
+// ====================================================================================================================
+// TinSnapshot.h
+// ====================================================================================================================
+
+#ifndef __TINSNAPSHOT_H
+#define __TINSNAPSHOT_H
+
+// == namespace TinScript =============================================================================================
+
+namespace TinScript
+{
+
+// --------------------------------------------------------------------------------------------------------------------
+// -- forward declarations
+class CVariableEntry;
+
+// --------------------------------------------------------------------------------------------------------------------
+// -- the snapshot file begins with the magic number and the version - a snapshot of a different version is rejected
+// -- note:  values are written in their native layout, so a snapshot is only valid on a platform of the same endianness
+const uint32 kSnapshotMagic = 0x504e5354;
+const int32 kSnapshotVersion = 1;
+
+// --------------------------------------------------------------------------------------------------------------------
+// -- the sections of a snapshot, in the order they're written - objects are created before anything refers to them
+#define SnapshotSectionTuple            \
+    SnapshotSectionEntry(Objects)       \
+    SnapshotSectionEntry(Members)       \
+    SnapshotSectionEntry(Sets)          \
+    SnapshotSectionEntry(Globals)       \
+    SnapshotSectionEntry(Schedules)     \
+    SnapshotSectionEntry(Signals)       \
+    SnapshotSectionEntry(Strings)       \
+    SnapshotSectionEntry(Namespaces)    \
+    SnapshotSectionEntry(CodeBlocks)    \
+    SnapshotSectionEntry(Functions)     \
+
+// -- note:  the last four are only written to a context image (see TinClone.h), where they precede the rest
+
+enum eSnapshotSection
+{
+    #define SnapshotSectionEntry(a) SNAPSHOT_##a,
+    SnapshotSectionTuple
+    #undef SnapshotSectionEntry
+
+    SNAPSHOT_COUNT
+};
+
+// ====================================================================================================================
+// class CSnapshotWriter:  Serializes a snapshot into a growing memory buffer, written to the file in a single pass.
+// ====================================================================================================================
+class CSnapshotWriter
+{
+    public:
+        CSnapshotWriter(CScriptContext* script_context);
+        virtual ~CSnapshotWriter();
+
+        CScriptContext* GetScriptContext() { return (mContextOwner); }
+
+        void BeginSection(eSnapshotSection section);
+        void WriteBytes(const void* data, int32 count);
+        void WriteUInt32(uint32 value) { WriteBytes(&value, sizeof(uint32)); }
+        void WriteInt32(int32 value) { WriteBytes(&value, sizeof(int32)); }
+        void WriteString(const char* string);
+        void WriteHashString(uint32 hash) { WriteString(hash != 0 ? UnHash(hash) : ""); }
+
+        // -- pads to a 4-byte boundary, so an array of uint32 can be read in place
+        void WriteAlign();
+
+        // -- counts are often only known after writing the entries, so a placeholder is reserved and patched
+        int32 ReserveInt32();
+        void PatchInt32(int32 offset, int32 value);
+
+        // -- variables are written as: name, type, count, values - hashtables write their entries as the values
+        bool8 CanWriteVariable(CVariableEntry* ve) const;
+        void WriteVariable(CVariableEntry* ve, void* objaddr);
+        void WriteValue(eVarType type, void* addr);
+
+        bool8 SaveToFile(const char* filename);
+
+        // -- transfers ownership of the buffer to the caller (to be freed with TinFreeArray())
+        char* DetachBuffer(int32& size);
+
+    private:
+        CScriptContext* mContextOwner;
+        char* mBuffer;
+        int32 mSize;
+        int32 mUsed;
+};
+
+// ====================================================================================================================
+// class CSnapshotReader:  Reads a snapshot file into memory (or from a buffer it doesn't own), and deserializes it.
+// Object IDs are assigned by the context that restores them, so every object value read is remapped.
+// Any read past the end of the data sets the error flag, and returns zeroed values.
+// ====================================================================================================================
+class CSnapshotReader
+{
+    public:
+        CSnapshotReader(CScriptContext* script_context);
+        virtual ~CSnapshotReader();
+
+        CScriptContext* GetScriptContext() { return (mContextOwner); }
+
+        bool8 LoadFromFile(const char* filename);
+        void SetBuffer(const char* buffer, int32 size);
+        bool8 HasError() const { return (mError); }
+        void SetError() { mError = true; }
+
+        bool8 ReadSection(eSnapshotSection section);
+        bool8 ReadBytes(void* data, int32 count);
+        uint32 ReadUInt32();
+        int32 ReadInt32();
+        int32 ReadCount();
+        const char* ReadString(bool8 inc_refcount = false);
+        uint32 ReadHashString();
+
+        // -- returns a pointer to the data within the buffer - only valid as long as the buffer is
+        void ReadAlign();
+        const void* ReadInPlace(int32 count);
+
+        // -- reads the name, type, and count of a variable, then its values, applied to the variable if given
+        bool8 ReadVariableHeader(uint32& var_hash, eVarType& type, int32& count);
+        bool8 ReadVariableValues(CVariableEntry* ve, void* objaddr, eVarType type, int32 count);
+        bool8 ReadValue(eVarType type, void* value);
+
+        // -- the map of saved object IDs to restored object IDs (sorted once all objects are restored)
+        void AddObjectID(uint32 saved_id, uint32 restored_id);
+        void SortObjectIDs();
+        uint32 RemapObjectID(uint32 saved_id) const;
+
+    private:
+        struct tObjectIDPair
+        {
+            uint32 mSavedID;
+            uint32 mRestoredID;
+        };
+
+        CScriptContext* mContextOwner;
+        const char* mBuffer;
+        bool8 mOwnsBuffer;
+        int32 mSize;
+        int32 mReadOffset;
+        bool8 mError;
+
+        tObjectIDPair* mObjectIDs;
+        int32 mObjectIDCount;
+        int32 mObjectIDSize;
+};
+
+// --------------------------------------------------------------------------------------------------------------------
+// -- the state sections (Objects through Signals), shared by snapshots and context images
+// -- registered globals belong to the application, and can be excluded (e.g. when the reader is on another thread)
+void WriteSnapshotState(CScriptContext* script_context, CSnapshotWriter& writer, bool8 script_globals_only,
+                        int32& object_count);
+eSnapshotSection ReadSnapshotState(CScriptContext* script_context, CSnapshotReader& reader, int32& object_count);
+const char* GetSnapshotSectionName(eSnapshotSection section);
+
+} // TinScript
+
+#endif // __TINSNAPSHOT_H
+
+// ====================================================================================================================
+// EOF
+// ====================================================================================================================
@@ -324,7 +324,7 @@ const char* Print(const char* str0, const char* str1, const char* str2, const ch
     TinScript::CScriptContext* script_context = ::TinScript::GetContext();
 
     // -- automatically add a '\n'
-    TinPrint(script_context, "%s\n", str_concat);
+    TinLog(script_context, TinScript::LOG_SEVERITY_Info, TinScript::LOG_CHANNEL_Script, "%s\n", str_concat);
 
     // -- return the concatenated string
     return (str_concat);
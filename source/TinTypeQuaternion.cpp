@@ -0,0 +1,186 @@
+// ------------------------------------------------------------------------------------------------
+//  The MIT License
+//  
+//  Copyright (c) 2013 Tim Andersen
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+//  and associated documentation files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all copies or
+//  substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// ------------------------------------------------------------------------------------------------
+
+// ------------------------------------------------------------------------------------------------
+// TinTypeQuaternion.cpp : The registered type quaternion required methods
+// ------------------------------------------------------------------------------------------------
+
+// -- lib includes
+#include "stdafx.h"
+#include "stdio.h"
+#include "string.h"
+#include "stdlib.h"
+
+#include "mathutil.h"
+
+#include "TinHash.h"
+#include "TinCompile.h"
+#include "TinTypes.h"
+#include "TinScript.h"
+#include "TinStringTable.h"
+
+namespace TinScript {
+
+// --------------------------------------------------------------------------------------------------------------------
+// -- quaternion POD table
+tPODTypeTable* gQuaternionTable = NULL;
+
+// --------------------------------------------------------------------------------------------------------------------
+// External type - CQuaternion is a POD type, stored as x, y, z, w
+bool8 QuaternionToString(void* value, char* buf, int32 bufsize)
+{
+	if (value && buf && bufsize > 0)
+    {
+        CQuaternion* q = (CQuaternion*)value;
+		sprintf_s(buf, bufsize, "%.4f %.4f %.4f %.4f", q->x, q->y, q->z, q->w);
+		return (true);
+	}
+	return (false);
+}
+
+bool8 StringToQuaternion(void* addr, char* value)
+{
+	if (addr && value)
+    {
+		CQuaternion* varaddr = (CQuaternion*)addr;
+
+        // -- an empty string is the identity
+        if (!value[0])
+        {
+            *varaddr = CQuaternion::identity;
+            return (true);
+        }
+
+        // -- accepts both "x y z w" and "x, y, z, w"
+        float32 result[4];
+        if (StringToFloatArray(value, result, 4))
+        {
+            *varaddr = CQuaternion(result[0], result[1], result[2], result[3]);
+		    return (true);
+        }
+	}
+	return (false);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// -- Quaternion supports concatenation (quaternion * quaternion), rotation (quaternion * vector3f), and comparison
+bool8 QuaternionOpOverrides(CScriptContext* script_context, eOpCode op, eVarType& result_type, void* result_addr,
+                            eVarType val0_type, void* val0, eVarType val1_type, void* val1)
+{
+    // -- sanity check
+    if (!script_context || !result_addr || !val0 || !val1)
+        return (false);
+
+    // -- rotating a vector - the quaternion must be the first operand
+    if (op == OP_Mult && val1_type == TYPE_vector3f)
+    {
+        CQuaternion* q = (CQuaternion*)TypeConvert(script_context, val0_type, val0, TYPE_quaternion);
+        if (!q)
+            return (false);
+
+        result_type = TYPE_vector3f;
+        *(CVector3f*)result_addr = CQuaternion::Rotate(*q, *(CVector3f*)val1);
+        return (true);
+    }
+
+    // -- otherwise both operands must be quaternions
+    CQuaternion* q0 = (CQuaternion*)TypeConvert(script_context, val0_type, val0, TYPE_quaternion);
+    CQuaternion* q1 = (CQuaternion*)TypeConvert(script_context, val1_type, val1, TYPE_quaternion);
+    if (!q0 || !q1)
+        return (false);
+
+    int32* int_result = (int32*)result_addr;
+
+    // -- perform the operation
+    switch (op)
+    {
+        case OP_Mult:
+            result_type = TYPE_quaternion;
+            *(CQuaternion*)result_addr = *q0 * *q1;
+            return (true);
+
+        // -- comparison operations (push a -1, 0, 1) for less than, equal, greater than
+        case OP_CompareEqual:
+            result_type = TYPE_int;
+            *int_result = (*q0 == *q1) ? 0 : 1;
+            return (true);
+
+        case OP_CompareNotEqual:
+            result_type = TYPE_int;
+            *int_result = (*q0 != *q1) ? 0 : 1;
+            return (true);
+    }
+
+    // -- fail
+    return (false);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// -- Configure the registered Quaternion type, by registering the POD table and op functions
+bool8 QuaternionConfig(eVarType var_type, bool8 onInit)
+{
+    // -- see if this is the initialization or the shutdown
+    if (onInit)
+    {
+        // -- create the quaternion member lookup table (size 4 for 4x members)
+        if (gQuaternionTable == NULL)
+        {
+            gQuaternionTable = TinAlloc(ALLOC_HashTable, CHashTable<tPODTypeMember>, 4);
+            tPODTypeMember* member_x = new tPODTypeMember(TYPE_float, 0);
+            tPODTypeMember* member_y = new tPODTypeMember(TYPE_float, 4);
+            tPODTypeMember* member_z = new tPODTypeMember(TYPE_float, 8);
+            tPODTypeMember* member_w = new tPODTypeMember(TYPE_float, 12);
+            gQuaternionTable->AddItem(*member_x, Hash("x"));
+            gQuaternionTable->AddItem(*member_y, Hash("y"));
+            gQuaternionTable->AddItem(*member_z, Hash("z"));
+            gQuaternionTable->AddItem(*member_w, Hash("w"));
+        }
+
+        // -- now register the hashtable
+        RegisterPODTypeTable(var_type, gQuaternionTable);
+
+        // -- register the operation overrides
+        RegisterTypeOpOverride(OP_Mult, TYPE_quaternion, QuaternionOpOverrides);
+        RegisterTypeOpOverride(OP_CompareEqual, TYPE_quaternion, QuaternionOpOverrides);
+        RegisterTypeOpOverride(OP_CompareNotEqual, TYPE_quaternion, QuaternionOpOverrides);
+    }
+
+    // -- shutdown
+    else
+    {
+        // -- memory cleanup for the quaternion lookup table
+        if (gQuaternionTable != NULL)
+        {
+            gQuaternionTable->DestroyAll();
+            TinFree(gQuaternionTable);
+            gQuaternionTable = NULL;
+        }
+    }
+
+    // -- success
+    return (true);
+}
+
+} // TinScript
+
+// ------------------------------------------------------------------------------------------------
+// eof
+// ------------------------------------------------------------------------------------------------
@@ -59,23 +59,51 @@ bool8 StringToVector3f(void* addr, char* value) {
 		CVector3f* varaddr = (CVector3f*)addr;
 
         // -- handle an empty string
-        if (!value || !value[0])
+        if (!value[0])
         {
             *varaddr = CVector3f(0.0f, 0.0f, 0.0f);
             return (true);
         }
 
-        else if(sscanf_s(value, "%f %f %f", &varaddr->x, &varaddr->y, &varaddr->z) == 3) {
-		    return (true);
-        }
-
-        else if(sscanf_s(value, "%f, %f, %f", &varaddr->x, &varaddr->y, &varaddr->z) == 3) {
+        // -- accepts both "x y z" and "x, y, z"
+        float32 result[3];
+        if (StringToFloatArray(value, result, 3))
+        {
+            *varaddr = CVector3f(result[0], result[1], result[2]);
 		    return (true);
         }
 	}
 	return false;
 }
 
+// --------------------------------------------------------------------------------------------------------------------
+// StringToFloatArray():  Parses a fixed count of floats, separated by whitespace and/or commas.
+// Used instead of sscanf(), since vector values are converted from strings every time they're assigned a literal.
+bool8 StringToFloatArray(const char* value, float32* result, int32 count)
+{
+    if (!value || !result)
+        return (false);
+
+    const char* parse_ptr = value;
+    for (int32 i = 0; i < count; ++i)
+    {
+        // -- skip the separators
+        while (*parse_ptr == ' ' || *parse_ptr == '\t' || *parse_ptr == ',')
+            ++parse_ptr;
+
+        char* end_ptr = NULL;
+        float32 parsed = (float32)strtod(parse_ptr, &end_ptr);
+        if (end_ptr == parse_ptr)
+            return (false);
+
+        result[i] = parsed;
+        parse_ptr = end_ptr;
+    }
+
+    // -- success
+    return (true);
+}
+
 // --------------------------------------------------------------------------------------------------------------------
 // -- Vector3f only supports specific operations
 bool8 Vector3fOpOverrides(CScriptContext* script_context, eOpCode op, eVarType& result_type, void* result_addr,
@@ -85,11 +113,16 @@ bool8 Vector3fOpOverrides(CScriptContext* script_context, eOpCode op, eVarType&
     if (!script_context || !result_addr || !val0 || !val1)
         return (false);
 
-    // -- ensure the types are converted to vector3f
-    void* val0addr = TypeConvert(script_context, val0_type, val0, TYPE_vector3f);
-    void* val1addr = TypeConvert(script_context, val1_type, val1, TYPE_vector3f);
-    if (!val0addr || !val1addr)
-        return (false);
+    // -- ensure the types are converted to vector3f (the common case being they already are)
+    void* val0addr = val0;
+    void* val1addr = val1;
+    if (val0_type != TYPE_vector3f || val1_type != TYPE_vector3f)
+    {
+        val0addr = TypeConvert(script_context, val0_type, val0, TYPE_vector3f);
+        val1addr = TypeConvert(script_context, val1_type, val1, TYPE_vector3f);
+        if (!val0addr || !val1addr)
+            return (false);
+    }
 
     CVector3f* v0 = (CVector3f*)val0addr;
     CVector3f* v1 = (CVector3f*)val1addr;
@@ -133,8 +166,19 @@ bool8 Vector3fScale(CScriptContext* script_context, eOpCode op, eVarType& result
         return (false);
 
     // -- division is a scalar, but the order is relevent
-    CVector3f* v = (CVector3f*)TypeConvert(script_context, val0_type, val0, TYPE_vector3f);
-    float32* scalar = (float32*)TypeConvert(script_context, val1_type, val1, TYPE_float);
+    // -- (the common case, vector3f * float, needs no conversion)
+    CVector3f* v = NULL;
+    float32* scalar = NULL;
+    if (val0_type == TYPE_vector3f && val1_type == TYPE_float)
+    {
+        v = (CVector3f*)val0;
+        scalar = (float32*)val1;
+    }
+    else
+    {
+        v = (CVector3f*)TypeConvert(script_context, val0_type, val0, TYPE_vector3f);
+        scalar = (float32*)TypeConvert(script_context, val1_type, val1, TYPE_float);
+    }
     if (!v && op != OP_Div)
     {
         v = (CVector3f*)TypeConvert(script_context, val1_type, val1, TYPE_vector3f);
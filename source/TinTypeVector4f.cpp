@@ -0,0 +1,270 @@
+// ------------------------------------------------------------------------------------------------
+//  The MIT License
+//  
+//  Copyright (c) 2013 Tim Andersen
+//  
+//  Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+//  and associated documentation files (the "Software"), to deal in the Software without
+//  restriction, including without limitation the rights to use, copy, modify, merge, publish,
+//  distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the
+//  Software is furnished to do so, subject to the following conditions:
+//  
+//  The above copyright notice and this permission notice shall be included in all copies or
+//  substantial portions of the Software.
+//  
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+//  BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//  NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+//  DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// ------------------------------------------------------------------------------------------------
+
+// ------------------------------------------------------------------------------------------------
+// TinTypeVector4f.cpp : The registered type vector4f required methods
+// ------------------------------------------------------------------------------------------------
+
+// -- lib includes
+#include "stdafx.h"
+#include "stdio.h"
+#include "string.h"
+#include "stdlib.h"
+
+#include "mathutil.h"
+
+#include "TinHash.h"
+#include "TinCompile.h"
+#include "TinTypes.h"
+#include "TinScript.h"
+#include "TinStringTable.h"
+
+namespace TinScript {
+
+// --------------------------------------------------------------------------------------------------------------------
+// -- vector4f POD table
+tPODTypeTable* gVector4fTable = NULL;
+
+// --------------------------------------------------------------------------------------------------------------------
+// External type - CVector4f is a POD type, stored as x, y, z, w
+bool8 Vector4fToString(void* value, char* buf, int32 bufsize)
+{
+	if (value && buf && bufsize > 0)
+    {
+        CVector4f* v = (CVector4f*)value;
+		sprintf_s(buf, bufsize, "%.4f %.4f %.4f %.4f", v->x, v->y, v->z, v->w);
+		return (true);
+	}
+	return (false);
+}
+
+bool8 StringToVector4f(void* addr, char* value)
+{
+	if (addr && value)
+    {
+		CVector4f* varaddr = (CVector4f*)addr;
+
+        // -- an empty string is the zero vector
+        if (!value[0])
+        {
+            *varaddr = CVector4f::zero;
+            return (true);
+        }
+
+        // -- accepts both "x y z w" and "x, y, z, w"
+        float32 result[4];
+        if (StringToFloatArray(value, result, 4))
+        {
+            *varaddr = CVector4f(result[0], result[1], result[2], result[3]);
+		    return (true);
+        }
+	}
+	return (false);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// -- Vector4f supports addition, subtraction, and comparison with another vector4f
+bool8 Vector4fOpOverrides(CScriptContext* script_context, eOpCode op, eVarType& result_type, void* result_addr,
+                          eVarType val0_type, void* val0, eVarType val1_type, void* val1)
+{
+    // -- sanity check
+    if (!script_context || !result_addr || !val0 || !val1)
+        return (false);
+
+    // -- ensure the types are converted to vector4f (the common case being they already are)
+    void* val0addr = val0;
+    void* val1addr = val1;
+    if (val0_type != TYPE_vector4f || val1_type != TYPE_vector4f)
+    {
+        val0addr = TypeConvert(script_context, val0_type, val0, TYPE_vector4f);
+        val1addr = TypeConvert(script_context, val1_type, val1, TYPE_vector4f);
+        if (!val0addr || !val1addr)
+            return (false);
+    }
+
+    CVector4f* v0 = (CVector4f*)val0addr;
+    CVector4f* v1 = (CVector4f*)val1addr;
+    CVector4f* result = (CVector4f*)result_addr;
+    result_type = TYPE_vector4f;
+    int32* int_result = (int32*)result_addr;
+
+    // -- perform the operation
+    switch (op)
+    {
+        case OP_Add:
+            *result = *v0 + *v1;
+            return (true);
+
+        case OP_Sub:
+            *result = *v0 - *v1;
+            return (true);
+
+        // -- comparison operations (push a -1, 0, 1) for less than, equal, greater than
+        case OP_CompareEqual:
+            result_type = TYPE_int;
+            *int_result = (*v0 == *v1) ? 0 : 1;
+            return (true);
+
+        case OP_CompareNotEqual:
+            result_type = TYPE_int;
+            *int_result = (*v0 != *v1) ? 0 : 1;
+            return (true);
+    }
+
+    // -- fail
+    return (false);
+}
+
+bool8 Vector4fScale(CScriptContext* script_context, eOpCode op, eVarType& result_type, void* result_addr,
+                    eVarType val0_type, void* val0, eVarType val1_type, void* val1)
+{
+    // -- sanity check
+    if (!script_context || !result_addr || !val0 || !val1)
+        return (false);
+
+    // -- one of the types must be a vector4f, the other must be able to be converted to a float
+    // -- division is a scalar, but the order is relevent
+    CVector4f* v = NULL;
+    float32* scalar = NULL;
+    if (val0_type == TYPE_vector4f && val1_type == TYPE_float)
+    {
+        v = (CVector4f*)val0;
+        scalar = (float32*)val1;
+    }
+    else
+    {
+        v = (CVector4f*)TypeConvert(script_context, val0_type, val0, TYPE_vector4f);
+        scalar = (float32*)TypeConvert(script_context, val1_type, val1, TYPE_float);
+    }
+    if (!v && op != OP_Div)
+    {
+        v = (CVector4f*)TypeConvert(script_context, val1_type, val1, TYPE_vector4f);
+        scalar = (float32*)TypeConvert(script_context, val0_type, val0, TYPE_float);
+    }
+
+    // -- ensure we found valid types
+    if (!v || !scalar)
+        return (false);
+
+    // -- set up the result
+    CVector4f* result = (CVector4f*)result_addr;
+    result_type = TYPE_vector4f;
+
+    // -- perform the operation
+    switch (op)
+    {
+        case OP_Mult:
+            *result = *v * *scalar;
+            return (true);
+
+        case OP_Div:
+            *result = *v / *scalar;
+            return (true);
+    }
+
+    // -- fail
+    return (false);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// -- Type conversion functions
+void* Vector4fToBoolConvert(CScriptContext* script_context, eVarType from_type, void* from_val, void* to_buffer)
+{
+    // -- sanity check
+    if (!from_val || !to_buffer)
+        return (NULL);
+
+    // -- a non-zero vector4f is true, false otherwise
+    if (from_type == TYPE_vector4f)
+    {
+        CVector4f* v4 = (CVector4f*)from_val;
+        *(bool*)to_buffer = (*v4 == CVector4f::zero) ? 0 : 1;
+        return (void*)(to_buffer);
+    }
+
+    // -- no registered conversion
+    return (NULL);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// -- Configure the registered Vector4f type, by registering the POD table and op functions
+bool8 Vector4fConfig(eVarType var_type, bool8 onInit)
+{
+    // -- see if this is the initialization or the shutdown
+    if (onInit)
+    {
+        // -- create the vector4f member lookup table (size 4 for 4x members)
+        if (gVector4fTable == NULL)
+        {
+            gVector4fTable = TinAlloc(ALLOC_HashTable, CHashTable<tPODTypeMember>, 4);
+            tPODTypeMember* member_x = new tPODTypeMember(TYPE_float, 0);
+            tPODTypeMember* member_y = new tPODTypeMember(TYPE_float, 4);
+            tPODTypeMember* member_z = new tPODTypeMember(TYPE_float, 8);
+            tPODTypeMember* member_w = new tPODTypeMember(TYPE_float, 12);
+            gVector4fTable->AddItem(*member_x, Hash("x"));
+            gVector4fTable->AddItem(*member_y, Hash("y"));
+            gVector4fTable->AddItem(*member_z, Hash("z"));
+            gVector4fTable->AddItem(*member_w, Hash("w"));
+        }
+
+        // -- now register the hashtable
+        RegisterPODTypeTable(var_type, gVector4fTable);
+
+        // -- register the operation overrides
+        RegisterTypeOpOverride(OP_Add, TYPE_vector4f, Vector4fOpOverrides);
+        RegisterTypeOpOverride(OP_Sub, TYPE_vector4f, Vector4fOpOverrides);
+
+        RegisterTypeOpOverride(OP_CompareEqual, TYPE_vector4f, Vector4fOpOverrides);
+        RegisterTypeOpOverride(OP_CompareNotEqual, TYPE_vector4f, Vector4fOpOverrides);
+
+        // -- boolean operations - let type bool handle them
+        RegisterTypeOpOverride(OP_BooleanAnd, TYPE_vector4f, BooleanBinaryOp);
+        RegisterTypeOpOverride(OP_BooleanOr, TYPE_vector4f, BooleanBinaryOp);
+
+        // -- scalar operations use both a vector4f and a float
+        RegisterTypeOpOverride(OP_Mult, TYPE_vector4f, Vector4fScale);
+        RegisterTypeOpOverride(OP_Div, TYPE_vector4f, Vector4fScale);
+
+        // -- register the conversion from Vector4f to bool - note the first arg is Type_bool
+        RegisterTypeConvert(TYPE_bool, TYPE_vector4f, Vector4fToBoolConvert);
+    }
+
+    // -- shutdown
+    else
+    {
+        // -- memory cleanup for the vector4f lookup table
+        if (gVector4fTable != NULL)
+        {
+            gVector4fTable->DestroyAll();
+            TinFree(gVector4fTable);
+            gVector4fTable = NULL;
+        }
+    }
+
+    // -- success
+    return (true);
+}
+
+} // TinScript
+
+// ------------------------------------------------------------------------------------------------
+// eof
+// ------------------------------------------------------------------------------------------------
@@ -390,13 +390,13 @@ void* TypeConvert(CScriptContext* script_context, eVarType fromtype, void* froma
     if (! fromaddr)
         return (NULL);
 
+    // -- if the type remains the same, no conversion is necessary
+    if (fromtype == totype)
+        return fromaddr;
+
     // -- each script context maintains an array of scratch buffers...
     // -- this allows us to have a place to do conversions, without memory management
     char* bufferptr = script_context->GetScratchBuffer();
-    
-    // -- if the type remains the same, no conversion is necessary
-    if (fromtype == totype || !fromaddr)
-        return fromaddr;
 
     // -- if the "to type" is a string, use the registered string conversion function
     if (totype == TYPE_string)
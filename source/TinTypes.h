@@ -342,6 +342,15 @@ bool8 BoolConfig(eVarType var_type, bool8 onInit);
 bool8 Vector3fToString(void* value, char* buf, int32 bufsize);
 bool8 StringToVector3f(void* addr, char* value);
 bool8 Vector3fConfig(eVarType var_type, bool8 onInit);
+bool8 QuaternionToString(void* value, char* buf, int32 bufsize);
+bool8 StringToQuaternion(void* addr, char* value);
+bool8 QuaternionConfig(eVarType var_type, bool8 onInit);
+bool8 Vector4fToString(void* value, char* buf, int32 bufsize);
+bool8 StringToVector4f(void* addr, char* value);
+bool8 Vector4fConfig(eVarType var_type, bool8 onInit);
+
+// -- parses count floats, separated by whitespace and/or commas (used by the vector types)
+bool8 StringToFloatArray(const char* value, float32* result, int32 count);
 
 // ====================================================================================================================
 // -- operation and conversion type functions
@@ -364,7 +373,7 @@ typedef void* (*TypeConvertFunction)(CScriptContext* script_context, eVarType fr
 // -- will be chosen.  E.g. (3.5f * 10) is 35 using a float op, whereas (3.5f * 10) is 30 in integer math
 
 #define FIRST_VALID_TYPE TYPE_hashtable
-#define LAST_VALID_TYPE TYPE_vector3f
+#define LAST_VALID_TYPE TYPE_vector4f
 #define VarTypeTuple \
 	VarTypeEntry(NULL,		    0,		VoidToString,		StringToVoid,       uint8,          NULL)               \
 	VarTypeEntry(void,		    0,		VoidToString,		StringToVoid,       uint8,          NULL)   	        \
@@ -381,6 +390,8 @@ typedef void* (*TypeConvertFunction)(CScriptContext* script_context, eVarType fr
 	VarTypeEntry(int,		    4,		IntToString,		StringToInt,        int32,          IntegerConfig)      \
 	VarTypeEntry(bool,		    1,		BoolToString,		StringToBool,       bool8,          BoolConfig)         \
 	VarTypeEntry(vector3f,	   12,		Vector3fToString,   StringToVector3f,   CVector3f,      Vector3fConfig)		\
+	VarTypeEntry(quaternion,   16,		QuaternionToString, StringToQuaternion, CQuaternion,    QuaternionConfig)	\
+	VarTypeEntry(vector4f,     16,		Vector4fToString,   StringToVector4f,   CVector4f,      Vector4fConfig)		\
 
 // -- 4x words actually, 16x bytes, the size of a HashVar
 #define MAX_TYPE_SIZE 4
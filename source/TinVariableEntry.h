@@ -76,13 +76,13 @@ public:
     int32 GetArraySize() const
     {
         // -- note:  0 or 1 means this is not an array...
-        // -- postive value < kMaxVariableArraySize is the size, and -1 is an array, but an undetermined size
-        return (mArraySize);
+        // -- a positive value is the size, and -1 is an array, but an undetermined size
+        return (mArraySource ? mArraySource->mArraySize : mArraySize);
     }
 
     bool8 IsArray() const
     {
-        return ((mArraySize != 0 && mArraySize != 1) || (mArraySize == -1 && mIsParameter));
+        return ((mArraySize != 0 && mArraySize != 1) || (mArraySize == -1 && mIsParameter) || mIsResizedArray);
     }
 
     // -- strings being special...
@@ -92,6 +92,8 @@ public:
     }
 
     bool8 ConvertToArray(int32 array_size);
+    bool8 ResizeArray(int32 new_size);
+    bool8 HasArraySource() const { return (mArraySource != NULL); }
     void ClearArrayParameter();
     void InitializeArrayParameter(CVariableEntry* assign_from_ve, CObjectEntry* assign_from_oe,
                                   CExecStack& execstack, CFunctionCallStack& funccallstack);
@@ -134,7 +136,7 @@ public:
         if(objaddr && !mIsDynamic)
             valueaddr = (void*)((char*)objaddr + mOffset);
         else
-            valueaddr = mAddr;
+            valueaddr = mArraySource ? mArraySource->mAddr : mAddr;
 
         // -- return the value address
         return valueaddr;
@@ -158,7 +160,7 @@ public:
         if(objaddr && !mIsDynamic)
             valueaddr = (void*)((char*)objaddr + mOffset);
         else
-            valueaddr = mAddr;
+            valueaddr = mArraySource ? mArraySource->mAddr : mAddr;
 
         // -- return the address
         return (valueaddr);
@@ -191,11 +193,11 @@ public:
         }
 
         // -- ensure we're within range
-        if (array_index < 0 || array_index >= mArraySize)
+        if (array_index < 0 || array_index >= GetArraySize())
         {
             ScriptAssert_(GetScriptContext(), false, "<internal>", -1,
                           "Error - GetArrayVarAddr() index %d out of range [%d],\nvariable: %s\n", array_index,
-                          mArraySize, UnHash(GetHash()));
+                          GetArraySize(), UnHash(GetHash()));
             return (NULL);
         } 
 
@@ -214,6 +216,12 @@ public:
         return (mIsParameter);
     }
 
+    // -- false for variables registered from code, whose value is stored at an address owned by the application
+    bool8 IsScriptVar() const
+    {
+        return (mScriptVar);
+    }
+
     bool8 IsStackVariable(CFunctionCallStack& funccallstack) const;
 
     void SetValue(void* objaddr, void* value, CExecStack* execstack = NULL, CFunctionCallStack* funccallstack = NULL,
@@ -345,6 +353,8 @@ private:
     bool8 mIsParameter;
     bool8 mIsDynamic;
     bool8 mScriptVar;
+    bool8 mIsResizedArray; // once resized, an array remains an array, even with a size of 1
+    CVariableEntry* mArraySource; // the resizable array an array parameter is bound to
     mutable uint32 mStringValueHash;
     mutable uint32* mStringHashArray; // used only for registered string *arrays*
     uint32 mDispatchConvertFromObject;
@@ -95,12 +95,15 @@ typedef float               float32;
     AllocTypeEntry(ObjEntry)        \
     AllocTypeEntry(Namespace)       \
     AllocTypeEntry(SchedCmd)        \
+    AllocTypeEntry(Coroutine)       \
+    AllocTypeEntry(Signal)          \
     AllocTypeEntry(FuncCallEntry)   \
     AllocTypeEntry(CreateObj)       \
     AllocTypeEntry(StringTable)     \
     AllocTypeEntry(ObjectGroup)     \
     AllocTypeEntry(FileBuf)         \
     AllocTypeEntry(Debugger)        \
+    AllocTypeEntry(Log)             \
 
 enum eAllocType {
     #define AllocTypeEntry(a) ALLOC_##a,
@@ -111,6 +114,11 @@ enum eAllocType {
 #define TinAlloc(alloctype, T, ...) \
     new (reinterpret_cast<T*>(::operator new(sizeof(T)))) T(__VA_ARGS__)
 
+// -- tree nodes are bump allocated from the parse arena of the codeblock being compiled, and are released
+// -- all at once by DestroyTree() - they must not own any resources requiring a destructor
+#define TinAllocTreeNode(codeblock, T, ...) \
+    new (reinterpret_cast<T*>((codeblock)->GetParseArena()->Alloc(sizeof(T)))) T(__VA_ARGS__)
+
 #define TinAllocVarContent(type) \
     new char[gRegisteredTypeSize[_type]];
 
@@ -136,6 +144,7 @@ typedef bool8 (*TinAssertHandler)(TinScript::CScriptContext* script_context, con
     {                                                                                           \
         if(!(condition) && (!scriptcontext->mDebuggerConnected ||								\
 							!scriptcontext->mDebuggerBreakLoopGuard)) {                         \
+            scriptcontext->DrainLog();                                                          \
             if(!scriptcontext->GetAssertHandler()(scriptcontext, #condition, file, linenumber,  \
                                                   fmt, ##__VA_ARGS__)) {                        \
                 __asm   int 3                                                                   \
@@ -144,12 +153,23 @@ typedef bool8 (*TinAssertHandler)(TinScript::CScriptContext* script_context, con
     }
 
 // -- Pass a function of the following prototype when creating the CScriptContext
+// -- note:  the print handler is called by whichever thread drains the log (see CScriptLog)
 typedef int (*TinPrintHandler)(const char* fmt, ...);
-#define TinPrint(scriptcontext, fmt, ...)                           \
-    if (scriptcontext != NULL)                                      \
-    {                                                               \
-        scriptcontext->GetPrintHandler()(fmt, ##__VA_ARGS__);       \
-        scriptcontext->DebuggerSendPrint(fmt, ##__VA_ARGS__);       \
+#define TinPrint(scriptcontext, fmt, ...)                                                                       \
+    TinLog(scriptcontext, ::TinScript::LOG_SEVERITY_Info, ::TinScript::LOG_CHANNEL_System, fmt, ##__VA_ARGS__)
+
+// -- "Error - ..." and "Warning - ..." messages use these, so raising the log severity to quiet informational
+// -- output never hides them
+#define TinPrintError(scriptcontext, fmt, ...)                                                                  \
+    TinLog(scriptcontext, ::TinScript::LOG_SEVERITY_Error, ::TinScript::LOG_CHANNEL_System, fmt, ##__VA_ARGS__)
+#define TinPrintWarning(scriptcontext, fmt, ...)                                                                \
+    TinLog(scriptcontext, ::TinScript::LOG_SEVERITY_Warning, ::TinScript::LOG_CHANNEL_System, fmt, ##__VA_ARGS__)
+
+// -- the arguments aren't evaluated, and nothing is formatted, unless the severity and channel are enabled
+#define TinLog(scriptcontext, severity, channel, fmt, ...)                                                      \
+    if (scriptcontext != NULL && scriptcontext->IsLogEnabled(severity, channel))                               \
+    {                                                                                                           \
+        scriptcontext->Log(severity, channel, fmt, ##__VA_ARGS__);                                              \
     }
 
 #endif // __INTEGRATION_H
@@ -27,6 +27,8 @@
 
 // -- lib includes
 #include "stdio.h"
+#include <chrono>
+#include <thread>
 
 #include "mathutil.h"
 
@@ -34,6 +36,9 @@
 #include "TinHash.h"
 #include "TinScript.h"
 #include "TinRegistration.h"
+#include "TinCompile.h"
+#include "TinParse.h"
+#include "TinScheduler.h"
 
 // -- use the DECLARE_FILE/REGISTER_FILE macros to prevent deadstripping
 DECLARE_FILE(unittest_cpp);
@@ -591,6 +596,303 @@ void UnitTest_RegisteredStringArrayModify()
     sprintf_s(CUnitTest::gCodeResult, "%s %s", gUnitTestStringArray[4], gUnitTestStringArray[9]);
 }
 
+// -- an array parameter refers to the resized array, not to its storage at the time of the call
+void UnitTest_ArrayResizeParamDefine()
+{
+    TinScript::GetContext()->ExecCommand(
+        "int[4] gUnitTestResizeArray;"
+        "void UnitTest_ArrayResizeParam(int[] values)"
+        "{"
+        "    values[3] = 7;"
+        "    arrayresize(gUnitTestResizeArray, 64);"
+        "    values[40] = 9;"
+        "    arrayresize(values, 48);"
+        "    gUnitTestScriptResult = StringCat(arraycount(values), ' ', values[3], ' ', gUnitTestResizeArray[40], ' ',"
+        "                                      arraycount(gUnitTestResizeArray));"
+        "}");
+}
+
+// -- wait/yield tests ------------------------------------------------------------------------------------------------
+// -- a suspended function only resumes from the scheduler, so these tests advance it themselves, from its current time
+
+static const char* kUnitTestReloadScriptName = "unittest_reload.ts";
+static const char* kUnitTestReloadBinaryName = "unittest_reload.tso";
+
+void UnitTest_AdvanceScheduler(int32 update_count, uint32 update_ms)
+{
+    TinScript::CScheduler* scheduler = TinScript::GetContext()->GetScheduler();
+    for (int32 i = 0; i < update_count; ++i)
+        scheduler->Update(scheduler->GetCurrentSimTime() + update_ms);
+}
+
+bool8 UnitTest_WriteScriptFile(const char* filename, const char* script)
+{
+    FILE* filehandle = NULL;
+    int32 result = fopen_s(&filehandle, filename, "w");
+    if (result != 0 || !filehandle)
+    {
+        ScriptAssert_(TinScript::GetContext(), 0, "<internal>", -1,
+                      "Error - unable to write unit test script: %s\n", filename);
+        return (false);
+    }
+
+    fputs(script, filehandle);
+    fclose(filehandle);
+    return (true);
+}
+
+// -- the locals of a scheduled function survive each wait
+void UnitTest_WaitLocals()
+{
+    TinScript::CScriptContext* script_context = TinScript::GetContext();
+    script_context->ExecCommand(
+        "string gUnitTestWaitResult = '';"
+        "void UnitTest_WaitLocalsFunc(int count)"
+        "{"
+        "    int total = 0;"
+        "    while (count > 0)"
+        "    {"
+        "        total += count;"
+        "        count -= 1;"
+        "        wait 10;"
+        "    }"
+        "    gUnitTestWaitResult = StringCat(total, ' ', count);"
+        "}"
+        "schedule(0, 1, Hash('UnitTest_WaitLocalsFunc'), 4);");
+
+    // -- four waits, then the function completes
+    UnitTest_AdvanceScheduler(8, 10);
+    sprintf_s(CUnitTest::gCodeResult, "%d", script_context->GetScheduler()->GetCoroutineCount());
+}
+
+// -- a yield resumes on the next update, not the same one
+void UnitTest_YieldNextUpdate()
+{
+    TinScript::CScriptContext* script_context = TinScript::GetContext();
+    script_context->ExecCommand(
+        "string gUnitTestWaitResult = '';"
+        "void UnitTest_YieldNextUpdateFunc()"
+        "{"
+        "    gUnitTestWaitResult = 'before';"
+        "    yield;"
+        "    gUnitTestWaitResult = StringCat(gUnitTestWaitResult, ' after');"
+        "}"
+        "schedule(0, 1, Hash('UnitTest_YieldNextUpdateFunc'));");
+
+    const char* first_update = "";
+    const char* second_update = "";
+    UnitTest_AdvanceScheduler(1, 1);
+    TinScript::GetGlobalVar(script_context, "gUnitTestWaitResult", first_update);
+    char first_result[kMaxArgLength];
+    TinScript::SafeStrcpy(first_result, first_update, kMaxArgLength);
+
+    UnitTest_AdvanceScheduler(1, 1);
+    TinScript::GetGlobalVar(script_context, "gUnitTestWaitResult", second_update);
+    sprintf_s(CUnitTest::gCodeResult, "%s|%s", first_result, second_update);
+}
+
+// -- a wait is an error anywhere but the function called directly by the scheduler
+void UnitTest_WaitUnscheduled()
+{
+    TinScript::CScriptContext* script_context = TinScript::GetContext();
+    script_context->ExecCommand(
+        "string gUnitTestWaitResult = '';"
+        "void UnitTest_WaitUnscheduledFunc()"
+        "{"
+        "    wait 10;"
+        "    gUnitTestWaitResult = 'resumed';"
+        "}");
+
+    bool8 result = script_context->ExecCommand("UnitTest_WaitUnscheduledFunc();");
+    UnitTest_AdvanceScheduler(2, 10);
+    sprintf_s(CUnitTest::gCodeResult, "%s %d", result ? "executed" : "failed",
+              script_context->GetScheduler()->GetCoroutineCount());
+}
+
+// -- destroying an object cancels its suspended methods
+void UnitTest_WaitCancelDestroy()
+{
+    TinScript::CScriptContext* script_context = TinScript::GetContext();
+    script_context->ExecCommand(
+        "string gUnitTestWaitResult = '';"
+        "void UnitTestWaiter::OnCreate() : CScriptObject { }"
+        "void UnitTestWaiter::WaitFunc()"
+        "{"
+        "    gUnitTestWaitResult = 'started';"
+        "    wait 10;"
+        "    gUnitTestWaitResult = 'resumed';"
+        "}"
+        "object gUnitTestWaiter = create UnitTestWaiter('UnitTestWaiter');"
+        "schedule(gUnitTestWaiter, 1, Hash('WaitFunc'));");
+
+    UnitTest_AdvanceScheduler(1, 1);
+    int32 suspended_count = script_context->GetScheduler()->GetCoroutineCount();
+
+    script_context->ExecCommand("destroy gUnitTestWaiter;");
+    UnitTest_AdvanceScheduler(2, 10);
+    sprintf_s(CUnitTest::gCodeResult, "%d %d", suspended_count, script_context->GetScheduler()->GetCoroutineCount());
+}
+
+// -- reloading a changed function cancels its suspended executions (CancelCoroutines()), as its locals no longer match
+void UnitTest_WaitCancelReload()
+{
+    TinScript::CScriptContext* script_context = TinScript::GetContext();
+    script_context->ExecCommand("string gUnitTestWaitResult = '';");
+
+    // -- ensure we compile the source, and not a binary left by a previous run
+    remove(kUnitTestReloadBinaryName);
+    bool8 success = UnitTest_WriteScriptFile(kUnitTestReloadScriptName,
+        "void UnitTest_WaitReloadFunc()\n"
+        "{\n"
+        "    gUnitTestWaitResult = 'started';\n"
+        "    wait 10;\n"
+        "    gUnitTestWaitResult = 'resumed';\n"
+        "}\n");
+    success = success && TinScript::ExecScript(kUnitTestReloadScriptName);
+    success = success && script_context->ExecCommand("schedule(0, 1, Hash('UnitTest_WaitReloadFunc'));");
+
+    UnitTest_AdvanceScheduler(1, 1);
+    int32 suspended_count = script_context->GetScheduler()->GetCoroutineCount();
+
+    success = success && UnitTest_WriteScriptFile(kUnitTestReloadScriptName,
+        "void UnitTest_WaitReloadFunc()\n"
+        "{\n"
+        "    gUnitTestWaitResult = 'reloaded';\n"
+        "}\n");
+    success = success && TinScript::ReloadScript(kUnitTestReloadScriptName);
+    int32 reloaded_count = script_context->GetScheduler()->GetCoroutineCount();
+
+    UnitTest_AdvanceScheduler(2, 10);
+    remove(kUnitTestReloadScriptName);
+    remove(kUnitTestReloadBinaryName);
+
+    sprintf_s(CUnitTest::gCodeResult, "%s %d %d", success ? "reloaded" : "failed", suspended_count, reloaded_count);
+}
+
+void UnitTest_ReloadUnchanged()
+{
+    TinScript::CScriptContext* script_context = TinScript::GetContext();
+    script_context->ExecCommand("string gUnitTestWaitResult = '';");
+
+    // -- ensure we compile the source, and not a binary left by a previous run
+    remove(kUnitTestReloadBinaryName);
+    bool8 success = UnitTest_WriteScriptFile(kUnitTestReloadScriptName,
+        "void UnitTest_ReloadKeepFunc()\n"
+        "{\n"
+        "    gUnitTestWaitResult = 'started';\n"
+        "    wait 10;\n"
+        "    gUnitTestWaitResult = 'resumed';\n"
+        "}\n"
+        "void UnitTest_ReloadEditFunc() { gUnitTestWaitResult = 'original'; }\n");
+    success = success && TinScript::ExecScript(kUnitTestReloadScriptName);
+    success = success && script_context->ExecCommand("schedule(0, 1, Hash('UnitTest_ReloadKeepFunc'));");
+    UnitTest_AdvanceScheduler(1, 1);
+
+    // -- only the second function changes - the suspended call to the first continues in the new codeblock
+    success = success && UnitTest_WriteScriptFile(kUnitTestReloadScriptName,
+        "void UnitTest_ReloadKeepFunc()\n"
+        "{\n"
+        "    gUnitTestWaitResult = 'started';\n"
+        "    wait 10;\n"
+        "    gUnitTestWaitResult = 'resumed';\n"
+        "}\n"
+        "void UnitTest_ReloadEditFunc() { gUnitTestWaitResult = 'edited'; }\n");
+    success = success && TinScript::ReloadScript(kUnitTestReloadScriptName);
+    int32 suspended_count = script_context->GetScheduler()->GetCoroutineCount();
+
+    // -- the file is registered to a single codeblock
+    uint32 filename_hash = TinScript::Hash(kUnitTestReloadScriptName);
+    int32 registered_count = 0;
+    TinScript::CCodeBlock* codeblock = script_context->GetCodeBlockList()->First();
+    while (codeblock)
+    {
+        if (codeblock->GetFilenameHash() == filename_hash)
+            ++registered_count;
+        codeblock = script_context->GetCodeBlockList()->Next();
+    }
+
+    UnitTest_AdvanceScheduler(2, 10);
+    remove(kUnitTestReloadScriptName);
+    remove(kUnitTestReloadBinaryName);
+
+    sprintf_s(CUnitTest::gCodeResult, "%s %d %d", success ? "reloaded" : "failed", suspended_count, registered_count);
+}
+
+// -- snapshot tests --------------------------------------------------------------------------------------------------
+// -- LoadSnapshot() adds to the context it's loaded into, so the round trip runs on its own thread, with a context to
+// -- save from, and a fresh context to restore into
+
+static const char* kUnitTestSnapshotName = "unittest_snapshot.tss";
+static char gUnitTestSnapshotResult[TinScript::kMaxTokenLength];
+
+void UnitTest_SnapshotDefinitions()
+{
+    TinScript::GetContext()->ExecCommand(
+        "int gUnitTestSnapshotInt = 0;"
+        "string gUnitTestSnapshotTick = '';"
+        "object gUnitTestSnapshotGroup;"
+        "object gUnitTestSnapshotA;"
+        "void UnitTestSnapshot::OnCreate() : CScriptObject { int self.value = 0; }"
+        "void UnitTestSnapshotTick(object target, int count)"
+        "{"
+        "    gUnitTestSnapshotTick = StringCat(target.value, ' ', count);"
+        "}");
+}
+
+void UnitTest_SnapshotThread(TinPrintHandler printhandler, TinAssertHandler asserthandler)
+{
+    // -- save a context holding an object, a group, a global, and a pending schedule
+    TinScript::CScriptContext::Create(printhandler, asserthandler, false);
+    UnitTest_SnapshotDefinitions();
+    bool8 success = TinScript::GetContext()->ExecCommand(
+        "gUnitTestSnapshotGroup = create CObjectGroup('UnitTestSnapshotGroup');"
+        "gUnitTestSnapshotA = create UnitTestSnapshot('UnitTestSnapshotA');"
+        "gUnitTestSnapshotA.value = 17;"
+        "gUnitTestSnapshotGroup.AddObject(gUnitTestSnapshotA);"
+        "gUnitTestSnapshotInt = 23;"
+        "schedule(0, 500, Hash('UnitTestSnapshotTick'), gUnitTestSnapshotA, 5);");
+    success = success && TinScript::GetContext()->SaveSnapshot(kUnitTestSnapshotName);
+    TinScript::CScriptContext::Destroy();
+
+    // -- restore into a fresh context, and compare - the filler object ensures the restored IDs are remapped
+    TinScript::CScriptContext::Create(printhandler, asserthandler, false);
+    UnitTest_SnapshotDefinitions();
+    success = success && TinScript::GetContext()->ExecCommand("create CScriptObject('UnitTestSnapshotFiller');");
+    success = success && TinScript::GetContext()->LoadSnapshot(kUnitTestSnapshotName);
+    success = success && TinScript::GetContext()->ExecCommand(
+        "gUnitTestSnapshotTick = StringCat(gUnitTestSnapshotA.value, ' ', gUnitTestSnapshotGroup.Used(), ' ',"
+        "                                  gUnitTestSnapshotGroup.Contains(gUnitTestSnapshotA), ' ',"
+        "                                  gUnitTestSnapshotA == FindObject('UnitTestSnapshotA'), ' ',"
+        "                                  gUnitTestSnapshotInt);");
+
+    const char* restored = "";
+    success = success && TinScript::GetGlobalVar(TinScript::GetContext(), "gUnitTestSnapshotTick", restored);
+    char restored_buf[TinScript::kMaxTokenLength];
+    TinScript::SafeStrcpy(restored_buf, restored, TinScript::kMaxTokenLength);
+
+    UnitTest_AdvanceScheduler(1, 600);
+    const char* ticked = "";
+    success = success && TinScript::GetGlobalVar(TinScript::GetContext(), "gUnitTestSnapshotTick", ticked);
+
+    if (success)
+        sprintf_s(gUnitTestSnapshotResult, "%s|%s", restored_buf, ticked);
+    else
+        TinScript::SafeStrcpy(gUnitTestSnapshotResult, "failed", TinScript::kMaxTokenLength);
+
+    TinScript::CScriptContext::Destroy();
+    remove(kUnitTestSnapshotName);
+}
+
+void UnitTest_SnapshotRoundTrip()
+{
+    TinScript::CScriptContext* script_context = TinScript::GetContext();
+    std::thread snapshot_thread(UnitTest_SnapshotThread, script_context->GetPrintHandler(),
+                                script_context->GetAssertHandler());
+    snapshot_thread.join();
+
+    sprintf_s(CUnitTest::gCodeResult, "%s", gUnitTestSnapshotResult);
+}
+
 bool8 CreateUnitTests()
 {
     // -- initialize the result
@@ -704,6 +1006,13 @@ bool8 CreateUnitTests()
         success = success && AddUnitTest("vector3f_dot", "(1, 2, 3) dot (4 5 6)", "vector3f v0 = '1, 2, 3'; vector3f v1 = '4 5 6'; gUnitTestScriptResult = StringCat(V3fDot(v0, v1));", "32.0000");
         success = success && AddUnitTest("vector3f_norm", "(1, 2, 3) normalized", "vector3f v0 = '1, 2, 3'; gUnitTestScriptResult = StringCat(V3fNormalized(v0));", "0.2673 0.5345 0.8018");
 
+        // -- vector4f unit tests -----------------------------------------------------------------------------------------
+        success = success && AddUnitTest("vector4f_add", "(1, 2, 3, 4) + (5, 6, 7, 8)", "vector4f v0 = '1, 2, 3, 4'; vector4f v1 = '5 6 7 8'; gUnitTestScriptResult = StringCat(v0 + v1);", "6.0000 8.0000 10.0000 12.0000");
+        success = success && AddUnitTest("vector4f_scale", "-2.0f * (1, 2, 3, 4) / 4.0f", "vector4f v0 = '1, 2, 3, 4'; gUnitTestScriptResult = StringCat(-2.0f * v0 / 4.0f);", "-0.5000 -1.0000 -1.5000 -2.0000");
+        success = success && AddUnitTest("vector4f_podw", "Print the 'w' of (1, 2, 3, 4)", "vector4f v0 = '1, 2, 3, 4'; gUnitTestScriptResult = StringCat(v0:w);", "4.0000");
+        success = success && AddUnitTest("vector4f_dot", "(1, 2, 3, 4) dot (5 6 7 8)", "vector4f v0 = '1, 2, 3, 4'; vector4f v1 = '5 6 7 8'; gUnitTestScriptResult = StringCat(V4fDot(v0, v1));", "70.0000");
+        success = success && AddUnitTest("vector4f_lerp", "(0, 0, 0, 0) lerp (2 4 6 8) by 0.25", "vector4f v0; vector4f v1 = '2 4 6 8'; gUnitTestScriptResult = StringCat(V4fLerp(v0, v1, 0.25f));", "0.5000 1.0000 1.5000 2.0000");
+
         // -- script access to registered variables -------------------------------------------------------------------
         success = success && AddUnitTest("scriptaccess_regint", "gUnitTestRegisteredInt, value 17 read from script", "UnitTest_RegisteredIntAccess();", "17", UnitTest_RegisteredIntAccess);
         success = success && AddUnitTest("scriptmodify_regint", "Modify gUnitTestRegisteredInt set to 23 from script", "UnitTest_RegisteredIntModify();", "", UnitTest_RegisteredIntModify, "23", true);
@@ -766,6 +1075,18 @@ bool8 CreateUnitTests()
         success = success && AddUnitTest("registered_string_array", "Registered string[15]", "UnitTest_CodeStringArray();", "", UnitTest_RegisteredStringArrayModify, "Winter Goodbye", true);
         success = success && AddUnitTest("registered_member_int_array", "Registered int[15]", "UnitTest_CodeMemberIntArray();", "19 67");
         success = success && AddUnitTest("registered_member_string_array", "Registered int[15]", "UnitTest_CodeMemberStringArray();", "Foobar Goodbye");
+        success = success && AddUnitTest("param_array_resize", "Resize an int[] bound to a parameter", "UnitTest_ArrayResizeParam(gUnitTestResizeArray);", "48 7 9 48", UnitTest_ArrayResizeParamDefine);
+
+        // -- wait/yield in scheduled functions ------------------------------------------------------------------------
+        success = success && AddUnitTest("wait_locals", "Locals survive a wait", "gUnitTestScriptResult = gUnitTestWaitResult;", "10 0", UnitTest_WaitLocals, "0");
+        success = success && AddUnitTest("yield_next_update", "A yield resumes on the next update", "gUnitTestScriptResult = gUnitTestWaitResult;", "before after", UnitTest_YieldNextUpdate, "before|before after");
+        success = success && AddUnitTest("wait_unscheduled", "A wait outside a scheduled call is an error", "gUnitTestScriptResult = gUnitTestWaitResult;", "", UnitTest_WaitUnscheduled, "failed 0");
+        success = success && AddUnitTest("wait_cancel_destroy", "Destroying an object cancels its suspended method", "gUnitTestScriptResult = gUnitTestWaitResult;", "started", UnitTest_WaitCancelDestroy, "1 0");
+        success = success && AddUnitTest("wait_cancel_reload", "Reloading a function cancels its suspended calls", "gUnitTestScriptResult = gUnitTestWaitResult;", "started", UnitTest_WaitCancelReload, "reloaded 1 0");
+        success = success && AddUnitTest("reload_unchanged", "A reload moves unchanged functions to the new codeblock", "gUnitTestScriptResult = gUnitTestWaitResult;", "resumed", UnitTest_ReloadUnchanged, "reloaded 1 1");
+
+        // -- snapshot tests
+        success = success && AddUnitTest("snapshot_round_trip", "Restore a snapshot into a fresh context", "", "", UnitTest_SnapshotRoundTrip, "17 1 true true 23|17 5");
     }
 
     // -- return success
@@ -950,6 +1271,89 @@ void BeginMultiThreadTest()
 REGISTER_FUNCTION_P2(BeginUnitTests, BeginUnitTests, void, bool8, const char*);
 REGISTER_FUNCTION_P0(BeginMultiThreadTest, BeginMultiThreadTest, void);
 
+// -- parse throughput benchmark --------------------------------------------------------------------------------------
+
+// -- the scripts of the demo, parsed by default
+static const char* kParseBenchmarkScripts[] = { "TinScriptDemo.ts", "asteroids.ts", "demotools.ts" };
+
+// --------------------------------------------------------------------------------------------------------------------
+// ParseBenchmarkFile():  Parse and compile a file the given number of times, without executing or committing it.
+// Returns the total elapsed time in microseconds, or -1 if the file couldn't be parsed.
+// --------------------------------------------------------------------------------------------------------------------
+int64 ParseBenchmarkFile(TinScript::CScriptContext* script_context, const char* filename, int32 iterations)
+{
+    const char* filebuf = TinScript::ReadFileAllocBuf(filename);
+    if (!filebuf)
+    {
+        MTPrint("Error - ParseBenchmark():  unable to read file: %s\n", filename);
+        return (-1);
+    }
+
+    // -- each parse is compiled as a reload, so the functions are detached, and discarded with the codeblock
+    int64 elapsed_us = 0;
+    for (int32 i = 0; i < iterations; ++i)
+    {
+        std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+        TinScript::CCodeBlock* codeblock = TinScript::ParseText(script_context, filename, filebuf, true);
+        elapsed_us += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                            start_time).count();
+        if (!codeblock)
+        {
+            elapsed_us = -1;
+            break;
+        }
+
+        codeblock->SetReloading(false);
+        codeblock->SetFinishedParsing();
+        TinScript::CCodeBlock::DestroyCodeBlock(codeblock);
+    }
+
+    int32 length = (int32)strlen(filebuf);
+    TinFreeArray((char*)filebuf);
+
+    if (elapsed_us >= 0)
+    {
+        int64 per_parse_us = elapsed_us / iterations;
+        MTPrint("%s:  %d bytes, %d parses, %lld us per parse, %.1f KB/sec\n", filename, length, iterations,
+                per_parse_us, elapsed_us > 0 ? ((double)length * iterations * 1000000.0 / 1024.0) / elapsed_us : 0.0);
+    }
+
+    return (elapsed_us);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// BeginParseBenchmark():  Measure the parse and compile throughput of a script, or of the demo scripts by default.
+// --------------------------------------------------------------------------------------------------------------------
+void BeginParseBenchmark(const char* filename, int32 iterations)
+{
+    TinScript::CScriptContext* script_context = TinScript::GetContext();
+    if (!script_context)
+        return;
+
+    if (iterations <= 0)
+        iterations = 100;
+
+    MTPrint("\n*** TinScript Parse Benchmark ***\n");
+    if (filename && filename[0])
+    {
+        ParseBenchmarkFile(script_context, filename, iterations);
+    }
+    else
+    {
+        int64 total_us = 0;
+        int32 count = sizeof(kParseBenchmarkScripts) / sizeof(kParseBenchmarkScripts[0]);
+        for (int32 i = 0; i < count; ++i)
+        {
+            int64 elapsed_us = ParseBenchmarkFile(script_context, kParseBenchmarkScripts[i], iterations);
+            if (elapsed_us > 0)
+                total_us += elapsed_us;
+        }
+        MTPrint("Total:  %lld us for %d parses of each script\n", total_us, iterations);
+    }
+}
+
+REGISTER_FUNCTION_P2(BeginParseBenchmark, BeginParseBenchmark, void, const char*, int32);
+
 // -- useful for profiling
 #ifdef WIN32
 	#include "windows.h"
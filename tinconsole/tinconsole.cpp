@@ -81,6 +81,7 @@ int32 _tmain(int32 argc, _TCHAR* argv[])
     // -- required to ensure registered functions from unittest.cpp are linked.
     REGISTER_FILE(unittest_cpp);
     REGISTER_FILE(mathutil_cpp);
+    REGISTER_FILE(spatialgrid_cpp);
     REGISTER_FILE(socket_cpp);
 
     // -- initialize